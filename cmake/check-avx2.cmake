@@ -0,0 +1,10 @@
+include(CheckCXXSourceCompiles)
+
+check_cxx_source_compiles("
+#include <immintrin.h>
+int main() {
+	__m256i i = _mm256_set1_epi64x(42);
+	__m256d a = _mm256_castsi256_pd(_mm256_add_epi64(i, i)), b = _mm256_set1_pd(23);
+	_mm256_sqrt_pd(_mm256_add_pd(a, b));
+	return 0;
+}" has_avx2_immintrin)
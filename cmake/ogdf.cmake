@@ -3,7 +3,7 @@
 # cache configuration
 option(BUILD_SHARED_LIBS "Whether to build shared libraries instead of static ones." OFF)
 set(OGDF_MEMORY_MANAGER "POOL_TS" CACHE STRING "Memory manager to be used.")
-set_property(CACHE OGDF_MEMORY_MANAGER PROPERTY STRINGS POOL_TS POOL_NTS MALLOC_TS)
+set_property(CACHE OGDF_MEMORY_MANAGER PROPERTY STRINGS POOL_TS POOL_NTS MALLOC_TS ARENA_TS)
 set(OGDF_DEBUG_MODE "REGULAR" CACHE STRING "Whether to use (heavy) OGDF assertions in debug mode.")
 set_property(CACHE OGDF_DEBUG_MODE PROPERTY STRINGS NONE REGULAR HEAVY)
 mark_as_advanced(OGDF_DEBUG_MODE)
@@ -203,6 +203,14 @@ else()
   message(STATUS "SSE3 could not be activated")
 endif()
 
+# autogen header variables for AVX2
+include(check-avx2)
+if(has_avx2_immintrin)
+  set(OGDF_AVX2_EXTENSIONS <immintrin.h>)
+else()
+  message(STATUS "AVX2 could not be activated")
+endif()
+
 # autogen header variables for Linux-specific CPU_SET, etc.
 include(check-cpu-macros)
 if(has_linux_cpu_macros)
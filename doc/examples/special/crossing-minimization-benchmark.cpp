@@ -0,0 +1,104 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/fileformats/GraphIO.h>
+#include <ogdf/layered/BarycenterHeuristic.h>
+#include <ogdf/layered/GreedySwitchHeuristic.h>
+#include <ogdf/layered/Hierarchy.h>
+#include <ogdf/layered/HierarchyLevels.h>
+#include <ogdf/layered/LayerByLayerSweep.h>
+#include <ogdf/layered/LongestPathRanking.h>
+#include <ogdf/layered/MedianHeuristic.h>
+#include <ogdf/layered/SiftingHeuristic.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ogdf;
+
+// performs one top-down and one bottom-up sweep over all levels
+static void sweep(HierarchyLevels& levels, LayerByLayerSweep& heuristic) {
+	levels.direction(HierarchyLevels::TraversingDir::downward);
+	for (int i = 1; i <= levels.high(); ++i) {
+		heuristic.call(levels[i]);
+	}
+	levels.direction(HierarchyLevels::TraversingDir::upward);
+	for (int i = levels.high() - 1; i >= 0; --i) {
+		heuristic.call(levels[i]);
+	}
+}
+
+// the levels of a graph ranked by longest paths
+struct Instance {
+	NodeArray<int> rank;
+	std::unique_ptr<Hierarchy> H;
+	std::unique_ptr<HierarchyLevels> levels;
+
+	explicit Instance(const Graph& G) : rank(G) {
+		LongestPathRanking().call(G, rank);
+		H.reset(new Hierarchy(G, rank));
+		levels.reset(new HierarchyLevels(*H));
+	}
+};
+
+// returns the number of sweeps per second over all instances
+static double run(std::vector<std::unique_ptr<Instance>>& instances, LayerByLayerSweep& heuristic,
+		int sweeps) {
+	int64_t t;
+	System::usedRealTime(t);
+	for (std::unique_ptr<Instance>& instance : instances) {
+		HierarchyLevels& levels = *instance->levels;
+		heuristic.init(levels);
+		for (int k = 0; k < sweeps; ++k) {
+			sweep(levels, heuristic);
+		}
+		heuristic.cleanup();
+	}
+	t = System::usedRealTime(t);
+	return t == 0 ? 0.0 : 1000.0 * sweeps * instances.size() / t;
+}
+
+int main(int argc, char* argv[]) {
+	int sweeps = argc > 1 ? std::atoi(argv[1]) : 100;
+
+	// read the Rome or North graphs given as arguments, or generate graphs of similar size
+	std::vector<std::unique_ptr<Graph>> graphs;
+	for (int i = 2; i < argc; ++i) {
+		std::unique_ptr<Graph> G(new Graph);
+		if (GraphIO::read(*G, argv[i])) {
+			graphs.push_back(std::move(G));
+		} else {
+			std::cerr << "Could not read " << argv[i] << std::endl;
+		}
+	}
+	if (graphs.empty()) {
+		for (int n = 10; n <= 100; ++n) {
+			std::unique_ptr<Graph> G(new Graph);
+			randomHierarchy(*G, n, 4 * n / 3, false, false, true);
+			graphs.push_back(std::move(G));
+		}
+	}
+
+	std::vector<std::unique_ptr<Instance>> instances;
+	for (const std::unique_ptr<Graph>& G : graphs) {
+		instances.emplace_back(new Instance(*G));
+	}
+
+	std::cout << graphs.size() << " graphs, " << sweeps << " sweeps per graph" << std::endl
+			  << "heuristic      sweeps/s" << std::endl;
+
+	BarycenterHeuristic barycenter;
+	MedianHeuristic median;
+	SiftingHeuristic sifting;
+	GreedySwitchHeuristic greedySwitch;
+	std::cout << "barycenter     " << run(instances, barycenter, sweeps) << std::endl
+			  << "median         " << run(instances, median, sweeps) << std::endl
+			  << "sifting        " << run(instances, sifting, sweeps) << std::endl
+			  << "greedy switch  " << run(instances, greedySwitch, sweeps) << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,80 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/fileformats/DotLexer.h>
+#include <ogdf/fileformats/DotParser.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+using namespace ogdf;
+
+// throughput in MBytes per second
+static double throughput(size_t bytes, int64_t ms) {
+	return ms > 0 ? bytes / 1048576.0 / (ms / 1000.0) : 0.0;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc < 2 || argc > 3) {
+		std::cerr << "usage: " << argv[0] << " <file.dot> [threads]" << std::endl;
+		return 1;
+	}
+	unsigned int numThreads = argc == 3 ? std::atoi(argv[2]) : 0;
+
+	std::ifstream is(argv[1], std::ios::binary);
+	std::string input {std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+
+	// lexing, the tokens refer to the input buffer
+	int64_t t;
+	System::usedRealTime(t);
+	dot::Lexer lexer(input.data(), input.data() + input.size());
+	bool ok = lexer.tokenize();
+	int64_t tLex = System::usedRealTime(t);
+
+	// building the syntax tree, sequentially and with the requested number of threads
+	int64_t tAstSequential = 0, tAstParallel = 0;
+	if (ok) {
+		System::usedRealTime(t);
+		dot::Ast sequential(lexer.tokens());
+		ok = sequential.build(1);
+		tAstSequential = System::usedRealTime(t);
+	}
+	if (ok) {
+		System::usedRealTime(t);
+		dot::Ast parallel(lexer.tokens());
+		ok = parallel.build(numThreads);
+		tAstParallel = System::usedRealTime(t);
+	}
+
+	// the whole reader, including the creation of the graph and its attributes
+	Graph G;
+	GraphAttributes GA(G, GraphAttributes::all);
+	int64_t tRead = 0;
+	if (ok) {
+		std::istringstream in(input);
+		System::usedRealTime(t);
+		dot::Parser parser(in, numThreads);
+		ok = parser.read(G, GA);
+		tRead = System::usedRealTime(t);
+	}
+
+	std::cout << "input:          " << input.size() << " bytes, "
+			  << lexer.tokens().size() << " tokens" << std::endl
+			  << "lexer:          " << tLex << " ms (" << throughput(input.size(), tLex)
+			  << " MB/s)" << std::endl
+			  << "AST, 1 thread:  " << tAstSequential << " ms ("
+			  << throughput(input.size(), tAstSequential) << " MB/s)" << std::endl
+			  << "AST, parallel:  " << tAstParallel << " ms ("
+			  << throughput(input.size(), tAstParallel) << " MB/s)" << std::endl
+			  << "read:           " << tRead << " ms (" << throughput(input.size(), tRead)
+			  << " MB/s), " << (ok ? "ok" : "failed") << std::endl
+			  << "nodes:          " << G.numberOfNodes() << std::endl
+			  << "edges:          " << G.numberOfEdges() << std::endl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/graph_generators.h>
+#include <ogdf/energybased/FastMultipoleEmbedder.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+
+using namespace ogdf;
+
+// returns the running time of the layout in ms
+static int64_t run(const Graph& G, bool threeD, int iterations, int threads) {
+	GraphAttributes GA(G,
+			GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics
+					| (threeD ? GraphAttributes::threeD : 0));
+	FastMultipoleEmbedder fme;
+	fme.setNumIterations(iterations);
+	fme.setNumberOfThreads(threads);
+	int64_t t;
+	System::usedRealTime(t);
+	fme.call(GA);
+	return System::usedRealTime(t);
+}
+
+int main(int argc, char* argv[]) {
+	int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+	int threads = argc > 2 ? std::atoi(argv[2]) : System::numberOfProcessors();
+
+	std::cout << "AVX2: " << (System::cpuSupports(CPUFeature::AVX2) ? "yes" : "no")
+			  << ", threads: " << threads << std::endl
+			  << "nodes   2D ms   3D ms" << std::endl;
+
+	for (int n : {1000, 10000, 50000, 100000}) {
+		Graph G;
+		randomSimpleConnectedGraph(G, n, 2 * n);
+		int64_t twoD = run(G, false, iterations, threads);
+		int64_t threeD = run(G, true, iterations, threads);
+		std::cout << n << "\t" << twoD << "\t" << threeD << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/fileformats/GmlParser.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifndef OGDF_SYSTEM_WINDOWS
+#	include <sys/resource.h>
+#endif
+
+using namespace ogdf;
+
+// peak resident set size of the process in KBytes
+static size_t peakKBytes() {
+#ifdef OGDF_SYSTEM_WINDOWS
+	return System::peakMemoryUsedByProcess() / 1024;
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#	ifdef __APPLE__
+	return usage.ru_maxrss / 1024;
+#	else
+	return usage.ru_maxrss;
+#	endif
+#endif
+}
+
+int main(int argc, char* argv[]) {
+	if (argc != 3 || (std::string(argv[2]) != "tree" && std::string(argv[2]) != "stream")) {
+		std::cerr << "usage: " << argv[0] << " <file.gml> tree|stream" << std::endl;
+		return 1;
+	}
+
+	// the peak memory is a property of the whole process, so only one parser is run per call
+	bool streaming = std::string(argv[2]) == "stream";
+	std::ifstream is(argv[1]);
+
+	size_t peakBefore = peakKBytes();
+	int64_t t;
+	System::usedRealTime(t);
+
+	Graph G;
+	GraphAttributes GA(G, GraphAttributes::all);
+	gml::Parser parser(is, false, streaming);
+	bool ok = parser.read(G, GA);
+
+	t = System::usedRealTime(t);
+
+	std::cout << (streaming ? "streaming" : "object tree") << " parser: "
+			  << (ok ? "ok" : "failed") << std::endl
+			  << "nodes:     " << G.numberOfNodes() << std::endl
+			  << "edges:     " << G.numberOfEdges() << std::endl
+			  << "time:      " << t << " ms" << std::endl
+			  << "peak RSS:  " << peakKBytes() << " KBytes (" << peakBefore << " KBytes before reading)"
+			  << std::endl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+#include <ogdf/basic/Array.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/graph_generators.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+using namespace ogdf;
+
+// creates and destroys numArrays node arrays on G in each of numThreads threads
+static int64_t run(const Graph& G, int numThreads, int numArrays) {
+	std::vector<std::function<void()>> workers(numThreads, [&] {
+		for (int i = 0; i < numArrays; ++i) {
+			NodeArray<int> a(G, i);
+			NodeArray<bool> b(G, false);
+		}
+	});
+
+	int64_t t;
+	System::usedRealTime(t);
+	Array<Thread> threads(numThreads);
+	for (int i = 0; i < numThreads; ++i) {
+		threads[i] = Thread(workers[i]);
+	}
+	for (Thread& thread : threads) {
+		thread.join();
+	}
+	return System::usedRealTime(t);
+}
+
+int main(int argc, char* argv[]) {
+	int maxThreads = argc > 1 ? std::atoi(argv[1]) : 32;
+	int numArrays = argc > 2 ? std::atoi(argv[2]) : 200000;
+
+	// a small graph, so the time is dominated by the registration of the arrays
+	Graph G;
+	randomSimpleGraph(G, 16, 32);
+
+	std::cout << "threads  ms      arrays/ms  speedup" << std::endl;
+	int64_t single = 0;
+	for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+		int64_t ms = run(G, numThreads, numArrays);
+		if (numThreads == 1) {
+			single = ms;
+		}
+		double perMs = ms > 0 ? 2.0 * numArrays * numThreads / ms : 0.0;
+		double speedup = ms > 0 ? double(single) * numThreads / ms : 0.0;
+		std::cout << numThreads << "\t " << ms << "\t " << perMs << "\t    " << speedup << std::endl;
+	}
+
+	return 0;
+}
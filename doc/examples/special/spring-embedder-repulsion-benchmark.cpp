@@ -0,0 +1,66 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/energybased/SpringEmbedderGridVariant.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <vector>
+
+using namespace ogdf;
+
+// creates numClusters dense clusters of clusterSize nodes, each with a hub adjacent to all of
+// its nodes, and connects consecutive clusters by a single edge
+static void clusteredGraph(Graph& G, int numClusters, int clusterSize) {
+	std::vector<node> hubs;
+	for (int c = 0; c < numClusters; ++c) {
+		std::vector<node> nodes;
+		for (int i = 0; i < clusterSize; ++i) {
+			nodes.push_back(G.newNode());
+		}
+		for (int i = 1; i < clusterSize; ++i) {
+			G.newEdge(nodes[0], nodes[i]);
+			for (int j = 0; j < 2; ++j) {
+				node w = nodes[randomNumber(1, clusterSize - 1)];
+				if (w != nodes[i] && G.searchEdge(nodes[i], w) == nullptr) {
+					G.newEdge(nodes[i], w);
+				}
+			}
+		}
+		if (!hubs.empty()) {
+			G.newEdge(hubs.back(), nodes[randomNumber(1, clusterSize - 1)]);
+		}
+		hubs.push_back(nodes[0]);
+	}
+}
+
+// returns the running time of the layout in ms
+static int64_t run(const Graph& G, SpringEmbedderGridVariant::Repulsion repulsion) {
+	GraphAttributes GA(G);
+	SpringEmbedderGridVariant layout;
+	layout.repulsion(repulsion);
+	int64_t t;
+	System::usedRealTime(t);
+	layout.call(GA);
+	return System::usedRealTime(t);
+}
+
+int main(int argc, char* argv[]) {
+	int numClusters = argc > 1 ? std::atoi(argv[1]) : 20;
+
+	std::cout << "AVX2: " << (System::cpuSupports(CPUFeature::AVX2) ? "yes" : "no") << std::endl
+			  << "nodes   grid ms  Barnes-Hut ms" << std::endl;
+
+	for (int clusterSize : {100, 200, 500, 1000}) {
+		Graph G;
+		clusteredGraph(G, numClusters, clusterSize);
+		int64_t grid = run(G, SpringEmbedderGridVariant::Repulsion::grid);
+		int64_t barnesHut = run(G, SpringEmbedderGridVariant::Repulsion::barnesHut);
+		std::cout << G.numberOfNodes() << "\t" << grid << "\t " << barnesHut << std::endl;
+	}
+
+	return 0;
+}
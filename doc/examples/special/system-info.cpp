@@ -35,6 +35,8 @@ int main()
 	  << "VMX:    " << yn(System::cpuSupports(CPUFeature::VMX))    << std::endl
 	  << "SMX:    " << yn(System::cpuSupports(CPUFeature::SMX))    << std::endl
 	  << "EST:    " << yn(System::cpuSupports(CPUFeature::EST))    << std::endl
+	  << "AVX:    " << yn(System::cpuSupports(CPUFeature::AVX))    << std::endl
+	  << "AVX2:   " << yn(System::cpuSupports(CPUFeature::AVX2))   << std::endl
 	  << std::endl
 
 	  << "Memory management:" << std::endl
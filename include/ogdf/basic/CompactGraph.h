@@ -0,0 +1,121 @@
+/** \file
+ * \brief Declaration of ogdf::CompactGraph, an immutable
+ *        compressed sparse row (CSR) snapshot of a graph.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/basic.h>
+
+#include <vector>
+
+namespace ogdf {
+
+//! Immutable compressed sparse row (CSR) snapshot of a Graph.
+/**
+ * @ingroup graphs
+ *
+ * A CompactGraph stores the adjacency lists of a graph in three contiguous
+ * arrays (offsets, adjacent node indices, edge indices) so that read-only
+ * traversals do not have to chase the pointers of the doubly linked lists
+ * used by Graph. It is built in time O(n + m) from any Graph (including
+ * GraphCopy and its relatives) and is indexed by node->index() and
+ * edge->index() of the original graph. Hence NodeArray and EdgeArray
+ * instances of the original graph can be accessed directly by the indices
+ * returned by a CompactGraph.
+ *
+ * The adjacency slots of node index \a v are the half-open range
+ * [firstAdj(\a v), stopAdj(\a v)) and follow the order of \a v's adjacency
+ * list in the original graph, so embeddings are preserved. Indices that do
+ * not belong to a node of the original graph (e.g. of deleted nodes) have
+ * an empty range.
+ *
+ * The snapshot does not observe the original graph: modifying the graph
+ * after construction invalidates the CompactGraph.
+ */
+class OGDF_EXPORT CompactGraph {
+public:
+	//! Builds the snapshot of \p G in time O(n + m).
+	explicit CompactGraph(const Graph& G);
+
+	//! Returns the graph this snapshot was built from.
+	const Graph& constGraph() const { return *m_pGraph; }
+
+	//! Returns the number of nodes.
+	int numberOfNodes() const { return static_cast<int>(m_nodes.size()); }
+
+	//! Returns the number of edges.
+	int numberOfEdges() const { return m_numberOfEdges; }
+
+	//! Returns the largest used node index.
+	int maxNodeIndex() const { return static_cast<int>(m_offset.size()) - 2; }
+
+	//! Returns the largest used edge index.
+	int maxEdgeIndex() const { return static_cast<int>(m_edges.size()) - 1; }
+
+	//! Returns the indices of all nodes in the order of Graph::nodes.
+	const std::vector<int>& nodes() const { return m_nodes; }
+
+	//! Returns the first adjacency slot of the node with index \p v.
+	int firstAdj(int v) const { return m_offset[v]; }
+
+	//! Returns the adjacency slot behind the last one of the node with index \p v.
+	int stopAdj(int v) const { return m_offset[v + 1]; }
+
+	//! Returns the degree of the node with index \p v.
+	int degree(int v) const { return m_offset[v + 1] - m_offset[v]; }
+
+	//! Returns the index of the node at the other end of adjacency slot \p i.
+	int twinNode(int i) const { return m_twin[i]; }
+
+	//! Returns the index of the edge of adjacency slot \p i.
+	int edgeIndex(int i) const { return m_adjEdge[i] >> 1; }
+
+	//! Returns true iff the node owning adjacency slot \p i is the source of its edge.
+	bool isOutgoing(int i) const { return (m_adjEdge[i] & 1) != 0; }
+
+	//! Returns the node of the original graph with index \p v.
+	node original(int v) const { return m_original[v]; }
+
+	//! Returns the edge of the original graph with index \p e.
+	edge originalEdge(int e) const { return m_edges[e]; }
+
+private:
+	const Graph* m_pGraph; //!< The original graph.
+	int m_numberOfEdges; //!< The number of edges.
+
+	std::vector<int> m_nodes; //!< Indices of all nodes in list order.
+	std::vector<int> m_offset; //!< First adjacency slot of each node index (plus sentinel).
+	std::vector<int> m_twin; //!< Adjacent node index of each adjacency slot.
+	std::vector<int> m_adjEdge; //!< Edge index of each slot shifted left by one; lowest bit marks outgoing slots.
+	std::vector<node> m_original; //!< Original node of each node index.
+	std::vector<edge> m_edges; //!< Original edge of each edge index.
+};
+
+}
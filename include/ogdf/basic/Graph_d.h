@@ -767,6 +767,8 @@ OGDF_DECL_REG_ARRAY(AdjEntryArray)
  * and thus delayed, that is, when the callback is made the Graph may already contain some further
  * (fully initialized) nodes or edges for which the respective callbacks have not been called
  * (but will be called right after).
+ * Graph::newNodes() and Graph::newEdges() report all created objects with a single call of
+ * nodesAdded() or edgesAdded(), which by default calls nodeAdded() or edgeAdded() for each of them.
  *
  * Note that there are no callbacks for the reassignment of edge endpoints. Thus, \c Graph::split
  * will be seen by a GraphObserver as the creation of an isolated node plus addition of a new edge to this node.
@@ -794,6 +796,26 @@ public:
 	//! Called by watched graph after an edge has been added.
 	virtual void edgeAdded(edge e) = 0;
 
+	//! Called by watched graph after the nodes from \p first to \p last (in the node list) have been added.
+	virtual void nodesAdded(node first, node last) {
+		for (node v = first;; v = v->succ()) {
+			nodeAdded(v);
+			if (v == last) {
+				break;
+			}
+		}
+	}
+
+	//! Called by watched graph after the edges from \p first to \p last (in the edge list) have been added.
+	virtual void edgesAdded(edge first, edge last) {
+		for (edge e = first;; e = e->succ()) {
+			edgeAdded(e);
+			if (e == last) {
+				break;
+			}
+		}
+	}
+
 	//! Called by watched graph when its clear function is called, just before things are removed.
 	virtual void cleared() = 0;
 
@@ -1180,6 +1202,81 @@ public:
 		return e;
 	}
 
+	//! Creates \p n new isolated nodes at once.
+	/**
+	 * Equivalent to calling newNode() \p n times, but registered NodeArrays are resized only
+	 * once and GraphObservers are notified by a single call of GraphObserver::nodesAdded()
+	 * after all nodes have been created.
+	 *
+	 * @param n is the number of nodes to create.
+	 * @param created is resized to \p n and receives the new nodes in order of creation.
+	 */
+	void newNodes(int n, Array<node>& created) {
+		OGDF_ASSERT(n >= 0);
+		created.init(n);
+		for (int i = 0; i < n; ++i) {
+			created[i] = pureNewNode(-1);
+		}
+		if (n == 0) {
+			return;
+		}
+
+		m_regNodeArrays.keysAdded(created.begin(), created.end());
+		for (GraphObserver* obs : getObservers()) {
+			obs->nodesAdded(created[0], created[n - 1]);
+		}
+
+#ifdef OGDF_HEAVY_DEBUG
+		consistencyCheck();
+#endif
+	}
+
+	//! Creates an edge for each pair of end points in [\p edgesBegin, \p edgesEnd) at once.
+	/**
+	 * Each element \a p of the range describes the edge (\a p.first, \a p.second), e.g., it is a
+	 * \c std::pair<node,node>. The new edges are appended to the adjacency lists of their end
+	 * points in the order of the range, just like repeated calls of newEdge(node, node) would.
+	 * However, registered EdgeArrays and AdjEntryArrays are resized only once and GraphObservers
+	 * are notified by a single call of GraphObserver::edgesAdded() after all edges have been created.
+	 *
+	 * @param edgesBegin is the iterator to the first pair of end points.
+	 * @param edgesEnd is the iterator one past the last pair of end points.
+	 * @return the number of created edges.
+	 */
+	template<typename EI>
+	int newEdges(const EI& edgesBegin, const EI& edgesEnd) {
+		edge last = edges.tail();
+		int count = 0;
+		for (auto it = edgesBegin; it != edgesEnd; ++it) {
+			node src = it->first;
+			node tgt = it->second;
+			edge e = pureNewEdge(src, tgt, -1);
+			src->adjEntries.pushBack(e->m_adjSrc);
+			tgt->adjEntries.pushBack(e->m_adjTgt);
+			++count;
+		}
+		if (count == 0) {
+			return 0;
+		}
+
+		edge first = last ? last->succ() : edges.head();
+		m_regEdgeArrays.keysAdded(internal::GraphIterator<edge>(first),
+				internal::GraphIterator<edge>(nullptr));
+		m_regAdjArrays.resizeArrays();
+		for (edge e = first; e; e = e->succ()) {
+			m_regAdjArrays.keyAdded(e->adjSource());
+			m_regAdjArrays.keyAdded(e->adjTarget());
+		}
+		for (GraphObserver* obs : getObservers()) {
+			obs->edgesAdded(first, edges.tail());
+		}
+
+#ifdef OGDF_HEAVY_DEBUG
+		consistencyCheck();
+#endif
+		return count;
+	}
+
 	//! @}
 	/**
 	 * @name Removing nodes and edges
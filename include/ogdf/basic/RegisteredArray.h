@@ -48,6 +48,7 @@
 
 #ifndef OGDF_MEMORY_POOL_NTS
 
+#	include <atomic>
 #	include <mutex>
 
 #endif
@@ -56,6 +57,15 @@ namespace ogdf {
 namespace internal {
 template<typename Registry>
 class RegisteredArrayBase;
+
+#ifndef OGDF_MEMORY_POOL_NTS
+//! Returns a number identifying the calling thread, starting with 0 for the first caller.
+inline int threadOrdinal() {
+	static std::atomic<int> s_nextOrdinal {0};
+	static thread_local int s_ordinal = s_nextOrdinal++;
+	return s_ordinal;
+}
+#endif
 }
 template<typename Key, typename Registry, typename Iterator = void>
 class RegistryBase; // IWYU pragma: keep
@@ -144,18 +154,82 @@ public:
 	using iterator_type = Iterator;
 	using registration_list_type =
 			std::list<registered_array_type*, OGDFAllocator<registered_array_type*>>;
-	using registration_iterator_type = typename registration_list_type::iterator;
+
+	//! Identifies the entry of a registered array, see registerArray().
+	struct registration_type {
+		typename registration_list_type::iterator it;
+		int shard = 0;
+	};
+
+	//! The number of shards the list of registered arrays is split into.
+	/**
+	 * Each thread registers its arrays with the shard given by its ordinal modulo this number,
+	 * so up to this many threads can create and destroy arrays associated with the same
+	 * registry without contending for a lock.
+	 */
+#ifndef OGDF_MEMORY_POOL_NTS
+	static constexpr int NUM_SHARDS = 32;
+#else
+	static constexpr int NUM_SHARDS = 1;
+#endif
 
 private:
 	using Obs = Observable<RegisteredObserver<Registry>, Registry>;
 
-	mutable registration_list_type m_registeredArrays;
+	//! Part of the list of registered arrays that is protected by its own lock.
+	struct RegistrationShard {
+		registration_list_type arrays;
+#ifndef OGDF_MEMORY_POOL_NTS
+		std::mutex mutex;
+#endif
+	};
+
+	//! Shards whose arrays are stored in different cache lines.
+	struct alignas(64) AlignedRegistrationShard : RegistrationShard { };
+
+	//! The shard of the first thread, which is usually the only one registering arrays.
+	mutable RegistrationShard m_firstShard;
+#ifndef OGDF_MEMORY_POOL_NTS
+	//! The remaining NUM_SHARDS - 1 shards, allocated when another thread registers an array.
+	mutable std::atomic<AlignedRegistrationShard*> m_otherShards {nullptr};
+#endif
 	bool m_autoShrink = false;
 	int m_size = 0;
 
+	//! Returns the shard with index \p index, allocating the other shards if necessary.
+	RegistrationShard& shard(int index) const {
 #ifndef OGDF_MEMORY_POOL_NTS
-	mutable std::mutex m_mutexRegArrays;
+		if (index > 0) {
+			AlignedRegistrationShard* others = m_otherShards.load(std::memory_order_acquire);
+			if (others == nullptr) {
+				AlignedRegistrationShard* allocated = new AlignedRegistrationShard[NUM_SHARDS - 1];
+				if (m_otherShards.compare_exchange_strong(others, allocated,
+							std::memory_order_acq_rel)) {
+					others = allocated;
+				} else {
+					delete[] allocated;
+				}
+			}
+			return others[index - 1];
+		}
+#endif
+		OGDF_ASSERT(index == 0);
+		return m_firstShard;
+	}
+
+	//! Calls \p func for the list of registered arrays of every shard in use.
+	template<typename Func>
+	void forEachShard(Func func) const {
+		func(m_firstShard.arrays);
+#ifndef OGDF_MEMORY_POOL_NTS
+		AlignedRegistrationShard* others = m_otherShards.load(std::memory_order_acquire);
+		if (others != nullptr) {
+			for (int i = 0; i < NUM_SHARDS - 1; ++i) {
+				func(others[i].arrays);
+			}
+		}
 #endif
+	}
 
 protected:
 	RegistryBase() = default;
@@ -165,38 +239,51 @@ public:
 	virtual ~RegistryBase() noexcept {
 		Obs::clearObservers();
 		unregisterArrays();
+#ifndef OGDF_MEMORY_POOL_NTS
+		delete[] m_otherShards.load();
+#endif
 	}
 
 	//! Registers a new array with this registry.
 	/**
+	 * The array is added to the shard of the calling thread. Concurrent calls from different
+	 * threads only contend for a lock if the threads share a shard.
+	 *
 	 * @param pArray A pointer to the registered array.
-	 * @return An iterator pointing to the entry for the registered array in the list of registered arrays.
-	 *         This iterator is required for unregistering the array again.
+	 * @return The entry for the registered array in the list of registered arrays.
+	 *         It is required for unregistering the array again.
 	 */
-	OGDF_NODISCARD registration_iterator_type registerArray(registered_array_type* pArray) const {
+	OGDF_NODISCARD registration_type registerArray(registered_array_type* pArray) const {
 #ifndef OGDF_MEMORY_POOL_NTS
-		std::lock_guard<std::mutex> guard(m_mutexRegArrays);
+		const int index = internal::threadOrdinal() % NUM_SHARDS;
+		RegistrationShard& s = shard(index);
+		std::lock_guard<std::mutex> guard(s.mutex);
+#else
+		const int index = 0;
+		RegistrationShard& s = m_firstShard;
 #endif
-		return m_registeredArrays.emplace(m_registeredArrays.end(), pArray);
+		return {s.arrays.emplace(s.arrays.end(), pArray), index};
 	}
 
 	//! Unregisters an array associated with this registry.
 	/**
-	 * @param it An iterator pointing to the entry of the array in the list of all registered arrays.
+	 * @param registration The entry of the array in the list of all registered arrays.
 	 */
-	void unregisterArray(registration_iterator_type it) const noexcept {
+	void unregisterArray(registration_type registration) const noexcept {
+		RegistrationShard& s = shard(registration.shard);
 #ifndef OGDF_MEMORY_POOL_NTS
-		std::lock_guard<std::mutex> guard(m_mutexRegArrays);
+		std::lock_guard<std::mutex> guard(s.mutex);
 #endif
-		m_registeredArrays.erase(it);
+		s.arrays.erase(registration.it);
 	}
 
-	//! Stores array \p pArray at position \p it in the list of registered arrays.
-	void moveRegisterArray(registration_iterator_type it, registered_array_type* pArray) const {
+	//! Stores array \p pArray at the entry \p registration in the list of registered arrays.
+	void moveRegisterArray(registration_type registration, registered_array_type* pArray) const {
+		RegistrationShard& s = shard(registration.shard);
 #ifndef OGDF_MEMORY_POOL_NTS
-		std::lock_guard<std::mutex> guard(m_mutexRegArrays);
+		std::lock_guard<std::mutex> guard(s.mutex);
 #endif
-		*it = pArray;
+		*registration.it = pArray;
 	}
 
 	//! Records the addition of a new key and resizes all registered arrays if necessary.
@@ -209,6 +296,27 @@ public:
 		}
 	}
 
+	//! Records the addition of the keys in [\p first, \p last) and resizes all registered arrays once.
+	/**
+	 * Equivalent to calling keyAdded() for every key in the range, but the registered arrays are
+	 * resized at most once, before any observer is notified.
+	 *
+	 * @param first is the iterator to the first added key.
+	 * @param last is the iterator one past the last added key.
+	 */
+	template<typename It>
+	void keysAdded(It first, It last) {
+		if (first == last) {
+			return;
+		}
+		resizeArrays();
+		for (auto& ob : getObservers()) {
+			for (It it = first; it != last; ++it) {
+				ob->keyAdded(*it);
+			}
+		}
+	}
+
 	//! Records the deletion of a key and resizes all registered arrays if auto shrink is enabled.
 	void keyRemoved(Key key) {
 		if (m_autoShrink) {
@@ -240,9 +348,7 @@ public:
 			return;
 		}
 		m_size = size = max(size, 0);
-		for (registered_array_type* ab : m_registeredArrays) {
-			ab->resize(size, shrink);
-		}
+		forEachRegisteredArray([&](registered_array_type* ab) { ab->resize(size, shrink); });
 	}
 
 	//! Resizes all arrays to make space of \p new_keys new keys.
@@ -252,9 +358,7 @@ public:
 
 	//! Swaps the entries at \p index1 and \p index2 in all registered arrays.
 	void swapArrayEntries(int index1, int index2) {
-		for (registered_array_type* ab : m_registeredArrays) {
-			ab->swapEntries(index1, index2);
-		}
+		forEachRegisteredArray([&](registered_array_type* ab) { ab->swapEntries(index1, index2); });
 		for (auto& ob : getObservers()) {
 			ob->keysSwapped(index1, index2);
 		}
@@ -262,9 +366,8 @@ public:
 
 	//! Copies the entry from \p fromIndex to \p toIndex in all registered arrays.
 	void copyArrayEntries(int toIndex, int fromIndex) {
-		for (registered_array_type* ab : m_registeredArrays) {
-			ab->copyEntry(toIndex, fromIndex);
-		}
+		forEachRegisteredArray(
+				[&](registered_array_type* ab) { ab->copyEntry(toIndex, fromIndex); });
 		for (auto& ob : getObservers()) {
 			ob->keysCopied(fromIndex, toIndex);
 		}
@@ -272,17 +375,39 @@ public:
 
 	//! Unregister all associated arrays.
 	void unregisterArrays() noexcept {
-		while (!m_registeredArrays.empty()) {
+		forEachShard([](registration_list_type& arrays) {
+			while (!arrays.empty()) {
 #ifdef OGDF_DEBUG
-			auto size = m_registeredArrays.size();
+				auto size = arrays.size();
 #endif
-			m_registeredArrays.front()->unregister();
-			OGDF_ASSERT(m_registeredArrays.size() < size);
-		}
+				arrays.front()->unregister();
+				OGDF_ASSERT(arrays.size() < size);
+			}
+		});
+	}
+
+	//! Calls \p func for every registered array.
+	/**
+	 * Must not be called concurrently with the registration of arrays.
+	 */
+	template<typename Func>
+	void forEachRegisteredArray(Func func) const {
+		forEachShard([&](const registration_list_type& arrays) {
+			for (registered_array_type* ab : arrays) {
+				func(ab);
+			}
+		});
 	}
 
-	//! Returns a reference to the list of all registered arrays.
-	const registration_list_type& getRegisteredArrays() const { return m_registeredArrays; }
+	//! Returns the number of registered arrays.
+	/**
+	 * Must not be called concurrently with the registration of arrays.
+	 */
+	size_t numberOfRegisteredArrays() const {
+		size_t num = 0;
+		forEachShard([&](const registration_list_type& arrays) { num += arrays.size(); });
+		return num;
+	}
 
 	//! Returns whether the registry allows arrays to shrink when keys are removed.
 	bool isAutoShrink() const { return m_autoShrink; }
@@ -307,9 +432,9 @@ namespace internal {
 template<class Registry>
 class RegisteredArrayBase {
 	using registry_type = Registry;
-	using registration_iterator_type = typename Registry::registration_iterator_type;
+	using registration_type = typename Registry::registration_type;
 
-	registration_iterator_type m_registration;
+	registration_type m_registration;
 	const Registry* m_pRegistry = nullptr;
 
 public:
@@ -368,7 +493,7 @@ protected:
 		if (m_pRegistry != nullptr) {
 			m_registration = m_pRegistry->registerArray(this);
 		} else {
-			m_registration = registration_iterator_type();
+			m_registration = registration_type();
 		}
 	}
 
@@ -380,7 +505,7 @@ protected:
 		m_pRegistry = move_from.m_pRegistry;
 		m_registration = move_from.m_registration;
 		move_from.m_pRegistry = nullptr;
-		move_from.m_registration = registration_iterator_type();
+		move_from.m_registration = registration_type();
 		if (m_pRegistry != nullptr) {
 			m_pRegistry->moveRegisterArray(m_registration, this);
 		}
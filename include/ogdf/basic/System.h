@@ -33,6 +33,7 @@
 #pragma once
 
 #include <ogdf/basic/basic.h>
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
 
 #include <cstdint>
 #include <cstdlib>
@@ -86,7 +87,9 @@ enum class CPUFeature {
 	VMX, //!< Virtual Machine Extensions
 	SMX, //!< Safer Mode Extensions
 	EST, //!< Enhanced Intel SpeedStep Technology
-	MONITOR //!< Processor supports MONITOR/MWAIT instructions
+	MONITOR, //!< Processor supports MONITOR/MWAIT instructions
+	AVX, //!< Advanced Vector Extensions (AVX), including support by the operating system
+	AVX2 //!< Advanced Vector Extensions 2 (AVX2), including support by the operating system
 };
 
 //! Bit mask for CPU features.
@@ -104,7 +107,9 @@ enum class CPUFeatureMask : unsigned int {
 	VMX = 1 << static_cast<int>(CPUFeature::VMX), //!< Virtual Machine Extensions
 	SMX = 1 << static_cast<int>(CPUFeature::SMX), //!< Safer Mode Extensions
 	EST = 1 << static_cast<int>(CPUFeature::EST), //!< Enhanced Intel SpeedStep Technology
-	MONITOR = 1 << static_cast<int>(CPUFeature::MONITOR) //!< Processor supports MONITOR/MWAIT instructions
+	MONITOR = 1 << static_cast<int>(CPUFeature::MONITOR), //!< Processor supports MONITOR/MWAIT instructions
+	AVX = 1 << static_cast<int>(CPUFeature::AVX), //!< Advanced Vector Extensions (AVX)
+	AVX2 = 1 << static_cast<int>(CPUFeature::AVX2) //!< Advanced Vector Extensions 2 (AVX2)
 };
 
 OGDF_EXPORT unsigned int operator|=(unsigned int& i, CPUFeatureMask fm);
@@ -191,6 +196,13 @@ public:
 	//! Returns the amount of memory (in bytes) contained in the thread's free list of OGDF's memory manager.
 	static size_t memoryInThreadFreeListOfMemoryManager();
 
+	//! Returns the counters of the per-thread arena memory manager.
+	/**
+	 * The counters only change if OGDF is configured with \c OGDF_MEMORY_MANAGER set to
+	 * \c ARENA_TS, or if the ArenaMemoryAllocator is used directly.
+	 */
+	static ArenaStatistics arenaStatisticsOfMemoryManager();
+
 	//! Returns the amount of memory (in bytes) allocated on the heap (e.g., with malloc).
 	/**
 	 * This refers to dynamically allocated memory, e.g., memory allocated with malloc()
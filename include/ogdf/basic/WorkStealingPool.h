@@ -0,0 +1,124 @@
+/** \file
+ * \brief Declaration of a persistent work-stealing thread pool for
+ *        independent randomized runs.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/basic.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace ogdf {
+
+//! A persistent thread pool executing independent runs with work stealing.
+/**
+ * @ingroup threads
+ *
+ * Modules that repeat a randomized heuristic and keep the best result (like SugiyamaLayout,
+ * SubgraphPlanarizer and PlanarSubgraphFast) hand their runs to the pool shared by the whole
+ * process, see instance(). The worker threads are started once and sleep while there is no
+ * work, so repeated calls do not create and join threads.
+ *
+ * A call of run() distributes the runs evenly among its slots. The calling thread always works
+ * on slot 0, idle pool threads join the call on the remaining slots. A thread whose slot is
+ * exhausted steals runs from the other slots, hence the call finishes when the last run is done
+ * instead of when the slowest thread has finished its fixed share. Since the calling thread
+ * participates, run() also makes progress if all pool threads are busy with other calls.
+ *
+ * Each call has a StopFlag. If a run reaches a lower bound on the objective (e.g. zero
+ * crossings), it calls StopFlag::stop() and no further runs are started; runs that poll
+ * StopFlag::stopped() can also return early.
+ */
+class OGDF_EXPORT WorkStealingPool {
+public:
+	//! The early termination flag shared by all runs of one call of run().
+	class StopFlag {
+		std::atomic<bool> m_stop {false};
+
+	public:
+		//! Tells all threads to start no further runs.
+		void stop() { m_stop.store(true, std::memory_order_relaxed); }
+
+		//! Returns whether stop() has been called.
+		bool stopped() const { return m_stop.load(std::memory_order_relaxed); }
+	};
+
+	//! A run: the index of the run and the slot of the executing thread.
+	/**
+	 * Runs with the same slot are executed one after another by the same thread, so
+	 * per-thread data can be indexed by the slot.
+	 */
+	using RunFunction = std::function<void(int run, unsigned int slot)>;
+
+	//! Returns the pool shared by all modules.
+	static WorkStealingPool& instance();
+
+	//! Creates a pool with \p numThreads worker threads, which are started on first use.
+	explicit WorkStealingPool(unsigned int numThreads);
+
+	//! Stops and joins the worker threads.
+	~WorkStealingPool();
+
+	//! Returns the number of worker threads (not counting the threads calling run()).
+	unsigned int numberOfThreads() const { return m_numThreads; }
+
+	//! Executes \p f for the runs 0, ..., \p nRuns - 1 on at most \p maxThreads threads.
+	/**
+	 * The calling thread works on slot 0, so \p f is called with slots in [0, \p maxThreads).
+	 * Returns after all started runs have finished. Runs that have not been started when
+	 * \p stop is set are skipped.
+	 *
+	 * Calls from within a run that is executed by a pool thread are executed by that thread alone.
+	 */
+	void run(int nRuns, unsigned int maxThreads, StopFlag& stop, const RunFunction& f);
+
+private:
+	class Job;
+
+	unsigned int m_numThreads;
+	std::function<void()> m_workerLoop; //!< Calls workerLoop(), Thread keeps a reference to it.
+	std::vector<Thread> m_threads;
+	bool m_started = false;
+	bool m_shutdown = false;
+
+	std::list<Job*> m_jobs; //!< The calls that still accept helping threads.
+	std::mutex m_mutex;
+	std::condition_variable m_jobAvailable;
+
+	void startThreads();
+	void workerLoop();
+};
+
+}
@@ -39,3 +39,7 @@
 #ifdef OGDF_SSE3_EXTENSIONS
 #	include OGDF_SSE3_EXTENSIONS // IWYU pragma: export
 #endif
+
+#ifdef OGDF_AVX2_EXTENSIONS
+#	include OGDF_AVX2_EXTENSIONS // IWYU pragma: export
+#endif
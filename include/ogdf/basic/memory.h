@@ -33,6 +33,7 @@
 #pragma once
 
 #include <ogdf/basic/basic.h>
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
 #include <ogdf/basic/memory/MallocMemoryAllocator.h>
 #include <ogdf/basic/memory/PoolMemoryAllocator.h>
 
@@ -72,6 +73,8 @@ public:                                                             \
 
 #ifdef OGDF_MEMORY_MALLOC_TS
 #	define OGDF_ALLOCATOR ogdf::MallocMemoryAllocator
+#elif defined(OGDF_MEMORY_ARENA_TS)
+#	define OGDF_ALLOCATOR ogdf::ArenaMemoryAllocator
 #else
 //! The used memory manager
 #	define OGDF_ALLOCATOR ogdf::PoolMemoryAllocator
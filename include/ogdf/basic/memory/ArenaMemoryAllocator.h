@@ -0,0 +1,187 @@
+/** \file
+ * \brief Declaration of memory manager for allocating small
+ *        pieces of memory from per-thread arenas
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/internal/config_autogen.h>
+#include <ogdf/basic/internal/copy_move.h>
+
+#include <cstddef>
+
+namespace ogdf {
+
+//! Counters maintained by the ArenaMemoryAllocator.
+struct ArenaStatistics {
+	size_t blocksAllocated = 0; //!< Number of blocks ever requested from the system.
+	size_t blocksReleased = 0; //!< Number of blocks returned to the system.
+	size_t scopesOpened = 0; //!< Number of ArenaScope objects constructed.
+	size_t scopesClosed = 0; //!< Number of ArenaScope objects destructed.
+};
+
+//! Allocates memory from per-thread arenas without any global lock on the fast path.
+/**
+ * Used as memory manager if OGDF is configured with \c OGDF_MEMORY_MANAGER set to \c ARENA_TS.
+ *
+ * Every thread carves small pieces of memory (at most #TABLE_SIZE bytes) out of its own
+ * blocks of #BLOCK_SIZE bytes by bumping a pointer, and keeps deallocated pieces in its own
+ * free lists, one per size. In contrast to the PoolMemoryAllocator, new blocks are requested
+ * from the system without entering a critical section. The global mutex is only used when a
+ * terminating thread hands its memory over (see flushPool()) and when another thread later
+ * reuses that memory.
+ *
+ * In addition, an ArenaScope opens a nested arena on the current thread. All memory
+ * allocated while the scope is the innermost one is carved from blocks owned by the scope
+ * and is returned to the system in one go when the scope is destructed.
+ */
+class ArenaMemoryAllocator {
+	friend class ArenaScope;
+
+	struct MemElem {
+		MemElem* m_next;
+	};
+
+	using MemElemPtr = MemElem*;
+
+	struct Arena;
+	struct Block;
+
+	static constexpr size_t MIN_BYTES = sizeof(MemElemPtr);
+	static constexpr size_t TABLE_SIZE = 256;
+	static constexpr size_t BLOCK_SIZE = 8192;
+
+public:
+	ArenaMemoryAllocator() { }
+
+	~ArenaMemoryAllocator() { }
+
+	//! Frees all memory of the calling thread and all memory handed over by terminated threads.
+	static OGDF_EXPORT void cleanup();
+
+	//! Returns true iff #allocate can be invoked with \c nBytes
+	static bool checkSize(size_t nBytes) { return nBytes < TABLE_SIZE; }
+
+	//! Allocates memory of size \c nBytes from the innermost arena of the calling thread.
+	static OGDF_EXPORT void* allocate(size_t nBytes);
+
+	//! Deallocates memory at address \c p which is of size \c nBytes.
+	/**
+	 * The memory is put into the free list of the arena it was allocated from, or into
+	 * the calling thread's free list if it does not belong to an ArenaScope.
+	 */
+	static OGDF_EXPORT void deallocate(size_t nBytes, void* p);
+
+	//! Deallocate a complete list starting at \c pHead and ending at \c pTail.
+	/**
+	 * The elements are assumed to be chained using the first word of each element and
+	 * elements are of size \c nBytes.
+	 */
+	static OGDF_EXPORT void deallocateList(size_t nBytes, void* pHead, void* pTail);
+
+	//! Hands the memory of the calling thread over to the global free lists.
+	/**
+	 * Must be called before a thread terminates, which ogdf::Thread does automatically.
+	 */
+	static OGDF_EXPORT void flushPool();
+
+	//! Returns the total amount of memory (in bytes) allocated from the system.
+	static OGDF_EXPORT size_t memoryAllocatedInBlocks();
+
+	//! Returns the total amount of memory (in bytes) available in the global free lists.
+	static OGDF_EXPORT size_t memoryInGlobalFreeList();
+
+	//! Returns the total amount of memory (in bytes) available to the calling thread's innermost arena.
+	static OGDF_EXPORT size_t memoryInThreadFreeList();
+
+	//! Returns a snapshot of the allocator's counters.
+	static OGDF_EXPORT ArenaStatistics statistics();
+
+private:
+	//! Returns the innermost arena of the calling thread.
+	static Arena& currentArena();
+
+	//! Serves a request that the free list of \p arena could not satisfy.
+	static void* fillArena(Arena& arena, size_t nBytes);
+
+	//! Opens a new scoped arena on top of the calling thread's arenas.
+	static OGDF_EXPORT Arena* openScope();
+
+	//! Closes the innermost scoped arena \p arena and frees all its blocks.
+	static OGDF_EXPORT void closeScope(Arena* arena);
+
+	//! Returns the number of blocks of \p arena.
+	static OGDF_EXPORT size_t numberOfBlocks(const Arena* arena);
+
+	//! Frees all blocks of the chain starting at \p block.
+	static void freeBlocks(Block* block);
+
+	//! Returns the free memory (in bytes) in the free lists and the current block of \p arena.
+	static size_t freeMemory(const Arena& arena);
+
+	//! The arena of the calling thread that is used outside of any ArenaScope.
+	static thread_local Arena s_threadArena;
+
+	//! The innermost open ArenaScope of the calling thread (or nullptr).
+	static thread_local Arena* s_scope;
+};
+
+//! Opens a nested arena of the ArenaMemoryAllocator on the current thread.
+/**
+ * While an ArenaScope is the innermost scope of a thread, all objects managed by
+ * OGDF's memory manager that the thread allocates are carved from blocks owned by the scope.
+ * Destructing the scope returns all these blocks to the system at once, without visiting the
+ * individual objects.
+ *
+ * \pre All objects allocated within the scope must be destructed (or abandoned, i.e., never
+ * touched again) before the scope is destructed, and only by the thread that owns the scope.
+ * Typical use is a per-request GraphCopy or PlanRep that lives on the stack of the scope.
+ *
+ * If OGDF is not configured with \c OGDF_MEMORY_MANAGER set to \c ARENA_TS, an ArenaScope has
+ * no effect.
+ */
+class OGDF_EXPORT ArenaScope {
+public:
+	//! Opens a new arena as the innermost one of the calling thread.
+	ArenaScope();
+
+	//! Frees all memory allocated within the scope and reactivates the enclosing arena.
+	~ArenaScope();
+
+	//! Returns the amount of memory (in bytes) the scope has allocated from the system.
+	size_t memoryAllocatedInBlocks() const;
+
+	OGDF_NO_COPY(ArenaScope)
+	OGDF_NO_MOVE(ArenaScope)
+
+private:
+	ArenaMemoryAllocator::Arena* m_arena;
+};
+
+}
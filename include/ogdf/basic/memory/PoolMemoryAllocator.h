@@ -44,6 +44,19 @@
 
 namespace ogdf {
 
+//! Counters of the PoolMemoryAllocator for a single size class.
+struct PoolSizeClassStatistics {
+	size_t blocks = 0; //!< Number of blocks sliced into elements of this size.
+	size_t live = 0; //!< Number of elements neither in the global nor the calling thread's free list.
+	size_t inGlobalFreeList = 0; //!< Number of elements in the global free list.
+	size_t inThreadFreeList = 0; //!< Number of elements in the calling thread's free list.
+	//! Number of allocations by the calling thread and all threads that flushed their pool.
+	/**
+	 * The allocation rate is obtained by comparing two snapshots taken some time apart.
+	 */
+	size_t allocations = 0;
+};
+
 //! Allocates memory in large chunks for better runtime
 /**
  * Possibly allocates more memory than required.
@@ -132,6 +145,35 @@ public:
 	//! Reports the number of pooled memory chunks in the thread's free lists for each possible size up to TABLE_SIZE.
 	static OGDF_EXPORT void getThreadFreeListSizes(std::vector<size_t>& sizes);
 
+	//! Reports the counters of each possible size up to TABLE_SIZE.
+	/**
+	 * Elements in the free lists of other threads are counted as live.
+	 */
+	static OGDF_EXPORT void getSizeClassStatistics(std::vector<PoolSizeClassStatistics>& stats);
+
+	//! Returns blocks whose elements are all free to the system.
+	/**
+	 * Only the global free lists and the calling thread's free lists are considered, i.e.,
+	 * a block of which some element is in the free list of another thread is kept.
+	 * Takes time linear in the number of blocks and free elements.
+	 *
+	 * @return the amount of memory (in bytes) returned to the system.
+	 */
+	static OGDF_EXPORT size_t trim();
+
+	//! Sets the policy for trimming automatically.
+	/**
+	 * Whenever a thread flushes its pool (see #flushPool()) and the global free lists afterwards
+	 * contain more than \p bytes, #trim() is called. A value of 0 (the default) disables
+	 * automatic trimming.
+	 *
+	 * Has no effect if OGDF is configured with \c OGDF_MEMORY_MANAGER set to \c POOL_NTS.
+	 */
+	static OGDF_EXPORT void setTrimThreshold(size_t bytes);
+
+	//! Returns the threshold set by #setTrimThreshold().
+	static OGDF_EXPORT size_t trimThreshold();
+
 private:
 	static inline void enterCS() {
 #ifndef OGDF_MEMORY_POOL_NTS
@@ -160,9 +202,22 @@ private:
 	static MemElemPtr allocateBlock();
 	static void makeSlices(MemElemPtr p, int nWords, int nSlices);
 
+	//! Removes all elements contained in a block marked in \p released from the list \p head.
+	static size_t removeReleased(MemElemPtr& head, const std::vector<BlockChain*>& blocks,
+			const std::vector<bool>& released);
+
 	//! Holds all allocated memory independently of whether it is cleared in chunks of size #BLOCK_SIZE.
 	static BlockChain* s_blocks;
 
+	//! Holds the number of blocks sliced for each size.
+	static size_t s_blocksPerSize[TABLE_SIZE];
+
+	//! Holds the number of allocations of threads that flushed their pool for each size.
+	static size_t s_allocations[TABLE_SIZE];
+
+	//! Holds the global free memory (in bytes) above which flushing the pool triggers #trim().
+	static size_t s_trimThreshold;
+
 #ifdef OGDF_DEBUG
 	//! Holds the number of globally allocated bytes for debugging.
 	static long long s_globallyAllocatedBytes;
@@ -172,6 +227,7 @@ private:
 
 #ifdef OGDF_MEMORY_POOL_NTS
 	static MemElemPtr s_tp[TABLE_SIZE];
+	static size_t s_threadAllocations[TABLE_SIZE];
 #else
 	//! Contains allocated but free memory that may be used by all threads.
 	//! Filled upon exiting a thread that allocated memory that was later freed.
@@ -180,6 +236,8 @@ private:
 	static std::mutex s_mutex;
 	//! Contains the allocated but free memory for a single thread.
 	static thread_local MemElemPtr s_tp[TABLE_SIZE];
+	//! Holds the number of allocations of a single thread for each size.
+	static thread_local size_t s_threadAllocations[TABLE_SIZE];
 #endif
 };
 
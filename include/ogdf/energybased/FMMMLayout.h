@@ -32,9 +32,9 @@
 #pragma once
 
 #include <ogdf/basic/Graph.h>
-#include <ogdf/basic/LayoutModule.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/geometry.h>
+#include <ogdf/energybased/ForceLayoutModule.h>
 #include <ogdf/energybased/fmmm/EdgeAttributes.h>
 #include <ogdf/energybased/fmmm/FMMMOptions.h>
 #include <ogdf/energybased/fmmm/FruchtermanReingold.h>
@@ -43,6 +43,7 @@
 #include <ogdf/energybased/fmmm/maar_packing/Rectangle.h>
 
 #include <algorithm>
+#include <functional>
 
 namespace ogdf {
 class ClusterGraphAttributes;
@@ -219,7 +220,8 @@ class List;
  *     <td>The grid quotient.
  *   </tr><tr>
  *     <td><i>nmTreeConstruction</i><td> FMMMOptions::ReducedTreeConstruction <td> \c SubtreeBySubtree
- *     <td>Defines how the reduced bucket quadtree is constructed.
+ *     <td>Defines how the reduced bucket quadtree is constructed. \c MortonOrder is the
+ *     fastest way for large graphs.
  *   </tr><tr>
  *     <td><i>nmSmallCell</i><td> FMMMOptions::SmallestCellFinding <td> \c Iteratively
  *     <td>Defines how the smallest quadratic cell that surrounds
@@ -231,6 +233,9 @@ class List;
  *   </tr><tr>
  *     <td><i>nmPrecision</i><td>int<td>4
  *     <td>The precision \a p for the <i>p</i>-term multipole expansions.
+ *   </tr><tr>
+ *     <td><i>nmThreads</i><td>int<td>1
+ *     <td>The number of threads used for the calculation of the repulsive forces.
  *   </tr>
  * </table>
  *
@@ -238,8 +243,14 @@ class List;
  * The running time of the algorithm is
  * O(<i>n</i> log <i>n</i> + <i>m</i>) for graphs with \a n nodes
  * and \a m edges. The required space is linear in the input size.
+ *
+ * <H3>Progress</H3>
+ * The progress is reported after each force calculation step on each level, see
+ * ForceLayoutModule::setProgressCallback(). If the algorithm stops early, the remaining
+ * levels are only placed by the multilevel step and the connected components are packed
+ * as usual.
  */
-class OGDF_EXPORT FMMMLayout : public LayoutModule {
+class OGDF_EXPORT FMMMLayout : public ForceLayoutModule {
 	using Rectangle = energybased::fmmm::Rectangle;
 	using NodeAttributes = energybased::fmmm::NodeAttributes;
 	using EdgeAttributes = energybased::fmmm::EdgeAttributes;
@@ -713,6 +724,18 @@ public:
 	//! Sets the precision for the multipole expansions to \p p.
 	void nmPrecision(int p) { m_NMPrecision = ((p >= 1) ? p : 1); }
 
+	//! Returns the number of threads used by the New Multipole Method.
+	/**
+	 * The construction of the reduced bucket quadtree, the passes over the multipole and
+	 * local expansions, and the calculation of the forces between neighboured leaves are
+	 * distributed over this many threads. For a fixed number of threads the resulting
+	 * layout does not depend on the scheduling of the threads.
+	 */
+	int nmThreads() const { return m_NMThreads; }
+
+	//! Sets the number of threads used by the New Multipole Method to \p n.
+	void nmThreads(int n) { m_NMThreads = ((n >= 1) ? n : 1); }
+
 	//! @}
 
 private:
@@ -781,6 +804,7 @@ private:
 	FMMMOptions::SmallestCellFinding m_NMSmallCell; //!< The option for how to calculate smallest quadtratic cells.
 	int m_NMParticlesInLeaves; //!< The maximal number of particles in a leaf.
 	int m_NMPrecision; //!< The precision for multipole expansions.
+	int m_NMThreads; //!< The number of threads used by the New Multipole Method.
 
 	//other variables
 	double max_integer_position; //!< The maximum value for an integer position.
@@ -791,6 +815,8 @@ private:
 	DPoint down_left_corner; //!< Holds down left corner of the comput. box.
 	NodeArray<double> radius; //!< Holds the radius of the surrounding circle for each node.
 	double time_total; //!< The runtime (=CPU-time) of the algorithm in seconds.
+	//! The attributes of the simple loop-free copy during a call, used to report progress.
+	const NodeArray<NodeAttributes>* m_reducedAttributes = nullptr;
 
 	energybased::fmmm::FruchtermanReingold FR; //!< Class for repulsive force calculation (Fruchterman, Reingold).
 	energybased::fmmm::NewMultipoleMethod NM; //!< Class for repulsive force calculation.
@@ -814,14 +840,17 @@ private:
 	 * If act_level is 0 and resizeDrawing is true the drawing is resized.
 	 * Furthermore, the maximum number of force calc. steps is calculated
 	 * depending on MaxIterChange, act_level, and max_level.
+	 * The progress is reported after each iteration, see ForceLayoutModule::reportProgress().
 	 */
 	void call_FORCE_CALCULATION_step(Graph& G, NodeArray<NodeAttributes>& A,
-			EdgeArray<EdgeAttributes>& E, int act_level, int max_level);
+			EdgeArray<EdgeAttributes>& E, int act_level, int max_level,
+			const std::function<void(GraphAttributes&)>& exportLayout);
 
-	//! Calls the postprocessing step.
+	//! Calls the postprocessing step, continuing the progress reports after \p iter iterations.
 	void call_POSTPROCESSING_step(Graph& G, NodeArray<NodeAttributes>& A,
 			EdgeArray<EdgeAttributes>& E, NodeArray<DPoint>& F, NodeArray<DPoint>& F_attr,
-			NodeArray<DPoint>& F_rep, NodeArray<DPoint>& last_node_movement);
+			NodeArray<DPoint>& F_rep, NodeArray<DPoint>& last_node_movement, int iter,
+			const std::function<void(GraphAttributes&)>& exportLayout);
 
 	//! @}
 	//! \name Functions for pre- and post-processing
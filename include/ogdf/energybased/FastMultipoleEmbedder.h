@@ -34,6 +34,7 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/LayoutModule.h>
 #include <ogdf/basic/basic.h>
+#include <ogdf/energybased/ForceLayoutModule.h>
 #include <ogdf/energybased/fast_multipole_embedder/ArrayGraph.h>
 #include <ogdf/energybased/fast_multipole_embedder/FMEFunc.h>
 #include <ogdf/energybased/fast_multipole_embedder/FMEKernel.h>
@@ -48,6 +49,12 @@ class GraphAttributes;
 //! The fast multipole embedder approach for force-directed layout.
 /**
  * @ingroup gd-energy
+ *
+ * If the GraphAttributes passed to call() have GraphAttributes::threeD enabled, a 3D layout
+ * is computed. The 3D layout approximates the repulsive forces with a Morton-ordered octree
+ * whose cells store monopole and quadrupole expansions (see
+ * fast_multipole_embedder::LinearOctree) and runs on the same thread pool as the 2D layout.
+ * The multipole precision only applies to 2D layouts.
  */
 class OGDF_EXPORT FastMultipoleEmbedder : public LayoutModule {
 	using ArrayGraph = fast_multipole_embedder::ArrayGraph;
@@ -68,6 +75,9 @@ public:
 			const EdgeArray<float>& edgeLength, const NodeArray<float>& nodeSize);
 
 	//! Calls the algorithm for graph \p GA with the given \p edgeLength and returns the layout information in \p GA.
+	/**
+	 * The layout is three-dimensional if \p GA has GraphAttributes::threeD.
+	 */
 	void call(GraphAttributes& GA, const EdgeArray<float>& edgeLength,
 			const NodeArray<float>& nodeSize);
 
@@ -107,8 +117,11 @@ private:
 
 	void runSingle();
 
-	//! runs the simulation with the given number of iterations
-	void run(uint32_t numIterations);
+	//! runs the 3D simulation, which uses an octree for any number of nodes
+	void runOctree();
+
+	//! runs the simulation with the given number of iterations, in 3D if \p threeD is set
+	void run(uint32_t numIterations, bool threeD = false);
 
 	//! allocates the memory
 	void allocate(uint32_t numNodes, uint32_t numEdges);
@@ -140,8 +153,12 @@ private:
 //! The fast multipole multilevel embedder approach for force-directed multilevel layout.
 /**
  * @ingroup gd-energy
+ *
+ * The progress is reported after each level of the multilevel hierarchy, see
+ * ForceLayoutModule::setProgressCallback(). If the algorithm stops early, the positions of
+ * the remaining levels are interpolated from the last level that has been laid out.
  */
-class OGDF_EXPORT FastMultipoleMultilevelEmbedder : public LayoutModule {
+class OGDF_EXPORT FastMultipoleMultilevelEmbedder : public ForceLayoutModule {
 	using GalaxyMultilevel = fast_multipole_embedder::GalaxyMultilevel;
 	using GalaxyMultilevelBuilder = fast_multipole_embedder::GalaxyMultilevelBuilder;
 
@@ -182,6 +199,9 @@ private:
 	//! writes the current level to graph attributes. used for output
 	void writeCurrentToGraphAttributes(GraphAttributes& GA);
 
+	//! reports the progress after the current level has been laid out
+	void reportCurrentLevel();
+
 	//! refine
 	void nextLevel();
 
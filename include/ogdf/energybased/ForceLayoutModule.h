@@ -34,21 +34,70 @@
 
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/LayoutModule.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/Timeouter.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/memory.h>
 #include <ogdf/energybased/multilevel_mixer/MultilevelGraph.h>
 
+#include <cstdint>
+#include <functional>
+
 namespace ogdf {
 
 /**
  * \brief Interface of general layout algorithms.
  *
+ * Implementations may support anytime layouts: they report their progress to the
+ * callback set by setProgressCallback() after each iteration (or each level of a multilevel
+ * hierarchy) and stop early if the callback returns false or the time limit (see Timeouter)
+ * is exceeded. An algorithm that stops early still assigns a position to every node, so the
+ * result is a rough layout that a later call can refine.
  */
-class OGDF_EXPORT ForceLayoutModule : public LayoutModule {
+class OGDF_EXPORT ForceLayoutModule : public LayoutModule, public Timeouter {
 	// holds index of the current level in multilevel hierarchy
 	int m_currentLevel;
 
 public:
+	//! The state of a running layout algorithm passed to the progress callback.
+	class Progress {
+	public:
+		Progress(int level, int iteration, double elapsedSeconds,
+				const std::function<void(GraphAttributes&)>& exportLayout)
+			: m_level(level)
+			, m_iteration(iteration)
+			, m_elapsedSeconds(elapsedSeconds)
+			, m_exportLayout(exportLayout) { }
+
+		//! Returns the level of the multilevel hierarchy that is laid out (0 is the input graph).
+		int level() const { return m_level; }
+
+		//! Returns the number of iterations performed on the current level.
+		int iteration() const { return m_iteration; }
+
+		//! Returns the wall-clock time since the start of the call in seconds.
+		double elapsedSeconds() const { return m_elapsedSeconds; }
+
+		//! Writes the intermediate positions to \p GA, which belongs to the input graph.
+		/**
+		 * This takes time linear in the number of nodes (times the number of levels for
+		 * multilevel algorithms), so callers only pay for the snapshots they request.
+		 * On a coarser level, each node gets the position of its representative. If the
+		 * algorithm lays out the connected components one after the other, only the nodes
+		 * of the current component are written.
+		 */
+		void exportLayout(GraphAttributes& GA) const { m_exportLayout(GA); }
+
+	private:
+		int m_level;
+		int m_iteration;
+		double m_elapsedSeconds;
+		const std::function<void(GraphAttributes&)>& m_exportLayout;
+	};
+
+	//! The type of the progress callback; the algorithm stops if it returns false.
+	using ProgressCallback = std::function<bool(const Progress&)>;
+
 	//! Initializes a force layout module.
 	ForceLayoutModule() { }
 
@@ -86,7 +135,59 @@ public:
 		MLG.importAttributesSimple(GA);
 	};
 
+	//! Sets the callback that is called after each iteration or level.
+	/**
+	 * The callback runs in the thread that called the algorithm, which waits until the
+	 * callback returns. Hence, the caller can pause the algorithm by blocking in the callback
+	 * and resume it by returning true. Returning false stops the algorithm.
+	 */
+	void setProgressCallback(const ProgressCallback& callback) { m_progressCallback = callback; }
+
+	//! Returns the progress callback.
+	const ProgressCallback& progressCallback() const { return m_progressCallback; }
+
+	//! Returns whether the last call stopped before its last iteration.
+	bool stoppedEarly() const { return m_stoppedEarly; }
+
 	OGDF_MALLOC_NEW_DELETE
+
+protected:
+	//! Starts the clock for the time limit; to be called at the beginning of a call.
+	void startProgress() {
+		m_startTime = System::realTime();
+		m_stoppedEarly = false;
+	}
+
+	//! Reports the progress after \p iteration iterations on \p level.
+	/**
+	 * \p exportLayout writes the current positions to the graph attributes of the input
+	 * graph and is only invoked if the callback asks for them.
+	 * @return false if the algorithm should stop, which is remembered for further calls.
+	 */
+	bool reportProgress(int level, int iteration,
+			const std::function<void(GraphAttributes&)>& exportLayout) const {
+		if (m_stoppedEarly) {
+			return false;
+		}
+		if (m_progressCallback || isTimeLimit()) {
+			double elapsed = (System::realTime() - m_startTime) / 1000.0;
+			if (m_progressCallback) {
+				m_stoppedEarly = !m_progressCallback(Progress(level, iteration, elapsed, exportLayout));
+			}
+			if (isTimeLimit() && elapsed >= m_timeLimit) {
+				m_stoppedEarly = true;
+			}
+		}
+		return !m_stoppedEarly;
+	}
+
+	//! Returns whether the algorithm has to stop, see reportProgress().
+	bool stopRequested() const { return m_stoppedEarly; }
+
+private:
+	ProgressCallback m_progressCallback;
+	int64_t m_startTime = 0;
+	mutable bool m_stoppedEarly = false;
 };
 
 }
@@ -37,10 +37,12 @@
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/LayoutModule.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 namespace ogdf {
 class GraphAttributes;
@@ -56,12 +58,29 @@ inline bool isinf(T value) {
  */
 class OGDF_EXPORT PivotMDS : public LayoutModule {
 public:
+	//! The strategies for selecting the pivots.
+	enum class PivotSelection {
+		//! Each pivot is the node farthest away from the pivots selected before.
+		//! The shortest-path searches depend on each other and run one after the other.
+		MaxMin,
+		//! The pivots are drawn uniformly at random (with a fixed seed).
+		//! The shortest-path searches are independent and run in parallel.
+		Random
+	};
+
 	PivotMDS()
 		: m_numberOfPivots(250)
 		, m_dimensionCount(2)
 		, m_edgeCosts(100)
 		, m_hasEdgeCostsAttribute(false)
-		, m_forcing2DLayout(false) { }
+		, m_forcing2DLayout(false)
+		, m_pivotSelection(PivotSelection::MaxMin) {
+#ifdef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = 1;
+#else
+		m_maxThreads = max(1u, Thread::hardware_concurrency());
+#endif
+	}
 
 	virtual ~PivotMDS() { }
 
@@ -98,6 +117,29 @@ public:
 
 	bool useEdgeCostsAttribute() const { return m_hasEdgeCostsAttribute; }
 
+	//! Sets the strategy for selecting the pivots.
+	void setPivotSelection(PivotSelection pivotSelection) { m_pivotSelection = pivotSelection; }
+
+	//! Returns the strategy for selecting the pivots.
+	PivotSelection pivotSelection() const { return m_pivotSelection; }
+
+	//! Returns the maximal number of threads used by the algorithm.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used by the algorithm to \p n.
+	/**
+	 * The threads center the pivot matrix, compute its self product and project the nodes
+	 * onto the eigenvectors. If the pivots are selected by PivotSelection::Random, the
+	 * shortest-path searches are distributed over the threads as well.
+	 * The work is split independently of the scheduling, so the layout only depends on the
+	 * number of threads by rounding errors.
+	 */
+	void maxThreads(unsigned int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = max(1u, n);
+#endif
+	}
+
 private:
 	//! Convergence factor used for power iteration.
 	const static double EPSILON;
@@ -127,23 +169,36 @@ private:
 	//! GraphAttributes::threeD is set.
 	bool m_forcing2DLayout;
 
-	//! Centers the pivot matrix.
-	void centerPivotmatrix(Array<Array<double>>& pivotMatrix);
+	//! The strategy for selecting the pivots.
+	PivotSelection m_pivotSelection;
+
+	//! The maximal number of threads.
+	unsigned int m_maxThreads;
+
+	//! Centers the pivot matrix with \p numberOfPivots rows stored in row-major order.
+	void centerPivotmatrix(std::vector<double>& pivotMatrix, int numberOfPivots);
 
 	//! Computes the pivot mds layout of the given connected graph of \p GA.
 	void pivotMDSLayout(GraphAttributes& GA);
 
-	void copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom);
-
 	//! Computes the layout of a path.
 	void doPathLayout(GraphAttributes& GA, const node& v);
 
-	//! Computes the eigen value decomposition based on power iteration.
-	void eigenValueDecomposition(Array<Array<double>>& K, Array<Array<double>>& eVecs,
+	//! Computes the eigen value decomposition of the symmetric \a p x \a p matrix \p K
+	//! by block power iteration.
+	/**
+	 * The eigenvectors are stored in \p eVecs, whose rows have length \a p. All of them are
+	 * multiplied by \p K in a single pass over the matrix.
+	 */
+	void eigenValueDecomposition(const std::vector<double>& K, Array<Array<double>>& eVecs,
 			Array<double>& eValues);
 
-	//! Computes the pivot distance matrix based on the maxmin strategy
-	void getPivotDistanceMatrix(const GraphAttributes& GA, Array<Array<double>>& pivDistMatrix);
+	//! Computes the pivot distance matrix with one row per pivot in row-major order.
+	/**
+	 * The columns correspond to the nodes in the order of Graph::nodes.
+	 * @return the number of pivots.
+	 */
+	int getPivotDistanceMatrix(const GraphAttributes& GA, std::vector<double>& pivDistMatrix);
 
 	//! Checks whether the given graph is a path or not.
 	node getRootedPath(const Graph& G);
@@ -157,12 +212,16 @@ private:
 	//! Fills the given \p matrix with random doubles d 0 <= d <= 1.
 	void randomize(Array<Array<double>>& matrix);
 
-	//! Computes the self product of \p d.
-	void selfProduct(const Array<Array<double>>& d, Array<Array<double>>& result);
+	//! Computes the self product of the matrix \p d with \p rows rows.
+	/**
+	 * Both matrices are stored in row-major order. The columns of \p d are processed in
+	 * blocks that fit into the cache, and the blocks are distributed over the threads.
+	 */
+	void selfProduct(const std::vector<double>& d, int rows, std::vector<double>& result);
 
-	//! Computes the singular value decomposition of matrix \p K.
-	void singularValueDecomposition(Array<Array<double>>& K, Array<Array<double>>& eVecs,
-			Array<double>& eVals);
+	//! Computes the singular value decomposition of the pivot matrix \p C.
+	void singularValueDecomposition(const std::vector<double>& C, int numberOfPivots,
+			Array<Array<double>>& eVecs, Array<double>& eVals);
 };
 
 }
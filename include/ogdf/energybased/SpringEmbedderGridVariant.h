@@ -77,8 +77,17 @@ class GraphCopy;
  *   </tr><tr>
  *     <td><i>userBoundingBox</i><td>rectangle<td>(0.0,100.0,0.0,100.0)
  *     <td>The user bounding box for scaling (used if scaling = scUserBoundingBox).
+ *   </tr><tr>
+ *     <td><i>repulsion</i><td> #Repulsion <td> Repulsion::grid
+ *     <td>The method for computing the repulsive forces: a uniform grid or a Barnes-Hut quadtree.
+ *   </tr><tr>
+ *     <td><i>barnesHutTheta</i><td>double<td>0.6
+ *     <td>The opening angle of the quadtree (used if repulsion = barnesHut).
  *   </tr>
  * </table>
+ *
+ * The progress is reported after each iteration of both phases, see
+ * ForceLayoutModule::setProgressCallback().
  */
 class OGDF_EXPORT SpringEmbedderGridVariant : public spring_embedder::SpringEmbedderBase {
 public:
@@ -33,10 +33,10 @@
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/LayoutModule.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/tuples.h>
-
-#include <limits>
+#include <ogdf/graphalg/DistanceMatrix.h>
 
 namespace ogdf {
 class GraphAttributes;
@@ -58,8 +58,9 @@ class GraphAttributes;
  * First of all note that the algorithm uses all pairs shortest path
  * to compute the graph theoretic distance. This can be done either
  * with BFS (ignoring node sizes) in quadratic time or by using
- * e.g. Floyd's algorithm in cubic time with given edge lengths
- * that may reflect the node sizes.  Also m_computeMaxIt decides
+ * %Dijkstra's algorithm with given edge lengths that may reflect
+ * the node sizes. The single-source searches are distributed over
+ * maxThreads() threads.  Also m_computeMaxIt decides
  * if the computation is stopped after a fixed maximum number of
  * iterations. The desirable edge length can either be set or computed
  * from the graph and the given layout.
@@ -90,9 +91,15 @@ public:
 		, m_desLength(0.0)
 		, m_distFactor(2.0)
 		, m_useLayout(true)
+		, m_useVectorization(true)
 		, m_gItBaseVal(50)
 		, m_gItFactor(16) {
 		m_maxLocalIt = m_maxGlobalIt = maxVal;
+#ifdef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = 1;
+#else
+		m_maxThreads = max(1u, Thread::hardware_concurrency());
+#endif
 	}
 
 	//! Calls the layout algorithm for graph attributes \p GA.
@@ -114,6 +121,16 @@ public:
 
 	bool useLayout() { return m_useLayout; }
 
+	//! If set to true, the sums over the springs of a node use SSE3 or AVX2 instructions.
+	/**
+	 * The instruction set is chosen at runtime among those enabled at build time, see
+	 * OGDF_SSE3_EXTENSIONS and OGDF_AVX2_EXTENSIONS. The sums are added in a different
+	 * order, so the layout may differ slightly from the one computed without vectorization.
+	 */
+	void setUseVectorization(bool b) { m_useVectorization = b; }
+
+	bool useVectorization() const { return m_useVectorization; }
+
 	//! If set != 0, value zerolength is used to determine the
 	//! desirable edge length by L = zerolength / max distance_ij.
 	//! Otherwise, zerolength is determined using the node number and sizes.
@@ -153,6 +170,16 @@ public:
 
 	//! If set to true, number of iterations is computed depending on G
 	void computeMaxIterations(bool b) { m_computeMaxIt = b; }
+
+	//! Returns the maximal number of threads used to compute the shortest-path distances.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used to compute the shortest-path distances to \p n.
+	void maxThreads(unsigned int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = max(1u, n);
+#endif
+	}
 #if 0
 	//We could add some noise to the computation
 
@@ -225,21 +252,21 @@ protected:
 
 	//! Computes contribution of node u to the first partial
 	//! derivatives (dE/dx_m, dE/dy_m) (for node m) (eq. 7 and 8 in paper)
-	dpair computeParDer(node m, node u, GraphAttributes& GA, NodeArray<NodeArray<double>>& ss,
-			NodeArray<NodeArray<double>>& dist);
+	dpair computeParDer(node m, node u, GraphAttributes& GA, DistanceMatrix<double>& ss,
+			DistanceMatrix<double>& dist);
 
 	//! Compute partial derivative for v
-	dpair computeParDers(node v, GraphAttributes& GA, NodeArray<NodeArray<double>>& ss,
-			NodeArray<NodeArray<double>>& dist);
+	dpair computeParDers(node v, GraphAttributes& GA, DistanceMatrix<double>& ss,
+			DistanceMatrix<double>& dist);
 
 	//! Does the necessary initialization work for the call functions
 	void initialize(GraphAttributes& GA, NodeArray<dpair>& partialDer,
-			const EdgeArray<double>& eLength, NodeArray<NodeArray<double>>& oLength,
-			NodeArray<NodeArray<double>>& sstrength, bool simpleBFS);
+			const EdgeArray<double>& eLength, DistanceMatrix<double>& oLength,
+			DistanceMatrix<double>& sstrength, bool simpleBFS);
 
 	//! Main computation loop, nodes are moved here
 	void mainStep(GraphAttributes& GA, NodeArray<dpair>& partialDer,
-			NodeArray<NodeArray<double>>& oLength, NodeArray<NodeArray<double>>& sstrength);
+			DistanceMatrix<double>& oLength, DistanceMatrix<double>& sstrength);
 
 	//! Does the scaling if no edge lengths are given but node sizes
 	//! are respected
@@ -260,6 +287,7 @@ private:
 	double m_desLength; //!< Desirable edge length, used instead if > 0
 	double m_distFactor; //< introduces some distance for scaling in case BFS is used
 	bool m_useLayout; //!< use positions or allow to shuffle nodes to avoid degeneration
+	bool m_useVectorization; //!< use SIMD instructions for the sums over the springs
 	int m_gItBaseVal; //!< minimum number of global iterations
 	int m_gItFactor; //!< factor for global iterations: m_gItBaseVal+m_gItFactor*|V|
 
@@ -268,10 +296,14 @@ private:
 	static const double desMinLength; //!< Defines minimum desired edge length. Smaller values are treated as zero
 	static const int maxVal; //!< defines infinite upper bound for iteration number
 
-	double allpairsspBFS(const Graph& G, NodeArray<NodeArray<double>>& distance);
+	unsigned int m_maxThreads; //!< The maximal number of threads used for the shortest paths
+
+	double allpairsspBFS(const Graph& G, DistanceMatrix<double>& distance);
 	double allpairssp(const Graph& G, const EdgeArray<double>& eLengths,
-			NodeArray<NodeArray<double>>& distance,
-			const double threshold = std::numeric_limits<double>::max());
+			DistanceMatrix<double>& distance);
+
+	//! Returns the maximum distance of the connected pairs in \p distance.
+	double maxDistance(const Graph& G, const DistanceMatrix<double>& distance);
 };
 
 #if 0
@@ -37,7 +37,11 @@
 
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/LayoutModule.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
+
+#include <functional>
 
 namespace ogdf {
 class GraphAttributes;
@@ -45,6 +49,10 @@ class GraphAttributes;
 //! Energy-based layout using stress minimization.
 /**
  * @ingroup gd-energy
+ *
+ * By default, the full stress model is minimized, which needs the shortest-path distances
+ * between all pairs of nodes and thus quadratic time and memory. The sparse stress model
+ * (see useSparseStress()) only needs linear memory per pivot.
  */
 class OGDF_EXPORT StressMinimization : public LayoutModule {
 public:
@@ -63,7 +71,15 @@ public:
 		, m_fixYCoords(false)
 		, m_fixZCoords(false)
 		, m_forcing2DLayout(false)
-		, m_use3D(false) { }
+		, m_use3D(false)
+		, m_sparseStress(false)
+		, m_numberOfPivots(DEFAULT_NUMBER_OF_PIVOTS) {
+#ifdef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = 1;
+#else
+		m_maxThreads = max(1u, Thread::hardware_concurrency());
+#endif
+	}
 
 	//! Destructor.
 	~StressMinimization() { }
@@ -111,7 +127,38 @@ public:
 	 */
 	inline void setForcing2DLayout(bool forcing2DLayout);
 
+	//! Sets whether the sparse stress model is minimized instead of the full one.
+	/**
+	 * The sparse stress model (Ortmann, Klimenta, Brandes: A Sparse Stress Model, 2016)
+	 * keeps the terms of adjacent nodes and replaces the terms of all other pairs by
+	 * terms towards a set of pivots, which are weighted by the number of nodes they
+	 * represent. It needs O(<i>kn</i>) time per iteration and O(<i>kn</i>) memory for
+	 * \a k pivots (see setNumberOfPivots()) instead of O(<i>n</i><sup>2</sup>).
+	 */
+	inline void useSparseStress(bool sparse);
+
+	//! Sets the number of pivots of the sparse stress model. If the new value is smaller
+	//! or equal 0 the default value (50) is used.
+	inline void setNumberOfPivots(int numberOfPivots);
+
+	//! Returns the maximal number of threads used to compute the shortest-path distances.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used to compute the shortest-path distances to \p n.
+	/**
+	 * The single-source searches of the full stress model are distributed over the
+	 * threads. The threads are also used for the initial layout, see PivotMDS::maxThreads().
+	 */
+	void maxThreads(unsigned int n) {
+#ifndef OGDF_MEMORY_POOL_NTS
+		m_maxThreads = max(1u, n);
+#endif
+	}
+
 private:
+	struct SparseStressModel;
+	struct PositionVote;
+
 	//! Convergence constant.
 	const static double EPSILON;
 
@@ -157,17 +204,35 @@ private:
 	//! Indicates whether a 3D-layout is computed.
 	bool m_use3D;
 
+	//! Indicates whether the sparse stress model is used.
+	bool m_sparseStress;
+
+	//! The number of pivots of the sparse stress model.
+	int m_numberOfPivots;
+
+	//! The maximal number of threads used to compute the shortest-path distances.
+	unsigned int m_maxThreads;
+
 	//! Calculates the stress for the given layout
-	double calcStress(const GraphAttributes& GA, NodeArray<NodeArray<double>>& shortestPathMatrix,
-			NodeArray<NodeArray<double>>& weightMatrix);
+	double calcStress(const GraphAttributes& GA, DistanceMatrix<double>& shortestPathMatrix,
+			DistanceMatrix<double>& weightMatrix);
 
 	//! Runs the stress for a given Graph, shortest path and weight matrix.
-	void call(GraphAttributes& GA, NodeArray<NodeArray<double>>& shortestPathMatrix,
-			NodeArray<NodeArray<double>>& weightMatrix);
+	void call(GraphAttributes& GA, DistanceMatrix<double>& shortestPathMatrix,
+			DistanceMatrix<double>& weightMatrix);
 
 	//! Calculates the weight matrix of the shortest path matrix. This is done by w_ij = s_ij^{-2}
-	void calcWeights(const Graph& G, NodeArray<NodeArray<double>>& shortestPathMatrix,
-			NodeArray<NodeArray<double>>& weightMatrix);
+	void calcWeights(const Graph& G, DistanceMatrix<double>& shortestPathMatrix,
+			DistanceMatrix<double>& weightMatrix);
+
+	//! Runs the stress minimization of the sparse stress model.
+	void callSparse(GraphAttributes& GA);
+
+	//! Selects the pivots and calculates the pivot terms of the sparse stress model.
+	void initSparseModel(const GraphAttributes& GA, SparseStressModel& model);
+
+	//! Calculates the stress of the sparse stress model for the given layout.
+	double calcStress(const GraphAttributes& GA, const SparseStressModel& model);
 
 	//! Calculates the intial layout of the graph if necessary.
 	void computeInitialLayout(GraphAttributes& GA);
@@ -185,22 +250,34 @@ private:
 			NodeArray<double>& prevXCoords, NodeArray<double>& prevYCoords, const double prevStress,
 			const double curStress);
 
-	//! Convenience method to initialize the matrices.
-	void initMatrices(const Graph& G, NodeArray<NodeArray<double>>& shortestPathMatrix,
-			NodeArray<NodeArray<double>>& weightMatrix);
-
 	//! Minimizes the stress for each component separately given
 	//! the shortest path matrix and the weight matrix.
-	void minimizeStress(GraphAttributes& GA, NodeArray<NodeArray<double>>& shortestPathMatrix,
-			NodeArray<NodeArray<double>>& weightMatrix);
+	void minimizeStress(GraphAttributes& GA, DistanceMatrix<double>& shortestPathMatrix,
+			DistanceMatrix<double>& weightMatrix);
+
+	//! Runs \p iterate until the termination criterion is met, using \p stress to
+	//! calculate the stress of the current layout.
+	void minimizeStress(GraphAttributes& GA, const std::function<void()>& iterate,
+			const std::function<double()>& stress);
 
 	//! Runs the next iteration of the stress minimization process. Note that serial update
 	//! is used.
-	void nextIteration(GraphAttributes& GA, NodeArray<NodeArray<double>>& shortestPathMatrix,
-			NodeArray<NodeArray<double>>& weightMatrix);
+	void nextIteration(GraphAttributes& GA, DistanceMatrix<double>& shortestPathMatrix,
+			DistanceMatrix<double>& weightMatrix);
 
-	//! Replaces infinite distances to the given value
-	void replaceInfinityDistances(NodeArray<NodeArray<double>>& shortestPathMatrix, double newVal);
+	//! Runs the next iteration of the minimization of the sparse stress model.
+	void nextIteration(GraphAttributes& GA, const SparseStressModel& model);
+
+	//! Adds the vote of the term of \p v and \p w with the desired distance \p desDistance
+	//! and the weight \p weight to \p vote.
+	inline void addVote(const GraphAttributes& GA, node v, node w, double desDistance,
+			double weight, PositionVote& vote) const;
+
+	//! Moves \p v to the position voted for by \p vote.
+	inline void applyVote(GraphAttributes& GA, node v, const PositionVote& vote) const;
+
+	//! Replaces the distances of unreachable pairs by the given value
+	void replaceInfinityDistances(DistanceMatrix<double>& shortestPathMatrix, double newVal);
 };
 
 void StressMinimization::fixXCoordinates(bool fix) { m_fixXCoords = fix; }
@@ -235,4 +312,10 @@ void StressMinimization::setForcing2DLayout(bool forcing2DLayout) {
 	m_forcing2DLayout = forcing2DLayout;
 }
 
+void StressMinimization::useSparseStress(bool sparse) { m_sparseStress = sparse; }
+
+void StressMinimization::setNumberOfPivots(int numberOfPivots) {
+	m_numberOfPivots = (numberOfPivots > 0) ? numberOfPivots : DEFAULT_NUMBER_OF_PIVOTS;
+}
+
 }
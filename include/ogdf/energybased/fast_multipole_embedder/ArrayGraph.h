@@ -67,6 +67,7 @@ public:
 	//! Updates an ArrayGraph from GraphAttributes with the given edge lengths and node sizes and creates the edges.
 	/**
 	 * The nodes and edges are ordered in the same way like in the Graph instance.
+	 * The \a z coordinates are read if \p GA has GraphAttributes::threeD, otherwise they are 0.
 	 * @param GA the GraphAttributes to read from
 	 * @param edgeLength the desired edge length
 	 * @param nodeSize the size of the nodes
@@ -99,6 +100,7 @@ public:
 		for (node v : G.nodes) {
 			m_nodeXPos[m_numNodes] = (float)xPos[v];
 			m_nodeYPos[m_numNodes] = (float)yPos[v];
+			m_nodeZPos[m_numNodes] = 0.0f;
 			m_nodeSize[m_numNodes] = (float)nodeSize[v];
 			m_avgNodeSize += nodeSize[v];
 			nodeIndex[v] = m_numNodes;
@@ -115,7 +117,7 @@ public:
 	//! Store the data back in GraphAttributes
 	/**
 	 * The function does not require to be the same Graph, only the order of nodes and edges
-	 * is important
+	 * is important. The \a z coordinates are only written if \p GA has GraphAttributes::threeD.
 	 * @param GA the GraphAttributes to update
 	 */
 	void writeTo(GraphAttributes& GA);
@@ -176,6 +178,12 @@ public:
 	//! Returns the \a y coord array for all nodes.
 	inline const float* nodeYPos() const { return m_nodeYPos; }
 
+	//! Returns the \a z coord array for all nodes, only used by 3D layouts.
+	inline float* nodeZPos() { return m_nodeZPos; }
+
+	//! Returns the \a z coord array for all nodes, only used by 3D layouts.
+	inline const float* nodeZPos() const { return m_nodeZPos; }
+
 	//! Returns the node size array for all nodes.
 	inline float* nodeSize() { return m_nodeSize; }
 
@@ -222,7 +230,7 @@ public:
 	//! Transforms all positions via shifting them by \p translate and afterwards scaling by \p scale.
 	void transform(float translate, float scale);
 
-	//! Transforming all positions such that the new center is at \a (0,0).
+	//! Transforming all positions such that the new center is at \a (0,0,0).
 	void centerGraph();
 
 private:
@@ -250,6 +258,7 @@ private:
 
 	float* m_nodeXPos; //!< The \a x coordinates.
 	float* m_nodeYPos; //!< The \a y coordinates.
+	float* m_nodeZPos; //!< The \a z coordinates.
 
 	float* m_nodeSize; //!< Sizes of the nodes.
 	double m_avgNodeSize; //!< Avg. node size.
@@ -0,0 +1,118 @@
+/** \file
+ * \brief Declaration of the 3D kernel of the fast multipole embedder.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/energybased/fast_multipole_embedder/FMEFunc.h>
+#include <ogdf/energybased/fast_multipole_embedder/FMEKernel.h>
+#include <ogdf/energybased/fast_multipole_embedder/FMEMultipoleKernel.h>
+#include <ogdf/energybased/fast_multipole_embedder/LinearOctree.h>
+
+#include <cstdint>
+
+namespace ogdf {
+namespace fast_multipole_embedder {
+class ArrayGraph;
+class FMEThread;
+
+struct FMEOctreeLocalContext;
+
+//! Global context of the 3D kernel.
+struct FMEOctreeGlobalContext {
+	FMEOctreeLocalContext** pLocalContext; //!< all local contexts
+	uint32_t numThreads; //!< number of threads, local contexts
+	ArrayGraph* pGraph; //!< pointer to the array graph
+	LinearOctree* pOctree; //!< pointer to the octree
+	FMEGlobalOptions* pOptions; //!< pointer to the global options
+	float* globalForceX; //!< the global node force x array
+	float* globalForceY; //!< the global node force y array
+	float* globalForceZ; //!< the global node force z array
+	float repForceScale; //!< the repulsive forces are scaled to be comparable to the 2D ones
+	float minDistSq; //!< squared distance below which the repulsive forces do not grow
+	bool earlyExit; //!< var for the main thread to notify the other threads that they are done
+	float coolDown;
+	float min[3]; //!< global bounding box min coordinates
+	float max[3]; //!< global bounding box max coordinates
+};
+
+//! Local thread context of the 3D kernel.
+struct FMEOctreeLocalContext {
+	FMEOctreeGlobalContext* pGlobalContext; //!< pointer to the global context
+	float* forceX; //!< local edge force array for all nodes
+	float* forceY; //!< local edge force array for all nodes
+	float* forceZ; //!< local edge force array for all nodes
+	double maxForceSq; //!< local maximum force
+	float min[3]; //!< local bounding box min coordinates
+	float max[3]; //!< local bounding box max coordinates
+	LinearOctree::Workspace workspace; //!< scratch space for the repulsive forces
+};
+
+//! The 3D kernel of the fast multipole embedder.
+/**
+ * Runs the same iterations as FMEMultipoleKernel on the thread pool, but the repulsive forces
+ * are approximated with a LinearOctree. The repulsive force between two nodes at distance
+ * <i>d</i> in 3D is 1/<i>d</i><sup>2</sup> instead of 1/<i>d</i>, it is scaled by the average
+ * desired edge length so that both agree at that distance.
+ */
+class FMEOctreeKernel : public FMEKernel {
+public:
+	explicit FMEOctreeKernel(FMEThread* pThread) : FMEKernel(pThread) { }
+
+	//! allocate the global and local contexts used by an instance of this kernel
+	static FMEOctreeGlobalContext* allocateContext(ArrayGraph* pGraph, FMEGlobalOptions* pOptions,
+			uint32_t numThreads);
+
+	//! free the global and local context
+	static void deallocateContext(FMEOctreeGlobalContext* globalContext);
+
+	//! main function of the kernel
+	void operator()(FMEOctreeGlobalContext* globalContext);
+
+private:
+	//! returns the part of the array of size \p n for this thread
+	ArrayPartition arrayPartition(uint32_t n) const;
+
+	//! computes the bounding box and the Morton numbers in parallel and builds the octree
+	void octreeConstruction(const ArrayPartition& nodePartition);
+
+	//! computes the repulsive forces of the points in the thread's groups of the octree
+	void repulsiveForces();
+
+	//! adds the edge forces of the edges in the partition to the threads arrays
+	void edgeForces(const ArrayPartition& edgePartition);
+
+	//! collects the forces of all threads and moves the nodes in the partition by \p timeStep
+	void collectAndMove(const ArrayPartition& nodePartition, float timeStep);
+
+	FMEOctreeGlobalContext* m_pGlobalContext = nullptr;
+	FMEOctreeLocalContext* m_pLocalContext = nullptr;
+};
+
+}
+}
@@ -0,0 +1,169 @@
+/** \file
+ * \brief Declaration of class LinearOctree.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace ogdf {
+namespace fast_multipole_embedder {
+
+//! Octree over 3D points with multipole expansions for the repulsive forces in 3D layouts.
+/**
+ * The points are sorted by their 3D Morton numbers, so the points of each cell are a
+ * contiguous range. Every cell stores the multipole expansion of the potential
+ * <i>q</i> / <i>d</i> of its points with the node sizes as charges <i>q</i>, i.e., the
+ * monopole about its center of charge and the traceless quadrupole tensor (there is no
+ * dipole about the center of charge). Points and cells are stored as separate coordinate
+ * arrays. The forces are computed for groups of nearby points: the points in the near
+ * leaves and the far cells of a group are gathered into contiguous arrays and summed up for
+ * all its points with vector instructions if available.
+ *
+ * The Morton numbers may be computed in parallel, the tree is linked by one thread and the
+ * forces may then be evaluated concurrently.
+ */
+class OGDF_EXPORT LinearOctree {
+public:
+	//! Creates an octree for the \p n points with coordinates \p x, \p y, \p z and charges \p q.
+	/**
+	 * The arrays are not copied, their contents are read by computeMortonNumbers() and build().
+	 */
+	LinearOctree(uint32_t n, const float* x, const float* y, const float* z, const float* q,
+			float theta = 0.7f);
+
+	//! Returns the number of points.
+	uint32_t numberOfPoints() const { return m_numPoints; }
+
+	//! Returns the opening angle: a cell is approximated if its size is at most theta times its distance.
+	float theta() const { return m_theta; }
+
+	//! Sets the opening angle to \p theta.
+	void theta(float theta) { m_theta = theta; }
+
+	//! Sets the bounding box of the points, which must be set before computing the Morton numbers.
+	void init(float minX, float minY, float minZ, float maxX, float maxY, float maxZ);
+
+	//! Computes the Morton numbers of the points \p begin, ..., \p end.
+	void computeMortonNumbers(uint32_t begin, uint32_t end);
+
+	//! Sorts the points by their Morton numbers, links the tree and computes the expansions.
+	void build();
+
+	//! Returns the index in the input arrays of the point at position \p k in Morton order.
+	uint32_t refOfPoint(uint32_t k) const { return m_points[k].ref; }
+
+	//! Returns the number of groups, which are numbered in Morton order.
+	/**
+	 * The groups are the largest cells with at most #s_groupSize points and the leaves with
+	 * more points, so every point is in exactly one group.
+	 */
+	uint32_t numberOfGroups() const { return static_cast<uint32_t>(m_groups.size()); }
+
+	//! Returns the position in Morton order of the first point in \p group.
+	uint32_t firstPointOfGroup(uint32_t group) const { return m_begin[m_groups[group]]; }
+
+	//! Returns the position in Morton order after the last point in \p group.
+	uint32_t endPointOfGroup(uint32_t group) const { return m_end[m_groups[group]]; }
+
+	//! Scratch space for computing the forces of a group, each thread needs its own.
+	struct Workspace {
+		std::vector<int> nearLeaves; //!< The leaves near the group.
+		std::vector<int> farCells; //!< The cells far from the group.
+		//! The points of the near leaves.
+		std::vector<float> x, y, z, q;
+		//! The expansions of the far cells.
+		std::vector<float> cellX, cellY, cellZ, cellQ, xx, yy, zz, xy, xz, yz;
+		//! The forces on the points of the group in Morton order.
+		std::vector<float> forceX, forceY, forceZ;
+	};
+
+	//! Computes the repulsive forces on the points of \p group and stores them in \p workspace.
+	/**
+	 * The tree is traversed once for all points of the group: the cells that are far enough
+	 * from the bounding box of the group are approximated by their expansions, the points in
+	 * the remaining leaves are summed up directly.
+	 *
+	 * The force of a charge <i>q</i> at distance <i>d</i> is <i>q</i> / <i>d</i><sup>2</sup>,
+	 * squared distances below \p minDistSq are replaced by \p minDistSq.
+	 */
+	void computeGroupForces(uint32_t group, float minDistSq, Workspace& workspace) const;
+
+private:
+	//! Maximum number of points in a leaf unless the maximum depth is reached.
+	static constexpr uint32_t s_leafSize = 16;
+	//! Maximum number of points in a group that shares the traversal of the tree.
+	static constexpr uint32_t s_groupSize = 64;
+	//! Maximum depth, i.e., the number of bits of the Morton numbers per coordinate.
+	static constexpr int s_maxDepth = 21;
+
+	struct Point {
+		uint64_t mortonNr;
+		uint32_t ref;
+	};
+
+	uint32_t m_numPoints;
+	const float* m_inputX;
+	const float* m_inputY;
+	const float* m_inputZ;
+	const float* m_inputQ;
+	float m_theta;
+	bool m_useAVX2; //!< Whether the forces are summed up with AVX2 instructions.
+
+	float m_min[3]; //!< The lower corner of the bounding cube.
+	float m_size; //!< The side length of the bounding cube.
+	double m_quantization; //!< Scales coordinates to the grid of the Morton numbers.
+
+	// the points in Morton order
+	std::vector<Point> m_points;
+	std::vector<float> m_x, m_y, m_z, m_q;
+
+	// the cells, the children of a cell are stored consecutively
+	std::vector<float> m_cellX, m_cellY, m_cellZ; //!< The centers of charge.
+	std::vector<float> m_cellQ; //!< The total charge.
+	std::vector<float> m_qxx, m_qyy, m_qzz, m_qxy, m_qxz, m_qyz; //!< The quadrupole tensor.
+	std::vector<float> m_cellSize; //!< The side length.
+	std::vector<int> m_firstChild; //!< The first child or -1 for leaves.
+	std::vector<int> m_numChildren;
+	std::vector<uint32_t> m_begin, m_end; //!< The range of the points in Morton order.
+	std::vector<int> m_groups; //!< The groups in Morton order.
+
+	//! Creates the subtree of \p cell whose points have equal Morton numbers above \p depth.
+	/**
+	 * The cell is added to the groups unless it is \p inGroup of an ancestor.
+	 */
+	void buildCell(int cell, int depth, float size, bool inGroup);
+
+	int newCell(uint32_t begin, uint32_t end, float size);
+};
+
+}
+}
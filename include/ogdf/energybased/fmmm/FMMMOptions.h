@@ -136,7 +136,8 @@ public:
 	//! Specifies how the reduced bucket quadtree is constructed.
 	enum class ReducedTreeConstruction {
 		PathByPath, //!< Path-by-path construction.
-		SubtreeBySubtree //!< Subtree-by-subtree construction.
+		SubtreeBySubtree, //!< Subtree-by-subtree construction.
+		MortonOrder //!< Linear construction on the particles sorted by their Morton codes.
 	};
 
 	//! Specifies how to calculate the smallest quadratic cell that surrounds
@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/List.h>
 #include <ogdf/basic/basic.h>
@@ -38,6 +39,10 @@
 #include <ogdf/energybased/fmmm/FMMMOptions.h>
 #include <ogdf/energybased/fmmm/FruchtermanReingold.h>
 
+#include <cstdint>
+#include <functional>
+#include <vector>
+
 namespace ogdf::energybased::fmmm {
 class NodeAttributes;
 class ParticleInfo;
@@ -65,7 +70,7 @@ public:
 	void make_initialisations(const Graph& G, double boxlength, DPoint down_left_corner,
 			int particles_in_leaves, int precision,
 			FMMMOptions::ReducedTreeConstruction tree_construction_way,
-			FMMMOptions::SmallestCellFinding find_small_cell);
+			FMMMOptions::SmallestCellFinding find_small_cell, int number_of_threads = 1);
 
 	//! Dynamically allocated memory is freed here.
 	void deallocate_memory();
@@ -87,6 +92,7 @@ private:
 	FMMMOptions::SmallestCellFinding _find_small_cell;
 	int _particles_in_leaves; //!< max. number of particles for leaves of the quadtree
 	int _precision; //!< precision for p-term multipole expansion
+	int _number_of_threads; //!< number of threads used for the force calculation
 
 	double boxlength; //!< length of drawing box
 	DPoint down_left_corner; //!< down left corner of drawing box
@@ -94,6 +100,17 @@ private:
 	const int max_power_of_2_index; //!< holds max. index for power_of_2 (= 30)
 	double** BK; //!< holds the binomial coefficients
 
+	//! A particle with the Morton code of its position in the grid of the finest level.
+	struct MortonParticle {
+		uint64_t code; //!< the interleaved bits of x and y
+		uint32_t x, y; //!< the grid coordinates
+		node v;
+	};
+
+	//! the particles sorted by their Morton codes (reused in each iteration)
+	std::vector<MortonParticle> morton_particles;
+	std::vector<MortonParticle> morton_buffer; //!< buffer for sorting #morton_particles
+
 	//! stores the rep. forces of the last iteration
 	//! needed for error calculation)
 	List<DPoint> rep_forces;
@@ -106,6 +123,10 @@ private:
 	//! Returns the maximal index of a box in level i.
 	int maxboxindex(int level);
 
+	//! Calls \p task for 0,...,number_of_tasks-1, distributed over number_of_threads()
+	//! threads; task i is always run by thread i mod number_of_threads().
+	void run_in_parallel(int number_of_tasks, const std::function<void(int)>& task);
+
 	//! Use NMM for force calculation (used for large Graphs (|V| > MIN_NODE_NUMBER)).
 	void calculate_repulsive_forces_by_NMM(const Graph& G, NodeArray<NodeAttributes>& A,
 			NodeArray<DPoint>& F_rep);
@@ -209,6 +230,13 @@ private:
 	void build_up_red_quad_tree_subtree_by_subtree(const Graph& G, NodeArray<NodeAttributes>& A,
 			QuadTreeNM& T);
 
+	//! The subtrees rooted at the nodes of subtree_root_List are constructed in parallel
+	//! by construct_subtree(); subtree_root_List is empty afterwards and the new subtree
+	//! roots are appended to new_subtree_root_List in the order of their tasks.
+	void construct_subtrees_in_parallel(NodeArray<NodeAttributes>& A, QuadTreeNM& T,
+			List<QuadTreeNodeNM*>& subtree_root_List,
+			List<QuadTreeNodeNM*>& new_subtree_root_List);
+
 	//! The root node of T is constructed and contained_nodes is set to the list of
 	//! all nodes of G.
 	void build_up_root_vertex(const Graph& G, QuadTreeNM& T);
@@ -277,6 +305,25 @@ private:
 	//! are placed at a point nothing is done.
 	bool find_smallest_quad(NodeArray<NodeAttributes>& A, QuadTreeNM& T);
 
+	//! @}
+	//! @{
+	//! \name Functions needed for the construction on Morton-ordered particles
+
+	//! The reduced quadtree is built up from the particles sorted by their Morton codes
+	//! (the lists LE, ME, the centers, D1, D2, M, and quad_tree_leaves are not
+	//! calculated here).
+	void build_up_red_quad_tree_morton_order(const Graph& G, NodeArray<NodeAttributes>& A,
+			QuadTreeNM& T);
+
+	//! morton_particles is set to the particles of G sorted by their Morton codes
+	//! (by a radix sort).
+	void sort_particles_by_morton_code(const Graph& G, NodeArray<NodeAttributes>& A);
+
+	//! *T.get_act_ptr() becomes the root of the reduced subtree containing the particles
+	//! morton_particles[first], ..., morton_particles[last-1]; its small cell is the
+	//! smallest cell containing all of them.
+	void construct_morton_subtree(QuadTreeNM& T, int first, int last);
+
 	//! @}
 
 	//! Finds the small cell of the actual Node of T iteratively,and updates
@@ -303,15 +350,35 @@ private:
 	//! The reduced quad tree is deleted; Furthermore the treenode_number is calculated.
 	void delete_red_quad_tree_and_count_treenodes(QuadTreeNM& T);
 
-	//! The multipole expansion terms ME are calculated for all nodes of T ( centers are
-	//! initialized for each cell and quad_tree_leaves stores pointers to leaves of T).
-	void form_multipole_expansions(NodeArray<NodeAttributes>& A, QuadTreeNM& T,
-			List<QuadTreeNodeNM*>& quad_tree_leaves);
-
-	//! The multipole expansion List ME for the tree rooted at T.get_act_ptr() is
+	//! The Lists ME and LE are initialized and the centers are set for all nodes of the
+	//! subtree rooted at *act_ptr; quad_tree_leaves stores pointers to its leaves in
+	//! preorder.
+	void init_expansions_of_subtree(QuadTreeNodeNM* act_ptr,
+			ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves);
+
+	//! T is split into the nodes of its top levels (top_nodes, in BFS order) and the
+	//! roots of the remaining subtrees (subtree_roots), such that there are enough
+	//! subtrees to keep number_of_threads() threads busy.
+	void split_red_quad_tree(QuadTreeNM& T, ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+			ArrayBuffer<QuadTreeNodeNM*>& subtree_roots);
+
+	//! The leaves are split into number_of_threads() consecutive chunks containing about
+	//! the same number of particles; chunk i consists of the leaves first_leaf[i], ...,
+	//! first_leaf[i+1]-1.
+	void partition_leaves(const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves,
+			Array<int>& first_leaf);
+
+	//! The multipole expansion terms ME are calculated for all nodes of T, the subtrees
+	//! in parallel and the top nodes afterwards (precondition: the expansions have
+	//! been initialized by init_expansions_of_subtree()).
+	void form_multipole_expansions(NodeArray<NodeAttributes>& A,
+			const ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+			const ArrayBuffer<QuadTreeNodeNM*>& subtree_roots);
+
+	//! The multipole expansion List ME for the tree rooted at act_ptr is
 	//! recursively calculated.
-	void form_multipole_expansion_of_subtree(NodeArray<NodeAttributes>& A, QuadTreeNM& T,
-			List<QuadTreeNodeNM*>& quad_tree_leaves);
+	void form_multipole_expansion_of_subtree(NodeArray<NodeAttributes>& A,
+			QuadTreeNodeNM* act_ptr);
 
 	//! The Lists ME and LE are both initialized to zero entries for *act_ptr.
 	void init_expansion_Lists(QuadTreeNodeNM* act_ptr);
@@ -332,6 +399,17 @@ private:
 	void calculate_local_expansions_and_WSPRLS(NodeArray<NodeAttributes>& A,
 			QuadTreeNodeNM* act_node_ptr);
 
+	//! Calculates the lists D1, D2, M and LE for the top nodes of T and then for the
+	//! subtrees rooted at subtree_roots in parallel.
+	void calculate_local_expansions_and_WSPRLS(NodeArray<NodeAttributes>& A,
+			const ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+			const ArrayBuffer<QuadTreeNodeNM*>& subtree_roots);
+
+	//! Calculates the lists D1, D2, M and LE of act_node_ptr only; precondition: they
+	//! have been calculated for the father of act_node_ptr.
+	void calculate_local_expansions_and_WSPRLS_of_node(NodeArray<NodeAttributes>& A,
+			QuadTreeNodeNM* act_node_ptr);
+
 	//! If the small cell of ptr_1 and ptr_2 are well separated true is returned (else
 	//! false).
 	bool well_separated(QuadTreeNodeNM* ptr_1, QuadTreeNodeNM* ptr_2);
@@ -356,17 +434,27 @@ private:
 	//! For each leaf v in quad_tree_leaves the force contribution defined by
 	//! v.get_local_exp() is calculated and stored in F_local_exp.
 	void transform_local_exp_to_forces(NodeArray<NodeAttributes>& A,
-			List<QuadTreeNodeNM*>& quad_tree_leaves, NodeArray<DPoint>& F_local_exp);
+			const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, const Array<int>& first_leaf,
+			NodeArray<DPoint>& F_local_exp);
 
 	//! For each leaf v in quad_tree_leaves the force contribution defined by all nodes
 	//! in v.get_M() is calculated and stored in F_multipole_exp.
 	void transform_multipole_exp_to_forces(NodeArray<NodeAttributes>& A,
-			List<QuadTreeNodeNM*>& quad_tree_leaves, NodeArray<DPoint>& F_multipole_exp);
+			const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, const Array<int>& first_leaf,
+			NodeArray<DPoint>& F_multipole_exp);
 
 	//! For each leaf v in quad_tree_leaves the force contributions from all leaves in
-	//! v.get_D1() and v.get_D2() are calculated.
+	//! v.get_D1() and v.get_D2() are calculated. Each chunk of leaves adds its
+	//! contributions to a separate array; these are summed up in the order of the chunks.
+	void calculate_neighbourcell_forces(const Graph& G, NodeArray<NodeAttributes>& A,
+			const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, const Array<int>& first_leaf,
+			NodeArray<DPoint>& F_direct);
+
+	//! The force contributions of the leaves quad_tree_leaves[first], ...,
+	//! quad_tree_leaves[last-1] are added to F_direct.
 	void calculate_neighbourcell_forces(NodeArray<NodeAttributes>& A,
-			List<QuadTreeNodeNM*>& quad_tree_leaves, NodeArray<DPoint>& F_direct);
+			const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, int first, int last,
+			NodeArray<DPoint>& F_direct);
 
 	//! Add repulsive force contributions for each node.
 	void add_rep_forces(const Graph& G, NodeArray<DPoint>& F_direct,
@@ -406,6 +494,11 @@ private:
 	void precision(int p) { _precision = ((p >= 1) ? p : 1); }
 
 	int precision() const { return _precision; }
+
+	//! The number of threads used for the force calculation.
+	void number_of_threads(int n) { _number_of_threads = ((n >= 1) ? n : 1); }
+
+	int number_of_threads() const { return _number_of_threads; }
 };
 
 }
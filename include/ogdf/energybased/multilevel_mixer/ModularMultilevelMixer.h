@@ -31,7 +31,9 @@
 
 #pragma once
 
+#include <ogdf/basic/Graph.h>
 #include <ogdf/basic/LayoutModule.h>
+#include <ogdf/basic/List.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/energybased/multilevel_mixer/InitialPlacer.h>
 #include <ogdf/energybased/multilevel_mixer/MultilevelBuilder.h>
@@ -71,6 +73,19 @@ class MultilevelGraph;
  *     <td>The layout module applied to the final drawing for additional beautification.
  *   </tr>
  * </table>
+ *
+ * <H3>Incremental layout</H3>
+ * After a small change of a graph that has already been laid out, callIncremental() only
+ * lays out the region around the changed nodes again and keeps all other positions.
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>incrementalRadius</i><td>int<td>2
+ *     <td>The number of hops around the changed nodes that are laid out again.
+ *   </tr>
+ * </table>
  */
 class OGDF_EXPORT ModularMultilevelMixer : public LayoutModule {
 private:
@@ -110,6 +125,8 @@ private:
 	bool m_levelBound; //!< Determines if computation is stopped when number of levels is too high.
 	bool m_randomize; //!< Determines if initial random layout is computed.
 
+	int m_incrementalRadius; //!< Number of hops around changed nodes laid out by callIncremental().
+
 public:
 	//! Error codes for calls.
 	enum class erc {
@@ -150,9 +167,31 @@ public:
 	//! Determines if computation is stopped when number of levels is too high.
 	void setLevelBound(bool b) { m_levelBound = b; }
 
+	//! Sets the number of hops around the changed nodes that are laid out by callIncremental().
+	void setIncrementalRadius(int radius) { m_incrementalRadius = max(0, radius); }
+
+	//! Returns the number of hops around the changed nodes that are laid out by callIncremental().
+	int incrementalRadius() const { return m_incrementalRadius; }
+
 	//! Calls the multilevel layout algorithm for graph attributes \p GA.
 	void call(GraphAttributes& GA) override;
 
+	//! Updates the layout in \p GA after a small change of its graph.
+	/**
+	 * The coordinates in \p GA are the layout before the change. \p changedNodes contains the
+	 * inserted nodes and the end nodes of inserted or deleted edges.
+	 *
+	 * The changed nodes are placed at the barycenter of their neighbours, starting with the
+	 * neighbours that have not changed. Then the nodes within incrementalRadius() hops of
+	 * a changed node are laid out again: each connected part of this region is coarsened and
+	 * refined by the modules of the mixer, together with its unchanged neighbours outside of
+	 * the region. Finally, the new layout of the part is translated, rotated, scaled and
+	 * possibly mirrored such that its unchanged nodes fit their previous positions best.
+	 * Nodes outside of the region keep their positions, so the running time only depends on
+	 * the size of the region.
+	 */
+	void callIncremental(GraphAttributes& GA, const List<node>& changedNodes);
+
 	/**
 	 * \brief Calls the multilevel layout algorithm for multilevel graph \a MLG.
 	 *
@@ -0,0 +1,119 @@
+/** \file
+ * \brief Declaration of ogdf::spring_embedder::BarnesHutTree.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/geometry.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace ogdf {
+namespace spring_embedder {
+
+//! Quadtree approximating the repulsive forces between all pairs of points (Barnes-Hut).
+/**
+ * The points are sorted by their Morton codes, so the points of each cell are a contiguous
+ * range. Points and cells are stored as separate coordinate arrays (structure of arrays):
+ * a query collects the points and the centers of mass of the cells that are far enough
+ * away into small buffers and sums up their forces with vector instructions if available.
+ *
+ * The tree is built by a single thread, queries may be issued concurrently.
+ */
+class OGDF_EXPORT BarnesHutTree {
+public:
+	//! Creates an empty tree with opening angle \p theta.
+	explicit BarnesHutTree(double theta = 0.6);
+
+	//! Returns the opening angle: a cell is approximated if its size is at most theta times its distance.
+	double theta() const { return m_theta; }
+
+	//! Sets the opening angle to \p theta.
+	void theta(double theta) { m_theta = theta; }
+
+	//! Builds the tree for the points \p position(0), ..., \p position(\p n - 1).
+	template<typename Position>
+	void build(int n, Position&& position) {
+		m_inputX.resize(n);
+		m_inputY.resize(n);
+		for (int i = 0; i < n; ++i) {
+			const DPoint& p = position(i);
+			m_inputX[i] = p.m_x;
+			m_inputY[i] = p.m_y;
+		}
+		build();
+	}
+
+	//! Multiplies all coordinates by \p s, i.e., adapts the tree to the scaled points.
+	void scale(double s);
+
+	//! Returns the repulsive force on point \p i.
+	/**
+	 * The force is the sum of <i>w</i> (<i>p</i><sub>i</sub> - <i>c</i>) /
+	 * (<i>d</i><sup>normExponent + 1</sup> + \p eps) over all points and approximating
+	 * centers of mass <i>c</i> with weight <i>w</i> at distance <i>d</i>.
+	 */
+	DPoint repulsion(int i, int normExponent, double eps) const;
+
+private:
+	//! Maximum number of points in a leaf unless the maximum depth is reached.
+	static constexpr int s_leafSize = 8;
+	//! Maximum depth, i.e., the number of bits of the Morton codes per coordinate.
+	static constexpr int s_maxDepth = 16;
+
+	double m_theta;
+	bool m_useAVX2; //!< Whether the forces are summed up with AVX2 instructions.
+
+	std::vector<double> m_inputX, m_inputY; //!< The points by input index.
+
+	// the points in Morton order
+	std::vector<uint32_t> m_code;
+	std::vector<int> m_order; //!< The input index of each point.
+	std::vector<int> m_rank; //!< The position of each input point in Morton order.
+	std::vector<double> m_x, m_y;
+
+	// the cells, the children of a cell are stored consecutively
+	std::vector<double> m_cellX, m_cellY; //!< The centers of mass.
+	std::vector<double> m_cellMass; //!< The number of points.
+	std::vector<double> m_cellSize; //!< The side length.
+	std::vector<int> m_firstChild; //!< The first child or -1 for leaves.
+	std::vector<int> m_numChildren;
+	std::vector<int> m_begin, m_end; //!< The range of the points in Morton order.
+
+	void build();
+
+	//! Creates the subtree of \p cell whose points have equal codes in the bits above \p depth.
+	void buildCell(int cell, int depth, double size);
+
+	int newCell(int begin, int end, double size);
+};
+
+}
+}
@@ -36,6 +36,7 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphCopy.h>
 #include <ogdf/basic/geometry.h>
+#include <ogdf/energybased/spring_embedder/BarnesHutTree.h>
 #include <ogdf/energybased/spring_embedder/SpringEmbedderBase.h>
 
 #include <cmath>
@@ -65,6 +66,8 @@ protected:
 
 	Barrier* m_barrier;
 
+	BarnesHutTree m_barnesHutTree; //!< Only used if the repulsion is computed by Barnes-Hut.
+
 	double m_idealEdgeLength;
 
 	double m_tNull;
@@ -90,6 +93,7 @@ public:
 		, m_forceModel(nullptr)
 		, m_forceModelImprove(nullptr)
 		, m_barrier(nullptr)
+		, m_barnesHutTree(spring.barnesHutTheta())
 		, m_avgDisplacement(std::numeric_limits<double>::max())
 		, m_maxDisplacement(std::numeric_limits<double>::max()) { }
 
@@ -134,6 +138,20 @@ public:
 		m_coolingFactor *= m_spring.coolDownFactor();
 	}
 
+	//! Returns whether the repulsive forces are computed by Barnes-Hut.
+	bool useBarnesHut() const {
+		return m_spring.repulsion() == SpringEmbedderBase::Repulsion::barnesHut;
+	}
+
+	//! Builds the Barnes-Hut quadtree for the current positions; to be called by a single thread.
+	void buildBarnesHutTree() {
+		if (useBarnesHut()) {
+			m_barnesHutTree.build(numberOfNodes(), [&](int j) { return m_vInfo[j].m_pos; });
+		}
+	}
+
+	const BarnesHutTree& barnesHutTree() const { return m_barnesHutTree; }
+
 	double maxForceLength() const { return m_t; }
 
 	double coolingFactor() const { return m_coolingFactor; }
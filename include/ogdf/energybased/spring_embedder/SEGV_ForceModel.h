@@ -34,6 +34,7 @@
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/SpringEmbedderGridVariant.h>
+#include <ogdf/energybased/spring_embedder/BarnesHutTree.h>
 #include <ogdf/energybased/spring_embedder/common.h>
 
 #include <functional>
@@ -56,8 +57,12 @@ public:
 
 	virtual DPoint computeDisplacement(int j, double boxLength) const = 0;
 
+	//! Computes the repulsive forces with \p tree instead of the grid cells.
+	void useBarnesHut(const spring_embedder::BarnesHutTree* tree) { m_barnesHutTree = tree; }
+
 protected:
 	const Array2D<ListPure<int>>& m_gridCell;
+	const spring_embedder::BarnesHutTree* m_barnesHutTree = nullptr;
 
 	DPoint computeRepulsiveForce(int j, double boxLength, int idealExponent,
 			int normExponent = 1) const;
@@ -36,12 +36,12 @@
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphCopy.h>
 #include <ogdf/basic/GraphList.h>
-#include <ogdf/basic/LayoutModule.h>
 #include <ogdf/basic/LayoutStandards.h>
 #include <ogdf/basic/List.h>
 #include <ogdf/basic/System.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/energybased/ForceLayoutModule.h>
 #include <ogdf/energybased/SpringForceModel.h>
 #include <ogdf/packing/TileToRowsCCPacker.h>
 
@@ -51,7 +51,7 @@ namespace ogdf {
 namespace spring_embedder {
 
 //! Common base class for ogdf::SpringEmbedderBase and ogdf::SpringEmbedderGridVariant.
-class SpringEmbedderBase : public LayoutModule {
+class SpringEmbedderBase : public ForceLayoutModule {
 public:
 	//! The scaling method used by the algorithm.
 	enum class Scaling {
@@ -61,6 +61,12 @@ public:
 		useIdealEdgeLength //!< use the given ideal edge length to scale the layout suitably.
 	};
 
+	//! The method used for computing the repulsive forces.
+	enum class Repulsion {
+		grid, //!< only nodes in neighbouring cells of a uniform grid repel each other.
+		barnesHut //!< all pairs of nodes repel each other, approximated by a quadtree (Barnes-Hut).
+	};
+
 	//! Constructor
 	SpringEmbedderBase() {
 		// default parameters
@@ -81,6 +87,9 @@ public:
 		m_scaling = Scaling::scaleFunction;
 		m_scaleFactor = 4.0;
 
+		m_repulsion = Repulsion::grid;
+		m_barnesHutTheta = 0.6;
+
 		m_userBoundingBox = DRect(0, 0, 100, 100);
 
 		m_minDistCC = LayoutStandards::defaultCCSeparation();
@@ -99,6 +108,7 @@ public:
 		if (G.empty()) {
 			return;
 		}
+		startProgress();
 
 		// all edges straight-line
 		GA.clearAllBends();
@@ -284,6 +294,31 @@ public:
 	//! Gets the user bounding box.
 	DRect userBoundingBox() const { return m_userBoundingBox; }
 
+	//! Returns the method used for computing the repulsive forces.
+	Repulsion repulsion() const { return m_repulsion; }
+
+	//! Sets the method used for computing the repulsive forces to \p rep.
+	/**
+	 * The grid is fast on graphs whose nodes are spread evenly, but on graphs with dense
+	 * clusters the cells of the clusters contain many nodes. The Barnes-Hut quadtree adapts
+	 * to the distribution of the nodes.
+	 */
+	void repulsion(Repulsion rep) { m_repulsion = rep; }
+
+	//! Returns the opening angle of the Barnes-Hut quadtree.
+	/**
+	 * A cell of the quadtree is approximated by its center of mass if its side length is at
+	 * most this factor times its distance. Smaller values are more accurate but slower.
+	 */
+	double barnesHutTheta() const { return m_barnesHutTheta; }
+
+	//! Sets the opening angle of the Barnes-Hut quadtree to \p theta.
+	void barnesHutTheta(double theta) {
+		if (theta >= 0) {
+			m_barnesHutTheta = theta;
+		}
+	}
+
 	//! Returns the maximal number of used threads.
 	unsigned int maxThreads() const { return m_maxThreads; }
 
@@ -310,6 +345,9 @@ protected:
 
 	DRect m_userBoundingBox;
 
+	Repulsion m_repulsion; //!< The method for computing the repulsive forces.
+	double m_barnesHutTheta; //!< The opening angle of the Barnes-Hut quadtree.
+
 	double m_minDistCC; //!< The minimal distance between connected components.
 	double m_pageRatio; //!< The page ratio.
 
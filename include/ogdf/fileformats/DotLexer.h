@@ -32,8 +32,10 @@
 #pragma once
 
 #include <cstddef>
+#include <deque>
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ogdf {
@@ -83,10 +85,14 @@ struct Token {
 	size_t row;
 	//! Indicated a token column.
 	size_t column;
-	//! Identifier content (nullptr for non-id tokens).
-	std::string* value;
+	//! Identifier content (empty for non-id tokens).
+	/**
+	 * Points into the input buffer of the Lexer that created the token and
+	 * is thus only valid as long as the lexer exists.
+	 */
+	std::string_view value;
 
-	Token(size_t tokenRow, size_t tokenColumn, std::string* identifierContent = nullptr);
+	Token(size_t tokenRow, size_t tokenColumn, std::string_view identifierContent = {});
 
 	//! Returns string representation of given token type.
 	static std::string toString(const Type& type);
@@ -100,52 +106,53 @@ struct Token {
  * identifier representations in DOT format (C-like identifier, double-quoted
  * strings, number literals).
  *
+ * The whole input is kept in a single buffer (or, if the lexer is constructed
+ * from a memory range, not copied at all), and identifier tokens refer to
+ * their content in that buffer instead of owning a copy.
+ *
  * \sa dot::Parser
  */
 class Lexer {
 private:
-	std::istream& m_input;
+	std::istream* m_input;
 
-	std::string m_buffer; // Current line of given file.
-	size_t m_row, m_col; // Current position in parsed file.
+	std::string m_buffer; // Contents of the input stream.
+	const char* m_begin; // Range that is tokenized.
+	const char* m_end;
 
-	std::vector<Token> m_tokens;
+	size_t m_row; // Current line of the input.
+	const char* m_lineStart; // Start of the current line.
 
-	bool tokenizeLine();
+	// Quoted strings spanning several lines, with the line breaks removed.
+	std::deque<std::string> m_joinedStrings;
 
-	//! Checks if \a head matches given token. Advances \a head on success.
-	/**
-	 * @param type A type of token being matched.
-	 * @param word True if token is part of a word, false otherwise.
-	 * @return True if matches, false otherwise.
-	 */
-	bool match(const Token::Type& type, bool word = false);
+	std::vector<Token> m_tokens;
 
-	//! Checks if \a head matches given string. Advances \a head on success.
-	/**
-	 * @param str A string being matched.
-	 * @param word True if token is part of a word, false otherwise.
-	 * @return True if matches, false otherwise.
-	 */
-	bool match(const std::string& str, bool word = false);
+	//! Advances \a p to \a to, keeping track of the line breaks in between.
+	void advance(const char*& p, const char* to);
 
-	//! Checks whether \a head is an identifier.
+	//! Checks whether \a p is the start of an identifier and moves it to its end.
 	/**
-	 * @param token Function fills it with identifier value and col/row info.
+	 * @param p Position in the input, advanced on success.
+	 * @param token Function fills it with identifier value.
 	 * @return True if matches, false otherwise.
 	 */
-	bool identifier(Token& token);
+	bool identifier(const char*& p, Token& token);
 
 	//! Checks if character is allowed in an identifier by DOT standard
 	/**
 	 * @param c A character
 	 * @return True if c is one of alphabetic ([a-zA-Z\200-\377]) characters, underscores ('_') or digits ([0-9])
 	 */
-	bool isDotAlnum(signed char c);
+	static bool isDotAlnum(signed char c);
 
 public:
 	//! Initializes lexer with given input (but does nothing to it).
 	explicit Lexer(std::istream& input);
+
+	//! Initializes lexer with the characters in [\p begin, \p end), which must outlive the lexer.
+	Lexer(const char* begin, const char* end);
+
 	~Lexer();
 
 	//! Scans input and turns it into token list.
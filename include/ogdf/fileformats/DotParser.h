@@ -130,11 +130,16 @@ private:
 	using Tokens = std::vector<Token>;
 	using Iterator = Tokens::const_iterator;
 
-	const Tokens m_tokens;
+	const Iterator m_tbegin;
 	const Iterator m_tend;
 
+	unsigned int m_numThreads;
+
 	Graph* m_graph;
 
+	//! Initializes AST building for the tokens in [\p begin, \p end).
+	Ast(Iterator begin, Iterator end);
+
 	Graph* parseGraph(Iterator current, Iterator& rest);
 	Subgraph* parseSubgraph(Iterator current, Iterator& rest);
 	NodeStmt* parseNodeStmt(Iterator current, Iterator& rest);
@@ -145,6 +150,8 @@ private:
 	NodeId* parseNodeId(Iterator current, Iterator& rest);
 	Stmt* parseStmt(Iterator current, Iterator& rest);
 	StmtList* parseStmtList(Iterator current, Iterator& rest);
+	//! Parses the statements of the graph body starting at \p current using #m_numThreads threads.
+	StmtList* parseStmtListParallel(Iterator current, Iterator& rest);
 	AttrList* parseAttrList(Iterator current, Iterator& rest);
 	AList* parseAList(Iterator current, Iterator& rest);
 	Port* parsePort(Iterator current, Iterator& rest);
@@ -153,16 +160,23 @@ private:
 public:
 	//! Initializes AST building but does not trigger the process itself.
 	/**
-	 * @param tokens DOT format token list to build the AST.
+	 * @param tokens DOT format token list to build the AST, must outlive the AST.
 	 */
 	explicit Ast(const Tokens& tokens);
 	~Ast();
 
 	//! Builds the DOT format AST.
 	/**
+	 * The top-level statements of the graph are independent of each other
+	 * as far as parsing is concerned. If \p numThreads is not 1, the statement
+	 * list is split at top-level semicolons and the parts are parsed
+	 * concurrently. The result is the same as for a sequential build.
+	 *
+	 * @param numThreads The number of threads to use, 0 chooses it based on
+	 *        the number of processors and tokens.
 	 * @return True if success, false otherwise.
 	 */
-	bool build();
+	bool build(unsigned int numThreads = 1);
 
 	//! Returns the root of the AST (nullptr if none).
 	Graph* root() const;
@@ -325,6 +339,7 @@ public:
 class Parser {
 private:
 	std::istream& m_in;
+	unsigned int m_numThreads;
 
 	// Maps node id to Graph node.
 	HashArray<std::string, node> m_nodeId;
@@ -333,7 +348,11 @@ private:
 
 public:
 	//! Initializes parser class with given input (but does nothing to it).
-	explicit Parser(std::istream& in);
+	/**
+	 * @param in The input stream to read from.
+	 * @param numThreads The number of threads used for building the AST, see Ast#build().
+	 */
+	explicit Parser(std::istream& in, unsigned int numThreads = 0);
 
 	bool read(Graph& G);
 	bool read(Graph& G, GraphAttributes& GA);
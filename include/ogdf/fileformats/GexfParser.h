@@ -43,6 +43,7 @@
 namespace ogdf {
 class ClusterGraphAttributes;
 class GraphAttributes;
+class XmlStreamReader;
 
 namespace gexf {
 
@@ -50,6 +51,7 @@ namespace gexf {
 class Parser {
 private:
 	std::istream& m_is;
+	bool m_streaming;
 
 	pugi::xml_document m_xml;
 	pugi::xml_node m_graphTag, m_nodesTag, m_edgesTag;
@@ -67,10 +69,23 @@ private:
 	bool readAttributes(GraphAttributes& GA, node v, const pugi::xml_node nodeTag);
 	bool readAttributes(GraphAttributes& GA, edge e, const pugi::xml_node edgeTag);
 
+	// Reads the graph directly from m_is, creating nodes and edges as they appear.
+	bool readStreaming(Graph& G, GraphAttributes* GA);
+	bool readStreamedGraph(XmlStreamReader& xml, Graph& G, GraphAttributes* GA);
+	bool readStreamedNode(XmlStreamReader& xml, Graph& G, GraphAttributes* GA);
+	bool readStreamedEdge(XmlStreamReader& xml, Graph& G, GraphAttributes* GA);
+
 	static void error(const pugi::xml_node tag, const std::string& msg);
 
 public:
-	explicit Parser(std::istream& is);
+	//! Creates a parser reading from \p is.
+	/**
+	 * If \p streaming is true, reading a Graph (with or without GraphAttributes) does not
+	 * load the whole document into memory but creates each node and edge as soon as it has
+	 * been read. In this case, the \c nodes tag must precede the \c edges tag, as required
+	 * by the GEXF schema. Clustered graphs are always read via the document tree.
+	 */
+	explicit Parser(std::istream& is, bool streaming = false);
 
 	bool read(Graph& G);
 	bool read(Graph& G, GraphAttributes& GA);
@@ -100,13 +100,22 @@ class OGDF_EXPORT Parser {
 	Object* m_objectTree; // root node of GML parse tree
 
 	bool m_doCheck;
+	bool m_streaming; // true <=> the sons of m_graphObject are still to be read from m_is
 	Array<node> m_mapToNode;
 	Object* m_graphObject;
 
 public:
-	// construction: creates object tree
-	// sets m_error flag if an error occured
-	explicit Parser(std::istream& is, bool doCheck = false);
+	//! Construction: creates object tree.
+	/**
+	 * Sets m_error flag if an error occured.
+	 *
+	 * If \p streaming is true, the contents of the top-level \c graph list are not stored in the
+	 * object tree. Instead, read() parses them one by one, creating each node and edge directly
+	 * and discarding its object subtree right afterwards. This keeps the memory required by the
+	 * parser independent of the size of the graph. In this case, read() may only be called once
+	 * and \p is must stay valid until it returns.
+	 */
+	explicit Parser(std::istream& is, bool doCheck = false, bool streaming = false);
 
 	//! Destruction: destroys object tree
 	~Parser();
@@ -132,10 +141,18 @@ private:
 	void setError(const string& errorString, Logger::Level level = Logger::Level::Default);
 
 	Object* parseList(ObjectType closingKey);
+	//! Parses a single key-value pair; returns nullptr at \p closingKey or on error.
+	Object* parseObject(ObjectType closingKey);
 	ObjectType getNextSymbol();
 	bool getLine();
 
 	Object* getNodeIdRange(int& minId, int& maxId);
+	//! Returns the node with GML id \p id, or nullptr if there is none (yet).
+	node nodeForId(int id) const {
+		return m_mapToNode.low() <= id && id <= m_mapToNode.high() ? m_mapToNode[id] : nullptr;
+	}
+	//! Maps GML id \p id to \p v, growing the map if necessary.
+	void setNodeForId(int id, node v);
 	void readLineAttribute(Object* object, DPolyline& dpl);
 
 	void destroyObjectList(Object* object);
@@ -893,6 +893,163 @@ public:
 	 */
 	static OGDF_EXPORT bool readMatrixMarket(Graph& G, std::istream& inStream);
 
+	//! Reads graph \p G in Matrix Market exchange format from file \p filename using \p numThreads threads.
+	/**
+	 * Creates the same graph as readMatrixMarket(Graph &G, std::istream &inStream), but is meant
+	 * for large files: the file is mapped into memory (or read at once if that is not possible)
+	 * and split into chunks of lines that are parsed in parallel. All nodes and edges are then
+	 * inserted in bulk.
+	 *
+	 * @param G          is assigned the read graph.
+	 * @param filename   is the name of the file to read from.
+	 * @param numThreads is the number of threads to use; 0 chooses it based on the number of
+	 *                   processors and the size of the file.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readMatrixMarketMapped(Graph& G, const string& filename,
+			unsigned int numThreads = 0);
+
+	//! @}
+
+#pragma mark Edge list
+	/**
+	 * @name Edge list
+	 *
+	 * Plain edge lists as used, e.g., by the SNAP collection (https://snap.stanford.edu/data/).
+	 * Every line contains the integer ids of the source and the target of an edge, separated by
+	 * white space. Lines starting with \c # or \c % are comments; further entries of a line
+	 * (e.g., weights) are ignored.
+	 */
+	//! @{
+
+	//! Reads graph \p G as edge list from file \p filename using \p numThreads threads.
+	/**
+	 * Nodes are created in the order in which their ids first occur, edges in the order of
+	 * the file. Like readMatrixMarketMapped(), the file is mapped into memory and parsed in
+	 * parallel.
+	 *
+	 * @param G          is assigned the read graph.
+	 * @param filename   is the name of the file to read from.
+	 * @param numThreads is the number of threads to use; 0 chooses it based on the number of
+	 *                   processors and the size of the file.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readEdgeListMapped(Graph& G, const string& filename,
+			unsigned int numThreads = 0);
+
+	//! @}
+
+#pragma mark Binary
+	/**
+	 * @name Binary
+	 *
+	 * OGDF's own compact binary format, meant for caching large graphs between runs rather than
+	 * for exchanging them with other tools.
+	 *
+	 * A file starts with the magic string \c OGDF-BIN, a format version and the number of nodes
+	 * and edges, followed by the edges as two arrays of endpoint indices and the adjacency lists
+	 * in compressed sparse row form, i.e., the order of the adjacency entries (and thus the
+	 * embedding) is preserved. Optional sections contain the cluster tree and the attributes.
+	 * All numbers are stored little-endian as raw arrays, each starting at a multiple of
+	 * eight bytes, so a file can also be memory-mapped and accessed directly.
+	 *
+	 * Streams must be opened in binary mode (\c std::ios::binary). The format is not
+	 * detected automatically by read() and write().
+	 */
+	//! @{
+
+	//! Reads graph \p G in binary format from input stream \p is.
+	/**
+	 * \sa writeBinary(const Graph &G, std::ostream &os)
+	 *
+	 * @param G   is assigned the read graph.
+	 * @param is  is the input stream to be read.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(Graph& G, std::istream& is);
+
+	//! Writes graph \p G in binary format to output stream \p os.
+	/**
+	 * \sa readBinary(Graph &G, std::istream &is)
+	 *
+	 * @param G   is the graph to be written.
+	 * @param os  is the output stream to which the graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const Graph& G, std::ostream& os);
+
+	//! Reads clustered graph (\p C, \p G) in binary format from input stream \p is.
+	/**
+	 * \pre \p G is the graph associated with clustered graph \p C.
+	 * \sa writeBinary(const ClusterGraph &C, std::ostream &os)
+	 *
+	 * @param C   is assigned the read clustered graph (cluster structure).
+	 * @param G   is assigned the read clustered graph (graph structure).
+	 * @param is  is the input stream to be read.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(ClusterGraph& C, Graph& G, std::istream& is);
+
+	//! Writes clustered graph \p C in binary format to output stream \p os.
+	/**
+	 * \sa readBinary(ClusterGraph &C, Graph &G, std::istream &is)
+	 *
+	 * @param C   is the clustered graph to be written.
+	 * @param os  is the output stream to which the clustered graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const ClusterGraph& C, std::ostream& os);
+
+	//! Reads clustered graph (\p C, \p G) with attributes \p A in binary format from input stream \p is.
+	/**
+	 * Only the attributes enabled in \p A are assigned, further attributes in the file are skipped.
+	 *
+	 * \pre \p C is the clustered graph associated with attributes \p A, and \p G is the graph associated with \p C.
+	 * \sa writeBinary(const ClusterGraphAttributes &A, std::ostream &os)
+	 *
+	 * @param A   is assigned the graph's attributes.
+	 * @param C   is assigned the read clustered graph (cluster structure).
+	 * @param G   is assigned the read clustered graph (graph structure).
+	 * @param is  is the input stream to be read.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(ClusterGraphAttributes& A, ClusterGraph& C, Graph& G,
+			std::istream& is);
+
+	//! Writes graph with attributes \p A in binary format to output stream \p os.
+	/**
+	 * \sa readBinary(ClusterGraphAttributes &A, ClusterGraph &C, Graph &G, std::istream &is)
+	 *
+	 * @param A   specifies the clustered graph and its attributes to be written.
+	 * @param os  is the output stream to which the clustered graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const ClusterGraphAttributes& A, std::ostream& os);
+
+	//! Reads graph \p G with attributes \p A in binary format from input stream \p is.
+	/**
+	 * Only the attributes enabled in \p A are assigned, further attributes in the file are skipped.
+	 *
+	 * \pre \p G is the graph associated with attributes \p A.
+	 * \sa writeBinary(const GraphAttributes &A, std::ostream &os)
+	 *
+	 * @param A   is assigned the graph's attributes.
+	 * @param G   is assigned the read graph.
+	 * @param is  is the input stream to be read.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool readBinary(GraphAttributes& A, Graph& G, std::istream& is);
+
+	//! Writes graph with attributes \p A in binary format to output stream \p os.
+	/**
+	 * \sa readBinary(GraphAttributes &A, Graph &G, std::istream &is)
+	 *
+	 * @param A   specifies the graph and its attributes to be written.
+	 * @param os  is the output stream to which the graph will be written.
+	 * @return true if successful, false otherwise.
+	 */
+	static OGDF_EXPORT bool writeBinary(const GraphAttributes& A, std::ostream& os);
+
 	//! @}
 
 #pragma mark Rudy
@@ -1043,6 +1200,9 @@ public:
 
 	//! Reads graph \p G in GraphML format from input stream \p is.
 	/**
+	 * The input is parsed incrementally and the nodes and edges are created while reading,
+	 * so the document is never held in memory as a whole. Nested graphs are flattened.
+	 *
 	 * \sa writeGraphML(const Graph &G, std::ostream &os)
 	 *
 	 * @param G   is assigned the read graph.
@@ -1065,6 +1225,9 @@ public:
 
 	//! Reads graph \p G with attributes \p A in GraphML format from input stream \p is.
 	/**
+	 * The input is parsed incrementally and the nodes and edges are created while reading,
+	 * so the document is never held in memory as a whole. Nested graphs are flattened.
+	 *
 	 * \pre \p G is the graph associated with attributes \p A.
 	 * \sa writeGraphML(const GraphAttributes &A, std::ostream &os)
 	 *
@@ -1231,6 +1394,9 @@ public:
 
 	//! Reads graph \p G in GEXF format from input stream \p is.
 	/**
+	 * The input is parsed incrementally and the nodes and edges are created while reading,
+	 * so the document is never held in memory as a whole.
+	 *
 	 * \sa writeGEXF(const Graph &G, std::ostream &os)
 	 *
 	 * @param G   is assigned the read graph.
@@ -1253,6 +1419,9 @@ public:
 
 	//! Reads graph \p G with attributes \p A in GEXF format from input stream \p is.
 	/**
+	 * The input is parsed incrementally and the nodes and edges are created while reading,
+	 * so the document is never held in memory as a whole.
+	 *
 	 * \pre \p G is the graph associated with attributes \p A.
 	 * \sa writeGEXF(const GraphAttributes &A, std::ostream &os)
 	 *
@@ -40,13 +40,18 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ogdf {
 class ClusterGraphAttributes;
 class GraphAttributes;
+class XmlStreamReader;
 
 class GraphMLParser {
 private:
+	std::istream* m_in; // Input still to be read in streaming mode, nullptr otherwise.
+
 	pugi::xml_document m_xml;
 	pugi::xml_node m_graphTag; // "Almost root" tag.
 
@@ -56,15 +61,26 @@ private:
 	// Maps attribute id to its name.
 	std::unordered_map<string, string> m_attrName;
 
-	bool readData(GraphAttributes& GA, const node& v, const pugi::xml_node nodeData);
-	bool readData(GraphAttributes& GA, const edge& e, const pugi::xml_node edgeData);
-	bool readData(ClusterGraphAttributes& CA, const cluster& c, const pugi::xml_node clusterData);
+	// Edges whose endpoints have not been read yet (streaming mode only).
+	struct PendingEdge {
+		string source, target;
+		std::vector<std::pair<string, string>> data; // Pairs of key and text.
+	};
+	std::vector<PendingEdge> m_pendingEdges;
+
+	// Sets the attribute with key id \p keyId (nullptr if missing) of an element to \p text.
+	bool readData(GraphAttributes& GA, const node& v, const char* keyId, const char* text);
+	bool readData(GraphAttributes& GA, const edge& e, const char* keyId, const char* text);
+	bool readData(ClusterGraphAttributes& CA, const cluster& c, const char* keyId,
+			const char* text);
 
 	// Finds all data-keys for given element and calls appropiate "readData".
 	template<typename A, typename T>
 	bool readAttributes(A& GA, const T& elem, const pugi::xml_node xmlElem) {
 		for (pugi::xml_node dataTag : xmlElem.children("data")) {
-			const bool result = readData(GA, elem, dataTag);
+			pugi::xml_attribute keyId = dataTag.attribute("key");
+			const bool result =
+					readData(GA, elem, keyId ? keyId.value() : nullptr, dataTag.text().get());
 			if (!result) {
 				return false;
 			}
@@ -78,10 +94,31 @@ private:
 	bool readClusters(Graph& G, ClusterGraph& C, ClusterGraphAttributes* CA,
 			const cluster& rootCluster, const pugi::xml_node clusterRoot);
 
+	// Loads the document and reads the key definitions.
+	void loadDocument(std::istream& in);
+
+	// Reads the document from m_in, creating nodes and edges as they appear.
+	bool readStreaming(Graph& G, GraphAttributes* GA);
+	bool readGraph(XmlStreamReader& xml, Graph& G, GraphAttributes* GA);
+	bool readNode(XmlStreamReader& xml, Graph& G, GraphAttributes* GA);
+	bool readEdge(XmlStreamReader& xml, Graph& G, GraphAttributes* GA);
+	bool readPendingEdges(Graph& G, GraphAttributes* GA);
+
 	bool m_error;
 
 public:
-	explicit GraphMLParser(std::istream& in);
+	//! Creates a parser reading from \p in.
+	/**
+	 * By default, the whole document is loaded into a pugixml document first.
+	 *
+	 * If \p streaming is true, reading a Graph (with or without GraphAttributes) instead
+	 * parses the input incrementally and creates each node and edge as soon as it has been
+	 * read, so the memory required by the parser does not depend on the size of the document.
+	 * Nested graphs are flattened in this case. Clustered graphs are still read via the
+	 * document tree. In streaming mode, only one of the read methods may be called and \p in
+	 * must stay valid until it returns.
+	 */
+	explicit GraphMLParser(std::istream& in, bool streaming = false);
 	~GraphMLParser();
 
 	bool read(Graph& G);
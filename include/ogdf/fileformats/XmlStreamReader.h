@@ -0,0 +1,237 @@
+/** \file
+ * \brief Declaration of an incremental pull parser for XML documents.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/internal/copy_move.h>
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ogdf {
+
+//! Incremental pull parser for XML documents.
+/**
+ * In contrast to pugixml, which builds the whole document tree in memory, the reader only
+ * keeps the current token, the names of the open elements and a window of the input stream
+ * whose size does not depend on the size of the document. This allows readers of XML based
+ * graph formats to create the graph while the document is being read.
+ *
+ * The reader supports the subset of XML used by graph exchange formats: elements with
+ * attributes, character data and CDATA sections. Comments, processing instructions and the
+ * document type declaration are skipped. The predefined entities and character references
+ * are decoded, other entity references are kept as they are. Like pugixml, line breaks in
+ * character data are normalized to \c '\\n' and whitespace in attribute values to spaces.
+ */
+class OGDF_EXPORT XmlStreamReader {
+public:
+	//! The kinds of tokens returned by next().
+	enum class Token {
+		StartElement, //!< a start tag or an empty-element tag
+		EndElement, //!< an end tag, also reported after an empty-element tag
+		Text, //!< character data or a CDATA section within the document element
+		EndOfDocument, //!< the end of the input after the document element
+		Error //!< the input is not well-formed, see error()
+	};
+
+	//! An attribute of the current start element.
+	/**
+	 * The interface mirrors the one of pugi::xml_attribute so that attribute handlers can be
+	 * shared by readers working on a pugixml document and readers working on the stream.
+	 * The attribute is only valid until the next call of next().
+	 */
+	class Attribute {
+		const string* m_value;
+
+	public:
+		explicit Attribute(const string* value = nullptr) : m_value(value) { }
+
+		//! Returns whether the attribute exists.
+		explicit operator bool() const { return m_value != nullptr; }
+
+		//! Returns the value of the attribute or the empty string if it does not exist.
+		const char* value() const { return m_value ? m_value->c_str() : ""; }
+
+		const char* as_string() const { return value(); }
+
+		int as_int(int def = 0) const { return m_value ? toInt(m_value->c_str()) : def; }
+
+		double as_double(double def = 0) const {
+			return m_value ? toDouble(m_value->c_str()) : def;
+		}
+
+		float as_float(float def = 0) const {
+			return m_value ? static_cast<float>(toDouble(m_value->c_str())) : def;
+		}
+	};
+
+	//! Creates a reader for \p is that reads the input in chunks of \p chunkSize bytes.
+	explicit XmlStreamReader(std::istream& is, size_t chunkSize = 1 << 16);
+
+	OGDF_NO_COPY(XmlStreamReader)
+
+	//! Reads the next token.
+	/**
+	 * Once Token::EndOfDocument or Token::Error has been returned, all further calls
+	 * return the same token.
+	 */
+	Token next();
+
+	//! Skips the contents of the current element, including its end tag.
+	/**
+	 * \pre The last token returned by next() is Token::StartElement.
+	 * @return false if the input is not well-formed.
+	 */
+	bool skipElement();
+
+	//! Reads the text of the current element and skips to its end tag (inclusive).
+	/**
+	 * Like pugi::xml_node::text(), the text is the first CDATA section or character data
+	 * that is a direct child of the element and does not consist of whitespace only.
+	 * \p text is empty if there is no such child.
+	 *
+	 * \pre The last token returned by next() is Token::StartElement.
+	 * @return false if the input is not well-formed.
+	 */
+	bool readText(string& text);
+
+	//! Calls \p handleChild for each child element of the current element.
+	/**
+	 * \p handleChild is called after the start tag of a child has been read and has to
+	 * consume the child, e.g. by calling skipElement(). Reading stops as soon as it returns
+	 * false. Text in between the children is ignored.
+	 *
+	 * \pre The last token returned by next() is Token::StartElement.
+	 * @return false if \p handleChild returned false or the input is not well-formed.
+	 */
+	template<typename F>
+	bool forEachChild(F&& handleChild) {
+		for (;;) {
+			switch (next()) {
+			case Token::StartElement:
+				if (!handleChild()) {
+					return false;
+				}
+				break;
+			case Token::EndElement:
+				return true;
+			case Token::Text:
+				break;
+			default:
+				return false;
+			}
+		}
+	}
+
+	//! Returns the name of the current element (for start and end elements).
+	const char* name() const { return m_name.c_str(); }
+
+	//! Returns the attribute \p attrName of the current start element.
+	Attribute attribute(const char* attrName) const;
+
+	//! Returns the current character data (for text tokens).
+	const string& text() const { return m_text; }
+
+	//! Returns whether the current text token is a CDATA section.
+	bool isCData() const { return m_cdata; }
+
+	//! Returns the number of currently open elements.
+	int depth() const { return static_cast<int>(m_openElements.size()); }
+
+	//! Returns the line the reader is currently at (starting with 1).
+	int line() const { return m_line; }
+
+	//! Returns a description of the error after Token::Error has been returned.
+	const string& error() const { return m_error; }
+
+	//! Converts \p s to an integer like pugixml does (0 if it is not a number).
+	static int toInt(const char* s);
+
+	//! Converts \p s to a floating-point number like pugixml does (0 if it is not a number).
+	static double toDouble(const char* s);
+
+private:
+	std::istream& m_is;
+	const size_t m_chunkSize;
+
+	string m_buffer; //!< the window of the input that has been read but not consumed
+	size_t m_pos = 0; //!< the position of the next character in #m_buffer
+	bool m_eof = false; //!< whether the whole input has been read into #m_buffer
+	int m_line = 1;
+
+	string m_name;
+	string m_text;
+	bool m_cdata = false;
+	std::vector<std::pair<string, string>> m_attributes; //!< reused, see #m_numAttributes
+	size_t m_numAttributes = 0;
+	std::vector<string> m_openElements;
+	bool m_closeEmptyElement = false; //!< whether the last start tag was an empty-element tag
+	bool m_seenDocumentElement = false;
+	bool m_done = false;
+	string m_error;
+
+	//! Ensures that at least \p n characters are buffered unless the input ends before.
+	bool fill(size_t n);
+
+	//! Returns the next character or -1 at the end of the input.
+	int peek() {
+		return m_pos < m_buffer.size() || fill(1)
+				? static_cast<unsigned char>(m_buffer[m_pos])
+				: -1;
+	}
+
+	bool startsWith(const char* prefix, size_t length);
+
+	void skipWhitespace();
+
+	void readName(string& name);
+
+	//! Reads character data up to \p quote (or the next tag if \p quote is 0) into \p out.
+	bool readCharData(string& out, char quote);
+
+	//! Decodes the entity or character reference at the current position.
+	void readReference(string& out);
+
+	//! Consumes the input up to and including \p delim, appending the skipped part to \p out.
+	bool skipPast(const char* delim, string* out = nullptr);
+
+	bool skipDoctype();
+
+	Token readStartTag();
+
+	Token readEndTag();
+
+	Token fail(const string& msg);
+};
+
+}
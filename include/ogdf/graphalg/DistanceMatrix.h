@@ -0,0 +1,117 @@
+/** \file
+ * \brief Declaration of ogdf::DistanceMatrix, a contiguous
+ *        matrix of the distances between all pairs of nodes.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/basic.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace ogdf {
+
+//! Row-major matrix storing a value for each ordered pair of nodes in one contiguous block.
+/**
+ * @ingroup ga-sp
+ *
+ * In contrast to NodeArray<NodeArray<T>>, which allocates a separate array for each row,
+ * all entries are stored in a single array of size (<i>N</i> + 1)<sup>2</sup>, where <i>N</i>
+ * is the largest node index of the associated graph. Rows and columns are indexed by
+ * node->index(), so the row of a node is a plain array that can be indexed by the indices
+ * returned by CompactGraph.
+ *
+ * The entry type may be smaller than the cost type of the graph to reduce the memory
+ * footprint, e.g., \c float instead of \c double for weighted distances or \c uint16_t for
+ * hop counts. Unreachable pairs are marked by unreachable().
+ *
+ * The matrix does not observe the graph: adding nodes after initialization invalidates it.
+ */
+template<typename T>
+class DistanceMatrix {
+public:
+	//! Creates a matrix that is not associated with a graph.
+	DistanceMatrix() : m_pGraph(nullptr), m_dimension(0) { }
+
+	//! Creates a matrix for the nodes of \p G with all entries set to \p x.
+	explicit DistanceMatrix(const Graph& G, T x = unreachable()) { init(G, x); }
+
+	//! Associates the matrix with \p G and sets all entries to \p x.
+	void init(const Graph& G, T x = unreachable()) {
+		m_pGraph = &G;
+		m_dimension = static_cast<size_t>(G.maxNodeIndex() + 1);
+		m_entries.assign(m_dimension * m_dimension, x);
+	}
+
+	//! Sets all entries to \p x.
+	void fill(T x) { std::fill(m_entries.begin(), m_entries.end(), x); }
+
+	//! Returns the associated graph.
+	const Graph* graphOf() const { return m_pGraph; }
+
+	//! Returns the number of rows (and columns), i.e., the largest node index plus one.
+	int dimension() const { return static_cast<int>(m_dimension); }
+
+	//! Returns the row of the node with index \p v.
+	T* row(int v) { return &m_entries[v * m_dimension]; }
+
+	//! Returns the row of the node with index \p v.
+	const T* row(int v) const { return &m_entries[v * m_dimension]; }
+
+	//! Returns the row of \p v.
+	T* row(node v) { return row(v->index()); }
+
+	//! Returns the row of \p v.
+	const T* row(node v) const { return row(v->index()); }
+
+	//! Returns the entry of the nodes with indices \p v and \p w.
+	T& operator()(int v, int w) { return m_entries[v * m_dimension + w]; }
+
+	//! Returns the entry of the nodes with indices \p v and \p w.
+	const T& operator()(int v, int w) const { return m_entries[v * m_dimension + w]; }
+
+	//! Returns the entry of \p v and \p w.
+	T& operator()(node v, node w) { return (*this)(v->index(), w->index()); }
+
+	//! Returns the entry of \p v and \p w.
+	const T& operator()(node v, node w) const { return (*this)(v->index(), w->index()); }
+
+	//! Returns the value marking pairs of nodes that are not connected.
+	static constexpr T unreachable() { return std::numeric_limits<T>::max(); }
+
+private:
+	const Graph* m_pGraph; //!< The associated graph.
+	size_t m_dimension; //!< The number of rows and columns.
+	std::vector<T> m_entries; //!< The entries in row-major order.
+};
+
+}
@@ -34,6 +34,7 @@
 #include <ogdf/basic/Graph.h>
 
 namespace ogdf {
+class CompactGraph;
 
 //! Basic page rank calculation.
 /**
@@ -47,6 +48,15 @@ public:
 	void call(const Graph& graph, const EdgeArray<double>& edgeWeight,
 			NodeArray<double>& pageRankResult);
 
+	//! main algorithm call on a CSR snapshot of the graph
+	/**
+	 * Computes the same result as call(const Graph&, const EdgeArray<double>&, NodeArray<double>&)
+	 * but iterates over the contiguous adjacency arrays of \p graph.
+	 * \p edgeWeight and \p pageRankResult belong to graph.constGraph().
+	 */
+	void call(const CompactGraph& graph, const EdgeArray<double>& edgeWeight,
+			NodeArray<double>& pageRankResult);
+
 	//! sets the default options.
 	void initDefaultOptions() {
 		m_dampingFactor = 0.85;
@@ -31,12 +31,25 @@
 
 #pragma once
 
+#include <ogdf/basic/Array.h>
+#include <ogdf/basic/CompactGraph.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/Math.h>
 #include <ogdf/basic/SList.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/graphalg/Dijkstra.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
 
 namespace ogdf {
 
@@ -81,6 +94,51 @@ void bfs_SPSS(node s, const Graph& G, NodeArray<TCost>& distanceArray, TCost edg
 	}
 }
 
+//! Computes all-pairs shortest paths in the snapshot \p G using breadth-first search (BFS).
+/**
+ * @ingroup ga-sp
+ *
+ * Behaves like bfs_SPAP(const Graph&, NodeArray<NodeArray<TCost>>&, TCost) but traverses
+ * the contiguous adjacency arrays of \p G. \p distance is indexed by the nodes of
+ * G.constGraph().
+ */
+template<typename TCost>
+void bfs_SPAP(const CompactGraph& G, NodeArray<NodeArray<TCost>>& distance, TCost edgeCosts) {
+	for (int v : G.nodes()) {
+		bfs_SPSS(G.original(v), G, distance[v], edgeCosts);
+	}
+}
+
+//! Computes single-source shortest paths from \p s in the snapshot \p G using breadth-first search (BFS).
+/**
+ * @ingroup ga-sp
+ *
+ * Behaves like bfs_SPSS(node, const Graph&, NodeArray<TCost>&, TCost) but traverses
+ * the contiguous adjacency arrays of \p G. \p s and \p distanceArray belong to G.constGraph().
+ */
+template<typename TCost>
+void bfs_SPSS(node s, const CompactGraph& G, NodeArray<TCost>& distanceArray, TCost edgeCosts) {
+	std::vector<bool> mark(G.maxNodeIndex() + 1, false);
+	// the queue never holds more than n nodes, so a plain vector with a head index suffices
+	std::vector<int> bfs;
+	bfs.reserve(G.numberOfNodes());
+	bfs.push_back(s->index());
+	mark[s->index()] = true;
+	distanceArray[s] = TCost(0);
+	for (size_t head = 0; head < bfs.size(); ++head) {
+		int w = bfs[head];
+		TCost d = distanceArray[w] + edgeCosts;
+		for (int i = G.firstAdj(w); i < G.stopAdj(w); ++i) {
+			int v = G.twinNode(i);
+			if (!mark[v]) {
+				mark[v] = true;
+				bfs.push_back(v);
+				distanceArray[v] = d;
+			}
+		}
+	}
+}
+
 //! Computes all-pairs shortest paths in \p GA using %Dijkstra's algorithm.
 /**
  * @ingroup ga-sp
@@ -132,6 +190,176 @@ void dijkstra_SPSS(node s, const Graph& G, NodeArray<TCost>& shortestPathMatrix,
 	sssp.call(G, edgeCosts, s, predecessor, shortestPathMatrix);
 }
 
+//! Computes all-pairs shortest paths in the snapshot \p G using %Dijkstra's algorithm.
+/**
+ * @ingroup ga-sp
+ *
+ * Behaves like dijkstra_SPAP(const Graph&, NodeArray<NodeArray<TCost>>&, const EdgeArray<TCost>&)
+ * but traverses the contiguous adjacency arrays of \p G. \p shortestPathMatrix and
+ * \p edgeCosts belong to G.constGraph().
+ */
+template<typename TCost>
+void dijkstra_SPAP(const CompactGraph& G, NodeArray<NodeArray<TCost>>& shortestPathMatrix,
+		const EdgeArray<TCost>& edgeCosts) {
+	for (int v : G.nodes()) {
+		dijkstra_SPSS(G.original(v), G, shortestPathMatrix[v], edgeCosts);
+	}
+}
+
+//! Computes single-source shortest paths from node \p s in the snapshot \p G using %Dijkstra's algorithm.
+/**
+ * @ingroup ga-sp
+ *
+ * Distances of unreachable nodes are set to std::numeric_limits<TCost>::max(), just like
+ * dijkstra_SPSS(node, const Graph&, NodeArray<TCost>&, const EdgeArray<TCost>&) does.
+ * Uses a binary heap with lazy deletion on node indices instead of an addressable heap.
+ */
+template<typename TCost>
+void dijkstra_SPSS(node s, const CompactGraph& G, NodeArray<TCost>& shortestPathMatrix,
+		const EdgeArray<TCost>& edgeCosts) {
+	using Entry = std::pair<TCost, int>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+	std::vector<bool> done(G.maxNodeIndex() + 1, false);
+
+	shortestPathMatrix.init(G.constGraph(), std::numeric_limits<TCost>::max());
+	shortestPathMatrix[s] = TCost(0);
+	queue.emplace(TCost(0), s->index());
+
+	while (!queue.empty()) {
+		Entry top = queue.top();
+		queue.pop();
+		int v = top.second;
+		if (done[v]) {
+			continue;
+		}
+		done[v] = true;
+		for (int i = G.firstAdj(v); i < G.stopAdj(v); ++i) {
+			int w = G.twinNode(i);
+			TCost dist = top.first + edgeCosts[G.edgeIndex(i)];
+			if (!done[w] && dist < shortestPathMatrix[w]) {
+				shortestPathMatrix[w] = dist;
+				queue.emplace(dist, w);
+			}
+		}
+	}
+}
+
+namespace internal {
+
+//! Runs a single-source search from each node of \p G using up to \p numberOfThreads threads.
+/**
+ * Each thread creates its own search by calling \p makeSearch and then calls it with the
+ * indices of the sources it takes from a shared counter, so all buffers of a search are
+ * reused for all sources of that thread. The calling thread takes part in the work.
+ */
+template<typename MakeSearch>
+void forEachSourceInParallel(const CompactGraph& G, unsigned int numberOfThreads,
+		const MakeSearch& makeSearch) {
+	const std::vector<int>& sources = G.nodes();
+	std::atomic<size_t> next(0);
+	std::function<void()> worker = [&] {
+		auto search = makeSearch();
+		for (size_t i = next++; i < sources.size(); i = next++) {
+			search(sources[i]);
+		}
+	};
+
+	const int numberOfHelpers =
+			static_cast<int>(std::min<size_t>(std::max(numberOfThreads, 1u), sources.size())) - 1;
+	Array<Thread> threads(max(numberOfHelpers, 0));
+	for (Thread& thread : threads) {
+		thread = Thread(worker);
+	}
+	worker();
+	for (Thread& thread : threads) {
+		thread.join();
+	}
+}
+
+}
+
+//! Computes all-pairs shortest paths in the snapshot \p G using breadth-first search (BFS) in parallel.
+/**
+ * @ingroup ga-sp
+ *
+ * The single-source searches are distributed over up to \p numberOfThreads threads. The
+ * result is stored in \p distance, which is initialized for G.constGraph(). Unreachable pairs
+ * are set to DistanceMatrix<TCost>::unreachable(). All other distances (i.e. \p edgeCosts
+ * times the number of edges of a shortest path) have to be smaller than that, which matters
+ * for compressed entry types like \c uint16_t.
+ */
+template<typename TCost>
+void bfs_SPAP(const CompactGraph& G, DistanceMatrix<TCost>& distance, TCost edgeCosts,
+		unsigned int numberOfThreads = 1) {
+	distance.init(G.constGraph());
+	internal::forEachSourceInParallel(G, numberOfThreads, [&] {
+		// each thread reuses its queue; unreached nodes are recognized by their distance
+		return [&, bfs = std::vector<int>()](int s) mutable {
+			TCost* row = distance.row(s);
+			bfs.clear();
+			bfs.push_back(s);
+			row[s] = TCost(0);
+			for (size_t head = 0; head < bfs.size(); ++head) {
+				int w = bfs[head];
+				TCost d = static_cast<TCost>(row[w] + edgeCosts);
+				for (int i = G.firstAdj(w); i < G.stopAdj(w); ++i) {
+					int v = G.twinNode(i);
+					if (row[v] == DistanceMatrix<TCost>::unreachable()) {
+						bfs.push_back(v);
+						row[v] = d;
+					}
+				}
+			}
+		};
+	});
+}
+
+//! Computes all-pairs shortest paths in the snapshot \p G using %Dijkstra's algorithm in parallel.
+/**
+ * @ingroup ga-sp
+ *
+ * The single-source searches are distributed over up to \p numberOfThreads threads. The
+ * result is stored in \p distance, which is initialized for G.constGraph(). Unreachable pairs
+ * are set to DistanceMatrix<TCost>::unreachable(). \p edgeCosts belongs to G.constGraph()
+ * and must be non-negative.
+ */
+template<typename TCost>
+void dijkstra_SPAP(const CompactGraph& G, DistanceMatrix<TCost>& distance,
+		const EdgeArray<TCost>& edgeCosts, unsigned int numberOfThreads = 1) {
+	distance.init(G.constGraph());
+	internal::forEachSourceInParallel(G, numberOfThreads, [&] {
+		using Entry = std::pair<TCost, int>;
+		// each thread reuses its heap storage and marks
+		return [&, heap = std::vector<Entry>(), done = std::vector<bool>()](int s) mutable {
+			const auto greater = std::greater<Entry>();
+			TCost* row = distance.row(s);
+			done.assign(G.maxNodeIndex() + 1, false);
+			row[s] = TCost(0);
+			heap.emplace_back(TCost(0), s);
+
+			while (!heap.empty()) {
+				std::pop_heap(heap.begin(), heap.end(), greater);
+				Entry top = heap.back();
+				heap.pop_back();
+				int v = top.second;
+				if (done[v]) {
+					continue;
+				}
+				done[v] = true;
+				for (int i = G.firstAdj(v); i < G.stopAdj(v); ++i) {
+					int w = G.twinNode(i);
+					TCost dist = top.first + edgeCosts[G.edgeIndex(i)];
+					if (!done[w] && dist < row[w]) {
+						row[w] = dist;
+						heap.emplace_back(dist, w);
+						std::push_heap(heap.begin(), heap.end(), greater);
+					}
+				}
+			}
+		};
+	});
+}
+
 //! Computes all-pairs shortest paths in graph \p G using Floyd-Warshall's algorithm.
 /**
  * @ingroup ga-sp
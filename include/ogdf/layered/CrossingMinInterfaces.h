@@ -93,7 +93,51 @@ public:
 	int calculateCrossings(int i) const;
 
 	//! Computes the total number of crossings.
+	/**
+	 * The pairs of adjacent levels are counted on up to maxThreads() threads.
+	 */
 	int calculateCrossings() const;
+
+	//! Returns the total number of crossings, only the level pairs changed since the last call are counted.
+	/**
+	 * The number of crossings between each pair of adjacent levels is cached. The pairs
+	 * that involve a level marked by levelChanged() are counted again on up to maxThreads()
+	 * threads, so after a layer-by-layer sweep that changed few levels only these are counted.
+	 */
+	int updateCrossings();
+
+	//! Marks the order of level \p i as changed for updateCrossings().
+	/**
+	 * Implementations must call this whenever they change the positions of nodes on level \p i.
+	 */
+	void levelChanged(int i) {
+		if (i > 0 && i <= m_pairChanged.size()) {
+			m_pairChanged[i - 1] = true;
+		}
+		if (i < m_pairChanged.size()) {
+			m_pairChanged[i] = true;
+		}
+	}
+
+	//! Discards all cached crossing numbers, e.g., if the levels have been rebuilt.
+	void invalidateCrossings() { m_pairChanged.init(); }
+
+	//! Returns the maximal number of threads used for counting crossings.
+	unsigned int maxThreads() const { return m_maxThreads; }
+
+	//! Sets the maximal number of threads used for counting crossings to \p n.
+	void maxThreads(unsigned int n) {
+		OGDF_ASSERT(n >= 1);
+		m_maxThreads = n;
+	}
+
+private:
+	//! Stores the crossings between level \p i and \p i+1 in \p crossings[\p i] for all \p pairs.
+	void calculateCrossings(const Array<int>& pairs, Array<int>& crossings) const;
+
+	Array<int> m_pairCrossings; //!< The cached crossings between level i and i+1.
+	Array<bool> m_pairChanged; //!< Whether the cached crossings of a pair are outdated.
+	unsigned int m_maxThreads = 1; //!< The maximal number of threads for counting crossings.
 };
 
 }
@@ -32,14 +32,12 @@
 
 #pragma once
 
-#include <ogdf/basic/Graph.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/layered/CrossingMinInterfaces.h>
 #include <ogdf/layered/HierarchyLayoutModule.h>
 
 namespace ogdf {
 class GraphAttributes;
-class GraphCopy;
 
 /**
  * \brief Coordinate assignment phase for the Sugiyama algorithm by Ulrik Brandes and Boris Köpf
@@ -58,6 +56,10 @@ class GraphCopy;
  * The <i>Alignment</i> and <i>Horzontal Compactation</i> phase are calculated downward, upward,
  * left-to-right and right-to-left. The four resulting layouts are combined in a balancing step.
  *
+ * The levels are copied into contiguous arrays of node positions and neighbours once. The four
+ * layouts only read these arrays and each has its own scratch arrays, so they are computed on
+ * separate threads for large hierarchies if the hardware supports it.
+ *
  * The implementation is based on:
  *
  * Ulrik Brandes, Boris Köpf: <i>Fast and Simple Horizontal Coordinate Assignment</i>.
@@ -145,99 +147,6 @@ public:
 
 	//! Sets the option <i>balanced</i> to \p b.
 	void balanced(bool b) { m_balanced = b; }
-
-
-private:
-	/**
-	 * Preprocessing step to find all type1 conflicts.
-	 * A type1 conflict is a crossing of a inner segment with a non-inner segment.
-	 *
-	 * This is for preferring straight inner segments.
-	 *
-	 * @param levels The Hierarchy
-	 * @param downward The level direction
-	 * @param type1Conflicts is assigned the conflicts, (type1Conflicts[v])[u]=true means (u,v) is marked, u is the upper node
-	 */
-	void markType1Conflicts(const HierarchyLevelsBase& levels, bool downward,
-			NodeArray<NodeArray<bool>>& type1Conflicts);
-
-	/**
-	 * Align each node to a node on the next higher level. The result is a blockgraph where each
-	 * node is in a block whith a nother node when they have the same root.
-	 *
-	 * @param levels The Hierarchy
-	 * @param root The root for each node (calculated by this method)
-	 * @param align The alignment to the next level node (align(v)=u <=> u is aligned to v) (calculated by this method)
-	 * @param type1Conflicts Type1 conflicts to prefer straight inner segments
-	 * @param downward The level direction
-	 * @param leftToRight The node direction on each level
-	 */
-	void verticalAlignment(const HierarchyLevelsBase& levels, NodeArray<node>& root,
-			NodeArray<node>& align, const NodeArray<NodeArray<bool>>& type1Conflicts,
-			const bool downward, const bool leftToRight);
-
-	/**
-	 * Computes the width of each block, i.e., the maximal width of a node in the block, and
-	 * stores it in blockWidth for the root of the block.
-	 *
-	 * @param GC The input graph copy
-	 * @param GCA The input graph copies (gives in particular the widths of nodes)
-	 * @param root The root for each node (calculated by this method)
-	 * @param blockWidth Is assigned the width of each block (stored for the root)
-	 */
-	void computeBlockWidths(const GraphCopy& GC, const GraphAttributes& GCA, NodeArray<node>& root,
-			NodeArray<double>& blockWidth);
-
-	/**
-	 * Calculate the coordinates for each node
-	 *
-	 * @param align The alignment to the next level node (align(v)=u <=> u is aligned to v)
-	 * @param levels The Hierarchy
-	 * @param root The root for each node
-	 * @param blockWidth The width of each block
-	 * @param x The x-coordinates for each node (calculated by this method)
-	 * @param leftToRight The node direction on each level
-	 * @param downward The level direction
-	 */
-	void horizontalCompactation(const NodeArray<node>& align, const HierarchyLevelsBase& levels,
-			const NodeArray<node>& root, const NodeArray<double>& blockWidth, NodeArray<double>& x,
-			const bool leftToRight, bool downward);
-
-	/**
-	 * Calculate the coordinate for root nodes (placing)
-	 *
-	 * @param v The root node to place
-	 * @param sink The Sink for each node. A sink identifies each block class (calculated by this method)
-	 * @param shift The shift for each class (calculated by this method)
-	 * @param x The class relative x-coordinate for each node (calculated by this method)
-	 * @param align The alignment to the next level node (align(v)=u <=> u is aligned to v)
-	 * @param levels The Hierarchy
-	 * @param blockWidth The width of each block
-	 * @param root The root for each node
-	 * @param leftToRight The node direction on each level
-	 */
-	void placeBlock(node v, NodeArray<node>& sink, NodeArray<double>& shift, NodeArray<double>& x,
-			const NodeArray<node>& align, const HierarchyLevelsBase& levels,
-			const NodeArray<double>& blockWidth, const NodeArray<node>& root, const bool leftToRight);
-
-	/**
-	 * The twin of an inner Segment
-	 *
-	 * @return Parent node which is connected by an inner segment.
-	 * nullptr if there is no parent segment or if the segment is not an inner segment.
-	 */
-	node virtualTwinNode(const HierarchyLevelsBase& levels, const node v,
-			const HierarchyLevelsBase::TraversingDir dir) const;
-
-	/**
-	 * Predecessor of v on the same level,
-	 *
-	 * @param v The node for which the predecessor should be calculated.
-	 * @param levels The Hierarchy
-	 * @param leftToRight If true the left predecessor is choosen. Otherwise the right predecessor.
-	 * @return Predescessor on the same level. nullptr if there is no predecessor.
-	 */
-	node pred(const node v, const HierarchyLevelsBase& levels, const bool leftToRight);
 };
 
 }
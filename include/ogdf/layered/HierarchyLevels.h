@@ -40,10 +40,40 @@
 
 #include <cstdint>
 #include <iosfwd>
+#include <vector>
 
 namespace ogdf {
 class Hierarchy;
 
+//! The positions of the adjacent nodes of all nodes on a level in compressed sparse row format.
+/**
+ * Each node of the level has a row with the sorted positions of its adjacent nodes, and all
+ * rows are stored consecutively in one array. Two-layer heuristics read these positions
+ * directly instead of looking up an adjacency array and the position of each adjacent node.
+ *
+ * The rows keep their place in the array when the level is reordered, only the row of each
+ * position is updated.
+ *
+ * \see HierarchyLevels::adjPositions()
+ */
+class OGDF_EXPORT LevelAdjacency {
+	friend class HierarchyLevels;
+
+	std::vector<int> m_row; //!< The row of the node at each position.
+	std::vector<int> m_start; //!< The first index of each row in m_adjPos, and its size.
+	std::vector<int> m_adjPos; //!< The positions of the adjacent nodes, row by row.
+
+public:
+	//! Returns the number of nodes adjacent to the node at position \p j.
+	int degree(int j) const { return m_start[m_row[j] + 1] - m_start[m_row[j]]; }
+
+	//! Returns a pointer to the first adjacent position of the node at position \p j.
+	const int* begin(int j) const { return m_adjPos.data() + m_start[m_row[j]]; }
+
+	//! Returns a pointer past the last adjacent position of the node at position \p j.
+	const int* end(int j) const { return m_adjPos.data() + m_start[m_row[j] + 1]; }
+};
+
 //! Representation of proper hierarchies used by Sugiyama-layout.
 /**
  * \see Level, SugiyamaLayout
@@ -64,6 +94,11 @@ private:
 
 	NodeArray<int> m_nSet; //!< (Only used by buildAdjNodes().)
 
+	NodeArray<int> m_row; //!< The row of a node in the adjacent positions of its level.
+	Array<LevelAdjacency> m_lowerAdjPos; //!< The positions of the adjacent nodes on the lower level.
+	Array<LevelAdjacency> m_upperAdjPos; //!< The positions of the adjacent nodes on the upper level.
+	Array<bool> m_swapped; //!< Whether a level has been reordered by Level::swap() since buildAdjNodes().
+
 	TraversingDir m_direction; //!< The current direction of layer-by-layer sweep.
 
 public:
@@ -97,6 +132,25 @@ public:
 		return (dir == TraversingDir::downward) ? m_lowerAdjNodes[v] : m_upperAdjNodes[v];
 	}
 
+	//! Returns the positions of the adjacent nodes of all nodes on level \p i in direction \p dir.
+	/**
+	 * The positions are filled by buildAdjNodes(). Since Level::swap() does not update them,
+	 * the adjacent level is rebuilt if it has been reordered by swaps.
+	 */
+	const LevelAdjacency& adjPositions(int i, TraversingDir dir) {
+		if (dir == TraversingDir::downward) {
+			if (i > 0 && m_swapped[i - 1]) {
+				buildAdjNodes(i - 1);
+			}
+			return m_lowerAdjPos[i];
+		} else {
+			if (i < high() && m_swapped[i + 1]) {
+				buildAdjNodes(i + 1);
+			}
+			return m_upperAdjPos[i];
+		}
+	}
+
 	//! Returns the adjacent level of level \p i (according to direction()).
 	const Level& adjLevel(int i) const {
 		return (m_direction == TraversingDir::downward) ? *m_pLevel[i - 1] : *m_pLevel[i + 1];
@@ -139,6 +193,9 @@ public:
 private:
 	int transposePart(const Array<node>& adjV, const Array<node>& adjW);
 
+	//! Exchanges the rows of the adjacent positions of the nodes at position \p i and \p j on level \p k.
+	void swapAdjPositions(int k, int i, int j);
+
 	OGDF_MALLOC_NEW_DELETE
 };
 
@@ -42,6 +42,7 @@
 namespace ogdf {
 
 class HierarchyLevels;
+class LevelAdjacency;
 template<class E1, class E2>
 class Tuple2;
 template<class E>
@@ -103,6 +104,9 @@ public:
 	//! Returns the (sorted) array of adjacent nodes of \p v (according to direction()).
 	const Array<node>& adjNodes(node v) const;
 
+	//! Returns the positions of the adjacent nodes of all nodes on this level (according to direction()).
+	const LevelAdjacency& adjPositions() const;
+
 	//! Returns the hierarchy to which this level belongs.
 	const HierarchyLevels& levels() const { return *m_pLevels; }
 
@@ -0,0 +1,157 @@
+/** \file
+ * \brief Declaration of the network simplex ranking algorithm for Sugiyama
+ *        algorithm.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#pragma once
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/layered/AcyclicSubgraphModule.h>
+#include <ogdf/layered/RankingModule.h>
+
+#include <memory>
+
+namespace ogdf {
+
+//! The network simplex ranking algorithm.
+/**
+ * @ingroup gd-ranking
+ *
+ * The class NetworkSimplexRanking computes a node ranking with minimal (weighted) total edge
+ * length like OptimalRanking, but solves the problem with the network simplex algorithm of
+ * Gansner et al. directly on the ranking instead of a general min-cost flow formulation:
+ *   - the ranking is given by a spanning tree of tight edges and each tree edge has a
+ *     cut value, which only changes on the cycle closed by the entering edge,
+ *   - the tree is threaded in preorder, so each exchange of tree edges only relinks the
+ *     path between the entering and the leaving edge and shifts the ranks of one subtree,
+ *   - the entering edge is chosen by block search and the leaving edge such that the tree
+ *     stays strongly feasible, which prevents cycling on degenerate exchanges.
+ *
+ * In contrast to Gansner et al., the cut values stay non-negative and the edges with
+ * negative slack enter the tree, starting from an artificial tree; this needs far fewer
+ * and cheaper exchanges than keeping the ranking feasible.
+ *
+ * All traversals are iterative, so long paths in the hierarchy cause no deep recursion.
+ *
+ * The implementation is based on:
+ *
+ * Emden R. Gansner, Eleftherios Koutsofios, Stephen C. North, Kiem-Phong Vo:
+ * <i>A Technique for Drawing Directed Graphs</i>.
+ * IEEE Transactions on Software Engineering 19(3), pp. 214-230, 1993.
+ *
+ * <H3>Optional parameters</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>separateMultiEdges</i><td>bool<td>true
+ *     <td>If set to true, multi-edges will span at least two layers.
+ *   </tr>
+ * </table>
+ *
+ * <H3>%Module options</H3>
+ *
+ * <table>
+ *   <tr>
+ *     <th><i>Option</i><th><i>Type</i><th><i>Default</i><th><i>Description</i>
+ *   </tr><tr>
+ *     <td><i>subgraph</i><td>AcyclicSubgraphModule<td>DfsAcyclicSubgraph
+ *     <td>The module for the computation of the acyclic subgraph.
+ *   </tr>
+ * </table>
+ */
+class OGDF_EXPORT NetworkSimplexRanking : public RankingModule {
+	std::unique_ptr<AcyclicSubgraphModule> m_subgraph; // option for acyclic sugraph
+	bool m_separateMultiEdges;
+
+public:
+	//! Creates an instance of network simplex ranking.
+	NetworkSimplexRanking();
+
+
+	/**
+	 *  @name Algorithm call
+	 *  @{
+	 */
+
+	//! Computes a node ranking of \p G in \p rank.
+	virtual void call(const Graph& G, NodeArray<int>& rank) override;
+
+	//! Computes a node ranking of \p G with given minimal edge length in \p rank.
+	/**
+	 * @param G is the input graph.
+	 * @param length specifies the minimal length of each edge.
+	 * @param rank is assigned the rank (layer) of each node.
+	 */
+	void call(const Graph& G, const EdgeArray<int>& length, NodeArray<int>& rank);
+
+	//! Computes a cost-minimal node ranking of \p G for given edge costs and minimal edge lengths in \p rank.
+	/**
+	 * @param G is the input graph.
+	 * @param length specifies the minimal length of each edge.
+	 * @param cost specifies the non-negative cost of each edge.
+	 * @param rank is assigned the rank (layer) of each node.
+	 */
+	virtual void call(const Graph& G, const EdgeArray<int>& length, const EdgeArray<int>& cost,
+			NodeArray<int>& rank) override;
+
+	/** @}
+	 *  @name Optional parameters
+	 *  @{
+	 */
+
+	//! Returns the current setting of option separateMultiEdges.
+	/**
+	 * If set to true, multi-edges will span at least two layers. Since
+	 * each such edge will have at least one dummy node, the edges will
+	 * automaticall be separated in a Sugiyama drawing.
+	 */
+	bool separateMultiEdges() const { return m_separateMultiEdges; }
+
+	//! Sets the option separateMultiEdges to \p b.
+	void separateMultiEdges(bool b) { m_separateMultiEdges = b; }
+
+	/** @}
+	 *  @name Module options
+	 *  @{
+	 */
+
+	//! Sets the module for the computation of the acyclic subgraph.
+	void setSubgraph(AcyclicSubgraphModule* pSubgraph) { m_subgraph.reset(pSubgraph); }
+
+	//! @}
+
+private:
+	//! Implements the algorithm call.
+	void doCall(const Graph& G, NodeArray<int>& rank, const EdgeArray<bool>& reversed,
+			const EdgeArray<int>& length, const EdgeArray<int>& cost);
+};
+
+}
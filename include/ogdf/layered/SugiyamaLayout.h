@@ -93,7 +93,9 @@ class HierarchyLevelsBase;
  *     <td>Determines, how many times the crossing minimization is repeated.
  *     Each repetition (except for the first) starts with randomly
  *     permuted nodes on each layer. Deterministic behaviour can be achieved
- *     by setting runs to 1.
+ *     by setting runs to 1. The runs are distributed over up to maxThreads()
+ *     threads of WorkStealingPool::instance(); no further runs are performed
+ *     once a drawing without crossings has been found.
  *   </tr><tr>
  *     <td><i>transpose</i><td>bool<td>true
  *     <td>Determines whether the transpose step is
@@ -39,6 +39,7 @@
 #include <ogdf/basic/SList.h>
 #include <ogdf/basic/STNumbering.h>
 #include <ogdf/basic/Thread.h>
+#include <ogdf/basic/WorkStealingPool.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/pqtree/PQLeafKey.h>
 #include <ogdf/basic/simple_graph_alg.h>
@@ -48,7 +49,6 @@
 #include <ogdf/planarity/planar_subgraph_fast/whaInfo.h>
 
 #include <algorithm>
-#include <atomic>
 #include <limits>
 #include <mutex>
 #include <utility>
@@ -88,17 +88,15 @@ class PlanarSubgraphFast : public PlanarSubgraphModule<TCost> {
 		int m_nBlocks; //!< number of blocks
 		const Array<BlockType>& m_block; //!< the blocks (graph and edge mapping)
 		const EdgeArray<TCost>* m_pCost; //!< edge cost (may be 0)
-		std::atomic<int> m_runs;
 		std::mutex m_mutex; //!< thread synchronization
 
 	public:
-		ThreadMaster(const Array<BlockType>& block, const EdgeArray<TCost>* pCost, int runs)
+		ThreadMaster(const Array<BlockType>& block, const EdgeArray<TCost>* pCost)
 			: m_bestSolution(block.size())
 			, m_bestDelEdges(block.size())
 			, m_nBlocks(block.size())
 			, m_block(block)
-			, m_pCost(pCost)
-			, m_runs(runs) {
+			, m_pCost(pCost) {
 			for (int i = 0; i < m_nBlocks; ++i) {
 				m_bestDelEdges[i] = nullptr;
 				m_bestSolution[i] =
@@ -146,23 +144,6 @@ class PlanarSubgraphFast : public PlanarSubgraphModule<TCost> {
 				}
 			}
 		}
-
-		bool getNextRun() { return --m_runs >= 0; }
-	};
-
-	class Worker {
-		ThreadMaster* m_pMaster; // associated master
-
-	public:
-		Worker(ThreadMaster* pMaster) : m_pMaster(pMaster) { }
-
-		~Worker() = default;
-
-		void operator()() { doWorkHelper(*m_pMaster); }
-
-	private:
-		Worker(const Worker& other); // = delete
-		Worker& operator=(const Worker& other); // = delete
 	};
 
 public:
@@ -327,21 +308,11 @@ private:
 	//! Realizes the parallel implementation.
 	void parCall(const Array<BlockType>& block, const EdgeArray<TCost>* pCost, int nRuns,
 			unsigned int nThreads, List<edge>& delEdges) {
-		ThreadMaster master(block, pCost, nRuns - nThreads);
-
-		Array<Worker*> worker(nThreads - 1);
-		Array<Thread> thread(nThreads - 1);
-		for (unsigned int i = 0; i < nThreads - 1; ++i) {
-			worker[i] = new Worker(&master);
-			thread[i] = Thread(*worker[i]);
-		}
-
-		doWorkHelper(master);
+		ThreadMaster master(block, pCost);
 
-		for (unsigned int i = 0; i < nThreads - 1; ++i) {
-			thread[i].join();
-			delete worker[i];
-		}
+		WorkStealingPool::StopFlag stop;
+		WorkStealingPool::instance().run(nRuns, nThreads, stop,
+				[&](int, unsigned int) { doWorkHelper(master, stop); });
 
 		master.buildSolution(delEdges);
 	}
@@ -402,26 +373,34 @@ private:
 		// function CleanNode for freeing node information class.
 	}
 
-	static void doWorkHelper(ThreadMaster& master) {
+	//! Performs one randomized run on all blocks that are not solved optimally yet.
+	/**
+	 * Stops the remaining runs if no such block is left.
+	 */
+	static void doWorkHelper(ThreadMaster& master, WorkStealingPool::StopFlag& stop) {
 		const int nBlocks = master.numBlocks();
 
-		do {
-			for (int i = 0; i < nBlocks; ++i) {
-				if (master.considerBlock(i)) {
-					const Graph& B = master.block(i);
+		bool solved = true;
+		for (int i = 0; i < nBlocks; ++i) {
+			if (master.considerBlock(i)) {
+				const Graph& B = master.block(i);
 
-					NodeArray<int> numbering(B, 0); // compute (randomized) st-numbering
-					computeSTNumbering(B, numbering, nullptr, nullptr, true);
+				NodeArray<int> numbering(B, 0); // compute (randomized) st-numbering
+				computeSTNumbering(B, numbering, nullptr, nullptr, true);
 
-					List<edge>* pCurrentDelEdges = new List<edge>;
-					planarize(B, numbering, *pCurrentDelEdges);
+				List<edge>* pCurrentDelEdges = new List<edge>;
+				planarize(B, numbering, *pCurrentDelEdges);
 
-					pCurrentDelEdges = master.postNewResult(i, pCurrentDelEdges);
-					delete pCurrentDelEdges;
-				}
+				pCurrentDelEdges = master.postNewResult(i, pCurrentDelEdges);
+				delete pCurrentDelEdges;
+
+				solved &= !master.considerBlock(i);
 			}
+		}
 
-		} while (master.getNextRun());
+		if (solved) {
+			stop.stop();
+		}
 	}
 };
 
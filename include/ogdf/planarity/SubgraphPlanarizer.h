@@ -86,8 +86,9 @@ class PlanRepLight;
  *     <td><i>maxThreads</i><td>int<td>System::numberOfProcessors()
  *     <td>This is the maximal number of threads that will be used for parallelizing the
  *     algorithm. At the moment, each permutation is parallelized, hence the there will
- *     never be used more threads than permutations. To achieve sequential behaviour, set
- *     maxThreads to 1.
+ *     never be used more threads than permutations. The permutations are executed by
+ *     WorkStealingPool::instance() and stop as soon as a solution without crossings is
+ *     found. To achieve sequential behaviour, set maxThreads to 1.
  *   </tr>
  * </table>
  *
@@ -161,9 +162,6 @@ public:
 	}
 
 private:
-	static void doWorkHelper(ThreadMaster& master, EdgeInsertionModule& inserter,
-			std::minstd_rand& rng);
-
 	static bool doSinglePermutation(PlanRepLight& prl, int cc, const EdgeArray<int>* pCost,
 			const EdgeArray<bool>* pForbid, const EdgeArray<uint32_t>* pEdgeSubGraphs,
 			Array<edge>& deletedEdges, EdgeInsertionModule& inserter, std::minstd_rand& rng,
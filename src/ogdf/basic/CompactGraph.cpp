@@ -0,0 +1,71 @@
+/** \file
+ * \brief Implementation of ogdf::CompactGraph.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphList.h>
+#include <ogdf/basic/basic.h>
+
+namespace ogdf {
+
+CompactGraph::CompactGraph(const Graph& G)
+	: m_pGraph(&G)
+	, m_numberOfEdges(G.numberOfEdges())
+	, m_offset(G.maxNodeIndex() + 2, 0)
+	, m_original(G.maxNodeIndex() + 1, nullptr)
+	, m_edges(G.maxEdgeIndex() + 1, nullptr) {
+	m_nodes.reserve(G.numberOfNodes());
+	for (node v : G.nodes) {
+		m_nodes.push_back(v->index());
+		m_original[v->index()] = v;
+		m_offset[v->index() + 1] = v->degree();
+	}
+	for (edge e : G.edges) {
+		m_edges[e->index()] = e;
+	}
+
+	// prefix sums turn degrees into offsets
+	for (size_t i = 1; i < m_offset.size(); ++i) {
+		m_offset[i] += m_offset[i - 1];
+	}
+
+	m_twin.resize(m_offset.back());
+	m_adjEdge.resize(m_offset.back());
+	for (node v : G.nodes) {
+		int i = m_offset[v->index()];
+		for (adjEntry adj : v->adjEntries) {
+			m_twin[i] = adj->twinNode()->index();
+			m_adjEdge[i] = (adj->theEdge()->index() << 1) | (adj->isSource() ? 1 : 0);
+			++i;
+		}
+		OGDF_ASSERT(i == m_offset[v->index() + 1]);
+	}
+}
+
+}
@@ -100,6 +100,40 @@ static inline void cpuid(int CPUInfo[4], int infoType) {
 #endif
 }
 
+static inline void cpuidex(int CPUInfo[4], int infoType, int subType) {
+#if defined(OGDF_SYSTEM_WINDOWS) && !defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__cpuidex(CPUInfo, infoType, subType);
+#else
+	uint32_t a = 0;
+	uint32_t b = 0;
+	uint32_t c = 0;
+	uint32_t d = 0;
+
+#	if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	__get_cpuid_count(infoType, subType, &a, &b, &c, &d);
+#	endif
+
+	CPUInfo[0] = a;
+	CPUInfo[1] = b;
+	CPUInfo[2] = c;
+	CPUInfo[3] = d;
+#endif
+}
+
+// returns whether the operating system saves the SSE and AVX registers on context switches
+static inline bool osSavesAVXState() {
+#if defined(OGDF_SYSTEM_WINDOWS) && !defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return (_xgetbv(0) & 6) == 6;
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	uint32_t a = 0;
+	uint32_t d = 0;
+	__asm__ volatile("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	return (a & 6) == 6;
+#else
+	return false;
+#endif
+}
+
 namespace ogdf {
 
 unsigned int System::s_cpuFeatures = 0;
@@ -161,6 +195,16 @@ void System::init() {
 		if (featureInfoECX & (1 << 3)) {
 			s_cpuFeatures |= CPUFeatureMask::MONITOR;
 		}
+		// AVX needs OSXSAVE and the operating system has to save the YMM registers
+		if ((featureInfoECX & (1 << 27)) && (featureInfoECX & (1 << 28)) && osSavesAVXState()) {
+			s_cpuFeatures |= CPUFeatureMask::AVX;
+			if (nIds >= 7) {
+				cpuidex(CPUInfo, 7, 0);
+				if (CPUInfo[1] & (1 << 5)) {
+					s_cpuFeatures |= CPUFeatureMask::AVX2;
+				}
+			}
+		}
 	}
 
 	cpuid(CPUInfo, 0x80000000);
@@ -422,6 +466,10 @@ size_t System::memoryInThreadFreeListOfMemoryManager() {
 	return OGDF_ALLOCATOR::memoryInThreadFreeList();
 }
 
+ArenaStatistics System::arenaStatisticsOfMemoryManager() {
+	return ArenaMemoryAllocator::statistics();
+}
+
 // TODO: Untested for cygwin, mingw!
 #ifdef OGDF_SYSTEM_WINDOWS
 
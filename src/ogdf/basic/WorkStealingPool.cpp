@@ -0,0 +1,192 @@
+/** \file
+ * \brief Implementation of a persistent work-stealing thread pool for
+ *        independent randomized runs.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/WorkStealingPool.h>
+#include <ogdf/basic/basic.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace ogdf {
+
+namespace {
+
+//! Whether the current thread belongs to a WorkStealingPool.
+thread_local bool t_inPool = false;
+
+}
+
+//! One call of WorkStealingPool::run().
+/**
+ * The runs of each slot form a range; its owner takes runs from the front, other threads
+ * steal from the back.
+ */
+class WorkStealingPool::Job {
+	struct Slot {
+		std::mutex mutex;
+		int begin;
+		int end;
+	};
+
+	const RunFunction& m_f;
+	StopFlag& m_stop;
+	std::unique_ptr<Slot[]> m_slots;
+
+public:
+	const unsigned int numSlots;
+	unsigned int nextSlot = 1; //!< The next slot for a helping thread (guarded by the pool).
+	unsigned int helpers = 0; //!< The number of working helping threads (guarded by the pool).
+	std::condition_variable helpersDone;
+
+	Job(int nRuns, unsigned int nSlots, StopFlag& stop, const RunFunction& f)
+		: m_f(f), m_stop(stop), m_slots(new Slot[nSlots]), numSlots(nSlots) {
+		for (unsigned int i = 0; i < nSlots; ++i) {
+			m_slots[i].begin = static_cast<int>(int64_t(nRuns) * i / nSlots);
+			m_slots[i].end = static_cast<int>(int64_t(nRuns) * (i + 1) / nSlots);
+		}
+	}
+
+	//! Executes runs on \p slot until all runs are taken or the job is stopped.
+	void work(unsigned int slot) {
+		int run;
+		while (!m_stop.stopped() && nextRun(slot, run)) {
+			m_f(run, slot);
+		}
+	}
+
+private:
+	bool nextRun(unsigned int slot, int& run) {
+		{
+			Slot& own = m_slots[slot];
+			std::lock_guard<std::mutex> guard(own.mutex);
+			if (own.begin < own.end) {
+				run = own.begin++;
+				return true;
+			}
+		}
+
+		for (unsigned int i = 1; i < numSlots; ++i) {
+			Slot& victim = m_slots[(slot + i) % numSlots];
+			std::lock_guard<std::mutex> guard(victim.mutex);
+			if (victim.begin < victim.end) {
+				run = --victim.end;
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+WorkStealingPool& WorkStealingPool::instance() {
+	static WorkStealingPool pool(max(1u, Thread::hardware_concurrency()) - 1);
+	return pool;
+}
+
+WorkStealingPool::WorkStealingPool(unsigned int numThreads)
+	: m_numThreads(numThreads), m_workerLoop([this] { workerLoop(); }) { }
+
+WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_shutdown = true;
+	}
+	m_jobAvailable.notify_all();
+	for (Thread& thread : m_threads) {
+		thread.join();
+	}
+}
+
+void WorkStealingPool::startThreads() {
+	m_started = true;
+	m_threads.reserve(m_numThreads);
+	for (unsigned int i = 0; i < m_numThreads; ++i) {
+		m_threads.emplace_back(m_workerLoop);
+	}
+}
+
+void WorkStealingPool::workerLoop() {
+	t_inPool = true;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;) {
+		m_jobAvailable.wait(lock, [this] { return m_shutdown || !m_jobs.empty(); });
+		if (m_shutdown) {
+			return;
+		}
+
+		Job* job = m_jobs.front();
+		const unsigned int slot = job->nextSlot++;
+		if (job->nextSlot == job->numSlots) {
+			m_jobs.pop_front();
+		}
+		++job->helpers;
+
+		lock.unlock();
+		job->work(slot);
+		lock.lock();
+
+		if (--job->helpers == 0) {
+			job->helpersDone.notify_all();
+		}
+	}
+}
+
+void WorkStealingPool::run(int nRuns, unsigned int maxThreads, StopFlag& stop,
+		const RunFunction& f) {
+	const unsigned int nSlots = std::min({max(1u, maxThreads), m_numThreads + 1,
+			static_cast<unsigned int>(max(0, nRuns))});
+
+	if (t_inPool || nSlots <= 1) {
+		for (int i = 0; i < nRuns && !stop.stopped(); ++i) {
+			f(i, 0);
+		}
+		return;
+	}
+
+	Job job(nRuns, nSlots, stop, f);
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		if (!m_started) {
+			startThreads();
+		}
+		m_jobs.push_back(&job);
+	}
+	m_jobAvailable.notify_all();
+
+	job.work(0);
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_jobs.remove(&job);
+	job.helpersDone.wait(lock, [&job] { return job.helpers == 0; });
+}
+
+}
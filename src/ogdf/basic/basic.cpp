@@ -31,6 +31,7 @@
 
 #include <ogdf/basic/System.h>
 #include <ogdf/basic/basic.h>
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
 #include <ogdf/basic/memory/PoolMemoryAllocator.h>
 
 #include <algorithm>
@@ -80,6 +81,7 @@ static void initializeOGDF() {
 static void deinitializeOGDF() {
 	if (--initializerCount == 0) {
 		ogdf::PoolMemoryAllocator::cleanup();
+		ogdf::ArenaMemoryAllocator::cleanup();
 	}
 }
 
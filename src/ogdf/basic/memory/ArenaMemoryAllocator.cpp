@@ -0,0 +1,314 @@
+/** \file
+ * \brief Implementation of memory manager for allocating small
+ *        pieces of memory from per-thread arenas
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/exceptions.h>
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+
+#ifdef OGDF_SYSTEM_WINDOWS
+#	include <malloc.h>
+#endif
+
+namespace ogdf {
+
+//! Header at the start of every block; blocks are aligned to their size.
+struct ArenaMemoryAllocator::Block {
+	Arena* m_owner; //!< The owning scoped arena, or nullptr for thread memory.
+	Block* m_next; //!< The next block of the same arena.
+};
+
+//! Free lists and current block of a single arena.
+struct ArenaMemoryAllocator::Arena {
+	MemElemPtr m_freeList[TABLE_SIZE];
+	char* m_top; //!< First unused byte of the current block.
+	char* m_end; //!< End of the current block.
+	Block* m_blocks; //!< All blocks of this arena.
+	Arena* m_parent; //!< The enclosing scoped arena (nullptr if there is none).
+	bool m_scoped; //!< Whether the arena belongs to an ArenaScope.
+};
+
+// zero-initialized, i.e., all free lists are empty and there is no current block
+thread_local ArenaMemoryAllocator::Arena ArenaMemoryAllocator::s_threadArena;
+thread_local ArenaMemoryAllocator::Arena* ArenaMemoryAllocator::s_scope = nullptr;
+
+namespace {
+std::atomic<size_t> s_blocksAllocated {0};
+std::atomic<size_t> s_blocksReleased {0};
+std::atomic<size_t> s_scopesOpened {0};
+std::atomic<size_t> s_scopesClosed {0};
+
+//! Protects the global free lists and the blocks handed over by terminated threads.
+std::mutex s_mutex;
+
+//! Global free lists, filled by terminating threads.
+void* s_globalFreeList[256];
+
+//! Number of elements in each global free list; may be read without locking to skip empty lists.
+std::atomic<size_t> s_globalSize[256];
+
+//! Blocks handed over by terminated threads.
+void* s_globalBlocks = nullptr;
+
+void* allocateAlignedBlock(size_t size) {
+	void* p;
+#ifdef OGDF_SYSTEM_WINDOWS
+#	ifdef __MINGW64__
+	p = __mingw_aligned_malloc(size, size);
+#	else
+	p = _aligned_malloc(size, size);
+#	endif
+#else
+	if (posix_memalign(&p, size, size) != 0) {
+		p = nullptr;
+	}
+#endif
+	if (OGDF_UNLIKELY(p == nullptr)) {
+		OGDF_THROW(ogdf::InsufficientMemoryException);
+	}
+	return p;
+}
+
+void freeAlignedBlock(void* p) {
+#ifdef OGDF_SYSTEM_WINDOWS
+#	ifdef __MINGW64__
+	__mingw_aligned_free(p);
+#	else
+	_aligned_free(p);
+#	endif
+#else
+	free(p);
+#endif
+}
+}
+
+inline ArenaMemoryAllocator::Arena& ArenaMemoryAllocator::currentArena() {
+	return OGDF_LIKELY(s_scope == nullptr) ? s_threadArena : *s_scope;
+}
+
+void* ArenaMemoryAllocator::allocate(size_t nBytes) {
+	Arena& arena = currentArena();
+	MemElemPtr& pFreeBytes = arena.m_freeList[nBytes];
+
+	if (OGDF_LIKELY(pFreeBytes != nullptr)) {
+		MemElemPtr p = pFreeBytes;
+		pFreeBytes = p->m_next;
+		p->m_next = nullptr;
+		return p;
+	}
+	return fillArena(arena, nBytes);
+}
+
+void* ArenaMemoryAllocator::fillArena(Arena& arena, size_t nBytes) {
+	// round up to full words so that carved pieces stay aligned
+	const size_t size = (max(nBytes, MIN_BYTES) + MIN_BYTES - 1) & ~(MIN_BYTES - 1);
+
+	if (OGDF_LIKELY(size <= static_cast<size_t>(arena.m_end - arena.m_top))) {
+		void* p = arena.m_top;
+		arena.m_top += size;
+		return p;
+	}
+
+	if (!arena.m_scoped && s_globalSize[nBytes].load(std::memory_order_relaxed) > 0) {
+		// reuse memory handed over by terminated threads before requesting a new block
+		std::lock_guard<std::mutex> guard(s_mutex);
+		MemElemPtr p = static_cast<MemElemPtr>(s_globalFreeList[nBytes]);
+		if (p != nullptr) {
+			s_globalFreeList[nBytes] = nullptr;
+			s_globalSize[nBytes].store(0, std::memory_order_relaxed);
+			arena.m_freeList[nBytes] = p->m_next;
+			p->m_next = nullptr;
+			return p;
+		}
+	}
+
+	// the remainder of the current block is left unused
+	Block* block = static_cast<Block*>(allocateAlignedBlock(BLOCK_SIZE));
+	s_blocksAllocated.fetch_add(1, std::memory_order_relaxed);
+	block->m_owner = arena.m_scoped ? &arena : nullptr;
+	block->m_next = arena.m_blocks;
+	arena.m_blocks = block;
+	arena.m_top = reinterpret_cast<char*>(block) + sizeof(Block) + size;
+	arena.m_end = reinterpret_cast<char*>(block) + BLOCK_SIZE;
+	return reinterpret_cast<char*>(block) + sizeof(Block);
+}
+
+void ArenaMemoryAllocator::deallocate(size_t nBytes, void* p) {
+	const Block* block = reinterpret_cast<const Block*>(
+			reinterpret_cast<uintptr_t>(p) & ~static_cast<uintptr_t>(BLOCK_SIZE - 1));
+	// thread memory migrates to the deallocating thread, just like with the pool allocator
+	Arena& arena = block->m_owner == nullptr ? s_threadArena : *block->m_owner;
+	MemElemPtr& pFreeBytes = arena.m_freeList[nBytes];
+	MemElemPtr(p)->m_next = pFreeBytes;
+	pFreeBytes = MemElemPtr(p);
+}
+
+void ArenaMemoryAllocator::deallocateList(size_t nBytes, void* pHead, void* pTail) {
+	// the elements may stem from different arenas, so hand them back one by one
+	MemElemPtr pStop = MemElemPtr(pTail)->m_next;
+	for (MemElemPtr p = MemElemPtr(pHead); p != pStop;) {
+		MemElemPtr pNext = p->m_next;
+		deallocate(nBytes, p);
+		p = pNext;
+	}
+}
+
+void ArenaMemoryAllocator::flushPool() {
+	OGDF_ASSERT(s_scope == nullptr);
+	Arena& arena = s_threadArena;
+
+	std::lock_guard<std::mutex> guard(s_mutex);
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		MemElemPtr pHead = arena.m_freeList[sz];
+		if (pHead == nullptr) {
+			continue;
+		}
+		MemElemPtr pTail = pHead;
+		size_t n = 1;
+		while (pTail->m_next != nullptr) {
+			pTail = pTail->m_next;
+			++n;
+		}
+		pTail->m_next = static_cast<MemElemPtr>(s_globalFreeList[sz]);
+		s_globalFreeList[sz] = pHead;
+		s_globalSize[sz].fetch_add(n, std::memory_order_relaxed);
+		arena.m_freeList[sz] = nullptr;
+	}
+
+	// blocks may still hold objects used by other threads, so keep them until cleanup()
+	while (arena.m_blocks != nullptr) {
+		Block* block = arena.m_blocks;
+		arena.m_blocks = block->m_next;
+		block->m_next = static_cast<Block*>(s_globalBlocks);
+		s_globalBlocks = block;
+	}
+	arena.m_top = arena.m_end = nullptr;
+}
+
+void ArenaMemoryAllocator::freeBlocks(Block* block) {
+	size_t n = 0;
+	while (block != nullptr) {
+		Block* next = block->m_next;
+		freeAlignedBlock(block);
+		block = next;
+		++n;
+	}
+	s_blocksReleased.fetch_add(n, std::memory_order_relaxed);
+}
+
+void ArenaMemoryAllocator::cleanup() {
+	Arena& arena = s_threadArena;
+	freeBlocks(arena.m_blocks);
+	arena = Arena();
+
+	std::lock_guard<std::mutex> guard(s_mutex);
+	freeBlocks(static_cast<Block*>(s_globalBlocks));
+	s_globalBlocks = nullptr;
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		s_globalFreeList[sz] = nullptr;
+		s_globalSize[sz].store(0, std::memory_order_relaxed);
+	}
+}
+
+ArenaMemoryAllocator::Arena* ArenaMemoryAllocator::openScope() {
+	// scoped arenas must not be managed by themselves
+	Arena* arena = static_cast<Arena*>(calloc(1, sizeof(Arena)));
+	if (OGDF_UNLIKELY(arena == nullptr)) {
+		OGDF_THROW(ogdf::InsufficientMemoryException);
+	}
+	arena->m_scoped = true;
+	arena->m_parent = s_scope;
+	s_scope = arena;
+	s_scopesOpened.fetch_add(1, std::memory_order_relaxed);
+	return arena;
+}
+
+void ArenaMemoryAllocator::closeScope(Arena* arena) {
+	OGDF_ASSERT(s_scope == arena);
+	s_scope = arena->m_parent;
+	freeBlocks(arena->m_blocks);
+	free(arena);
+	s_scopesClosed.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t ArenaMemoryAllocator::numberOfBlocks(const Arena* arena) {
+	size_t n = 0;
+	for (const Block* block = arena->m_blocks; block != nullptr; block = block->m_next) {
+		++n;
+	}
+	return n;
+}
+
+size_t ArenaMemoryAllocator::freeMemory(const Arena& arena) {
+	size_t bytesFree = arena.m_end - arena.m_top;
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		for (MemElemPtr p = arena.m_freeList[sz]; p != nullptr; p = p->m_next) {
+			bytesFree += sz;
+		}
+	}
+	return bytesFree;
+}
+
+size_t ArenaMemoryAllocator::memoryAllocatedInBlocks() {
+	return (s_blocksAllocated.load() - s_blocksReleased.load()) * BLOCK_SIZE;
+}
+
+size_t ArenaMemoryAllocator::memoryInGlobalFreeList() {
+	size_t bytesFree = 0;
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		bytesFree += s_globalSize[sz].load(std::memory_order_relaxed) * sz;
+	}
+	return bytesFree;
+}
+
+size_t ArenaMemoryAllocator::memoryInThreadFreeList() { return freeMemory(currentArena()); }
+
+ArenaStatistics ArenaMemoryAllocator::statistics() {
+	ArenaStatistics stats;
+	stats.blocksAllocated = s_blocksAllocated.load();
+	stats.blocksReleased = s_blocksReleased.load();
+	stats.scopesOpened = s_scopesOpened.load();
+	stats.scopesClosed = s_scopesClosed.load();
+	return stats;
+}
+
+ArenaScope::ArenaScope() : m_arena(ArenaMemoryAllocator::openScope()) { }
+
+ArenaScope::~ArenaScope() { ArenaMemoryAllocator::closeScope(m_arena); }
+
+size_t ArenaScope::memoryAllocatedInBlocks() const {
+	return ArenaMemoryAllocator::numberOfBlocks(m_arena) * ArenaMemoryAllocator::BLOCK_SIZE;
+}
+
+}
@@ -53,6 +53,9 @@ struct PoolMemoryAllocator::BlockChain {
 };
 
 PoolMemoryAllocator::BlockChain* PoolMemoryAllocator::s_blocks;
+size_t PoolMemoryAllocator::s_blocksPerSize[TABLE_SIZE];
+size_t PoolMemoryAllocator::s_allocations[TABLE_SIZE];
+size_t PoolMemoryAllocator::s_trimThreshold = 0;
 
 #ifdef OGDF_DEBUG
 long long PoolMemoryAllocator::s_globallyAllocatedBytes = 0;
@@ -61,10 +64,12 @@ thread_local long long PoolMemoryAllocator::s_locallyAllocatedBytes = 0;
 
 #ifdef OGDF_MEMORY_POOL_NTS
 PoolMemoryAllocator::MemElemPtr PoolMemoryAllocator::s_tp[TABLE_SIZE];
+size_t PoolMemoryAllocator::s_threadAllocations[TABLE_SIZE];
 #else
 PoolMemoryAllocator::PoolElement PoolMemoryAllocator::s_pool[TABLE_SIZE];
 std::mutex PoolMemoryAllocator::s_mutex;
 thread_local PoolMemoryAllocator::MemElemPtr PoolMemoryAllocator::s_tp[TABLE_SIZE];
+thread_local size_t PoolMemoryAllocator::s_threadAllocations[TABLE_SIZE];
 #endif
 
 void PoolMemoryAllocator::cleanup() {
@@ -77,6 +82,8 @@ void PoolMemoryAllocator::cleanup() {
 		free(p);
 		p = pNext;
 	}
+	s_blocks = nullptr;
+	std::fill(s_blocksPerSize, s_blocksPerSize + TABLE_SIZE, 0);
 }
 
 bool PoolMemoryAllocator::checkSize(size_t nBytes) { return nBytes < TABLE_SIZE; }
@@ -84,6 +91,7 @@ bool PoolMemoryAllocator::checkSize(size_t nBytes) { return nBytes < TABLE_SIZE;
 void* PoolMemoryAllocator::allocate(size_t nBytes) {
 	MemElemPtr& pFreeBytes = s_tp[nBytes];
 	void* result;
+	++s_threadAllocations[nBytes];
 
 	if (OGDF_LIKELY(pFreeBytes != nullptr)) {
 		MemElemPtr p = pFreeBytes;
@@ -150,12 +158,24 @@ void PoolMemoryAllocator::flushPool() {
 			leaveCS();
 		}
 	}
-#	ifdef OGDF_DEBUG
+
 	enterCS();
+	size_t bytesFree = 0;
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		s_allocations[sz] += s_threadAllocations[sz];
+		s_threadAllocations[sz] = 0;
+		bytesFree += s_pool[sz].m_size * sz;
+	}
+	const bool needsTrim = s_trimThreshold > 0 && bytesFree > s_trimThreshold;
+#	ifdef OGDF_DEBUG
 	s_globallyAllocatedBytes += s_locallyAllocatedBytes;
-	leaveCS();
 	s_locallyAllocatedBytes = 0;
 #	endif
+	leaveCS();
+
+	if (needsTrim) {
+		trim();
+	}
 #endif
 }
 
@@ -165,6 +185,7 @@ void* PoolMemoryAllocator::fillPool(MemElemPtr& pFreeBytes, uint16_t nBytes) {
 
 #ifdef OGDF_MEMORY_POOL_NTS
 	pFreeBytes = allocateBlock();
+	++s_blocksPerSize[nBytes];
 	makeSlices(pFreeBytes, nWords, nSlices);
 #else
 	enterCS();
@@ -187,6 +208,7 @@ void* PoolMemoryAllocator::fillPool(MemElemPtr& pFreeBytes, uint16_t nBytes) {
 
 	} else {
 		pFreeBytes = allocateBlock();
+		++s_blocksPerSize[nBytes];
 
 		leaveCS();
 
@@ -329,4 +351,132 @@ void PoolMemoryAllocator::getThreadFreeListSizes(std::vector<size_t>& sizes) {
 	}
 }
 
+void PoolMemoryAllocator::getSizeClassStatistics(std::vector<PoolSizeClassStatistics>& stats) {
+	stats.assign(TABLE_SIZE, PoolSizeClassStatistics());
+
+	enterCS();
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		PoolSizeClassStatistics& st = stats[sz];
+		st.blocks = s_blocksPerSize[sz];
+		st.allocations = s_allocations[sz] + s_threadAllocations[sz];
+#ifndef OGDF_MEMORY_POOL_NTS
+		st.inGlobalFreeList = s_pool[sz].m_size;
+#endif
+		for (auto p = s_tp[sz]; p != nullptr; p = p->m_next) {
+			++st.inThreadFreeList;
+		}
+		st.live = st.blocks * slicesPerBlock(max(uint16_t(sz), (uint16_t)MIN_BYTES))
+				- st.inGlobalFreeList - st.inThreadFreeList;
+	}
+	leaveCS();
+}
+
+size_t PoolMemoryAllocator::removeReleased(MemElemPtr& head, const std::vector<BlockChain*>& blocks,
+		const std::vector<bool>& released) {
+	size_t nRemaining = 0;
+	MemElemPtr* pLink = &head;
+	for (MemElemPtr p = head; p != nullptr; p = p->m_next) {
+		auto it = std::upper_bound(blocks.begin(), blocks.end(), reinterpret_cast<BlockChain*>(p));
+		if (!released[it - blocks.begin() - 1]) {
+			*pLink = p;
+			pLink = &p->m_next;
+			++nRemaining;
+		}
+	}
+	*pLink = nullptr;
+	return nRemaining;
+}
+
+size_t PoolMemoryAllocator::trim() {
+	enterCS();
+
+	// sorted blocks allow to find the block of each free element by binary search
+	std::vector<BlockChain*> blocks;
+	for (BlockChain* p = s_blocks; p != nullptr; p = p->m_next) {
+		blocks.push_back(p);
+	}
+	std::sort(blocks.begin(), blocks.end());
+
+	std::vector<int> nFree(blocks.size(), 0);
+	std::vector<bool> released(blocks.size(), false);
+	std::vector<size_t> touched;
+	size_t nReleased = 0;
+
+	for (size_t sz = 1; sz < TABLE_SIZE; ++sz) {
+		if (s_blocksPerSize[sz] == 0) {
+			continue;
+		}
+
+		// every block is sliced for a single size, so it is free iff all its slices are listed
+		auto countFree = [&](MemElemPtr head) {
+			for (MemElemPtr p = head; p != nullptr; p = p->m_next) {
+				auto it = std::upper_bound(blocks.begin(), blocks.end(),
+						reinterpret_cast<BlockChain*>(p));
+				OGDF_ASSERT(it != blocks.begin());
+				size_t i = it - blocks.begin() - 1;
+				if (nFree[i]++ == 0) {
+					touched.push_back(i);
+				}
+			}
+		};
+		countFree(s_tp[sz]);
+#ifndef OGDF_MEMORY_POOL_NTS
+		countFree(s_pool[sz].m_gp);
+#endif
+
+		const int nSlices = slicesPerBlock(max(uint16_t(sz), (uint16_t)MIN_BYTES));
+		size_t nReleasedOfSize = 0;
+		for (size_t i : touched) {
+			if (nFree[i] == nSlices) {
+				released[i] = true;
+				++nReleasedOfSize;
+			}
+			nFree[i] = 0;
+		}
+		touched.clear();
+
+		if (nReleasedOfSize > 0) {
+			removeReleased(s_tp[sz], blocks, released);
+#ifndef OGDF_MEMORY_POOL_NTS
+			s_pool[sz].m_size = int(removeReleased(s_pool[sz].m_gp, blocks, released));
+#endif
+			s_blocksPerSize[sz] -= nReleasedOfSize;
+			nReleased += nReleasedOfSize;
+		}
+	}
+
+	if (nReleased > 0) {
+		BlockChain** pLink = &s_blocks;
+		for (BlockChain* p = s_blocks; p != nullptr;) {
+			BlockChain* pNext = p->m_next;
+			auto it = std::lower_bound(blocks.begin(), blocks.end(), p);
+			if (released[it - blocks.begin()]) {
+				free(p);
+			} else {
+				*pLink = p;
+				pLink = &p->m_next;
+			}
+			p = pNext;
+		}
+		*pLink = nullptr;
+	}
+
+	leaveCS();
+
+	return nReleased * BLOCK_SIZE;
+}
+
+void PoolMemoryAllocator::setTrimThreshold(size_t bytes) {
+	enterCS();
+	s_trimThreshold = bytes;
+	leaveCS();
+}
+
+size_t PoolMemoryAllocator::trimThreshold() {
+	enterCS();
+	size_t bytes = s_trimThreshold;
+	leaveCS();
+	return bytes;
+}
+
 }
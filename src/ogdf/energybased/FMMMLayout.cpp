@@ -95,6 +95,7 @@ void FMMMLayout::call(GraphAttributes& GA, const EdgeArray<double>& edgeLength)
 	EdgeArray<EdgeAttributes> E_reduced; //stores the edge attributes of G_reduced
 	NodeArray<NodeAttributes> A_reduced; //stores the node attributes of G_reduced
 
+	startProgress();
 	if (G.numberOfNodes() > 1) {
 		GA.clearAllBends(); //all edges are straight-line
 		if (useHighLevelOptions()) {
@@ -108,7 +109,9 @@ void FMMMLayout::call(GraphAttributes& GA, const EdgeArray<double>& edgeLength)
 		max_integer_position = pow(2.0, maxIntPosExponent());
 		init_ind_ideal_edgelength(G, A, E);
 		make_simple_loopfree(G, A, E, G_reduced, A_reduced, E_reduced);
+		m_reducedAttributes = &A_reduced;
 		call_DIVIDE_ET_IMPERA_step(G_reduced, A_reduced, E_reduced);
+		m_reducedAttributes = nullptr;
 		adjust_positions(G_reduced, A_reduced);
 		time_total = usedTime(t_total);
 
@@ -170,7 +173,23 @@ void FMMMLayout::call_MULTILEVEL_step_for_subGraph(Graph& G, NodeArray<NodeAttri
 	Mult.create_multilevel_representations(G, A, E, randSeed(), galaxyChoice(), minGraphSize(),
 			randomTries(), G_mult_ptr, A_mult_ptr, E_mult_ptr, max_level);
 
+	// writes the position of the representative on the current level of each node
+	int act_level = max_level;
+	std::function<void(GraphAttributes&)> exportLayout = [&](GraphAttributes& GA) {
+		for (node v : G.nodes) {
+			node v_act = v;
+			for (int level = 0; level < act_level; level++) {
+				const NodeArray<NodeAttributes>& A_level = *A_mult_ptr[level];
+				v_act = A_level[A_level[v_act].get_dedicated_sun_node()].get_higher_level_node();
+			}
+			node v_orig = (*m_reducedAttributes)[A[v].get_original_node()].get_original_node();
+			GA.x(v_orig) = (*A_mult_ptr[act_level])[v_act].get_x();
+			GA.y(v_orig) = (*A_mult_ptr[act_level])[v_act].get_y();
+		}
+	};
+
 	for (int i = max_level; i >= 0; i--) {
+		act_level = i;
 		if (i == max_level) {
 			create_initial_placement(*G_mult_ptr[i], *A_mult_ptr[i]);
 		} else {
@@ -178,7 +197,8 @@ void FMMMLayout::call_MULTILEVEL_step_for_subGraph(Graph& G, NodeArray<NodeAttri
 					E_mult_ptr);
 			update_boxlength_and_cornercoordinate(*G_mult_ptr[i], *A_mult_ptr[i]);
 		}
-		call_FORCE_CALCULATION_step(*G_mult_ptr[i], *A_mult_ptr[i], *E_mult_ptr[i], i, max_level);
+		call_FORCE_CALCULATION_step(*G_mult_ptr[i], *A_mult_ptr[i], *E_mult_ptr[i], i, max_level,
+				exportLayout);
 	}
 	Mult.delete_multilevel_representations(G_mult_ptr, A_mult_ptr, E_mult_ptr, max_level);
 }
@@ -197,7 +217,8 @@ bool FMMMLayout::running(int iter, int max_mult_iter, double actforcevectorlengt
 }
 
 void FMMMLayout::call_FORCE_CALCULATION_step(Graph& G, NodeArray<NodeAttributes>& A,
-		EdgeArray<EdgeAttributes>& E, int act_level, int max_level) {
+		EdgeArray<EdgeAttributes>& E, int act_level, int max_level,
+		const std::function<void(GraphAttributes&)>& exportLayout) {
 	if (G.numberOfNodes() > 1) {
 		int iter = 1;
 		int max_mult_iter = get_max_mult_iter(act_level, max_level, G.numberOfNodes());
@@ -212,16 +233,18 @@ void FMMMLayout::call_FORCE_CALCULATION_step(Graph& G, NodeArray<NodeAttributes>
 		set_average_ideal_edgelength(G, E); //needed for easy scaling of the forces
 		make_initialisations_for_rep_calc_classes(G);
 
-		while (running(iter, max_mult_iter, actforcevectorlength)) {
+		while (!stopRequested() && running(iter, max_mult_iter, actforcevectorlength)) {
 			calculate_forces(G, A, E, F, F_attr, F_rep, last_node_movement, iter, 0);
 			if (stopCriterion() != FMMMOptions::StopCriterion::FixedIterations) {
 				actforcevectorlength = get_average_forcevector_length(G, F);
 			}
+			reportProgress(act_level, iter, exportLayout);
 			iter++;
 		}
 
 		if (act_level == 0) {
-			call_POSTPROCESSING_step(G, A, E, F, F_attr, F_rep, last_node_movement);
+			call_POSTPROCESSING_step(G, A, E, F, F_attr, F_rep, last_node_movement, iter - 1,
+					exportLayout);
 		}
 
 		deallocate_memory_for_rep_calc_classes();
@@ -230,9 +253,11 @@ void FMMMLayout::call_FORCE_CALCULATION_step(Graph& G, NodeArray<NodeAttributes>
 
 void FMMMLayout::call_POSTPROCESSING_step(Graph& G, NodeArray<NodeAttributes>& A,
 		EdgeArray<EdgeAttributes>& E, NodeArray<DPoint>& F, NodeArray<DPoint>& F_attr,
-		NodeArray<DPoint>& F_rep, NodeArray<DPoint>& last_node_movement) {
-	for (int i = 1; i <= 10; i++) {
+		NodeArray<DPoint>& F_rep, NodeArray<DPoint>& last_node_movement, int iter,
+		const std::function<void(GraphAttributes&)>& exportLayout) {
+	for (int i = 1; i <= 10 && !stopRequested(); i++) {
 		calculate_forces(G, A, E, F, F_attr, F_rep, last_node_movement, i, 1);
+		reportProgress(0, ++iter, exportLayout);
 	}
 
 	if (resizeDrawing()) {
@@ -240,8 +265,9 @@ void FMMMLayout::call_POSTPROCESSING_step(Graph& G, NodeArray<NodeAttributes>& A
 		update_boxlength_and_cornercoordinate(G, A);
 	}
 
-	for (int i = 1; i <= fineTuningIterations(); i++) {
+	for (int i = 1; i <= fineTuningIterations() && !stopRequested(); i++) {
 		calculate_forces(G, A, E, F, F_attr, F_rep, last_node_movement, i, 2);
+		reportProgress(0, ++iter, exportLayout);
 	}
 
 	if (resizeDrawing()) {
@@ -308,6 +334,7 @@ void FMMMLayout::resetOptions() {
 	nmSmallCell(FMMMOptions::SmallestCellFinding::Iteratively);
 	nmParticlesInLeaves(25);
 	nmPrecision(4);
+	nmThreads(1);
 }
 
 void FMMMLayout::update_low_level_options_due_to_high_level_options_settings() {
@@ -1076,7 +1103,7 @@ void FMMMLayout::make_initialisations_for_rep_calc_classes(Graph& G) {
 		break;
 	case FMMMOptions::RepulsiveForcesMethod::NMM:
 		NM.make_initialisations(G, boxlength, down_left_corner, nmParticlesInLeaves(),
-				nmPrecision(), nmTreeConstruction(), nmSmallCell());
+				nmPrecision(), nmTreeConstruction(), nmSmallCell(), nmThreads());
 	}
 }
 
@@ -38,6 +38,7 @@
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/FastMultipoleEmbedder.h>
 #include <ogdf/energybased/fast_multipole_embedder/FMEMultipoleKernel.h>
+#include <ogdf/energybased/fast_multipole_embedder/FMEOctreeKernel.h>
 #include <ogdf/energybased/fast_multipole_embedder/FastUtils.h>
 #include <ogdf/fileformats/GraphIO.h>
 
@@ -117,7 +118,7 @@ void FastMultipoleEmbedder::call(GraphAttributes& GA, const EdgeArray<float>& ed
 		const NodeArray<float>& nodeSize) {
 	allocate(GA.constGraph().numberOfNodes(), GA.constGraph().numberOfEdges());
 	m_pGraph->readFrom(GA, edgeLength, nodeSize);
-	run(m_numIterations);
+	run(m_numIterations, GA.has(GraphAttributes::threeD));
 	m_pGraph->writeTo(GA);
 	deallocate();
 
@@ -126,13 +127,14 @@ void FastMultipoleEmbedder::call(GraphAttributes& GA, const EdgeArray<float>& ed
 	}
 }
 
-void FastMultipoleEmbedder::run(uint32_t numIterations) {
+void FastMultipoleEmbedder::run(uint32_t numIterations, bool threeD) {
 	if (m_pGraph->numNodes() == 0) {
 		return;
 	}
 	if (m_pGraph->numNodes() == 1) {
 		m_pGraph->nodeXPos()[0] = 0.0f;
 		m_pGraph->nodeYPos()[0] = 0.0f;
+		m_pGraph->nodeZPos()[0] = 0.0f;
 		return;
 	}
 
@@ -150,6 +152,11 @@ void FastMultipoleEmbedder::run(uint32_t numIterations) {
 			m_pGraph->nodeYPos()[i] =
 					(float)(randomDouble(-(double)m_pGraph->numNodes(), (double)m_pGraph->numNodes())
 							* avgNodeSize * 2);
+			if (threeD) {
+				m_pGraph->nodeZPos()[i] = (float)(randomDouble(-(double)m_pGraph->numNodes(),
+																  (double)m_pGraph->numNodes())
+						* avgNodeSize * 2);
+			}
 		}
 	}
 
@@ -157,7 +164,9 @@ void FastMultipoleEmbedder::run(uint32_t numIterations) {
 	m_pOptions->stopCritForce =
 			(((float)m_pGraph->numNodes()) * ((float)m_pGraph->numNodes()) * m_pGraph->avgNodeSize())
 			/ m_pOptions->stopCritConstSq;
-	if (m_pGraph->numNodes() < 100) {
+	if (threeD) {
+		runOctree();
+	} else if (m_pGraph->numNodes() < 100) {
 		runSingle();
 	} else {
 		runMultipole();
@@ -171,6 +180,13 @@ void FastMultipoleEmbedder::runMultipole() {
 	FMEMultipoleKernel::deallocateContext(pGlobalContext);
 }
 
+void FastMultipoleEmbedder::runOctree() {
+	FMEOctreeGlobalContext* pGlobalContext =
+			FMEOctreeKernel::allocateContext(m_pGraph, m_pOptions, m_threadPool->numThreads());
+	m_threadPool->runKernel<FMEOctreeKernel>(pGlobalContext);
+	FMEOctreeKernel::deallocateContext(pGlobalContext);
+}
+
 void FastMultipoleEmbedder::runSingle() {
 	FMESingleKernel kernel;
 	kernel(*m_pGraph, m_pOptions->timeStep, m_pOptions->minNumIterations,
@@ -217,6 +233,7 @@ void FastMultipoleMultilevelEmbedder::dumpCurrentLevel(const char* filename) {
 }
 
 void FastMultipoleMultilevelEmbedder::call(GraphAttributes& GA) {
+	startProgress();
 	EdgeArray<float> edgeLengthAuto(GA.constGraph());
 	computeAutoEdgeLength(GA, edgeLengthAuto);
 	const Graph& t = GA.constGraph();
@@ -275,6 +292,7 @@ void FastMultipoleMultilevelEmbedder::run(GraphAttributes& GA, const EdgeArray<f
 
 	// layout the current level
 	layoutCurrentLevel();
+	reportCurrentLevel();
 
 	//proceed with remaining levels
 	while (m_iCurrentLevelNr > 0) {
@@ -284,8 +302,11 @@ void FastMultipoleMultilevelEmbedder::run(GraphAttributes& GA, const EdgeArray<f
 		initCurrentLevel();
 		// assign positions from last to current
 		assignPositionsFromPrevLevel();
-		// layout the current level
-		layoutCurrentLevel();
+		// layout the current level unless the layout has been stopped
+		if (!stopRequested()) {
+			layoutCurrentLevel();
+			reportCurrentLevel();
+		}
 	}
 	// the finest level is processed
 	// assumes m_pCurrentGraph == GA.constGraph
@@ -320,6 +341,22 @@ void FastMultipoleMultilevelEmbedder::writeCurrentToGraphAttributes(GraphAttribu
 	}
 }
 
+void FastMultipoleMultilevelEmbedder::reportCurrentLevel() {
+	reportProgress(m_iCurrentLevelNr, numberOfIterationsByLevelNr(m_iCurrentLevelNr),
+			[&](GraphAttributes& GA) {
+				// each node gets the position of its ancestor on the current level
+				for (node v : m_pFinestLevel->m_pGraph->nodes) {
+					node w = v;
+					for (GalaxyMultilevel* level = m_pFinestLevel; level != m_pCurrentLevel;
+							level = level->m_pCoarserMultiLevel) {
+						w = (*level->m_pNodeInfo)[w].parent;
+					}
+					GA.x(v) = (*m_pCurrentNodeXPos)[w];
+					GA.y(v) = (*m_pCurrentNodeYPos)[w];
+				}
+			});
+}
+
 void FastMultipoleMultilevelEmbedder::nextLevel() {
 	m_pCurrentLevel = m_pCurrentLevel->m_pFinerMultiLevel;
 	std::swap(m_pLastNodeXPos, m_pCurrentNodeXPos);
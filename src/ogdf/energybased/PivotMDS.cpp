@@ -30,63 +30,222 @@
  */
 
 #include <ogdf/basic/Array.h>
+#include <ogdf/basic/CompactGraph.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphCopy.h>
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/exceptions.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/energybased/PivotMDS.h>
-#include <ogdf/graphalg/ShortestPathAlgorithms.h>
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
+#include <functional>
 #include <limits>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
 
 namespace ogdf {
 
 const double PivotMDS::EPSILON = 1 - 1e-10;
 const double PivotMDS::FACTOR = -0.5;
 
+namespace {
+
+//! Splits [0, \p count) into one range per thread and calls \p work(thread, begin, end) for each.
+/**
+ * The ranges only depend on \p count and the number of threads, so the results do not
+ * depend on the scheduling of the threads. The calling thread processes the first range.
+ */
+template<typename Work>
+void forEachRange(size_t count, unsigned int maxThreads, const Work& work) {
+	const size_t numberOfThreads = std::max<size_t>(1, std::min<size_t>(maxThreads, count));
+	std::vector<std::function<void()>> workers;
+	for (size_t t = 1; t < numberOfThreads; ++t) {
+		workers.emplace_back([&work, t, count, numberOfThreads] {
+			work(static_cast<unsigned int>(t), count * t / numberOfThreads,
+					count * (t + 1) / numberOfThreads);
+		});
+	}
+
+	Array<Thread> threads(static_cast<int>(workers.size()));
+	for (int i = 0; i < threads.size(); ++i) {
+		threads[i] = Thread(workers[i]);
+	}
+	work(0u, 0, count / numberOfThreads);
+	for (Thread& thread : threads) {
+		thread.join();
+	}
+}
+
+//! Returns the dot product of the arrays \p x and \p y of length \p length.
+/**
+ * The products are summed up in independent lanes, which allows the compiler to
+ * vectorize the loop without reordering floating-point additions.
+ */
+double dot(const double* x, const double* y, size_t length) {
+	constexpr size_t LANES = 8;
+	double lanes[LANES] = {};
+	size_t i = 0;
+	for (; i + LANES <= length; i += LANES) {
+		for (size_t l = 0; l < LANES; ++l) {
+			lanes[l] += x[i + l] * y[i + l];
+		}
+	}
+	double sum = 0;
+	for (; i < length; ++i) {
+		sum += x[i] * y[i];
+	}
+	for (double lane : lanes) {
+		sum += lane;
+	}
+	return sum;
+}
+
+//! Returns the number of columns of a matrix with \p rows rows that fit into the cache.
+size_t columnBlockSize(int rows) {
+	// about 256 KBytes, i.e. a fraction of the L2 cache, and a multiple of the lanes of dot()
+	return std::max<size_t>(64, (size_t(1) << 15) / rows) & ~size_t(7);
+}
+
+//! Single-source shortest-path searches in a CompactGraph that reuse their buffers.
+class PivotSearch {
+public:
+	//! Searches with the costs \p edgeCosts or, if it is \c nullptr, with \p uniformCosts.
+	PivotSearch(const CompactGraph& G, const EdgeArray<double>* edgeCosts, double uniformCosts)
+		: m_graph(G)
+		, m_edgeCosts(edgeCosts)
+		, m_uniformCosts(uniformCosts)
+		, m_distance(G.maxNodeIndex() + 1) { }
+
+	//! Stores the distances from the node with index \p s in \p row in the order of Graph::nodes.
+	void operator()(int s, double* row) {
+		std::fill(m_distance.begin(), m_distance.end(), std::numeric_limits<double>::infinity());
+		m_distance[s] = 0;
+		if (m_edgeCosts) {
+			dijkstra(s);
+		} else {
+			bfs(s);
+		}
+
+		const std::vector<int>& nodes = m_graph.nodes();
+		for (size_t j = 0; j < nodes.size(); ++j) {
+			row[j] = m_distance[nodes[j]];
+		}
+	}
+
+private:
+	const CompactGraph& m_graph;
+	const EdgeArray<double>* m_edgeCosts;
+	const double m_uniformCosts;
+	std::vector<double> m_distance; //!< The distances indexed by node index.
+	std::vector<int> m_queue;
+	std::vector<std::pair<double, int>> m_heap;
+
+	void bfs(int s) {
+		m_queue.clear();
+		m_queue.push_back(s);
+		for (size_t head = 0; head < m_queue.size(); ++head) {
+			int v = m_queue[head];
+			double d = m_distance[v] + m_uniformCosts;
+			for (int i = m_graph.firstAdj(v); i < m_graph.stopAdj(v); ++i) {
+				int w = m_graph.twinNode(i);
+				if (m_distance[w] == std::numeric_limits<double>::infinity()) {
+					m_distance[w] = d;
+					m_queue.push_back(w);
+				}
+			}
+		}
+	}
+
+	void dijkstra(int s) {
+		const auto greater = std::greater<std::pair<double, int>>();
+		m_heap.clear();
+		m_heap.emplace_back(0.0, s);
+		while (!m_heap.empty()) {
+			std::pop_heap(m_heap.begin(), m_heap.end(), greater);
+			std::pair<double, int> top = m_heap.back();
+			m_heap.pop_back();
+			int v = top.second;
+			// skip outdated entries
+			if (top.first > m_distance[v]) {
+				continue;
+			}
+			for (int i = m_graph.firstAdj(v); i < m_graph.stopAdj(v); ++i) {
+				int w = m_graph.twinNode(i);
+				double d = top.first + (*m_edgeCosts)[m_graph.edgeIndex(i)];
+				if (d < m_distance[w]) {
+					m_distance[w] = d;
+					m_heap.emplace_back(d, w);
+					std::push_heap(m_heap.begin(), m_heap.end(), greater);
+				}
+			}
+		}
+	}
+};
+
+}
+
 void PivotMDS::call(GraphAttributes& GA) {
 	OGDF_ASSERT(isConnected(GA.constGraph()));
 	OGDF_ASSERT(!m_hasEdgeCostsAttribute || GA.has(GraphAttributes::edgeDoubleWeight));
 	pivotMDSLayout(GA);
 }
 
-void PivotMDS::centerPivotmatrix(Array<Array<double>>& pivotMatrix) {
-	int numberOfPivots = pivotMatrix.size();
+void PivotMDS::centerPivotmatrix(std::vector<double>& pivotMatrix, int numberOfPivots) {
 	// this is ensured since the graph size is at least 2!
-	int nodeCount = pivotMatrix[0].size();
+	const size_t nodeCount = pivotMatrix.size() / numberOfPivots;
 
-	double normalizationFactor = 0;
-	double rowColNormalizer;
+	// square the entries and sum them up per pivot
 	Array<double> colNormalization(numberOfPivots);
-
-	for (int i = 0; i < numberOfPivots; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < nodeCount; j++) {
-			rowColNormalizer += pivotMatrix[i][j] * pivotMatrix[i][j];
+	forEachRange(numberOfPivots, m_maxThreads, [&](unsigned int, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			double* row = &pivotMatrix[i * nodeCount];
+			colNormalization[static_cast<int>(i)] = dot(row, row, nodeCount) / nodeCount;
+			for (size_t j = 0; j < nodeCount; j++) {
+				row[j] *= row[j];
+			}
 		}
+	});
+	double normalizationFactor = 0;
+	for (double rowColNormalizer : colNormalization) {
 		normalizationFactor += rowColNormalizer;
-		colNormalization[i] = rowColNormalizer / nodeCount;
 	}
-	normalizationFactor = normalizationFactor / (nodeCount * numberOfPivots);
-	for (int i = 0; i < nodeCount; i++) {
-		rowColNormalizer = 0;
-		for (int j = 0; j < numberOfPivots; j++) {
-			double square = pivotMatrix[j][i] * pivotMatrix[j][i];
-			pivotMatrix[j][i] = square + normalizationFactor - colNormalization[j];
-			rowColNormalizer += square;
-		}
-		rowColNormalizer /= numberOfPivots;
-		for (int j = 0; j < numberOfPivots; j++) {
-			pivotMatrix[j][i] = FACTOR * (pivotMatrix[j][i] - rowColNormalizer);
+	normalizationFactor /= numberOfPivots;
+
+	// center the squared entries, processing the columns in blocks
+	const size_t blockSize = columnBlockSize(numberOfPivots);
+	forEachRange(nodeCount, m_maxThreads, [&](unsigned int, size_t begin, size_t end) {
+		std::vector<double> rowColNormalizer(blockSize);
+		for (size_t first = begin; first < end; first += blockSize) {
+			const size_t length = std::min(blockSize, end - first);
+			std::fill(rowColNormalizer.begin(), rowColNormalizer.end(), 0.0);
+			for (int i = 0; i < numberOfPivots; i++) {
+				const double* row = &pivotMatrix[i * nodeCount + first];
+				for (size_t j = 0; j < length; j++) {
+					rowColNormalizer[j] += row[j];
+				}
+			}
+			for (size_t j = 0; j < length; j++) {
+				rowColNormalizer[j] /= numberOfPivots;
+			}
+			for (int i = 0; i < numberOfPivots; i++) {
+				double* row = &pivotMatrix[i * nodeCount + first];
+				const double offset = normalizationFactor - colNormalization[i];
+				for (size_t j = 0; j < length; j++) {
+					row[j] = FACTOR * (row[j] + offset - rowColNormalizer[j]);
+				}
+			}
 		}
-	}
+	});
 }
 
 void PivotMDS::pivotMDSLayout(GraphAttributes& GA) {
@@ -116,11 +275,11 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA) {
 	if (head != nullptr) {
 		doPathLayout(GA, head);
 	} else {
-		Array<Array<double>> pivDistMatrix;
+		std::vector<double> pivDistMatrix;
 		// compute the pivot matrix
-		getPivotDistanceMatrix(GA, pivDistMatrix);
+		const int numberOfPivots = getPivotDistanceMatrix(GA, pivDistMatrix);
 		// center the pivot matrix
-		centerPivotmatrix(pivDistMatrix);
+		centerPivotmatrix(pivDistMatrix, numberOfPivots);
 		// init the coordinate matrix
 		Array<Array<double>> coord(m_dimensionCount);
 		for (auto& elem : coord) {
@@ -128,7 +287,7 @@ void PivotMDS::pivotMDSLayout(GraphAttributes& GA) {
 		}
 		// init the eigen values array
 		Array<double> eVals(m_dimensionCount);
-		singularValueDecomposition(pivDistMatrix, coord, eVals);
+		singularValueDecomposition(pivDistMatrix, numberOfPivots, coord, eVals);
 		// compute the correct aspect ratio
 		for (int i = 0; i < coord.size(); i++) {
 			eVals[i] = sqrt(eVals[i]);
@@ -178,14 +337,18 @@ void PivotMDS::doPathLayout(GraphAttributes& GA, const node& v) {
 	} while (cur != oldCur);
 }
 
-void PivotMDS::eigenValueDecomposition(Array<Array<double>>& K, Array<Array<double>>& eVecs,
-		Array<double>& eValues) {
+void PivotMDS::eigenValueDecomposition(const std::vector<double>& K,
+		Array<Array<double>>& eVecs, Array<double>& eValues) {
 	randomize(eVecs);
-	const int p = K.size();
+	const int p = eVecs[0].size();
 	double r = 0;
 	for (int i = 0; i < m_dimensionCount; i++) {
 		eValues[i] = normalize(eVecs[i]);
 	}
+	Array<Array<double>> tmpOld(m_dimensionCount);
+	for (int i = 0; i < m_dimensionCount; i++) {
+		tmpOld[i].init(p);
+	}
 	while (r < EPSILON) {
 		if (std::isnan(r) || isinf(r)) {
 			// Throw arithmetic exception (Shouldn't occur
@@ -194,19 +357,20 @@ void PivotMDS::eigenValueDecomposition(Array<Array<double>>& K, Array<Array<doub
 			return;
 		}
 		// remember prev values
-		Array<Array<double>> tmpOld(m_dimensionCount);
 		for (int i = 0; i < m_dimensionCount; i++) {
-			tmpOld[i].init(p);
 			for (int j = 0; j < p; j++) {
 				tmpOld[i][j] = eVecs[i][j];
 				eVecs[i][j] = 0;
 			}
 		}
-		// multiply matrices
-		for (int i = 0; i < m_dimensionCount; i++) {
-			for (int j = 0; j < p; j++) {
+		// multiply matrices, reading each row of K once for all vectors
+		for (int j = 0; j < p; j++) {
+			const double* row = &K[size_t(j) * p];
+			for (int i = 0; i < m_dimensionCount; i++) {
+				const double factor = tmpOld[i][j];
+				double* eVec = &eVecs[i][0];
 				for (int k = 0; k < p; k++) {
-					eVecs[i][k] += K[j][k] * tmpOld[i][j];
+					eVec[k] += row[k] * factor;
 				}
 			}
 		}
@@ -235,62 +399,65 @@ void PivotMDS::eigenValueDecomposition(Array<Array<double>>& K, Array<Array<doub
 	}
 }
 
-void PivotMDS::getPivotDistanceMatrix(const GraphAttributes& GA, Array<Array<double>>& pivDistMatrix) {
+int PivotMDS::getPivotDistanceMatrix(const GraphAttributes& GA, std::vector<double>& pivDistMatrix) {
 	const Graph& G = GA.constGraph();
-	const int n = G.numberOfNodes();
+	const CompactGraph CG(G);
+	const size_t n = CG.numberOfNodes();
+	const std::vector<int>& nodes = CG.nodes();
 
 	// lower the number of pivots if necessary
-	int numberOfPivots = min(n, m_numberOfPivots);
+	const int numberOfPivots = min(CG.numberOfNodes(), m_numberOfPivots);
 	// number of pivots times n matrix used to store the graph distances
-	pivDistMatrix.init(numberOfPivots);
-	for (int i = 0; i < numberOfPivots; i++) {
-		pivDistMatrix[i].init(n);
-	}
+	pivDistMatrix.resize(numberOfPivots * n);
 	// edges costs array
 	EdgeArray<double> edgeCosts;
-	bool hasEdgeCosts = false;
 	// already checked whether this attribute exists or not (see call method)
 	if (m_hasEdgeCostsAttribute) {
 		edgeCosts.init(G);
 		for (edge e : G.edges) {
 			edgeCosts[e] = GA.doubleWeight(e);
 		}
-		hasEdgeCosts = true;
 	}
-	// used for min-max strategy
-	NodeArray<double> minDistances(G, std::numeric_limits<double>::infinity());
-	NodeArray<double> shortestPathSingleSource(G);
-	// the current pivot node
-	node pivNode = G.firstNode();
-	for (int i = 0; i < numberOfPivots; i++) {
-		// get the shortest path from the currently processed pivot node to
-		// all other nodes in the graph
-		shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
-		if (hasEdgeCosts) {
-			dijkstra_SPSS(pivNode, G, shortestPathSingleSource, edgeCosts);
-		} else {
-			bfs_SPSS(pivNode, G, shortestPathSingleSource, m_edgeCosts);
+	const EdgeArray<double>* pEdgeCosts = m_hasEdgeCostsAttribute ? &edgeCosts : nullptr;
+
+	if (m_pivotSelection == PivotSelection::Random) {
+		// draw the positions of the pivots by a partial Fisher-Yates shuffle
+		std::vector<size_t> pivots(n);
+		std::iota(pivots.begin(), pivots.end(), 0);
+		std::minstd_rand random(SEED);
+		for (size_t i = 0; i < size_t(numberOfPivots); i++) {
+			std::swap(pivots[i], pivots[i + random() % (n - i)]);
 		}
-		copySPSS(pivDistMatrix[i], shortestPathSingleSource);
-		// update the pivot and the minDistances array ... to ensure the
-		// correctness set minDistance of the pivot node to zero
-		minDistances[pivNode] = 0;
-		for (node v : G.nodes) {
-			Math::updateMin(minDistances[v], shortestPathSingleSource[v]);
-			if (minDistances[v] > minDistances[pivNode]) {
-				pivNode = v;
+		// the searches are independent of each other
+		forEachRange(numberOfPivots, m_maxThreads, [&](unsigned int, size_t begin, size_t end) {
+			PivotSearch search(CG, pEdgeCosts, m_edgeCosts);
+			for (size_t i = begin; i < end; i++) {
+				search(nodes[pivots[i]], &pivDistMatrix[i * n]);
+			}
+		});
+	} else {
+		// used for min-max strategy
+		std::vector<double> minDistances(n, std::numeric_limits<double>::infinity());
+		PivotSearch search(CG, pEdgeCosts, m_edgeCosts);
+		// the position of the current pivot node
+		size_t pivot = 0;
+		for (size_t i = 0; i < size_t(numberOfPivots); i++) {
+			// get the shortest path from the currently processed pivot node to
+			// all other nodes in the graph
+			double* row = &pivDistMatrix[i * n];
+			search(nodes[pivot], row);
+			// update the pivot and the minDistances array ... to ensure the
+			// correctness set minDistance of the pivot node to zero
+			minDistances[pivot] = 0;
+			for (size_t j = 0; j < n; j++) {
+				Math::updateMin(minDistances[j], row[j]);
+				if (minDistances[j] > minDistances[pivot]) {
+					pivot = j;
+				}
 			}
 		}
 	}
-}
-
-void PivotMDS::copySPSS(Array<double>& copyTo, NodeArray<double>& copyFrom) {
-	const Graph& G = *copyFrom.graphOf();
-
-	int i = 0;
-	for (node v : G.nodes) {
-		copyTo[i++] = copyFrom[v];
-	}
+	return numberOfPivots;
 }
 
 node PivotMDS::getRootedPath(const Graph& G) {
@@ -327,11 +494,7 @@ double PivotMDS::normalize(Array<double>& x) {
 }
 
 double PivotMDS::prod(const Array<double>& x, const Array<double>& y) {
-	double result = 0;
-	for (int i = 0; i < x.size(); i++) {
-		result += x[i] * y[i];
-	}
-	return result;
+	return dot(&x[0], &y[0], x.size());
 }
 
 void PivotMDS::randomize(Array<Array<double>>& matrix) {
@@ -343,48 +506,77 @@ void PivotMDS::randomize(Array<Array<double>>& matrix) {
 	}
 }
 
-void PivotMDS::selfProduct(const Array<Array<double>>& d, Array<Array<double>>& result) {
-	double sum;
-	for (int i = 0; i < d.size(); i++) {
+void PivotMDS::selfProduct(const std::vector<double>& d, int rows, std::vector<double>& result) {
+	const size_t columns = d.size() / rows;
+	const size_t blockSize = columnBlockSize(rows);
+
+	// each thread sums up the lower triangle of its columns separately
+	const size_t numberOfThreads = std::max<size_t>(1, std::min<size_t>(m_maxThreads, columns));
+	std::vector<std::vector<double>> partialResults(numberOfThreads);
+	forEachRange(columns, m_maxThreads, [&](unsigned int t, size_t begin, size_t end) {
+		std::vector<double>& partial = partialResults[t];
+		partial.assign(size_t(rows) * rows, 0.0);
+		for (size_t first = begin; first < end; first += blockSize) {
+			const size_t length = std::min(blockSize, end - first);
+			for (int i = 0; i < rows; i++) {
+				const double* rowI = &d[i * columns + first];
+				for (int j = 0; j <= i; j++) {
+					partial[size_t(i) * rows + j] += dot(rowI, &d[j * columns + first], length);
+				}
+			}
+		}
+	});
+
+	result.assign(size_t(rows) * rows, 0.0);
+	for (int i = 0; i < rows; i++) {
 		for (int j = 0; j <= i; j++) {
-			sum = 0;
-			for (int k = 0; k < d[0].size(); k++) {
-				sum += d[i][k] * d[j][k];
+			double sum = 0;
+			for (const std::vector<double>& partial : partialResults) {
+				sum += partial[size_t(i) * rows + j];
 			}
-			result[i][j] = sum;
-			result[j][i] = sum;
+			result[size_t(i) * rows + j] = sum;
+			result[size_t(j) * rows + i] = sum;
 		}
 	}
 }
 
-void PivotMDS::singularValueDecomposition(Array<Array<double>>& pivDistMatrix,
+void PivotMDS::singularValueDecomposition(const std::vector<double>& C, int numberOfPivots,
 		Array<Array<double>>& eVecs, Array<double>& eVals) {
-	const int size = pivDistMatrix.size();
-	const int n = pivDistMatrix[0].size();
-	Array<Array<double>> K(size);
-	for (int i = 0; i < size; i++) {
-		K[i].init(size);
-	}
+	const size_t n = C.size() / numberOfPivots;
 	// calc C^TC
-	selfProduct(pivDistMatrix, K);
+	std::vector<double> K;
+	selfProduct(C, numberOfPivots, K);
 
 	Array<Array<double>> tmp(m_dimensionCount);
 	for (int i = 0; i < m_dimensionCount; i++) {
-		tmp[i].init(size);
+		tmp[i].init(numberOfPivots);
 	}
 
 	eigenValueDecomposition(K, tmp, eVals);
 
-	// C^Tx
+	// C^Tx, reading each block of the pivot matrix once for all vectors
 	for (int i = 0; i < m_dimensionCount; i++) {
 		eVals[i] = sqrt(eVals[i]);
-		for (int j = 0; j < n; j++) { // node j
-			eVecs[i][j] = 0;
-			for (int k = 0; k < size; k++) { // pivot k
-				eVecs[i][j] += pivDistMatrix[k][j] * tmp[i][k];
+	}
+	const size_t blockSize = columnBlockSize(numberOfPivots);
+	forEachRange(n, m_maxThreads, [&](unsigned int, size_t begin, size_t end) {
+		for (size_t first = begin; first < end; first += blockSize) {
+			const size_t length = std::min(blockSize, end - first);
+			for (int i = 0; i < m_dimensionCount; i++) {
+				std::fill_n(&eVecs[i][static_cast<int>(first)], length, 0.0);
+			}
+			for (int k = 0; k < numberOfPivots; k++) { // pivot k
+				const double* row = &C[k * n + first];
+				for (int i = 0; i < m_dimensionCount; i++) {
+					const double factor = tmp[i][k];
+					double* eVec = &eVecs[i][static_cast<int>(first)];
+					for (size_t j = 0; j < length; j++) { // node first + j
+						eVec[j] += row[j] * factor;
+					}
+				}
 			}
 		}
-	}
+	});
 	for (int i = 0; i < m_dimensionCount; i++) {
 		normalize(eVecs[i]);
 	}
@@ -43,6 +43,7 @@
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/SpringEmbedderGridVariant.h>
 #include <ogdf/energybased/SpringForceModel.h>
+#include <ogdf/energybased/spring_embedder/BarnesHutTree.h>
 #include <ogdf/energybased/spring_embedder/MasterBase.h>
 #include <ogdf/energybased/spring_embedder/SEGV_ForceModel.h>
 #include <ogdf/energybased/spring_embedder/SpringEmbedderBase.h>
@@ -64,9 +65,13 @@ namespace ogdf {
 
 class SpringEmbedderGridVariant::Master
 	: public spring_embedder::MasterBase<NodeInfo, ForceModelBase> {
+	const SpringEmbedderGridVariant& m_layout;
 	Array<Worker*> m_worker;
 	Array2D<ListPure<int>> m_gridCell;
 
+	int m_iteration = 0; //!< The number of iterations performed in both phases.
+	bool m_stopped; //!< Whether the progress callback or the time limit stopped the layout.
+
 	double m_k2;
 
 	double m_xmin;
@@ -90,6 +95,11 @@ public:
 	void updateGridAndMoveNodes();
 	void scaleLayout(double sumLengths);
 	void computeFinalBB();
+
+	//! Reports the progress after an iteration; has to be called by the first worker.
+	void reportProgress();
+
+	bool stopped() const { return m_stopped; }
 };
 
 class SpringEmbedderGridVariant::Worker : spring_embedder::WorkerBase<Master, NodeInfo> {
@@ -109,7 +119,9 @@ public:
 
 SpringEmbedderGridVariant::Master::Master(const SpringEmbedderGridVariant& spring,
 		const GraphCopy& gc, GraphAttributes& ga, DPoint& boundingBox)
-	: spring_embedder::MasterBase<NodeInfo, ForceModelBase>(spring, gc, ga, boundingBox) {
+	: spring_embedder::MasterBase<NodeInfo, ForceModelBase>(spring, gc, ga, boundingBox)
+	, m_layout(spring)
+	, m_stopped(spring.stopRequested()) {
 	const unsigned int minNodesPerThread = 64;
 	const unsigned int n = gc.numberOfNodes();
 
@@ -315,6 +327,12 @@ void SpringEmbedderGridVariant::Master::initialize(double wsum, double hsum, dou
 		break;
 	}
 
+	if (useBarnesHut()) {
+		m_forceModel->useBarnesHut(&m_barnesHutTree);
+		m_forceModelImprove->useBarnesHut(&m_barnesHutTree);
+		buildBarnesHutTree();
+	}
+
 	// build grid cells
 	int xA = int(width / m_k2 + 2);
 	int yA = int(height / m_k2 + 2);
@@ -394,6 +412,8 @@ void SpringEmbedderGridVariant::Master::updateGridAndMoveNodes() {
 			vj.m_gridY = grid_y;
 		}
 	}
+
+	buildBarnesHutTree();
 }
 
 void SpringEmbedderGridVariant::Master::computeFinalBB() {
@@ -433,6 +453,22 @@ void SpringEmbedderGridVariant::Master::scaleLayout(double sumLengths) {
 
 	m_k2 = max((m_xmax - m_xmin) / (m_gridCell.high1() - 1),
 			(m_ymax - m_ymin) / (m_gridCell.high2() - 1));
+
+	// the workers scale the positions in the same way
+	if (useBarnesHut()) {
+		m_barnesHutTree.scale(m_scaleFactor);
+	}
+}
+
+void SpringEmbedderGridVariant::Master::reportProgress() {
+	m_stopped = !m_layout.reportProgress(0, ++m_iteration, [&](GraphAttributes& GA) {
+		for (node v : m_gc.nodes) {
+			const DPoint& pos = m_vInfo[m_index[v]].m_pos;
+			node vOrig = m_gc.original(v);
+			GA.x(vOrig) = pos.m_x;
+			GA.y(vOrig) = pos.m_y;
+		}
+	});
 }
 
 void SpringEmbedderGridVariant::callMaster(const GraphCopy& copy, GraphAttributes& attr, DPoint& box) {
@@ -515,7 +551,7 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 	const ForceModelBase& forceModel = m_master.forceModel();
 
 	const int numIter = m_master.numberOfIterations();
-	for (int iter = 1; !m_master.hasConverged() && iter <= numIter; ++iter) {
+	for (int iter = 1; !m_master.hasConverged() && !m_master.stopped() && iter <= numIter; ++iter) {
 		double boxLength = m_master.boxLength();
 
 		xmin = std::numeric_limits<double>::max();
@@ -572,6 +608,7 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 		if (m_id == 0) {
 			m_master.updateGridAndMoveNodes();
 			m_master.coolDown();
+			m_master.reportProgress();
 		}
 
 		m_master.syncThreads();
@@ -587,7 +624,8 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 
 		const ForceModelBase& forceModelImprove = m_master.forceModelImprove();
 
-		for (int iter = 1; !m_master.hasConverged() && iter <= numIterImp; ++iter) {
+		for (int iter = 1; !m_master.hasConverged() && !m_master.stopped() && iter <= numIterImp;
+				++iter) {
 			double boxLength = m_master.boxLength();
 
 			xmin = std::numeric_limits<double>::max();
@@ -651,6 +689,7 @@ void SpringEmbedderGridVariant::Worker::operator()() {
 			} else if (m_id == 0) {
 				m_master.updateGridAndMoveNodes();
 				m_master.coolDown();
+				m_master.reportProgress();
 			}
 
 			m_master.syncThreads();
@@ -29,33 +29,317 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
+#include <ogdf/basic/CompactGraph.h>
 #include <ogdf/basic/EpsilonTest.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/Math.h>
-#include <ogdf/basic/SList.h>
+#include <ogdf/basic/System.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/geometry.h>
+#include <ogdf/basic/internal/intrinsics.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/basic/tuples.h>
 #include <ogdf/energybased/SpringEmbedderKK.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
 
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 namespace ogdf {
+
+namespace {
+
+//! The instruction set used for the sums over all springs of a node.
+enum class Vectorization { None, SSE3, AVX2 };
+
+Vectorization availableVectorization() {
+#ifdef OGDF_AVX2_EXTENSIONS
+	if (System::cpuSupports(CPUFeature::AVX2)) {
+		return Vectorization::AVX2;
+	}
+#endif
+#ifdef OGDF_SSE3_EXTENSIONS
+	if (System::cpuSupports(CPUFeature::SSE3)) {
+		return Vectorization::SSE3;
+	}
+#endif
+	return Vectorization::None;
+}
+
+//! The gradient (dx, dy) and the Hessian of the energy with respect to the position of a node.
+struct EnergyDerivatives {
+	double dx = 0.0;
+	double dy = 0.0;
+	double dxx = 0.0;
+	double dxy = 0.0;
+	double dyy = 0.0;
+};
+
+// The kernels below get the positions (x, y) of all nodes and the strengths and lengths of
+// the springs of node m, all indexed by node index. Pairs at distance 0 (in particular m
+// itself) contribute nothing to the gradient, and entries with strength 0 contribute nothing
+// at all.
+
+//! Adds the terms of the springs of m to the nodes in [\p begin, \p end) to \p der.
+void addDerivatives(int m, const double* x, const double* y, const double* strength,
+		const double* length, int begin, int end, EnergyDerivatives& der) {
+	for (int u = begin; u < end; ++u) {
+		double x_diff = x[m] - x[u];
+		double y_diff = y[m] - y[u];
+		double distSquare = x_diff * x_diff + y_diff * y_diff;
+		double invDist = distSquare > 0.0 ? 1.0 / sqrt(distSquare) : 0.0;
+		double l_invDist = length[u] * invDist;
+		double l_invDist3 = l_invDist * invDist * invDist;
+		der.dx += strength[u] * (x_diff - l_invDist * x_diff);
+		der.dy += strength[u] * (y_diff - l_invDist * y_diff);
+		der.dxx += strength[u] * (1.0 - l_invDist3 * y_diff * y_diff);
+		der.dxy += strength[u] * l_invDist3 * x_diff * y_diff;
+		der.dyy += strength[u] * (1.0 - l_invDist3 * x_diff * x_diff);
+	}
+}
+
+//! Stores the contribution of m to the gradient of each node u in [\p begin, \p end) at
+//! (\p cx[u], \p cy[u]).
+void computeContributions(int m, const double* x, const double* y, const double* strength,
+		const double* length, int begin, int end, double* cx, double* cy) {
+	for (int u = begin; u < end; ++u) {
+		double x_diff = x[u] - x[m];
+		double y_diff = y[u] - y[m];
+		double distSquare = x_diff * x_diff + y_diff * y_diff;
+		double invDist = distSquare > 0.0 ? 1.0 / sqrt(distSquare) : 0.0;
+		cx[u] = strength[u] * (x_diff - length[u] * invDist * x_diff);
+		cy[u] = strength[u] * (y_diff - length[u] * invDist * y_diff);
+	}
+}
+
+#ifdef OGDF_SSE3_EXTENSIONS
+void addDerivatives_sse3(int m, const double* x, const double* y, const double* strength,
+		const double* length, int n, EnergyDerivatives& der) {
+	const int vecEnd = n - n % 2;
+	const __m128d mm_zero = _mm_setzero_pd();
+	const __m128d mm_one = _mm_set1_pd(1.0);
+	const __m128d mm_xm = _mm_set1_pd(x[m]);
+	const __m128d mm_ym = _mm_set1_pd(y[m]);
+	__m128d mm_dx = mm_zero, mm_dy = mm_zero, mm_dxx = mm_zero, mm_dxy = mm_zero,
+			mm_dyy = mm_zero;
+
+	for (int u = 0; u < vecEnd; u += 2) {
+		__m128d mm_x_diff = _mm_sub_pd(mm_xm, _mm_loadu_pd(x + u));
+		__m128d mm_y_diff = _mm_sub_pd(mm_ym, _mm_loadu_pd(y + u));
+		__m128d mm_distSquare =
+				_mm_add_pd(_mm_mul_pd(mm_x_diff, mm_x_diff), _mm_mul_pd(mm_y_diff, mm_y_diff));
+		__m128d mm_invDist = _mm_and_pd(_mm_cmpgt_pd(mm_distSquare, mm_zero),
+				_mm_div_pd(mm_one, _mm_sqrt_pd(mm_distSquare)));
+		__m128d mm_strength = _mm_loadu_pd(strength + u);
+		__m128d mm_l_invDist = _mm_mul_pd(_mm_loadu_pd(length + u), mm_invDist);
+		__m128d mm_l_invDist3 = _mm_mul_pd(mm_l_invDist, _mm_mul_pd(mm_invDist, mm_invDist));
+
+		mm_dx = _mm_add_pd(mm_dx,
+				_mm_mul_pd(mm_strength,
+						_mm_sub_pd(mm_x_diff, _mm_mul_pd(mm_l_invDist, mm_x_diff))));
+		mm_dy = _mm_add_pd(mm_dy,
+				_mm_mul_pd(mm_strength,
+						_mm_sub_pd(mm_y_diff, _mm_mul_pd(mm_l_invDist, mm_y_diff))));
+		mm_dxx = _mm_add_pd(mm_dxx,
+				_mm_mul_pd(mm_strength,
+						_mm_sub_pd(mm_one,
+								_mm_mul_pd(mm_l_invDist3, _mm_mul_pd(mm_y_diff, mm_y_diff)))));
+		mm_dxy = _mm_add_pd(mm_dxy,
+				_mm_mul_pd(mm_strength,
+						_mm_mul_pd(mm_l_invDist3, _mm_mul_pd(mm_x_diff, mm_y_diff))));
+		mm_dyy = _mm_add_pd(mm_dyy,
+				_mm_mul_pd(mm_strength,
+						_mm_sub_pd(mm_one,
+								_mm_mul_pd(mm_l_invDist3, _mm_mul_pd(mm_x_diff, mm_x_diff)))));
+	}
+
+	double sums[2];
+	_mm_storeu_pd(sums, _mm_hadd_pd(mm_dx, mm_dy));
+	der.dx += sums[0];
+	der.dy += sums[1];
+	_mm_storeu_pd(sums, _mm_hadd_pd(mm_dxx, mm_dxy));
+	der.dxx += sums[0];
+	der.dxy += sums[1];
+	_mm_storeu_pd(sums, _mm_hadd_pd(mm_dyy, mm_dyy));
+	der.dyy += sums[0];
+
+	addDerivatives(m, x, y, strength, length, vecEnd, n, der);
+}
+
+void computeContributions_sse3(int m, const double* x, const double* y, const double* strength,
+		const double* length, int n, double* cx, double* cy) {
+	const int vecEnd = n - n % 2;
+	const __m128d mm_zero = _mm_setzero_pd();
+	const __m128d mm_one = _mm_set1_pd(1.0);
+	const __m128d mm_xm = _mm_set1_pd(x[m]);
+	const __m128d mm_ym = _mm_set1_pd(y[m]);
+
+	for (int u = 0; u < vecEnd; u += 2) {
+		__m128d mm_x_diff = _mm_sub_pd(_mm_loadu_pd(x + u), mm_xm);
+		__m128d mm_y_diff = _mm_sub_pd(_mm_loadu_pd(y + u), mm_ym);
+		__m128d mm_distSquare =
+				_mm_add_pd(_mm_mul_pd(mm_x_diff, mm_x_diff), _mm_mul_pd(mm_y_diff, mm_y_diff));
+		__m128d mm_invDist = _mm_and_pd(_mm_cmpgt_pd(mm_distSquare, mm_zero),
+				_mm_div_pd(mm_one, _mm_sqrt_pd(mm_distSquare)));
+		__m128d mm_strength = _mm_loadu_pd(strength + u);
+		__m128d mm_l_invDist = _mm_mul_pd(_mm_loadu_pd(length + u), mm_invDist);
+		_mm_storeu_pd(cx + u,
+				_mm_mul_pd(mm_strength,
+						_mm_sub_pd(mm_x_diff, _mm_mul_pd(mm_l_invDist, mm_x_diff))));
+		_mm_storeu_pd(cy + u,
+				_mm_mul_pd(mm_strength,
+						_mm_sub_pd(mm_y_diff, _mm_mul_pd(mm_l_invDist, mm_y_diff))));
+	}
+
+	computeContributions(m, x, y, strength, length, vecEnd, n, cx, cy);
+}
+#endif
+
+#ifdef OGDF_AVX2_EXTENSIONS
+// returns the sum of the four lanes of a
+inline double horizontalSum(__m256d a) {
+	__m128d sum = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+	return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+void addDerivatives_avx2(int m, const double* x, const double* y, const double* strength,
+		const double* length, int n, EnergyDerivatives& der) {
+	const int vecEnd = n - n % 4;
+	const __m256d mm_zero = _mm256_setzero_pd();
+	const __m256d mm_one = _mm256_set1_pd(1.0);
+	const __m256d mm_xm = _mm256_set1_pd(x[m]);
+	const __m256d mm_ym = _mm256_set1_pd(y[m]);
+	__m256d mm_dx = mm_zero, mm_dy = mm_zero, mm_dxx = mm_zero, mm_dxy = mm_zero,
+			mm_dyy = mm_zero;
+
+	for (int u = 0; u < vecEnd; u += 4) {
+		__m256d mm_x_diff = _mm256_sub_pd(mm_xm, _mm256_loadu_pd(x + u));
+		__m256d mm_y_diff = _mm256_sub_pd(mm_ym, _mm256_loadu_pd(y + u));
+		__m256d mm_distSquare = _mm256_add_pd(_mm256_mul_pd(mm_x_diff, mm_x_diff),
+				_mm256_mul_pd(mm_y_diff, mm_y_diff));
+		__m256d mm_invDist = _mm256_and_pd(_mm256_cmp_pd(mm_distSquare, mm_zero, _CMP_GT_OQ),
+				_mm256_div_pd(mm_one, _mm256_sqrt_pd(mm_distSquare)));
+		__m256d mm_strength = _mm256_loadu_pd(strength + u);
+		__m256d mm_l_invDist = _mm256_mul_pd(_mm256_loadu_pd(length + u), mm_invDist);
+		__m256d mm_l_invDist3 =
+				_mm256_mul_pd(mm_l_invDist, _mm256_mul_pd(mm_invDist, mm_invDist));
+
+		mm_dx = _mm256_add_pd(mm_dx,
+				_mm256_mul_pd(mm_strength,
+						_mm256_sub_pd(mm_x_diff, _mm256_mul_pd(mm_l_invDist, mm_x_diff))));
+		mm_dy = _mm256_add_pd(mm_dy,
+				_mm256_mul_pd(mm_strength,
+						_mm256_sub_pd(mm_y_diff, _mm256_mul_pd(mm_l_invDist, mm_y_diff))));
+		mm_dxx = _mm256_add_pd(mm_dxx,
+				_mm256_mul_pd(mm_strength,
+						_mm256_sub_pd(mm_one,
+								_mm256_mul_pd(mm_l_invDist3,
+										_mm256_mul_pd(mm_y_diff, mm_y_diff)))));
+		mm_dxy = _mm256_add_pd(mm_dxy,
+				_mm256_mul_pd(mm_strength,
+						_mm256_mul_pd(mm_l_invDist3, _mm256_mul_pd(mm_x_diff, mm_y_diff))));
+		mm_dyy = _mm256_add_pd(mm_dyy,
+				_mm256_mul_pd(mm_strength,
+						_mm256_sub_pd(mm_one,
+								_mm256_mul_pd(mm_l_invDist3,
+										_mm256_mul_pd(mm_x_diff, mm_x_diff)))));
+	}
+
+	der.dx += horizontalSum(mm_dx);
+	der.dy += horizontalSum(mm_dy);
+	der.dxx += horizontalSum(mm_dxx);
+	der.dxy += horizontalSum(mm_dxy);
+	der.dyy += horizontalSum(mm_dyy);
+
+	addDerivatives(m, x, y, strength, length, vecEnd, n, der);
+}
+
+void computeContributions_avx2(int m, const double* x, const double* y, const double* strength,
+		const double* length, int n, double* cx, double* cy) {
+	const int vecEnd = n - n % 4;
+	const __m256d mm_zero = _mm256_setzero_pd();
+	const __m256d mm_one = _mm256_set1_pd(1.0);
+	const __m256d mm_xm = _mm256_set1_pd(x[m]);
+	const __m256d mm_ym = _mm256_set1_pd(y[m]);
+
+	for (int u = 0; u < vecEnd; u += 4) {
+		__m256d mm_x_diff = _mm256_sub_pd(_mm256_loadu_pd(x + u), mm_xm);
+		__m256d mm_y_diff = _mm256_sub_pd(_mm256_loadu_pd(y + u), mm_ym);
+		__m256d mm_distSquare = _mm256_add_pd(_mm256_mul_pd(mm_x_diff, mm_x_diff),
+				_mm256_mul_pd(mm_y_diff, mm_y_diff));
+		__m256d mm_invDist = _mm256_and_pd(_mm256_cmp_pd(mm_distSquare, mm_zero, _CMP_GT_OQ),
+				_mm256_div_pd(mm_one, _mm256_sqrt_pd(mm_distSquare)));
+		__m256d mm_strength = _mm256_loadu_pd(strength + u);
+		__m256d mm_l_invDist = _mm256_mul_pd(_mm256_loadu_pd(length + u), mm_invDist);
+		_mm256_storeu_pd(cx + u,
+				_mm256_mul_pd(mm_strength,
+						_mm256_sub_pd(mm_x_diff, _mm256_mul_pd(mm_l_invDist, mm_x_diff))));
+		_mm256_storeu_pd(cy + u,
+				_mm256_mul_pd(mm_strength,
+						_mm256_sub_pd(mm_y_diff, _mm256_mul_pd(mm_l_invDist, mm_y_diff))));
+	}
+
+	computeContributions(m, x, y, strength, length, vecEnd, n, cx, cy);
+}
+#endif
+
+//! Returns the derivatives of the energy with respect to the position of m.
+EnergyDerivatives sumDerivatives(Vectorization vectorization, int m, const double* x,
+		const double* y, const double* strength, const double* length, int n) {
+	EnergyDerivatives der;
+	switch (vectorization) {
+#ifdef OGDF_AVX2_EXTENSIONS
+	case Vectorization::AVX2:
+		addDerivatives_avx2(m, x, y, strength, length, n, der);
+		break;
+#endif
+#ifdef OGDF_SSE3_EXTENSIONS
+	case Vectorization::SSE3:
+		addDerivatives_sse3(m, x, y, strength, length, n, der);
+		break;
+#endif
+	default:
+		addDerivatives(m, x, y, strength, length, 0, n, der);
+	}
+	return der;
+}
+
+//! Stores the contributions of m to the gradients of all nodes in \p cx and \p cy.
+void computeContributions(Vectorization vectorization, int m, const double* x, const double* y,
+		const double* strength, const double* length, int n, double* cx, double* cy) {
+	switch (vectorization) {
+#ifdef OGDF_AVX2_EXTENSIONS
+	case Vectorization::AVX2:
+		computeContributions_avx2(m, x, y, strength, length, n, cx, cy);
+		break;
+#endif
+#ifdef OGDF_SSE3_EXTENSIONS
+	case Vectorization::SSE3:
+		computeContributions_sse3(m, x, y, strength, length, n, cx, cy);
+		break;
+#endif
+	default:
+		computeContributions(m, x, y, strength, length, 0, n, cx, cy);
+	}
+}
+
+}
+
 const double SpringEmbedderKK::startVal = std::numeric_limits<double>::max() - 1.0;
 const double SpringEmbedderKK::minVal = DBL_MIN;
 const double SpringEmbedderKK::desMinLength = 0.0001;
 const int SpringEmbedderKK::maxVal = std::numeric_limits<int>::max();
 
 void SpringEmbedderKK::initialize(GraphAttributes& GA, NodeArray<dpair>& partialDer,
-		const EdgeArray<double>& eLength, NodeArray<NodeArray<double>>& oLength,
-		NodeArray<NodeArray<double>>& sstrength, bool simpleBFS) {
+		const EdgeArray<double>& eLength, DistanceMatrix<double>& oLength,
+		DistanceMatrix<double>& sstrength, bool simpleBFS) {
 	double maxDist;
 	const Graph& G = GA.constGraph();
 	m_prevEnergy = startVal;
@@ -67,15 +351,9 @@ void SpringEmbedderKK::initialize(GraphAttributes& GA, NodeArray<dpair>& partial
 		shufflePositions(GA);
 	}
 
-	//the shortest path lengths
-	for (node v : G.nodes) {
-		oLength[v].init(G, std::numeric_limits<double>::max());
-	}
-
 	//computes shortest path distances d_ij
 	if (simpleBFS) {
-		//we use simply BFS n times
-		//TODO experimentally compare speed, also with bintree dijkstra
+		//we use simply BFS n times, distributed over the threads
 #if 0
 #	ifdef OGDF_DEBUG
 		double timeUsed;
@@ -93,9 +371,8 @@ void SpringEmbedderKK::initialize(GraphAttributes& GA, NodeArray<dpair>& partial
 	} else {
 		EdgeArray<double> adaptedLength(G);
 		adaptLengths(G, GA, eLength, adaptedLength);
-		//we use simply the BFM n times or Floyd instead, leading to cubic runtime
-		//TODO experimentally compare speed, also with bintree dijkstra
-		maxDist = allpairssp(G, adaptedLength, oLength, std::numeric_limits<double>::max());
+		//we use Dijkstra n times, the lengths are non-negative
+		maxDist = allpairssp(G, adaptedLength, oLength);
 	}
 	//computes original spring length l_ij
 
@@ -153,28 +430,66 @@ void SpringEmbedderKK::initialize(GraphAttributes& GA, NodeArray<dpair>& partial
 	}
 	// Having L we can compute the original lengths l_ij
 	// Computes spring strengths k_ij
+	// The vectorized sums in mainStep() run over all indices of a row. Hence the strength of
+	// a node to itself and the entries of indices without a node are 0, so they do not
+	// contribute.
 	double dij;
+	sstrength.init(G, 0.0);
+	std::vector<bool> isNode(oLength.dimension(), false);
+	for (node v : G.nodes) {
+		isNode[v->index()] = true;
+	}
 	for (node v : G.nodes) {
-		sstrength[v].init(G);
+		double* length = oLength.row(v);
+		double* strength = sstrength.row(v);
 		for (node w : G.nodes) {
-			dij = oLength[v][w];
-			if (dij == std::numeric_limits<double>::max()) {
-				sstrength[v][w] = minVal;
+			dij = length[w->index()];
+			if (dij == DistanceMatrix<double>::unreachable()) {
+				strength[w->index()] = minVal;
 			} else {
-				oLength[v][w] = L * dij;
-				if (v == w) {
-					sstrength[v][w] = 1.0;
-				} else {
-					sstrength[v][w] = m_K / (dij * dij);
+				length[w->index()] = L * dij;
+				if (v != w) {
+					strength[w->index()] = m_K / (dij * dij);
 				}
 			}
 		}
+		for (int i = 0; i < oLength.dimension(); ++i) {
+			if (!isNode[i]) {
+				length[i] = 0.0;
+			}
+		}
 	}
 }
 
 void SpringEmbedderKK::mainStep(GraphAttributes& GA, NodeArray<dpair>& partialDer,
-		NodeArray<NodeArray<double>>& oLength, NodeArray<NodeArray<double>>& sstrength) {
+		DistanceMatrix<double>& oLength, DistanceMatrix<double>& sstrength) {
 	const Graph& G = GA.constGraph();
+	const int dim = oLength.dimension();
+	const Vectorization vectorization =
+			m_useVectorization ? availableVectorization() : Vectorization::None;
+
+	// The positions in structure-of-arrays layout, indexed like the rows of the matrices.
+	// Indices without a node stay at the origin; their spring strength is 0.
+	std::vector<double> x(dim, 0.0);
+	std::vector<double> y(dim, 0.0);
+	for (node v : G.nodes) {
+		x[v->index()] = GA.x(v);
+		y[v->index()] = GA.y(v);
+	}
+
+	// The gradient and the Hessian of the energy with respect to the position of m
+	auto derivatives = [&](node m) {
+		return sumDerivatives(vectorization, m->index(), x.data(), y.data(),
+				sstrength.row(m), oLength.row(m), dim);
+	};
+	// The contributions of m to the gradients of all nodes; the matrices are symmetric, so
+	// row m holds the strengths and lengths of all springs of m
+	std::vector<double> contributionX(dim);
+	std::vector<double> contributionY(dim);
+	auto contributions = [&](node m, double* cx, double* cy) {
+		computeContributions(vectorization, m->index(), x.data(), y.data(), sstrength.row(m),
+				oLength.row(m), dim, cx, cy);
+	};
 
 	// Now we compute delta_m, we search for the node with max value
 	double delta_m = 0.0;
@@ -182,7 +497,8 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA, NodeArray<dpair>& partialDe
 
 	// Compute the partial derivatives first
 	for (node v : G.nodes) {
-		dpair parder = computeParDers(v, GA, sstrength, oLength);
+		EnergyDerivatives der = derivatives(v);
+		dpair parder(der.dx, der.dy);
 		partialDer[v] = parder;
 		//delta_m is sqrt of squares of partial derivatives
 		double delta_v = sqrt(parder.x1() * parder.x1() + parder.x2() * parder.x2());
@@ -202,51 +518,39 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA, NodeArray<dpair>& partialDe
 		localItCount = m_maxLocalIt;
 	}
 
+	// The contribution best_m makes to the partial derivatives of
+	// each vertex.
+	std::vector<double> p_partialsX(dim);
+	std::vector<double> p_partialsY(dim);
 
 	while (globalItCount-- > 0 && !finished(delta_m)) {
-		// The contribution best_m makes to the partial derivatives of
-		// each vertex.
-		NodeArray<dpair> p_partials(G);
-		for (node v : G.nodes) {
-			p_partials[v] = computeParDer(v, best_m, GA, sstrength, oLength);
-		}
+		contributions(best_m, p_partialsX.data(), p_partialsY.data());
+
+		// The Jacobian at the current position, later also the partial
+		// derivatives at the new position
+		EnergyDerivatives der = derivatives(best_m);
 
 		localItCount = 0;
 		do {
-			// Compute the 4 elements of the Jacobian
-			double dE_dx_dx = 0.0, dE_dx_dy = 0.0, dE_dy_dx = 0.0, dE_dy_dy = 0.0;
-			for (node v : G.nodes) {
-				if (v != best_m) {
-					double x_diff = GA.x(best_m) - GA.x(v);
-					double y_diff = GA.y(best_m) - GA.y(v);
-					double dist = sqrt(x_diff * x_diff + y_diff * y_diff);
-					double dist3 = dist * dist * dist;
-					OGDF_ASSERT(dist3 != 0.0);
-					double k_mi = sstrength[best_m][v];
-					double l_mi = oLength[best_m][v];
-					dE_dx_dx += k_mi * (1 - (l_mi * y_diff * y_diff) / dist3);
-					dE_dx_dy += k_mi * l_mi * x_diff * y_diff / dist3;
-					dE_dy_dx += k_mi * l_mi * x_diff * y_diff / dist3;
-					dE_dy_dy += k_mi * (1 - (l_mi * x_diff * x_diff) / dist3);
-				}
-			}
-
 			// Solve for delta_x and delta_y
 			double dE_dx = partialDer[best_m].x1();
 			double dE_dy = partialDer[best_m].x2();
 
-			double delta_x = (dE_dx_dy * dE_dy - dE_dy_dy * dE_dx)
-					/ (dE_dx_dx * dE_dy_dy - dE_dx_dy * dE_dy_dx);
+			double delta_x = (der.dxy * dE_dy - der.dyy * dE_dx)
+					/ (der.dxx * der.dyy - der.dxy * der.dxy);
 
-			double delta_y = (dE_dx_dx * dE_dy - dE_dy_dx * dE_dx)
-					/ (dE_dy_dx * dE_dx_dy - dE_dx_dx * dE_dy_dy);
+			double delta_y = (der.dxx * dE_dy - der.dxy * dE_dx)
+					/ (der.dxy * der.dxy - der.dxx * der.dyy);
 
 			// Move p by (delta_x, delta_y)
 			GA.x(best_m) += delta_x;
 			GA.y(best_m) += delta_y;
+			x[best_m->index()] = GA.x(best_m);
+			y[best_m->index()] = GA.y(best_m);
 
 			// Recompute partial derivatives and delta_p
-			dpair deriv = computeParDers(best_m, GA, sstrength, oLength);
+			der = derivatives(best_m);
+			dpair deriv(der.dx, der.dy);
 			partialDer[best_m] = deriv;
 
 			delta_m = sqrt(deriv.x1() * deriv.x1() + deriv.x2() * deriv.x2());
@@ -254,13 +558,12 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA, NodeArray<dpair>& partialDe
 
 		// Select new best_m by updating each partial derivative and delta
 		node old_p = best_m;
+		contributions(old_p, contributionX.data(), contributionY.data());
 		for (node v : G.nodes) {
-			dpair old_deriv_p = p_partials[v];
-			dpair old_p_partial = computeParDer(v, old_p, GA, sstrength, oLength);
 			dpair deriv = partialDer[v];
 
-			deriv.x1() += old_p_partial.x1() - old_deriv_p.x1();
-			deriv.x2() += old_p_partial.x2() - old_deriv_p.x2();
+			deriv.x1() += contributionX[v->index()] - p_partialsX[v->index()];
+			deriv.x2() += contributionY[v->index()] - p_partialsY[v->index()];
 
 			partialDer[v] = deriv;
 			double delta = sqrt(deriv.x1() * deriv.x1() + deriv.x2() * deriv.x2());
@@ -276,8 +579,8 @@ void SpringEmbedderKK::mainStep(GraphAttributes& GA, NodeArray<dpair>& partialDe
 void SpringEmbedderKK::doCall(GraphAttributes& GA, const EdgeArray<double>& eLength, bool simpleBFS) {
 	const Graph& G = GA.constGraph();
 	NodeArray<dpair> partialDer(G); //stores the partial derivative per node
-	NodeArray<NodeArray<double>> oLength(G); //first distance, then original length
-	NodeArray<NodeArray<double>> sstrength(G); //the spring strength
+	DistanceMatrix<double> oLength; //first distance, then original length
+	DistanceMatrix<double> sstrength; //the spring strength
 
 	//only for debugging
 	OGDF_ASSERT(isConnected(G));
@@ -342,14 +645,14 @@ void SpringEmbedderKK::shufflePositions(GraphAttributes& GA) {
 // Compute contribution of vertex u to the first partial
 // derivatives (dE/dx_m, dE/dy_m) (for vertex m) (eq. 7 and 8 in paper)
 SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(node m, node u, GraphAttributes& GA,
-		NodeArray<NodeArray<double>>& ss, NodeArray<NodeArray<double>>& dist) {
+		DistanceMatrix<double>& ss, DistanceMatrix<double>& dist) {
 	dpair result(0.0, 0.0);
 	if (m != u) {
 		double x_diff = GA.x(m) - GA.x(u);
 		double y_diff = GA.y(m) - GA.y(u);
 		double distance = sqrt(x_diff * x_diff + y_diff * y_diff);
-		result.x1() = (ss[m][u]) * (x_diff - (dist[m][u]) * x_diff / distance);
-		result.x2() = (ss[m][u]) * (y_diff - (dist[m][u]) * y_diff / distance);
+		result.x1() = (ss(m, u)) * (x_diff - (dist(m, u)) * x_diff / distance);
+		result.x2() = (ss(m, u)) * (y_diff - (dist(m, u)) * y_diff / distance);
 	}
 
 	return result;
@@ -357,7 +660,7 @@ SpringEmbedderKK::dpair SpringEmbedderKK::computeParDer(node m, node u, GraphAtt
 
 //compute partial derivative for v
 SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v, GraphAttributes& GA,
-		NodeArray<NodeArray<double>>& ss, NodeArray<NodeArray<double>>& dist) {
+		DistanceMatrix<double>& ss, DistanceMatrix<double>& dist) {
 	dpair result(0.0, 0.0);
 	for (node u : GA.constGraph().nodes) {
 		dpair deriv = computeParDer(v, u, GA, ss, dist);
@@ -368,123 +671,32 @@ SpringEmbedderKK::dpair SpringEmbedderKK::computeParDers(node v, GraphAttributes
 	return result;
 }
 
-/**
- * Initialise the original estimates from nodes and edges.
- */
-
-//we could speed this up by not using nested NodeArrays and
-//by not doing the fully symmetrical computation on undirected graphs
-//All Pairs Shortest Path Floyd, initializes the whole matrix
-//returns maximum distance. Does not detect negative cycles (lead to neg. values on diagonal)
-//threshold is the value for the distance of non-adjacent nodes, distance has to be
-//initialized with
+//All pairs shortest paths with Dijkstra, the searches are distributed over the threads
+//returns maximum distance, unreachable pairs are set to DistanceMatrix<double>::unreachable()
 double SpringEmbedderKK::allpairssp(const Graph& G, const EdgeArray<double>& eLengths,
-		NodeArray<NodeArray<double>>& distance, const double threshold) {
-	double maxDist = -threshold;
-
-	for (node v : G.nodes) {
-		distance[v][v] = 0.0;
-	}
-
-	//TODO: Experimentally compare this against
-	// all nodes and incident edges (memory access) on huge graphs
-	for (edge e : G.edges) {
-		distance[e->source()][e->target()] = eLengths[e];
-		distance[e->target()][e->source()] = eLengths[e];
-	}
-
-	///**
-	// * And run the main loop of the algorithm.
-	// */
-	for (node v : G.nodes) {
-		for (node u : G.nodes) {
-			for (node w : G.nodes) {
-				if ((distance[u][v] < threshold) && (distance[v][w] < threshold)) {
-					Math::updateMin(distance[u][w], distance[u][v] + distance[v][w]);
-#if 0
-					distance[w][u] = distance[u][w]; //is done anyway afterwards
-#endif
-				}
-				if (distance[u][w] < threshold) {
-					Math::updateMax(maxDist, distance[u][w]);
-				}
-			}
-		}
-	}
-#if 0
-#	ifdef OGDF_DEBUG
-	for(node v : G.nodes)
-	{
-		if (distance[v][v] < 0.0) std::cerr << "\n###Error in shortest path computation###\n\n";
-	}
-	std::cout << "Maxdist: "<<maxDist<<"\n";
-	for(node u : G.nodes)
-	{
-	for(node w : G.nodes)
-	{
-#		if 0
-		std::cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-#		endif
-	}
-	}
-#	endif
-#endif
-	return maxDist;
+		DistanceMatrix<double>& distance) {
+	dijkstra_SPAP(CompactGraph(G), distance, eLengths, m_maxThreads);
+	return maxDistance(G, distance);
 }
 
 //the same without weights, i.e. all pairs shortest paths with BFS
 //Runs in time |V|²
 //for compatibility, distances are double
-double SpringEmbedderKK::allpairsspBFS(const Graph& G, NodeArray<NodeArray<double>>& distance) {
-	double maxDist = 0;
-
-	for (node v : G.nodes) {
-		distance[v][v] = 0.0;
-	}
+double SpringEmbedderKK::allpairsspBFS(const Graph& G, DistanceMatrix<double>& distance) {
+	bfs_SPAP(CompactGraph(G), distance, 1.0, m_maxThreads);
+	return maxDistance(G, distance);
+}
 
-	//start in each node once
+double SpringEmbedderKK::maxDistance(const Graph& G, const DistanceMatrix<double>& distance) {
+	double maxDist = 0;
 	for (node v : G.nodes) {
-		//do a bfs
-		NodeArray<bool> mark(G, true);
-		SListPure<node> bfs;
-		bfs.pushBack(v);
-		mark[v] = false;
-
-		while (!bfs.empty()) {
-			node w = bfs.popFrontRet();
-			double d = distance[v][w] + 1.0f;
-
-
-			for (adjEntry adj : w->adjEntries) {
-				node u = adj->twinNode();
-				if (mark[u]) {
-					mark[u] = false;
-					bfs.pushBack(u);
-					distance[v][u] = d;
-					Math::updateMax(maxDist, d);
-				}
+		const double* dist = distance.row(v);
+		for (node w : G.nodes) {
+			if (dist[w->index()] != DistanceMatrix<double>::unreachable()) {
+				Math::updateMax(maxDist, dist[w->index()]);
 			}
 		}
 	}
-	//check for negative cycles
-	for (node v : G.nodes) {
-		if (distance[v][v] < 0.0) {
-			std::cerr << "\n###Error in shortest path computation###\n\n";
-		}
-	}
-
-#if 0
-#	ifdef OGDF_DEBUG
-	std::cout << "Maxdist: "<<maxDist<<"\n";
-	for(node u : G.nodes)
-	{
-	for(node w : G.nodes)
-	{
-		std::cout << "Distance " << u->index() << " -> "<<w->index()<<" "<<distance[u][w]<<"\n";
-	}
-	}
-#	endif
-#endif
 	return maxDist;
 }
 
@@ -30,20 +30,27 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/Array.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/Logger.h>
+#include <ogdf/basic/Math.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/energybased/PivotMDS.h>
 #include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
 #include <ogdf/graphalg/ShortestPathAlgorithms.h>
 #include <ogdf/packing/ComponentSplitterLayout.h>
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <ostream>
+#include <vector>
 
 namespace ogdf {
 
@@ -51,6 +58,22 @@ const double StressMinimization::EPSILON = 10e-4;
 
 const int StressMinimization::DEFAULT_NUMBER_OF_PIVOTS = 50;
 
+struct StressMinimization::SparseStressModel {
+	Array<node> pivots;
+
+	//! The desired distance and the weight of the term of node v and pivot i are stored at
+	//! v->index() * pivots.size() + i. Stored as float to halve the memory for large graphs.
+	std::vector<float> distance;
+	std::vector<float> weight; //!< 0 if there is no such term
+};
+
+struct StressMinimization::PositionVote {
+	double x = 0.0;
+	double y = 0.0;
+	double z = 0.0;
+	double totalWeight = 0.0;
+};
+
 void StressMinimization::call(GraphAttributes& GA) {
 	m_use3D = GA.has(GraphAttributes::threeD) && !m_forcing2DLayout;
 	const Graph& G = GA.constGraph();
@@ -68,24 +91,37 @@ void StressMinimization::call(GraphAttributes& GA) {
 	}
 	// Separate component layout cant be applied to a non-connected graph
 	OGDF_ASSERT(!m_componentLayout || isConnected(G));
-	NodeArray<NodeArray<double>> shortestPathMatrix(G);
-	NodeArray<NodeArray<double>> weightMatrix(G);
-	initMatrices(G, shortestPathMatrix, weightMatrix);
+	if (m_sparseStress) {
+		callSparse(GA);
+		return;
+	}
+	DistanceMatrix<double> shortestPathMatrix;
+	DistanceMatrix<double> weightMatrix(G, 0);
+	// the n single-source searches only read the graph, so run them on a CSR snapshot
+	// and distribute them over the threads
+	CompactGraph compactG(G);
 	// if the edge costs are defined by the attribute copy it to an array and
 	// construct the proper shortest path matrix
 	if (m_hasEdgeCostsAttribute) {
 		OGDF_ASSERT(GA.has(GraphAttributes::edgeDoubleWeight));
-		m_avgEdgeCosts = dijkstra_SPAP(GA, shortestPathMatrix);
+		EdgeArray<double> edgeCosts(G);
+		m_avgEdgeCosts = 0;
+		for (edge e : G.edges) {
+			edgeCosts[e] = GA.doubleWeight(e);
+			m_avgEdgeCosts += edgeCosts[e];
+		}
+		m_avgEdgeCosts /= G.numberOfEdges();
 		// compute shortest path all pairs
+		dijkstra_SPAP(compactG, shortestPathMatrix, edgeCosts, m_maxThreads);
 	} else {
 		m_avgEdgeCosts = m_edgeCosts;
-		bfs_SPAP(G, shortestPathMatrix, m_edgeCosts);
+		bfs_SPAP(compactG, shortestPathMatrix, m_edgeCosts, m_maxThreads);
 	}
 	call(GA, shortestPathMatrix, weightMatrix);
 }
 
-void StressMinimization::call(GraphAttributes& GA, NodeArray<NodeArray<double>>& shortestPathMatrix,
-		NodeArray<NodeArray<double>>& weightMatrix) {
+void StressMinimization::call(GraphAttributes& GA, DistanceMatrix<double>& shortestPathMatrix,
+		DistanceMatrix<double>& weightMatrix) {
 	// compute the initial layout if necessary
 	if (!m_hasInitialLayout) {
 		computeInitialLayout(GA);
@@ -104,12 +140,164 @@ void StressMinimization::call(GraphAttributes& GA, NodeArray<NodeArray<double>>&
 	minimizeStress(GA, shortestPathMatrix, weightMatrix);
 }
 
+void StressMinimization::callSparse(GraphAttributes& GA) {
+	// compute the initial layout if necessary
+	if (!m_hasInitialLayout) {
+		computeInitialLayout(GA);
+	}
+	SparseStressModel model;
+	initSparseModel(GA, model);
+	minimizeStress(
+			GA, [&] { nextIteration(GA, model); }, [&] { return calcStress(GA, model); });
+}
+
+void StressMinimization::initSparseModel(const GraphAttributes& GA, SparseStressModel& model) {
+	const Graph& G = GA.constGraph();
+	const int numberOfPivots = min(G.numberOfNodes(), m_numberOfPivots);
+	const size_t stride = numberOfPivots;
+	EdgeArray<double> edgeCosts;
+	if (m_hasEdgeCostsAttribute) {
+		OGDF_ASSERT(GA.has(GraphAttributes::edgeDoubleWeight));
+		edgeCosts.init(G);
+		m_avgEdgeCosts = 0;
+		for (edge e : G.edges) {
+			edgeCosts[e] = GA.doubleWeight(e);
+			m_avgEdgeCosts += edgeCosts[e];
+		}
+		m_avgEdgeCosts /= G.numberOfEdges();
+	} else {
+		m_avgEdgeCosts = m_edgeCosts;
+	}
+	// distance used for nodes in different components, as in the full model
+	const double unreachable = m_avgEdgeCosts * sqrt((double)(G.numberOfNodes()));
+
+	// select the pivots by the maxmin strategy like PivotMDS
+	CompactGraph compactG(G);
+	model.pivots.init(numberOfPivots);
+	model.distance.assign((G.maxNodeIndex() + 1) * stride, 0.0f);
+	model.weight.assign((G.maxNodeIndex() + 1) * stride, 0.0f);
+	NodeArray<int> pivotIndex(G, -1);
+	NodeArray<double> minDistances(G, std::numeric_limits<double>::infinity());
+	NodeArray<double> shortestPathSingleSource(G);
+	node pivNode = G.firstNode();
+	for (int i = 0; i < numberOfPivots; i++) {
+		model.pivots[i] = pivNode;
+		pivotIndex[pivNode] = i;
+		shortestPathSingleSource.fill(std::numeric_limits<double>::infinity());
+		if (m_hasEdgeCostsAttribute) {
+			dijkstra_SPSS(pivNode, compactG, shortestPathSingleSource, edgeCosts);
+		} else {
+			bfs_SPSS(pivNode, compactG, shortestPathSingleSource, m_edgeCosts);
+		}
+		minDistances[pivNode] = 0;
+		for (node v : G.nodes) {
+			double dist = shortestPathSingleSource[v];
+			// dijkstra_SPSS marks unreachable nodes by the maximum value
+			if (isinf(dist) || dist == std::numeric_limits<double>::max()) {
+				model.distance[v->index() * stride + i] = static_cast<float>(unreachable);
+			} else {
+				model.distance[v->index() * stride + i] = static_cast<float>(dist);
+				Math::updateMin(minDistances[v], dist);
+			}
+			if (minDistances[v] > minDistances[pivNode]) {
+				pivNode = v;
+			}
+		}
+	}
+
+	// each node is represented by its closest pivot
+	std::vector<std::vector<float>> regionDistances(numberOfPivots);
+	for (node v : G.nodes) {
+		const float* dist = &model.distance[v->index() * stride];
+		int closest = static_cast<int>(std::min_element(dist, dist + numberOfPivots) - dist);
+		regionDistances[closest].push_back(dist[closest]);
+	}
+	for (std::vector<float>& distances : regionDistances) {
+		std::sort(distances.begin(), distances.end());
+	}
+
+	// the term of v and pivot p stands for the nodes of p's region that are closer to p
+	// than half the distance between v and p
+	for (node v : G.nodes) {
+		for (int i = 0; i < numberOfPivots; i++) {
+			const float dist = model.distance[v->index() * stride + i];
+			if (dist > 0) {
+				const std::vector<float>& region = regionDistances[i];
+				auto represented =
+						std::upper_bound(region.begin(), region.end(), dist / 2) - region.begin();
+				model.weight[v->index() * stride + i] = represented / (dist * dist);
+			}
+		}
+		// the terms of adjacent pivots are replaced by the exact ones
+		for (adjEntry adj : v->adjEntries) {
+			int i = pivotIndex[adj->twinNode()];
+			if (i >= 0) {
+				model.weight[v->index() * stride + i] = 0;
+			}
+		}
+	}
+}
+
+double StressMinimization::calcStress(const GraphAttributes& GA, const SparseStressModel& model) {
+	const size_t stride = model.pivots.size();
+	auto term = [&](node v, node w, double desDistance, double weight) {
+		double xDiff = GA.x(v) - GA.x(w);
+		double yDiff = GA.y(v) - GA.y(w);
+		double zDiff = m_use3D ? GA.z(v) - GA.z(w) : 0.0;
+		double dist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+		return dist == 0 ? 0.0 : weight * (desDistance - dist) * (desDistance - dist);
+	};
+
+	double stress = 0;
+	for (node v : GA.constGraph().nodes) {
+		for (adjEntry adj : v->adjEntries) {
+			if (adj->isSource() && !adj->theEdge()->isSelfLoop()) {
+				double desDistance = m_hasEdgeCostsAttribute ? GA.doubleWeight(adj->theEdge())
+															 : m_edgeCosts;
+				stress += term(v, adj->twinNode(), desDistance, 1 / (desDistance * desDistance));
+			}
+		}
+		for (int i = 0; i < model.pivots.size(); i++) {
+			float weight = model.weight[v->index() * stride + i];
+			if (weight != 0) {
+				stress += term(v, model.pivots[i], model.distance[v->index() * stride + i], weight);
+			}
+		}
+	}
+	return stress;
+}
+
+void StressMinimization::nextIteration(GraphAttributes& GA, const SparseStressModel& model) {
+	const size_t stride = model.pivots.size();
+
+	for (node v : GA.constGraph().nodes) {
+		PositionVote vote;
+		for (adjEntry adj : v->adjEntries) {
+			node w = adj->twinNode();
+			if (w != v) {
+				double desDistance = m_hasEdgeCostsAttribute ? GA.doubleWeight(adj->theEdge())
+															 : m_edgeCosts;
+				addVote(GA, v, w, desDistance, 1 / (desDistance * desDistance), vote);
+			}
+		}
+		for (int i = 0; i < model.pivots.size(); i++) {
+			float weight = model.weight[v->index() * stride + i];
+			if (weight != 0) {
+				addVote(GA, v, model.pivots[i], model.distance[v->index() * stride + i], weight,
+						vote);
+			}
+		}
+		applyVote(GA, v, vote);
+	}
+}
+
 void StressMinimization::computeInitialLayout(GraphAttributes& GA) {
 	PivotMDS* pivMDS = new PivotMDS();
 	pivMDS->setNumberOfPivots(DEFAULT_NUMBER_OF_PIVOTS);
 	pivMDS->useEdgeCostsAttribute(m_hasEdgeCostsAttribute);
 	pivMDS->setEdgeCosts(m_edgeCosts);
 	pivMDS->setForcing2DLayout(m_forcing2DLayout);
+	pivMDS->maxThreads(m_maxThreads);
 	if (!m_componentLayout) {
 		// the graph might be disconnected therefore we need
 		// the component layouter
@@ -123,35 +311,39 @@ void StressMinimization::computeInitialLayout(GraphAttributes& GA) {
 	}
 }
 
-void StressMinimization::replaceInfinityDistances(NodeArray<NodeArray<double>>& shortestPathMatrix,
+void StressMinimization::replaceInfinityDistances(DistanceMatrix<double>& shortestPathMatrix,
 		double newVal) {
 	const Graph& G = *shortestPathMatrix.graphOf();
 
 	for (node v : G.nodes) {
 		for (node w : G.nodes) {
-			if (v != w && isinf(shortestPathMatrix[v][w])) {
-				shortestPathMatrix[v][w] = newVal;
+			if (v != w && shortestPathMatrix(v, w) == DistanceMatrix<double>::unreachable()) {
+				shortestPathMatrix(v, w) = newVal;
 			}
 		}
 	}
 }
 
-void StressMinimization::calcWeights(const Graph& G, NodeArray<NodeArray<double>>& shortestPathMatrix,
-		NodeArray<NodeArray<double>>& weightMatrix) {
+void StressMinimization::calcWeights(const Graph& G, DistanceMatrix<double>& shortestPathMatrix,
+		DistanceMatrix<double>& weightMatrix) {
 	for (node v : G.nodes) {
+		const double* dist = shortestPathMatrix.row(v);
+		double* weight = weightMatrix.row(v);
 		for (node w : G.nodes) {
 			if (v != w) {
 				// w_ij = d_ij^-2
-				weightMatrix[v][w] = 1 / (shortestPathMatrix[v][w] * shortestPathMatrix[v][w]);
+				weight[w->index()] = 1 / (dist[w->index()] * dist[w->index()]);
 			}
 		}
 	}
 }
 
 double StressMinimization::calcStress(const GraphAttributes& GA,
-		NodeArray<NodeArray<double>>& shortestPathMatrix, NodeArray<NodeArray<double>>& weightMatrix) {
+		DistanceMatrix<double>& shortestPathMatrix, DistanceMatrix<double>& weightMatrix) {
 	double stress = 0;
 	for (node v = GA.constGraph().firstNode(); v != nullptr; v = v->succ()) {
+		const double* desDist = shortestPathMatrix.row(v);
+		const double* weight = weightMatrix.row(v);
 		for (node w = v->succ(); w != nullptr; w = w->succ()) {
 			double xDiff = GA.x(v) - GA.x(w);
 			double yDiff = GA.y(v) - GA.y(w);
@@ -161,8 +353,8 @@ double StressMinimization::calcStress(const GraphAttributes& GA,
 			}
 			double dist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
 			if (dist != 0) {
-				stress += weightMatrix[v][w] * (shortestPathMatrix[v][w] - dist)
-						* (shortestPathMatrix[v][w] - dist); //
+				stress += weight[w->index()] * (desDist[w->index()] - dist)
+						* (desDist[w->index()] - dist); //
 			}
 		}
 	}
@@ -189,7 +381,14 @@ void StressMinimization::copyLayout(const GraphAttributes& GA, NodeArray<double>
 }
 
 void StressMinimization::minimizeStress(GraphAttributes& GA,
-		NodeArray<NodeArray<double>>& shortestPathMatrix, NodeArray<NodeArray<double>>& weightMatrix) {
+		DistanceMatrix<double>& shortestPathMatrix, DistanceMatrix<double>& weightMatrix) {
+	minimizeStress(
+			GA, [&] { nextIteration(GA, shortestPathMatrix, weightMatrix); },
+			[&] { return calcStress(GA, shortestPathMatrix, weightMatrix); });
+}
+
+void StressMinimization::minimizeStress(GraphAttributes& GA, const std::function<void()>& iterate,
+		const std::function<double()>& stress) {
 	const Graph& G = GA.constGraph();
 	int numberOfPerformedIterations = 0;
 
@@ -197,7 +396,7 @@ void StressMinimization::minimizeStress(GraphAttributes& GA,
 	double curStress = std::numeric_limits<double>::max();
 
 	if (m_terminationCriterion == TerminationCriterion::Stress) {
-		curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+		curStress = stress();
 	}
 
 	NodeArray<double> newX;
@@ -219,85 +418,86 @@ void StressMinimization::minimizeStress(GraphAttributes& GA,
 				copyLayout(GA, newX, newY);
 			}
 		}
-		nextIteration(GA, shortestPathMatrix, weightMatrix);
+		iterate();
 		if (m_terminationCriterion == TerminationCriterion::Stress) {
 			prevStress = curStress;
-			curStress = calcStress(GA, shortestPathMatrix, weightMatrix);
+			curStress = stress();
 		}
 	} while (!finished(GA, ++numberOfPerformedIterations, newX, newY, prevStress, curStress));
 
 	Logger::slout() << "Iteration count:\t" << numberOfPerformedIterations << "\tStress:\t"
-					<< calcStress(GA, shortestPathMatrix, weightMatrix) << std::endl;
+					<< stress() << std::endl;
 }
 
 void StressMinimization::nextIteration(GraphAttributes& GA,
-		NodeArray<NodeArray<double>>& shortestPathMatrix, NodeArray<NodeArray<double>>& weights) {
+		DistanceMatrix<double>& shortestPathMatrix, DistanceMatrix<double>& weights) {
 	const Graph& G = GA.constGraph();
 
 	for (node v : G.nodes) {
-		double newXCoord = 0.0;
-		double newYCoord = 0.0;
-		double newZCoord = 0.0;
-		double& currXCoord = GA.x(v);
-		double& currYCoord = GA.y(v);
-		double totalWeight = 0;
+		PositionVote vote;
+		const double* desDist = shortestPathMatrix.row(v);
+		const double* weight = weights.row(v);
 		for (node w : G.nodes) {
-			if (v == w) {
-				continue;
-			}
-			// calculate euclidean distance between both points
-			double xDiff = currXCoord - GA.x(w);
-			double yDiff = currYCoord - GA.y(w);
-			double zDiff = m_use3D ? GA.z(v) - GA.z(w) : 0.0;
-			double euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
-			// get the weight
-			double weight = weights[v][w];
-			// get the desired distance
-			double desDistance = shortestPathMatrix[v][w];
-			// reset the voted x coordinate
-			// if x is not fixed
-			if (!m_fixXCoords) {
-				double voteX = GA.x(w);
-				if (euclideanDist != 0) {
-					// calc the vote
-					voteX += desDistance * (currXCoord - voteX) / euclideanDist;
-				}
-				// add the vote
-				newXCoord += weight * voteX;
-			}
-			// reset the voted y coordinate
-			// y is not fixed
-			if (!m_fixYCoords) {
-				double voteY = GA.y(w);
-				if (euclideanDist != 0) {
-					// calc the vote
-					voteY += desDistance * (currYCoord - voteY) / euclideanDist;
-				}
-				newYCoord += weight * voteY;
-			}
-			if (m_use3D && !m_fixZCoords) {
-				// reset the voted z coordinate
-				double voteZ = GA.z(w);
-				if (euclideanDist != 0) {
-					// calc the vote
-					voteZ += desDistance * (GA.z(v) - voteZ) / euclideanDist;
-				}
-				newZCoord += weight * voteZ;
+			if (v != w) {
+				addVote(GA, v, w, desDist[w->index()], weight[w->index()], vote);
 			}
-			// sum up the weights
-			totalWeight += weight;
 		}
-		// update the positions
-		if (totalWeight != 0) {
-			if (!m_fixXCoords) {
-				currXCoord = newXCoord / totalWeight;
-			}
-			if (!m_fixYCoords) {
-				currYCoord = newYCoord / totalWeight;
-			}
-			if (m_use3D && !m_fixZCoords) {
-				GA.z(v) = newZCoord / totalWeight;
-			}
+		applyVote(GA, v, vote);
+	}
+}
+
+void StressMinimization::addVote(const GraphAttributes& GA, node v, node w, double desDistance,
+		double weight, PositionVote& vote) const {
+	// calculate euclidean distance between both points
+	double xDiff = GA.x(v) - GA.x(w);
+	double yDiff = GA.y(v) - GA.y(w);
+	double zDiff = m_use3D ? GA.z(v) - GA.z(w) : 0.0;
+	double euclideanDist = sqrt(xDiff * xDiff + yDiff * yDiff + zDiff * zDiff);
+	// reset the voted x coordinate
+	// if x is not fixed
+	if (!m_fixXCoords) {
+		double voteX = GA.x(w);
+		if (euclideanDist != 0) {
+			// calc the vote
+			voteX += desDistance * xDiff / euclideanDist;
+		}
+		// add the vote
+		vote.x += weight * voteX;
+	}
+	// reset the voted y coordinate
+	// y is not fixed
+	if (!m_fixYCoords) {
+		double voteY = GA.y(w);
+		if (euclideanDist != 0) {
+			// calc the vote
+			voteY += desDistance * yDiff / euclideanDist;
+		}
+		vote.y += weight * voteY;
+	}
+	if (m_use3D && !m_fixZCoords) {
+		// reset the voted z coordinate
+		double voteZ = GA.z(w);
+		if (euclideanDist != 0) {
+			// calc the vote
+			voteZ += desDistance * zDiff / euclideanDist;
+		}
+		vote.z += weight * voteZ;
+	}
+	// sum up the weights
+	vote.totalWeight += weight;
+}
+
+void StressMinimization::applyVote(GraphAttributes& GA, node v, const PositionVote& vote) const {
+	// update the positions
+	if (vote.totalWeight != 0) {
+		if (!m_fixXCoords) {
+			GA.x(v) = vote.x / vote.totalWeight;
+		}
+		if (!m_fixYCoords) {
+			GA.y(v) = vote.y / vote.totalWeight;
+		}
+		if (m_use3D && !m_fixZCoords) {
+			GA.z(v) = vote.z / vote.totalWeight;
 		}
 	}
 }
@@ -331,14 +531,4 @@ bool StressMinimization::finished(GraphAttributes& GA, int numberOfPerformedIter
 	}
 }
 
-void StressMinimization::initMatrices(const Graph& G,
-		NodeArray<NodeArray<double>>& shortestPathMatrix, NodeArray<NodeArray<double>>& weightMatrix) {
-	// init shortest path matrix by infinity distances
-	for (node v : G.nodes) {
-		shortestPathMatrix[v].init(G, std::numeric_limits<double>::infinity());
-		shortestPathMatrix[v][v] = 0;
-		weightMatrix[v].init(G, 0);
-	}
-}
-
 }
@@ -47,6 +47,7 @@ ArrayGraph::ArrayGraph()
 	, m_numEdges(0)
 	, m_nodeXPos(nullptr)
 	, m_nodeYPos(nullptr)
+	, m_nodeZPos(nullptr)
 	, m_nodeSize(nullptr)
 	, m_nodeMoveRadius(nullptr)
 	, m_desiredEdgeLength(nullptr)
@@ -58,6 +59,7 @@ ArrayGraph::ArrayGraph(uint32_t maxNumNodes, uint32_t maxNumEdges)
 	, m_numEdges(maxNumEdges)
 	, m_nodeXPos(nullptr)
 	, m_nodeYPos(nullptr)
+	, m_nodeZPos(nullptr)
 	, m_nodeSize(nullptr)
 	, m_nodeMoveRadius(nullptr)
 	, m_desiredEdgeLength(nullptr)
@@ -72,6 +74,7 @@ ArrayGraph::ArrayGraph(const GraphAttributes& GA, const EdgeArray<float>& edgeLe
 	, m_numEdges(0)
 	, m_nodeXPos(nullptr)
 	, m_nodeYPos(nullptr)
+	, m_nodeZPos(nullptr)
 	, m_nodeSize(nullptr)
 	, m_nodeMoveRadius(nullptr)
 	, m_desiredEdgeLength(nullptr)
@@ -90,6 +93,7 @@ ArrayGraph::~ArrayGraph(void) {
 void ArrayGraph::allocate(uint32_t numNodes, uint32_t numEdges) {
 	m_nodeXPos = static_cast<float*>(OGDF_MALLOC_16(numNodes * sizeof(float)));
 	m_nodeYPos = static_cast<float*>(OGDF_MALLOC_16(numNodes * sizeof(float)));
+	m_nodeZPos = static_cast<float*>(OGDF_MALLOC_16(numNodes * sizeof(float)));
 	m_nodeSize = static_cast<float*>(OGDF_MALLOC_16(numNodes * sizeof(float)));
 	m_nodeMoveRadius = static_cast<float*>(OGDF_MALLOC_16(numNodes * sizeof(float)));
 	m_nodeAdj = static_cast<NodeAdjInfo*>(OGDF_MALLOC_16(numNodes * sizeof(NodeAdjInfo)));
@@ -104,6 +108,7 @@ void ArrayGraph::allocate(uint32_t numNodes, uint32_t numEdges) {
 void ArrayGraph::deallocate() {
 	OGDF_FREE_16(m_nodeXPos);
 	OGDF_FREE_16(m_nodeYPos);
+	OGDF_FREE_16(m_nodeZPos);
 	OGDF_FREE_16(m_nodeSize);
 	OGDF_FREE_16(m_nodeMoveRadius);
 	OGDF_FREE_16(m_nodeAdj);
@@ -126,6 +131,7 @@ void ArrayGraph::pushBackEdge(uint32_t a, uint32_t b, float desiredEdgeLength) {
 void ArrayGraph::readFrom(const GraphAttributes& GA, const EdgeArray<float>& edgeLength,
 		const NodeArray<float>& nodeSize) {
 	const Graph& G = GA.constGraph();
+	const bool threeD = GA.has(GraphAttributes::threeD);
 	NodeArray<uint32_t> nodeIndex(G);
 
 	m_numNodes = 0;
@@ -135,6 +141,7 @@ void ArrayGraph::readFrom(const GraphAttributes& GA, const EdgeArray<float>& edg
 	for (node v : G.nodes) {
 		m_nodeXPos[m_numNodes] = (float)GA.x(v);
 		m_nodeYPos[m_numNodes] = (float)GA.y(v);
+		m_nodeZPos[m_numNodes] = threeD ? (float)GA.z(v) : 0.0f;
 		m_nodeSize[m_numNodes] = nodeSize[v];
 		nodeIndex[v] = m_numNodes;
 		m_avgNodeSize += nodeSize[v];
@@ -150,10 +157,14 @@ void ArrayGraph::readFrom(const GraphAttributes& GA, const EdgeArray<float>& edg
 
 void ArrayGraph::writeTo(GraphAttributes& GA) {
 	const Graph& G = GA.constGraph();
+	const bool threeD = GA.has(GraphAttributes::threeD);
 	uint32_t i = 0;
 	for (node v : G.nodes) {
 		GA.x(v) = m_nodeXPos[i];
 		GA.y(v) = m_nodeYPos[i];
+		if (threeD) {
+			GA.z(v) = m_nodeZPos[i];
+		}
 		i++;
 	}
 }
@@ -162,23 +173,28 @@ void ArrayGraph::transform(float translate, float scale) {
 	for (uint32_t i = 0; i < m_numNodes; i++) {
 		m_nodeXPos[i] = (m_nodeXPos[i] + translate) * scale;
 		m_nodeYPos[i] = (m_nodeYPos[i] + translate) * scale;
+		m_nodeZPos[i] = (m_nodeZPos[i] + translate) * scale;
 	}
 }
 
 void ArrayGraph::centerGraph() {
 	double dx_sum = 0;
 	double dy_sum = 0;
+	double dz_sum = 0;
 
 	for (uint32_t i = 0; i < m_numNodes; i++) {
 		dx_sum += m_nodeXPos[i];
 		dy_sum += m_nodeYPos[i];
+		dz_sum += m_nodeZPos[i];
 	};
 
 	dx_sum /= (double)m_numNodes;
 	dy_sum /= (double)m_numNodes;
+	dz_sum /= (double)m_numNodes;
 	for (uint32_t i = 0; i < m_numNodes; i++) {
 		m_nodeXPos[i] -= (float)dx_sum;
 		m_nodeYPos[i] -= (float)dy_sum;
+		m_nodeZPos[i] -= (float)dz_sum;
 	}
 }
 
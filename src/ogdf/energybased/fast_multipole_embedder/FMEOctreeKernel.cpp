@@ -0,0 +1,316 @@
+/** \file
+ * \brief Implementation of the 3D kernel of the fast multipole embedder.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/Math.h>
+#include <ogdf/energybased/fast_multipole_embedder/ArrayGraph.h>
+#include <ogdf/energybased/fast_multipole_embedder/FMEOctreeKernel.h>
+#include <ogdf/energybased/fast_multipole_embedder/FastUtils.h>
+#include <ogdf/energybased/fast_multipole_embedder/LinearOctree.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+namespace ogdf {
+namespace fast_multipole_embedder {
+
+ArrayPartition FMEOctreeKernel::arrayPartition(uint32_t n) const {
+	ArrayPartition result;
+	const uint32_t s = n / numThreads();
+	if (s == 0) {
+		result.begin = threadNr() == 0 ? 0 : 1;
+		result.end = threadNr() == 0 ? n - 1 : 0;
+		if (n == 0) {
+			result.begin = 1;
+			result.end = 0;
+		}
+		return result;
+	}
+	result.begin = s * threadNr();
+	result.end = threadNr() == numThreads() - 1 ? n - 1 : result.begin + s - 1;
+	return result;
+}
+
+void FMEOctreeKernel::octreeConstruction(const ArrayPartition& nodePartition) {
+	FMEOctreeGlobalContext* globalContext = m_pGlobalContext;
+	FMEOctreeLocalContext* localContext = m_pLocalContext;
+	const ArrayGraph& graph = *globalContext->pGraph;
+	const float* coords[3] = {graph.nodeXPos(), graph.nodeYPos(), graph.nodeZPos()};
+
+	// the bounding box of the thread's nodes
+	for (int d = 0; d < 3; d++) {
+		localContext->min[d] = FLT_MAX;
+		localContext->max[d] = -FLT_MAX;
+		for (uint32_t i = nodePartition.begin; i <= nodePartition.end; i++) {
+			Math::updateMin(localContext->min[d], coords[d][i]);
+			Math::updateMax(localContext->max[d], coords[d][i]);
+		}
+	}
+	sync();
+
+	// let the main thread compute the bounding box of the bounding boxes
+	if (isMainThread()) {
+		for (int d = 0; d < 3; d++) {
+			globalContext->min[d] = FLT_MAX;
+			globalContext->max[d] = -FLT_MAX;
+			for (uint32_t j = 0; j < numThreads(); j++) {
+				Math::updateMin(globalContext->min[d], globalContext->pLocalContext[j]->min[d]);
+				Math::updateMax(globalContext->max[d], globalContext->pLocalContext[j]->max[d]);
+			}
+		}
+		globalContext->pOctree->init(globalContext->min[0], globalContext->min[1],
+				globalContext->min[2], globalContext->max[0], globalContext->max[1],
+				globalContext->max[2]);
+		globalContext->coolDown *= 0.999f;
+	}
+	// wait because the morton number computation needs the bounding box
+	sync();
+	if (nodePartition.begin <= nodePartition.end) {
+		globalContext->pOctree->computeMortonNumbers(nodePartition.begin, nodePartition.end);
+	}
+	// wait so the main thread can sort the points and link the tree
+	sync();
+	if (isMainThread()) {
+		globalContext->pOctree->build();
+	}
+	sync();
+}
+
+void FMEOctreeKernel::repulsiveForces() {
+	FMEOctreeGlobalContext* globalContext = m_pGlobalContext;
+	const ArrayGraph& graph = *globalContext->pGraph;
+	const LinearOctree& tree = *globalContext->pOctree;
+	const float factor = globalContext->pOptions->repForceFactor * globalContext->repForceScale;
+	LinearOctree::Workspace& workspace = m_pLocalContext->workspace;
+
+	// the threads get consecutive groups in Morton order, so their points are close together
+	const ArrayPartition groupPartition = arrayPartition(tree.numberOfGroups());
+	for (uint32_t group = groupPartition.begin; group <= groupPartition.end; group++) {
+		tree.computeGroupForces(group, globalContext->minDistSq, workspace);
+		const uint32_t begin = tree.firstPointOfGroup(group);
+		for (uint32_t k = begin; k < tree.endPointOfGroup(group); k++) {
+			const uint32_t i = tree.refOfPoint(k);
+			float f = factor;
+			if (graph.nodeInfo(i).degree > 100) {
+				// prevent some evil effects
+				f /= (float)graph.nodeInfo(i).degree;
+			}
+			globalContext->globalForceX[i] += workspace.forceX[k - begin] * f;
+			globalContext->globalForceY[i] += workspace.forceY[k - begin] * f;
+			globalContext->globalForceZ[i] += workspace.forceZ[k - begin] * f;
+		}
+	}
+}
+
+void FMEOctreeKernel::edgeForces(const ArrayPartition& edgePartition) {
+	FMEOctreeLocalContext* localContext = m_pLocalContext;
+	const ArrayGraph& graph = *m_pGlobalContext->pGraph;
+	const float* x = graph.nodeXPos();
+	const float* y = graph.nodeYPos();
+	const float* z = graph.nodeZPos();
+	const float* desiredEdgeLength = graph.desiredEdgeLength();
+
+	for (uint32_t i = edgePartition.begin; i <= edgePartition.end; i++) {
+		const EdgeAdjInfo& e_info = graph.edgeInfo(i);
+		const uint32_t a = e_info.a;
+		const uint32_t b = e_info.b;
+
+		float d_x = x[a] - x[b];
+		float d_y = y[a] - y[b];
+		float d_z = z[a] - z[b];
+		float d_sq = d_x * d_x + d_y * d_y + d_z * d_z;
+		if (d_sq == 0.0f) {
+			continue;
+		}
+
+		// divide the forces by the degree of the node to avoid oscillation
+		float f = (logf(d_sq) * 0.5f - logf(desiredEdgeLength[i])) * 0.25f;
+		float fa = f / (float)graph.nodeInfo(a).degree;
+		float fb = f / (float)graph.nodeInfo(b).degree;
+		localContext->forceX[a] -= fa * d_x;
+		localContext->forceY[a] -= fa * d_y;
+		localContext->forceZ[a] -= fa * d_z;
+		localContext->forceX[b] += fb * d_x;
+		localContext->forceY[b] += fb * d_y;
+		localContext->forceZ[b] += fb * d_z;
+	}
+}
+
+void FMEOctreeKernel::collectAndMove(const ArrayPartition& nodePartition, float timeStep) {
+	FMEOctreeGlobalContext* globalContext = m_pGlobalContext;
+	FMEOctreeLocalContext* localContext = m_pLocalContext;
+	ArrayGraph& graph = *globalContext->pGraph;
+	float* x = graph.nodeXPos();
+	float* y = graph.nodeYPos();
+	float* z = graph.nodeZPos();
+	const float edgeFactor = globalContext->pOptions->preProcEdgeForceFactor;
+
+	for (uint32_t i = nodePartition.begin; i <= nodePartition.end; i++) {
+		float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+		for (uint32_t j = 0; j < numThreads(); j++) {
+			FMEOctreeLocalContext* context = globalContext->pLocalContext[j];
+			sumX += context->forceX[i];
+			sumY += context->forceY[i];
+			sumZ += context->forceZ[i];
+			context->forceX[i] = context->forceY[i] = context->forceZ[i] = 0.0f;
+		}
+
+		float d_x = (globalContext->globalForceX[i] + sumX * edgeFactor) * timeStep;
+		float d_y = (globalContext->globalForceY[i] + sumY * edgeFactor) * timeStep;
+		float d_z = (globalContext->globalForceZ[i] + sumZ * edgeFactor) * timeStep;
+		double dsq = d_x * d_x + d_y * d_y + d_z * d_z;
+		Math::updateMax(localContext->maxForceSq, dsq);
+		if (sqrt(dsq) < FLT_MAX) {
+			x[i] += d_x;
+			y[i] += d_y;
+			z[i] += d_z;
+		}
+		globalContext->globalForceX[i] = 0.0f;
+		globalContext->globalForceY[i] = 0.0f;
+		globalContext->globalForceZ[i] = 0.0f;
+	}
+}
+
+void FMEOctreeKernel::operator()(FMEOctreeGlobalContext* globalContext) {
+	m_pGlobalContext = globalContext;
+	m_pLocalContext = globalContext->pLocalContext[threadNr()];
+	const ArrayGraph& graph = *globalContext->pGraph;
+	const FMEGlobalOptions& options = *globalContext->pOptions;
+
+	const ArrayPartition edgePartition = arrayPartition(graph.numEdges());
+	const ArrayPartition nodePartition = arrayPartition(graph.numNodes());
+
+	// reset the force arrays, the thread arrays are read by all threads when collecting
+	for (uint32_t i = 0; i < graph.numNodes(); i++) {
+		m_pLocalContext->forceX[i] = m_pLocalContext->forceY[i] = m_pLocalContext->forceZ[i] = 0.0f;
+	}
+	for (uint32_t i = nodePartition.begin; i <= nodePartition.end; i++) {
+		globalContext->globalForceX[i] = globalContext->globalForceY[i] =
+				globalContext->globalForceZ[i] = 0.0f;
+	}
+	sync();
+
+	// the preprocessing only uses the edge forces
+	for (uint32_t currNumIteration = 0; currNumIteration < options.preProcMaxNumIterations;
+			currNumIteration++) {
+		edgeForces(edgePartition);
+		sync();
+		collectAndMove(nodePartition, options.preProcTimeStep);
+		sync();
+	}
+	if (isMainThread()) {
+		globalContext->coolDown = 1.0f;
+	}
+	sync();
+
+	for (uint32_t currNumIteration = 0;
+			currNumIteration < options.maxNumIterations && !globalContext->earlyExit;
+			currNumIteration++) {
+		m_pLocalContext->maxForceSq = 0.0;
+
+		octreeConstruction(nodePartition);
+
+		// the repulsive forces go to the global arrays and the edge forces to the threads
+		// arrays, so both can be computed without waiting in between
+		repulsiveForces();
+		edgeForces(edgePartition);
+		sync();
+
+		collectAndMove(nodePartition, options.timeStep * globalContext->coolDown);
+		// wait so we can decide if we need another iteration
+		sync();
+		if (isMainThread()) {
+			double maxForceSq = 0.0;
+			for (uint32_t j = 0; j < numThreads(); j++) {
+				Math::updateMax(maxForceSq, globalContext->pLocalContext[j]->maxForceSq);
+			}
+			if (currNumIteration >= options.minNumIterations && maxForceSq < options.stopCritForce) {
+				globalContext->earlyExit = true;
+			}
+		}
+		// this is required to wait for the earlyExit result
+		sync();
+	}
+}
+
+FMEOctreeGlobalContext* FMEOctreeKernel::allocateContext(ArrayGraph* pGraph,
+		FMEGlobalOptions* pOptions, uint32_t numThreads) {
+	FMEOctreeGlobalContext* globalContext = new FMEOctreeGlobalContext();
+	const uint32_t numNodes = pGraph->numNodes();
+
+	globalContext->numThreads = numThreads;
+	globalContext->pOptions = pOptions;
+	globalContext->pGraph = pGraph;
+	globalContext->pOctree = new LinearOctree(numNodes, pGraph->nodeXPos(), pGraph->nodeYPos(),
+			pGraph->nodeZPos(), pGraph->nodeSize());
+	globalContext->earlyExit = false;
+	globalContext->coolDown = 1.0f;
+
+	// the 3D force of a node at the average desired edge length equals the 2D one
+	float scale = pGraph->numEdges() > 0 ? pGraph->avgDesiredEdgeLength() : 0.0f;
+	if (!(scale > 0.0f)) {
+		scale = pGraph->avgNodeSize() > 0.0f ? 2.0f * pGraph->avgNodeSize() : 1.0f;
+	}
+	float minDist = pGraph->avgNodeSize() > 0.0f ? 0.5f * pGraph->avgNodeSize() : 0.25f * scale;
+	globalContext->repForceScale = scale;
+	globalContext->minDistSq = minDist * minDist;
+
+	globalContext->pLocalContext = new FMEOctreeLocalContext*[numThreads];
+	globalContext->globalForceX = (float*)OGDF_MALLOC_16(sizeof(float) * numNodes);
+	globalContext->globalForceY = (float*)OGDF_MALLOC_16(sizeof(float) * numNodes);
+	globalContext->globalForceZ = (float*)OGDF_MALLOC_16(sizeof(float) * numNodes);
+	for (uint32_t i = 0; i < numThreads; i++) {
+		FMEOctreeLocalContext* localContext = new FMEOctreeLocalContext();
+		localContext->forceX = (float*)OGDF_MALLOC_16(sizeof(float) * numNodes);
+		localContext->forceY = (float*)OGDF_MALLOC_16(sizeof(float) * numNodes);
+		localContext->forceZ = (float*)OGDF_MALLOC_16(sizeof(float) * numNodes);
+		localContext->maxForceSq = 0.0;
+		localContext->pGlobalContext = globalContext;
+		globalContext->pLocalContext[i] = localContext;
+	}
+	return globalContext;
+}
+
+void FMEOctreeKernel::deallocateContext(FMEOctreeGlobalContext* globalContext) {
+	for (uint32_t i = 0; i < globalContext->numThreads; i++) {
+		OGDF_FREE_16(globalContext->pLocalContext[i]->forceX);
+		OGDF_FREE_16(globalContext->pLocalContext[i]->forceY);
+		OGDF_FREE_16(globalContext->pLocalContext[i]->forceZ);
+		delete globalContext->pLocalContext[i];
+	}
+	OGDF_FREE_16(globalContext->globalForceX);
+	OGDF_FREE_16(globalContext->globalForceY);
+	OGDF_FREE_16(globalContext->globalForceZ);
+	delete[] globalContext->pLocalContext;
+	delete globalContext->pOctree;
+	delete globalContext;
+}
+
+}
+}
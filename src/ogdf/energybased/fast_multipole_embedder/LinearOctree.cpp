@@ -0,0 +1,495 @@
+/** \file
+ * \brief Implementation of class LinearOctree.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/internal/intrinsics.h>
+#include <ogdf/energybased/fast_multipole_embedder/LinearOctree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace ogdf {
+namespace fast_multipole_embedder {
+
+namespace {
+
+//! Spreads the lower 21 bits of \p x to every third bit of the result.
+uint64_t spreadBits(uint64_t x) {
+	x &= 0x1fffff;
+	x = (x | (x << 32)) & 0x1f00000000ffff;
+	x = (x | (x << 16)) & 0x1f0000ff0000ff;
+	x = (x | (x << 8)) & 0x100f00f00f00f00f;
+	x = (x | (x << 4)) & 0x10c30c30c30c30c3;
+	x = (x | (x << 2)) & 0x1249249249249249;
+	return x;
+}
+
+// The kernels add the forces on the point (px, py, pz) to (fx, fy, fz). addPointForces sums
+// over the charges q[i] at (x[i], y[i], z[i]) for i in [begin, end), addCellForces over the
+// expansions of the cells, see LinearOctree::computeGroupForces().
+
+void addPointForces(float px, float py, float pz, const float* x, const float* y, const float* z,
+		const float* q, int begin, int end, float minDistSq, float& fx, float& fy, float& fz) {
+	for (int i = begin; i < end; ++i) {
+		float dx = px - x[i];
+		float dy = py - y[i];
+		float dz = pz - z[i];
+		float invDist = 1.0f / std::sqrt(max(dx * dx + dy * dy + dz * dz, minDistSq));
+		float f = q[i] * invDist * invDist * invDist;
+		fx += f * dx;
+		fy += f * dy;
+		fz += f * dz;
+	}
+}
+
+void addCellForces(float px, float py, float pz, const LinearOctree::Workspace& c, int begin,
+		int end, float minDistSq, float& fx, float& fy, float& fz) {
+	for (int i = begin; i < end; ++i) {
+		float dx = px - c.cellX[i];
+		float dy = py - c.cellY[i];
+		float dz = pz - c.cellZ[i];
+		float invDist = 1.0f / std::sqrt(max(dx * dx + dy * dy + dz * dz, minDistSq));
+		float invDist2 = invDist * invDist;
+		float invDist3 = invDist * invDist2;
+		float invDist5 = invDist3 * invDist2;
+		// the field of the monopole and the quadrupole, i.e., minus the gradient of
+		// q / d + r^T Q r / (2 d^5)
+		float qrx = c.xx[i] * dx + c.xy[i] * dy + c.xz[i] * dz;
+		float qry = c.xy[i] * dx + c.yy[i] * dy + c.yz[i] * dz;
+		float qrz = c.xz[i] * dx + c.yz[i] * dy + c.zz[i] * dz;
+		float rqr = dx * qrx + dy * qry + dz * qrz;
+		float f = c.cellQ[i] * invDist3 + 2.5f * rqr * invDist5 * invDist2;
+		fx += f * dx - qrx * invDist5;
+		fy += f * dy - qry * invDist5;
+		fz += f * dz - qrz * invDist5;
+	}
+}
+
+#ifdef OGDF_AVX2_EXTENSIONS
+// returns the sum of the eight lanes of a
+inline float horizontalSum(__m256 a) {
+	__m128 sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	return _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+}
+
+// returns 1 / sqrt(a), the approximation of the instruction is refined by a Newton step
+inline __m256 inverseSqrt(__m256 a) {
+	__m256 r = _mm256_rsqrt_ps(a);
+	__m256 rra = _mm256_mul_ps(_mm256_mul_ps(r, r), a);
+	return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), r),
+			_mm256_sub_ps(_mm256_set1_ps(3.0f), rra));
+}
+
+void addPointForces_avx2(float px, float py, float pz, const float* x, const float* y,
+		const float* z, const float* q, int begin, int end, float minDistSq, float& fx, float& fy,
+		float& fz) {
+	const int vecEnd = end - (end - begin) % 8;
+	const __m256 mm_px = _mm256_set1_ps(px);
+	const __m256 mm_py = _mm256_set1_ps(py);
+	const __m256 mm_pz = _mm256_set1_ps(pz);
+	const __m256 mm_minDistSq = _mm256_set1_ps(minDistSq);
+	__m256 mm_fx = _mm256_setzero_ps(), mm_fy = _mm256_setzero_ps(), mm_fz = _mm256_setzero_ps();
+
+	for (int i = begin; i < vecEnd; i += 8) {
+		__m256 mm_dx = _mm256_sub_ps(mm_px, _mm256_loadu_ps(x + i));
+		__m256 mm_dy = _mm256_sub_ps(mm_py, _mm256_loadu_ps(y + i));
+		__m256 mm_dz = _mm256_sub_ps(mm_pz, _mm256_loadu_ps(z + i));
+		__m256 mm_d2 = _mm256_add_ps(_mm256_mul_ps(mm_dx, mm_dx),
+				_mm256_add_ps(_mm256_mul_ps(mm_dy, mm_dy), _mm256_mul_ps(mm_dz, mm_dz)));
+		__m256 mm_inv = inverseSqrt(_mm256_max_ps(mm_d2, mm_minDistSq));
+		__m256 mm_f = _mm256_mul_ps(_mm256_loadu_ps(q + i),
+				_mm256_mul_ps(mm_inv, _mm256_mul_ps(mm_inv, mm_inv)));
+		mm_fx = _mm256_add_ps(mm_fx, _mm256_mul_ps(mm_f, mm_dx));
+		mm_fy = _mm256_add_ps(mm_fy, _mm256_mul_ps(mm_f, mm_dy));
+		mm_fz = _mm256_add_ps(mm_fz, _mm256_mul_ps(mm_f, mm_dz));
+	}
+
+	fx += horizontalSum(mm_fx);
+	fy += horizontalSum(mm_fy);
+	fz += horizontalSum(mm_fz);
+	addPointForces(px, py, pz, x, y, z, q, vecEnd, end, minDistSq, fx, fy, fz);
+}
+
+void addCellForces_avx2(float px, float py, float pz, const LinearOctree::Workspace& c, int n,
+		float minDistSq, float& fx, float& fy, float& fz) {
+	const int vecEnd = n - n % 8;
+	const __m256 mm_px = _mm256_set1_ps(px);
+	const __m256 mm_py = _mm256_set1_ps(py);
+	const __m256 mm_pz = _mm256_set1_ps(pz);
+	const __m256 mm_minDistSq = _mm256_set1_ps(minDistSq);
+	const __m256 mm_five_halves = _mm256_set1_ps(2.5f);
+	__m256 mm_fx = _mm256_setzero_ps(), mm_fy = _mm256_setzero_ps(), mm_fz = _mm256_setzero_ps();
+
+	for (int i = 0; i < vecEnd; i += 8) {
+		__m256 mm_dx = _mm256_sub_ps(mm_px, _mm256_loadu_ps(c.cellX.data() + i));
+		__m256 mm_dy = _mm256_sub_ps(mm_py, _mm256_loadu_ps(c.cellY.data() + i));
+		__m256 mm_dz = _mm256_sub_ps(mm_pz, _mm256_loadu_ps(c.cellZ.data() + i));
+		__m256 mm_d2 = _mm256_add_ps(_mm256_mul_ps(mm_dx, mm_dx),
+				_mm256_add_ps(_mm256_mul_ps(mm_dy, mm_dy), _mm256_mul_ps(mm_dz, mm_dz)));
+		__m256 mm_inv = inverseSqrt(_mm256_max_ps(mm_d2, mm_minDistSq));
+		__m256 mm_inv2 = _mm256_mul_ps(mm_inv, mm_inv);
+		__m256 mm_inv3 = _mm256_mul_ps(mm_inv, mm_inv2);
+		__m256 mm_inv5 = _mm256_mul_ps(mm_inv3, mm_inv2);
+
+		__m256 mm_xy = _mm256_loadu_ps(c.xy.data() + i);
+		__m256 mm_xz = _mm256_loadu_ps(c.xz.data() + i);
+		__m256 mm_yz = _mm256_loadu_ps(c.yz.data() + i);
+		__m256 mm_qrx = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(c.xx.data() + i), mm_dx),
+				_mm256_add_ps(_mm256_mul_ps(mm_xy, mm_dy), _mm256_mul_ps(mm_xz, mm_dz)));
+		__m256 mm_qry = _mm256_add_ps(_mm256_mul_ps(mm_xy, mm_dx),
+				_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(c.yy.data() + i), mm_dy),
+						_mm256_mul_ps(mm_yz, mm_dz)));
+		__m256 mm_qrz = _mm256_add_ps(_mm256_mul_ps(mm_xz, mm_dx),
+				_mm256_add_ps(_mm256_mul_ps(mm_yz, mm_dy),
+						_mm256_mul_ps(_mm256_loadu_ps(c.zz.data() + i), mm_dz)));
+		__m256 mm_rqr = _mm256_add_ps(_mm256_mul_ps(mm_dx, mm_qrx),
+				_mm256_add_ps(_mm256_mul_ps(mm_dy, mm_qry), _mm256_mul_ps(mm_dz, mm_qrz)));
+
+		__m256 mm_f = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(c.cellQ.data() + i), mm_inv3),
+				_mm256_mul_ps(mm_five_halves,
+						_mm256_mul_ps(mm_rqr, _mm256_mul_ps(mm_inv5, mm_inv2))));
+		mm_fx = _mm256_add_ps(mm_fx,
+				_mm256_sub_ps(_mm256_mul_ps(mm_f, mm_dx), _mm256_mul_ps(mm_qrx, mm_inv5)));
+		mm_fy = _mm256_add_ps(mm_fy,
+				_mm256_sub_ps(_mm256_mul_ps(mm_f, mm_dy), _mm256_mul_ps(mm_qry, mm_inv5)));
+		mm_fz = _mm256_add_ps(mm_fz,
+				_mm256_sub_ps(_mm256_mul_ps(mm_f, mm_dz), _mm256_mul_ps(mm_qrz, mm_inv5)));
+	}
+
+	fx += horizontalSum(mm_fx);
+	fy += horizontalSum(mm_fy);
+	fz += horizontalSum(mm_fz);
+	addCellForces(px, py, pz, c, vecEnd, n, minDistSq, fx, fy, fz);
+}
+#endif
+
+}
+
+LinearOctree::LinearOctree(uint32_t n, const float* x, const float* y, const float* z,
+		const float* q, float theta)
+	: m_numPoints(n)
+	, m_inputX(x)
+	, m_inputY(y)
+	, m_inputZ(z)
+	, m_inputQ(q)
+	, m_theta(theta)
+	, m_min {0.0f, 0.0f, 0.0f}
+	, m_size(1.0f)
+	, m_quantization(1.0)
+	, m_points(n)
+	, m_x(n)
+	, m_y(n)
+	, m_z(n)
+	, m_q(n) {
+#ifdef OGDF_AVX2_EXTENSIONS
+	m_useAVX2 = System::cpuSupports(CPUFeature::AVX2);
+#else
+	m_useAVX2 = false;
+#endif
+}
+
+void LinearOctree::init(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) {
+	m_min[0] = minX;
+	m_min[1] = minY;
+	m_min[2] = minZ;
+	m_size = max(maxX - minX, max(maxY - minY, maxZ - minZ));
+	if (!(m_size > 0.0f)) {
+		m_size = 1.0f;
+	}
+	m_quantization = ((1 << s_maxDepth) - 1) / (double)m_size;
+}
+
+void LinearOctree::computeMortonNumbers(uint32_t begin, uint32_t end) {
+	const uint64_t maxCoord = (1 << s_maxDepth) - 1;
+	auto quantize = [&](float c, float min) {
+		return std::min(maxCoord, static_cast<uint64_t>(max(0.0, (c - min) * m_quantization)));
+	};
+	for (uint32_t i = begin; i <= end; ++i) {
+		m_points[i].mortonNr = spreadBits(quantize(m_inputX[i], m_min[0]))
+				| (spreadBits(quantize(m_inputY[i], m_min[1])) << 1)
+				| (spreadBits(quantize(m_inputZ[i], m_min[2])) << 2);
+		m_points[i].ref = i;
+	}
+}
+
+void LinearOctree::build() {
+	std::sort(m_points.begin(), m_points.end(), [](const Point& a, const Point& b) {
+		return a.mortonNr < b.mortonNr || (a.mortonNr == b.mortonNr && a.ref < b.ref);
+	});
+	for (uint32_t k = 0; k < m_numPoints; ++k) {
+		uint32_t i = m_points[k].ref;
+		m_x[k] = m_inputX[i];
+		m_y[k] = m_inputY[i];
+		m_z[k] = m_inputZ[i];
+		m_q[k] = m_inputQ[i];
+	}
+
+	for (std::vector<float>* a : {&m_cellX, &m_cellY, &m_cellZ, &m_cellQ, &m_qxx, &m_qyy, &m_qzz,
+				 &m_qxy, &m_qxz, &m_qyz, &m_cellSize}) {
+		a->clear();
+	}
+	m_firstChild.clear();
+	m_numChildren.clear();
+	m_begin.clear();
+	m_end.clear();
+	m_groups.clear();
+	if (m_numPoints > 0) {
+		buildCell(newCell(0, m_numPoints, m_size), 0, m_size, false);
+	}
+}
+
+int LinearOctree::newCell(uint32_t begin, uint32_t end, float size) {
+	for (std::vector<float>* a : {&m_cellX, &m_cellY, &m_cellZ, &m_cellQ, &m_qxx, &m_qyy, &m_qzz,
+				 &m_qxy, &m_qxz, &m_qyz}) {
+		a->push_back(0.0f);
+	}
+	m_cellSize.push_back(size);
+	m_firstChild.push_back(-1);
+	m_numChildren.push_back(0);
+	m_begin.push_back(begin);
+	m_end.push_back(end);
+	return static_cast<int>(m_cellX.size()) - 1;
+}
+
+void LinearOctree::buildCell(int cell, int depth, float size, bool inGroup) {
+	const uint32_t begin = m_begin[cell];
+	const uint32_t end = m_end[cell];
+	if (!inGroup && end - begin <= s_groupSize) {
+		m_groups.push_back(cell);
+		inGroup = true;
+	}
+
+	// the moments are accumulated in double precision, the quadrupole tensor about the center
+	// of charge c is the sum of q (3 r r^T - |r|^2 I) with r = p - c over all charges q at p
+	double q = 0.0, x = 0.0, y = 0.0, z = 0.0;
+	double xx = 0.0, yy = 0.0, zz = 0.0, xy = 0.0, xz = 0.0, yz = 0.0;
+	auto center = [&](double sumX, double sumY, double sumZ, double weight) {
+		if (weight > 0.0) {
+			m_cellX[cell] = float(sumX / weight);
+			m_cellY[cell] = float(sumY / weight);
+			m_cellZ[cell] = float(sumZ / weight);
+		}
+	};
+	auto addCharge = [&](double charge, double dx, double dy, double dz) {
+		double d2 = dx * dx + dy * dy + dz * dz;
+		xx += charge * (3.0 * dx * dx - d2);
+		yy += charge * (3.0 * dy * dy - d2);
+		zz += charge * (3.0 * dz * dz - d2);
+		xy += charge * 3.0 * dx * dy;
+		xz += charge * 3.0 * dx * dz;
+		yz += charge * 3.0 * dy * dz;
+	};
+
+	if (end - begin <= s_leafSize || depth == s_maxDepth) {
+		if (!inGroup) {
+			m_groups.push_back(cell);
+		}
+		double px = 0.0, py = 0.0, pz = 0.0;
+		for (uint32_t k = begin; k < end; ++k) {
+			q += m_q[k];
+			x += m_q[k] * m_x[k];
+			y += m_q[k] * m_y[k];
+			z += m_q[k] * m_z[k];
+			px += m_x[k];
+			py += m_y[k];
+			pz += m_z[k];
+		}
+		// without charges the center is only used for the opening criterion
+		center(px, py, pz, end - begin);
+		center(x, y, z, q);
+		for (uint32_t k = begin; k < end; ++k) {
+			addCharge(m_q[k], m_x[k] - m_cellX[cell], m_y[k] - m_cellY[cell],
+					m_z[k] - m_cellZ[cell]);
+		}
+	} else {
+		// the points of an octant share the next three bits of their Morton numbers
+		const int shift = 3 * (s_maxDepth - 1 - depth);
+		const int firstChild = static_cast<int>(m_cellX.size());
+		uint32_t childBegin = begin;
+		for (uint64_t octant = 0; octant < 8 && childBegin < end; ++octant) {
+			uint32_t childEnd = static_cast<uint32_t>(
+					std::partition_point(m_points.begin() + childBegin, m_points.begin() + end,
+							[&](const Point& p) { return ((p.mortonNr >> shift) & 7) <= octant; })
+					- m_points.begin());
+			if (childEnd > childBegin) {
+				newCell(childBegin, childEnd, 0.5f * size);
+				childBegin = childEnd;
+			}
+		}
+		const int numChildren = static_cast<int>(m_cellX.size()) - firstChild;
+		m_firstChild[cell] = firstChild;
+		m_numChildren[cell] = numChildren;
+
+		double px = 0.0, py = 0.0, pz = 0.0;
+		for (int child = firstChild; child < firstChild + numChildren; ++child) {
+			buildCell(child, depth + 1, 0.5f * size, inGroup);
+			double n = m_end[child] - m_begin[child];
+			q += m_cellQ[child];
+			x += m_cellQ[child] * m_cellX[child];
+			y += m_cellQ[child] * m_cellY[child];
+			z += m_cellQ[child] * m_cellZ[child];
+			px += n * m_cellX[child];
+			py += n * m_cellY[child];
+			pz += n * m_cellZ[child];
+		}
+		center(px, py, pz, end - begin);
+		center(x, y, z, q);
+
+		// shift the tensors of the children to the center of this cell
+		for (int child = firstChild; child < firstChild + numChildren; ++child) {
+			xx += m_qxx[child];
+			yy += m_qyy[child];
+			zz += m_qzz[child];
+			xy += m_qxy[child];
+			xz += m_qxz[child];
+			yz += m_qyz[child];
+			addCharge(m_cellQ[child], m_cellX[child] - m_cellX[cell],
+					m_cellY[child] - m_cellY[cell], m_cellZ[child] - m_cellZ[cell]);
+		}
+	}
+
+	m_cellQ[cell] = float(q);
+	m_qxx[cell] = float(xx);
+	m_qyy[cell] = float(yy);
+	m_qzz[cell] = float(zz);
+	m_qxy[cell] = float(xy);
+	m_qxz[cell] = float(xz);
+	m_qyz[cell] = float(yz);
+}
+
+void LinearOctree::computeGroupForces(uint32_t group, float minDistSq, Workspace& workspace) const {
+	const uint32_t begin = firstPointOfGroup(group);
+	const uint32_t end = endPointOfGroup(group);
+	const float theta2 = m_theta * m_theta;
+
+	// the bounding box of the points of the group
+	float minX = m_x[begin], minY = m_y[begin], minZ = m_z[begin];
+	float maxX = minX, maxY = minY, maxZ = minZ;
+	for (uint32_t k = begin + 1; k < end; ++k) {
+		minX = min(minX, m_x[k]);
+		minY = min(minY, m_y[k]);
+		minZ = min(minZ, m_z[k]);
+		maxX = max(maxX, m_x[k]);
+		maxY = max(maxY, m_y[k]);
+		maxZ = max(maxZ, m_z[k]);
+	}
+
+	// find the near leaves and the far cells, a cell is far if it is far from every point
+	Workspace& w = workspace;
+	w.nearLeaves.clear();
+	w.farCells.clear();
+	uint32_t numNear = 0;
+	// each cell on the path to the deepest open cell leaves at most seven siblings
+	int stack[7 * s_maxDepth + 9];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const int cell = stack[--top];
+		if (end <= m_begin[cell] || begin >= m_end[cell]) {
+			float dx = max(0.0f, max(minX - m_cellX[cell], m_cellX[cell] - maxX));
+			float dy = max(0.0f, max(minY - m_cellY[cell], m_cellY[cell] - maxY));
+			float dz = max(0.0f, max(minZ - m_cellZ[cell], m_cellZ[cell] - maxZ));
+			if (m_cellSize[cell] * m_cellSize[cell] <= theta2 * (dx * dx + dy * dy + dz * dz)) {
+				w.farCells.push_back(cell);
+				continue;
+			}
+		}
+
+		if (m_firstChild[cell] < 0) {
+			w.nearLeaves.push_back(cell);
+			numNear += m_end[cell] - m_begin[cell];
+		} else {
+			for (int child = m_firstChild[cell] + m_numChildren[cell] - 1;
+					child >= m_firstChild[cell]; --child) {
+				stack[top++] = child;
+			}
+		}
+	}
+
+	// copy them to contiguous arrays
+	const int numFar = static_cast<int>(w.farCells.size());
+	for (std::vector<float>* a : {&w.x, &w.y, &w.z, &w.q}) {
+		a->resize(numNear);
+	}
+	for (std::vector<float>* a : {&w.cellX, &w.cellY, &w.cellZ, &w.cellQ, &w.xx, &w.yy, &w.zz,
+				 &w.xy, &w.xz, &w.yz}) {
+		a->resize(numFar);
+	}
+	uint32_t i = 0;
+	for (int cell : w.nearLeaves) {
+		for (uint32_t k = m_begin[cell]; k < m_end[cell]; ++k, ++i) {
+			w.x[i] = m_x[k];
+			w.y[i] = m_y[k];
+			w.z[i] = m_z[k];
+			w.q[i] = m_q[k];
+		}
+	}
+	for (int j = 0; j < numFar; ++j) {
+		const int cell = w.farCells[j];
+		w.cellX[j] = m_cellX[cell];
+		w.cellY[j] = m_cellY[cell];
+		w.cellZ[j] = m_cellZ[cell];
+		w.cellQ[j] = m_cellQ[cell];
+		w.xx[j] = m_qxx[cell];
+		w.yy[j] = m_qyy[cell];
+		w.zz[j] = m_qzz[cell];
+		w.xy[j] = m_qxy[cell];
+		w.xz[j] = m_qxz[cell];
+		w.yz[j] = m_qyz[cell];
+	}
+
+	// sum up the forces, the point itself is at distance 0 and does not contribute
+	w.forceX.assign(end - begin, 0.0f);
+	w.forceY.assign(end - begin, 0.0f);
+	w.forceZ.assign(end - begin, 0.0f);
+	for (uint32_t k = begin; k < end; ++k) {
+		float& fx = w.forceX[k - begin];
+		float& fy = w.forceY[k - begin];
+		float& fz = w.forceZ[k - begin];
+#ifdef OGDF_AVX2_EXTENSIONS
+		if (m_useAVX2) {
+			addPointForces_avx2(m_x[k], m_y[k], m_z[k], w.x.data(), w.y.data(), w.z.data(),
+					w.q.data(), 0, (int)numNear, minDistSq, fx, fy, fz);
+			addCellForces_avx2(m_x[k], m_y[k], m_z[k], w, numFar, minDistSq, fx, fy, fz);
+			continue;
+		}
+#endif
+		addPointForces(m_x[k], m_y[k], m_z[k], w.x.data(), w.y.data(), w.z.data(), w.q.data(), 0,
+				numNear, minDistSq, fx, fy, fz);
+		addCellForces(m_x[k], m_y[k], m_z[k], w, 0, numFar, minDistSq, fx, fy, fz);
+	}
+}
+
+}
+}
@@ -32,10 +32,12 @@
 
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/Array2D.h>
+#include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/List.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/fmmm/FMMMOptions.h>
@@ -51,9 +53,12 @@
 #include <algorithm>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #define MIN_BOX_LENGTH 1e-300
 
@@ -118,6 +123,23 @@ static ParticleListState traverse(List<ParticleInfo>& relevantList, double mid_c
 	return state;
 }
 
+//! Calls \p f for each child of \p ptr in the order lt, rt, lb, rb.
+template<typename F>
+static inline void forEachChild(QuadTreeNodeNM* ptr, F f) {
+	if (ptr->child_lt_exists()) {
+		f(ptr->get_child_lt_ptr());
+	}
+	if (ptr->child_rt_exists()) {
+		f(ptr->get_child_rt_ptr());
+	}
+	if (ptr->child_lb_exists()) {
+		f(ptr->get_child_lb_ptr());
+	}
+	if (ptr->child_rb_exists()) {
+		f(ptr->get_child_rb_ptr());
+	}
+}
+
 NewMultipoleMethod::NewMultipoleMethod()
 	: MIN_NODE_NUMBER(175), using_NMM(true), max_power_of_2_index(30) {
 	// setting predefined parameters
@@ -125,6 +147,7 @@ NewMultipoleMethod::NewMultipoleMethod()
 	particles_in_leaves(25);
 	tree_construction_way(FMMMOptions::ReducedTreeConstruction::SubtreeBySubtree);
 	find_sm_cell(FMMMOptions::SmallestCellFinding::Iteratively);
+	number_of_threads(1);
 }
 
 void NewMultipoleMethod::calculate_repulsive_forces(const Graph& G, NodeArray<NodeAttributes>& A,
@@ -142,27 +165,35 @@ void NewMultipoleMethod::calculate_repulsive_forces_by_NMM(const Graph& G,
 	NodeArray<DPoint> F_direct(G);
 	NodeArray<DPoint> F_local_exp(G);
 	NodeArray<DPoint> F_multipole_exp(G);
-	List<QuadTreeNodeNM*> quad_tree_leaves;
+	ArrayBuffer<QuadTreeNodeNM*> quad_tree_leaves, top_nodes, subtree_roots;
+	Array<int> first_leaf;
 
 	// initializations
 	for (node v : G.nodes) {
 		F_direct[v] = F_local_exp[v] = F_multipole_exp[v] = DPoint(0, 0);
 	}
 
-	quad_tree_leaves.clear();
 	switch (tree_construction_way()) {
 	case FMMMOptions::ReducedTreeConstruction::PathByPath:
 		build_up_red_quad_tree_path_by_path(G, A, T);
 		break;
 	case FMMMOptions::ReducedTreeConstruction::SubtreeBySubtree:
 		build_up_red_quad_tree_subtree_by_subtree(G, A, T);
+		break;
+	case FMMMOptions::ReducedTreeConstruction::MortonOrder:
+		build_up_red_quad_tree_morton_order(G, A, T);
 	}
 
-	form_multipole_expansions(A, T, quad_tree_leaves);
-	calculate_local_expansions_and_WSPRLS(A, T.get_root_ptr());
-	transform_local_exp_to_forces(A, quad_tree_leaves, F_local_exp);
-	transform_multipole_exp_to_forces(A, quad_tree_leaves, F_multipole_exp);
-	calculate_neighbourcell_forces(A, quad_tree_leaves, F_direct);
+	// the centers are set sequentially, they depend on the sequence of random numbers
+	init_expansions_of_subtree(T.get_root_ptr(), quad_tree_leaves);
+	split_red_quad_tree(T, top_nodes, subtree_roots);
+	partition_leaves(quad_tree_leaves, first_leaf);
+
+	form_multipole_expansions(A, top_nodes, subtree_roots);
+	calculate_local_expansions_and_WSPRLS(A, top_nodes, subtree_roots);
+	transform_local_exp_to_forces(A, quad_tree_leaves, first_leaf, F_local_exp);
+	transform_multipole_exp_to_forces(A, quad_tree_leaves, first_leaf, F_multipole_exp);
+	calculate_neighbourcell_forces(G, A, quad_tree_leaves, first_leaf, F_direct);
 	add_rep_forces(G, F_direct, F_multipole_exp, F_local_exp, F_rep);
 
 	delete_red_quad_tree_and_count_treenodes(T);
@@ -174,7 +205,8 @@ inline void NewMultipoleMethod::calculate_repulsive_forces_by_exact_method(const
 }
 
 void NewMultipoleMethod::make_initialisations(const Graph& G, double bl, DPoint d_l_c, int p_i_l,
-		int p, FMMMOptions::ReducedTreeConstruction t_c_w, FMMMOptions::SmallestCellFinding f_s_c) {
+		int p, FMMMOptions::ReducedTreeConstruction t_c_w, FMMMOptions::SmallestCellFinding f_s_c,
+		int n_t) {
 	if (G.numberOfNodes() >= MIN_NODE_NUMBER) { // using_NMM
 		using_NMM = true; //indicate that NMM is used for force calculation
 
@@ -182,6 +214,7 @@ void NewMultipoleMethod::make_initialisations(const Graph& G, double bl, DPoint
 		precision(p);
 		tree_construction_way(t_c_w);
 		find_sm_cell(f_s_c);
+		number_of_threads(n_t);
 		down_left_corner = d_l_c; //Export this two values from FMMM
 		boxlength = bl;
 		init_binko(2 * precision());
@@ -223,6 +256,36 @@ inline int NewMultipoleMethod::maxboxindex(int level) {
 	}
 }
 
+void NewMultipoleMethod::run_in_parallel(int number_of_tasks,
+		const std::function<void(int)>& task) {
+	const int number_of_workers = min(number_of_threads(), number_of_tasks);
+	if (number_of_workers <= 1) {
+		for (int i = 0; i < number_of_tasks; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	std::vector<std::function<void()>> workers;
+	workers.reserve(number_of_workers);
+	for (int t = 0; t < number_of_workers; t++) {
+		workers.emplace_back([&task, t, number_of_workers, number_of_tasks] {
+			for (int i = t; i < number_of_tasks; i += number_of_workers) {
+				task(i);
+			}
+		});
+	}
+
+	Array<Thread> threads(1, number_of_workers - 1);
+	for (int t = 1; t < number_of_workers; t++) {
+		threads[t] = Thread(workers[t]);
+	}
+	workers[0]();
+	for (Thread& thread : threads) {
+		thread.join();
+	}
+}
+
 void NewMultipoleMethod::build_up_red_quad_tree_path_by_path(const Graph& G,
 		NodeArray<NodeAttributes>& A, QuadTreeNM& T) {
 	List<QuadTreeNodeNM*> act_leaf_List, new_leaf_List;
@@ -798,7 +861,6 @@ void NewMultipoleMethod::build_up_red_quad_tree_subtree_by_subtree(const Graph&
 		NodeArray<NodeAttributes>& A, QuadTreeNM& T) {
 	List<QuadTreeNodeNM*> act_subtree_root_List, new_subtree_root_List;
 	List<QuadTreeNodeNM*>*act_subtree_root_List_ptr, *new_subtree_root_List_ptr, *help_ptr;
-	QuadTreeNodeNM* subtree_root_ptr;
 
 	build_up_root_vertex(G, T);
 
@@ -809,9 +871,14 @@ void NewMultipoleMethod::build_up_red_quad_tree_subtree_by_subtree(const Graph&
 	new_subtree_root_List_ptr = &new_subtree_root_List;
 
 	while (!act_subtree_root_List_ptr->empty()) {
-		while (!act_subtree_root_List_ptr->empty()) {
-			subtree_root_ptr = act_subtree_root_List_ptr->popFrontRet();
-			construct_subtree(A, T, subtree_root_ptr, *new_subtree_root_List_ptr);
+		if (number_of_threads() == 1) {
+			while (!act_subtree_root_List_ptr->empty()) {
+				QuadTreeNodeNM* subtree_root_ptr = act_subtree_root_List_ptr->popFrontRet();
+				construct_subtree(A, T, subtree_root_ptr, *new_subtree_root_List_ptr);
+			}
+		} else {
+			construct_subtrees_in_parallel(A, T, *act_subtree_root_List_ptr,
+					*new_subtree_root_List_ptr);
 		}
 		help_ptr = act_subtree_root_List_ptr;
 		act_subtree_root_List_ptr = new_subtree_root_List_ptr;
@@ -819,6 +886,42 @@ void NewMultipoleMethod::build_up_red_quad_tree_subtree_by_subtree(const Graph&
 	}
 }
 
+void NewMultipoleMethod::construct_subtrees_in_parallel(NodeArray<NodeAttributes>& A,
+		QuadTreeNM& T, List<QuadTreeNodeNM*>& subtree_root_List,
+		List<QuadTreeNodeNM*>& new_subtree_root_List) {
+	// Subtree roots with the same father are handled by the same task, since
+	// deleting a degenerated subtree root changes the child pointers of its father.
+	std::unordered_map<QuadTreeNodeNM*, int> task_of_father;
+	std::vector<std::vector<QuadTreeNodeNM*>> roots;
+	for (QuadTreeNodeNM* ptr : subtree_root_List) {
+		auto it = task_of_father.emplace(ptr->get_father_ptr(), int(roots.size())).first;
+		if (it->second == int(roots.size())) {
+			roots.emplace_back();
+		}
+		roots[it->second].push_back(ptr);
+	}
+	subtree_root_List.clear();
+
+	if (roots.size() == 1) { // the root of T may be replaced, use T itself
+		for (QuadTreeNodeNM* ptr : roots.front()) {
+			construct_subtree(A, T, ptr, new_subtree_root_List);
+		}
+		return;
+	}
+
+	Array<List<QuadTreeNodeNM*>> new_roots(int(roots.size()));
+	run_in_parallel(int(roots.size()), [&](int task) {
+		QuadTreeNM T_task;
+		T_task.set_root_ptr(T.get_root_ptr());
+		for (QuadTreeNodeNM* ptr : roots[task]) {
+			construct_subtree(A, T_task, ptr, new_roots[task]);
+		}
+	});
+	for (List<QuadTreeNodeNM*>& L : new_roots) {
+		new_subtree_root_List.conc(L);
+	}
+}
+
 void NewMultipoleMethod::build_up_root_vertex(const Graph& G, QuadTreeNM& T) {
 	T.init_tree();
 	T.get_root_ptr()->set_Sm_level(0);
@@ -1186,6 +1289,129 @@ void NewMultipoleMethod::collect_contained_nodes(QuadTreeNM& T, QuadTreeNodeNM*
 	}
 }
 
+void NewMultipoleMethod::build_up_red_quad_tree_morton_order(const Graph& G,
+		NodeArray<NodeAttributes>& A, QuadTreeNM& T) {
+	sort_particles_by_morton_code(G, A);
+	T.init_tree();
+	construct_morton_subtree(T, 0, static_cast<int>(morton_particles.size()));
+}
+
+//! Returns \p x with a zero bit inserted in front of each of its bits.
+static inline uint64_t spread_bits(uint32_t x) {
+	uint64_t z = x;
+	z = (z | (z << 16)) & 0x0000FFFF0000FFFFull;
+	z = (z | (z << 8)) & 0x00FF00FF00FF00FFull;
+	z = (z | (z << 4)) & 0x0F0F0F0F0F0F0F0Full;
+	z = (z | (z << 2)) & 0x3333333333333333ull;
+	z = (z | (z << 1)) & 0x5555555555555555ull;
+	return z;
+}
+
+void NewMultipoleMethod::sort_particles_by_morton_code(const Graph& G,
+		NodeArray<NodeAttributes>& A) {
+	const uint32_t grid_size = uint32_t(1) << max_power_of_2_index;
+	const double scale = grid_size / boxlength;
+	auto grid_coord = [&](double c) {
+		double g = floor(c * scale);
+		return g <= 0 ? 0 : (g >= grid_size ? grid_size - 1 : static_cast<uint32_t>(g));
+	};
+
+	morton_particles.resize(G.numberOfNodes());
+	morton_buffer.resize(G.numberOfNodes());
+	int i = 0;
+	for (node v : G.nodes) {
+		MortonParticle& p = morton_particles[i++];
+		p.x = grid_coord(A[v].get_x() - down_left_corner.m_x);
+		p.y = grid_coord(A[v].get_y() - down_left_corner.m_y);
+		p.code = spread_bits(p.x) | (spread_bits(p.y) << 1);
+		p.v = v;
+	}
+
+	// LSD radix sort with 16-bit digits (stable, so the result is deterministic)
+	const int digit_bits = 16;
+	std::vector<int> first_of_digit(1 << digit_bits);
+	for (int shift = 0; shift < 2 * max_power_of_2_index; shift += digit_bits) {
+		std::fill(first_of_digit.begin(), first_of_digit.end(), 0);
+		for (const MortonParticle& p : morton_particles) {
+			first_of_digit[(p.code >> shift) & 0xFFFF]++;
+		}
+		if (first_of_digit[(morton_particles.front().code >> shift) & 0xFFFF]
+				== G.numberOfNodes()) {
+			continue; // all particles have the same digit
+		}
+		int sum = 0;
+		for (int& first : first_of_digit) {
+			int count = first;
+			first = sum;
+			sum += count;
+		}
+		for (const MortonParticle& p : morton_particles) {
+			morton_buffer[first_of_digit[(p.code >> shift) & 0xFFFF]++] = p;
+		}
+		std::swap(morton_particles, morton_buffer);
+	}
+}
+
+void NewMultipoleMethod::construct_morton_subtree(QuadTreeNM& T, int first, int last) {
+	QuadTreeNodeNM* act_ptr = T.get_act_ptr();
+	const MortonParticle& p_first = morton_particles[first];
+	const uint64_t diff = p_first.code ^ morton_particles[last - 1].code;
+
+	// the codes are sorted, so the particles in between share the common prefix of the
+	// codes of the first and the last particle, which defines the smallest cell
+	int level = max_power_of_2_index;
+	while (diff >> (2 * (max_power_of_2_index - level))) {
+		level--;
+	}
+	const int shift = max_power_of_2_index - level;
+	const double Sm_boxlength = boxlength / power_of_two(level);
+	act_ptr->set_Sm_level(level);
+	act_ptr->set_Sm_boxlength(Sm_boxlength);
+	act_ptr->set_Sm_downleftcorner(
+			DPoint(down_left_corner.m_x + Sm_boxlength * (p_first.x >> shift),
+					down_left_corner.m_y + Sm_boxlength * (p_first.y >> shift)));
+	act_ptr->set_particlenumber_in_subtree(last - first);
+
+	if (last - first <= particles_in_leaves() || level == max_power_of_2_index) {
+		for (int i = first; i < last; i++) {
+			act_ptr->pushBack_contained_nodes(morton_particles[i].v);
+		}
+		return;
+	}
+
+	// the particles of each quad are consecutive, ordered lb, rb, lt, rt
+	const int child_shift = 2 * (shift - 1);
+	MortonParticle* particles = morton_particles.data();
+	int begin = first;
+	for (uint64_t quad = 0; quad < 4 && begin < last; quad++) {
+		MortonParticle* quad_end = std::partition_point(particles + begin, particles + last,
+				[&](const MortonParticle& p) { return ((p.code >> child_shift) & 3) <= quad; });
+		int end = static_cast<int>(quad_end - particles);
+		if (end > begin) {
+			switch (quad) {
+			case 0:
+				T.create_new_lb_child();
+				T.go_to_lb_child();
+				break;
+			case 1:
+				T.create_new_rb_child();
+				T.go_to_rb_child();
+				break;
+			case 2:
+				T.create_new_lt_child();
+				T.go_to_lt_child();
+				break;
+			default:
+				T.create_new_rt_child();
+				T.go_to_rt_child();
+			}
+			construct_morton_subtree(T, begin, end);
+			T.go_to_father();
+		}
+		begin = end;
+	}
+}
+
 bool NewMultipoleMethod::find_smallest_quad(NodeArray<NodeAttributes>& A, QuadTreeNM& T) {
 	OGDF_ASSERT(!T.get_act_ptr()->contained_nodes_empty());
 #if 0
@@ -1364,45 +1590,89 @@ inline void NewMultipoleMethod::delete_red_quad_tree_and_count_treenodes(QuadTre
 	T.delete_tree(T.get_root_ptr());
 }
 
-inline void NewMultipoleMethod::form_multipole_expansions(NodeArray<NodeAttributes>& A,
-		QuadTreeNM& T, List<QuadTreeNodeNM*>& quad_tree_leaves) {
-	T.set_act_ptr(T.get_root_ptr());
-	form_multipole_expansion_of_subtree(A, T, quad_tree_leaves);
-}
+void NewMultipoleMethod::init_expansions_of_subtree(QuadTreeNodeNM* act_ptr,
+		ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves) {
+	init_expansion_Lists(act_ptr);
+	set_center(act_ptr);
 
-void NewMultipoleMethod::form_multipole_expansion_of_subtree(NodeArray<NodeAttributes>& A,
-		QuadTreeNM& T, List<QuadTreeNodeNM*>& quad_tree_leaves) {
-	init_expansion_Lists(T.get_act_ptr());
-	set_center(T.get_act_ptr());
+	if (act_ptr->is_leaf()) {
+		quad_tree_leaves.push(act_ptr);
+	} else {
+		forEachChild(act_ptr, [&](QuadTreeNodeNM* child_ptr) {
+			init_expansions_of_subtree(child_ptr, quad_tree_leaves);
+		});
+	}
+}
 
-	if (T.get_act_ptr()->is_leaf()) { // form expansions for leaf nodes
-		quad_tree_leaves.pushBack(T.get_act_ptr());
-		form_multipole_expansion_of_leaf_node(A, T.get_act_ptr());
-	} else { // recursive calls and add shifted expansions
-		if (T.get_act_ptr()->child_lt_exists()) {
-			T.go_to_lt_child();
-			form_multipole_expansion_of_subtree(A, T, quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
-			T.go_to_father();
-		}
-		if (T.get_act_ptr()->child_rt_exists()) {
-			T.go_to_rt_child();
-			form_multipole_expansion_of_subtree(A, T, quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
-			T.go_to_father();
-		}
-		if (T.get_act_ptr()->child_lb_exists()) {
-			T.go_to_lb_child();
-			form_multipole_expansion_of_subtree(A, T, quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
-			T.go_to_father();
+void NewMultipoleMethod::split_red_quad_tree(QuadTreeNM& T,
+		ArrayBuffer<QuadTreeNodeNM*>& top_nodes, ArrayBuffer<QuadTreeNodeNM*>& subtree_roots) {
+	const int min_number_of_subtrees = number_of_threads() > 1 ? 4 * number_of_threads() : 1;
+	ArrayBuffer<QuadTreeNodeNM*> next_level;
+	bool split = true;
+
+	subtree_roots.push(T.get_root_ptr());
+	while (split && subtree_roots.size() < min_number_of_subtrees) {
+		split = false;
+		next_level.clear();
+		for (QuadTreeNodeNM* ptr : subtree_roots) {
+			if (ptr->is_leaf()) {
+				next_level.push(ptr);
+			} else {
+				split = true;
+				top_nodes.push(ptr);
+				forEachChild(ptr, [&](QuadTreeNodeNM* child_ptr) { next_level.push(child_ptr); });
+			}
 		}
-		if (T.get_act_ptr()->child_rb_exists()) {
-			T.go_to_rb_child();
-			form_multipole_expansion_of_subtree(A, T, quad_tree_leaves);
-			add_shifted_expansion_to_father_expansion(T.get_act_ptr());
-			T.go_to_father();
+		std::swap(subtree_roots, next_level);
+	}
+}
+
+void NewMultipoleMethod::partition_leaves(const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves,
+		Array<int>& first_leaf) {
+	const int number_of_chunks = max(1, min(number_of_threads(), quad_tree_leaves.size()));
+	int64_t number_of_particles = 0;
+	for (QuadTreeNodeNM* leaf_ptr : quad_tree_leaves) {
+		number_of_particles += leaf_ptr->get_particlenumber_in_subtree();
+	}
+
+	first_leaf.init(number_of_chunks + 1);
+	first_leaf[0] = 0;
+	int i = 0;
+	int64_t particles_so_far = 0;
+	for (int c = 1; c < number_of_chunks; c++) {
+		const int64_t bound = number_of_particles * c / number_of_chunks;
+		while (i < quad_tree_leaves.size() && particles_so_far < bound) {
+			particles_so_far += quad_tree_leaves[i++]->get_particlenumber_in_subtree();
 		}
+		first_leaf[c] = i;
+	}
+	first_leaf[number_of_chunks] = quad_tree_leaves.size();
+}
+
+void NewMultipoleMethod::form_multipole_expansions(NodeArray<NodeAttributes>& A,
+		const ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+		const ArrayBuffer<QuadTreeNodeNM*>& subtree_roots) {
+	run_in_parallel(subtree_roots.size(),
+			[&](int i) { form_multipole_expansion_of_subtree(A, subtree_roots[i]); });
+
+	// children are handled before their fathers, and the shifted expansions of the
+	// children are added in the same order as in form_multipole_expansion_of_subtree()
+	for (int i = top_nodes.size() - 1; i >= 0; i--) {
+		forEachChild(top_nodes[i], [&](QuadTreeNodeNM* child_ptr) {
+			add_shifted_expansion_to_father_expansion(child_ptr);
+		});
+	}
+}
+
+void NewMultipoleMethod::form_multipole_expansion_of_subtree(NodeArray<NodeAttributes>& A,
+		QuadTreeNodeNM* act_ptr) {
+	if (act_ptr->is_leaf()) { // form expansions for leaf nodes
+		form_multipole_expansion_of_leaf_node(A, act_ptr);
+	} else { // recursive calls and add shifted expansions
+		forEachChild(act_ptr, [&](QuadTreeNodeNM* child_ptr) {
+			form_multipole_expansion_of_subtree(A, child_ptr);
+			add_shifted_expansion_to_father_expansion(child_ptr);
+		});
 	}
 }
 
@@ -1491,8 +1761,30 @@ void NewMultipoleMethod::add_shifted_expansion_to_father_expansion(QuadTreeNodeN
 	}
 }
 
+void NewMultipoleMethod::calculate_local_expansions_and_WSPRLS(NodeArray<NodeAttributes>& A,
+		const ArrayBuffer<QuadTreeNodeNM*>& top_nodes,
+		const ArrayBuffer<QuadTreeNodeNM*>& subtree_roots) {
+	// the fathers of the top nodes and of the subtree roots are top nodes
+	// and top_nodes is sorted top-down
+	for (QuadTreeNodeNM* ptr : top_nodes) {
+		calculate_local_expansions_and_WSPRLS_of_node(A, ptr);
+	}
+	run_in_parallel(subtree_roots.size(),
+			[&](int i) { calculate_local_expansions_and_WSPRLS(A, subtree_roots[i]); });
+}
+
 void NewMultipoleMethod::calculate_local_expansions_and_WSPRLS(NodeArray<NodeAttributes>& A,
 		QuadTreeNodeNM* act_node_ptr) {
+	calculate_local_expansions_and_WSPRLS_of_node(A, act_node_ptr);
+
+	// Step 4: recursive calls if act_node is not a leaf
+	forEachChild(act_node_ptr, [&](QuadTreeNodeNM* child_ptr) {
+		calculate_local_expansions_and_WSPRLS(A, child_ptr);
+	});
+}
+
+void NewMultipoleMethod::calculate_local_expansions_and_WSPRLS_of_node(
+		NodeArray<NodeAttributes>& A, QuadTreeNodeNM* act_node_ptr) {
 	List<QuadTreeNodeNM*> I, L, L2, E, D1, D2, M;
 	QuadTreeNodeNM* selected_node_ptr;
 
@@ -1585,21 +1877,7 @@ void NewMultipoleMethod::calculate_local_expansions_and_WSPRLS(NodeArray<NodeAtt
 		add_local_expansion_of_leaf(A, ptr, act_node_ptr);
 	}
 
-	// Step 4: recursive calls if act_node is not a leaf
-	if (!act_node_ptr->is_leaf()) {
-		if (act_node_ptr->child_lt_exists()) {
-			calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_lt_ptr());
-		}
-		if (act_node_ptr->child_rt_exists()) {
-			calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_rt_ptr());
-		}
-		if (act_node_ptr->child_lb_exists()) {
-			calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_lb_ptr());
-		}
-		if (act_node_ptr->child_rb_exists()) {
-			calculate_local_expansions_and_WSPRLS(A, act_node_ptr->get_child_rb_ptr());
-		}
-	} else { // *act_node_ptr is a leaf
+	if (act_node_ptr->is_leaf()) {
 		// Step 5: WSPRLS(Well Separateness Preserving Refinement of leaf surroundings)
 		// if act_node is a leaf then calculate the list D1,D2 and M from I and D1
 		act_node_ptr->get_D1(D1);
@@ -1814,85 +2092,126 @@ void NewMultipoleMethod::add_local_expansion_of_leaf(NodeArray<NodeAttributes>&
 }
 
 void NewMultipoleMethod::transform_local_exp_to_forces(NodeArray<NodeAttributes>& A,
-		List<QuadTreeNodeNM*>& quad_tree_leaves, NodeArray<DPoint>& F_local_exp) {
-	complex<double> sum;
-	complex<double> complex_null(0, 0);
-	complex<double> z_0;
-	complex<double> z_v_minus_z_0_over_k_minus_1;
-	DPoint force_vector;
-
+		const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, const Array<int>& first_leaf,
+		NodeArray<DPoint>& F_local_exp) {
 	//calculate derivative of the potential polynom (= local expansion at leaf nodes)
 	//and evaluate it for each node in contained_nodes()
 	//and transform the complex number back to the real-world, to obtain the force
 
-	for (const QuadTreeNodeNM* leaf_ptr : quad_tree_leaves) {
-		List<node> contained_nodes;
-		leaf_ptr->get_contained_nodes(contained_nodes);
-		z_0 = leaf_ptr->get_Sm_center();
-
-		for (node v : contained_nodes) {
-			complex<double> z_v(A[v].get_x(), A[v].get_y());
-			sum = complex_null;
-			z_v_minus_z_0_over_k_minus_1 = 1;
-			for (int k = 1; k <= precision(); k++) {
-				sum += double(k) * leaf_ptr->get_local_exp()[k] * z_v_minus_z_0_over_k_minus_1;
-				z_v_minus_z_0_over_k_minus_1 *= z_v - z_0;
+	run_in_parallel(first_leaf.size() - 1, [&](int chunk) {
+		complex<double> sum;
+		complex<double> complex_null(0, 0);
+		complex<double> z_0;
+		complex<double> z_v_minus_z_0_over_k_minus_1;
+		DPoint force_vector;
+
+		for (int i = first_leaf[chunk]; i < first_leaf[chunk + 1]; i++) {
+			const QuadTreeNodeNM* leaf_ptr = quad_tree_leaves[i];
+			List<node> contained_nodes;
+			leaf_ptr->get_contained_nodes(contained_nodes);
+			z_0 = leaf_ptr->get_Sm_center();
+
+			for (node v : contained_nodes) {
+				complex<double> z_v(A[v].get_x(), A[v].get_y());
+				sum = complex_null;
+				z_v_minus_z_0_over_k_minus_1 = 1;
+				for (int k = 1; k <= precision(); k++) {
+					sum += double(k) * leaf_ptr->get_local_exp()[k] * z_v_minus_z_0_over_k_minus_1;
+					z_v_minus_z_0_over_k_minus_1 *= z_v - z_0;
+				}
+				force_vector.m_x = sum.real();
+				force_vector.m_y = (-1) * sum.imag();
+				F_local_exp[v] = force_vector;
 			}
-			force_vector.m_x = sum.real();
-			force_vector.m_y = (-1) * sum.imag();
-			F_local_exp[v] = force_vector;
 		}
-	}
+	});
 }
 
 void NewMultipoleMethod::transform_multipole_exp_to_forces(NodeArray<NodeAttributes>& A,
-		List<QuadTreeNodeNM*>& quad_tree_leaves, NodeArray<DPoint>& F_multipole_exp) {
-	complex<double> sum;
-	complex<double> z_0;
-	complex<double> z_v_minus_z_0_over_minus_k_minus_1;
-	DPoint force_vector;
-
+		const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, const Array<int>& first_leaf,
+		NodeArray<DPoint>& F_multipole_exp) {
 	//for each leaf u in the M-List of an actual leaf v do:
 	//calculate derivative of the multipole expansion function at u
 	//and evaluate it for each node in v.get_contained_nodes()
 	//and transform the complex number back to the real-world, to obtain the force
 
-	for (QuadTreeNodeNM* act_leaf_ptr : quad_tree_leaves) {
-		List<node> act_contained_nodes;
-		act_leaf_ptr->get_contained_nodes(act_contained_nodes);
+	run_in_parallel(first_leaf.size() - 1, [&](int chunk) {
+		complex<double> sum;
+		complex<double> z_0;
+		complex<double> z_v_minus_z_0_over_minus_k_minus_1;
+		DPoint force_vector;
 
-		List<QuadTreeNodeNM*> M;
-		act_leaf_ptr->get_M(M);
+		for (int i = first_leaf[chunk]; i < first_leaf[chunk + 1]; i++) {
+			const QuadTreeNodeNM* act_leaf_ptr = quad_tree_leaves[i];
+			List<node> act_contained_nodes;
+			act_leaf_ptr->get_contained_nodes(act_contained_nodes);
 
-		for (const QuadTreeNodeNM* M_node_ptr : M) {
-			z_0 = M_node_ptr->get_Sm_center();
-			for (node v : act_contained_nodes) {
-				complex<double> z_v(A[v].get_x(), A[v].get_y());
-				z_v_minus_z_0_over_minus_k_minus_1 = 1.0 / (z_v - z_0);
-				sum = M_node_ptr->get_multipole_exp()[0] * z_v_minus_z_0_over_minus_k_minus_1;
+			List<QuadTreeNodeNM*> M;
+			act_leaf_ptr->get_M(M);
 
-				for (int k = 1; k <= precision(); k++) {
-					z_v_minus_z_0_over_minus_k_minus_1 /= z_v - z_0;
-					sum -= double(k) * M_node_ptr->get_multipole_exp()[k]
-							* z_v_minus_z_0_over_minus_k_minus_1;
+			for (const QuadTreeNodeNM* M_node_ptr : M) {
+				z_0 = M_node_ptr->get_Sm_center();
+				for (node v : act_contained_nodes) {
+					complex<double> z_v(A[v].get_x(), A[v].get_y());
+					z_v_minus_z_0_over_minus_k_minus_1 = 1.0 / (z_v - z_0);
+					sum = M_node_ptr->get_multipole_exp()[0] * z_v_minus_z_0_over_minus_k_minus_1;
+
+					for (int k = 1; k <= precision(); k++) {
+						z_v_minus_z_0_over_minus_k_minus_1 /= z_v - z_0;
+						sum -= double(k) * M_node_ptr->get_multipole_exp()[k]
+								* z_v_minus_z_0_over_minus_k_minus_1;
+					}
+					force_vector.m_x = sum.real();
+					force_vector.m_y = (-1) * sum.imag();
+					F_multipole_exp[v] = F_multipole_exp[v] + force_vector;
 				}
-				force_vector.m_x = sum.real();
-				force_vector.m_y = (-1) * sum.imag();
-				F_multipole_exp[v] = F_multipole_exp[v] + force_vector;
 			}
 		}
+	});
+}
+
+void NewMultipoleMethod::calculate_neighbourcell_forces(const Graph& G,
+		NodeArray<NodeAttributes>& A, const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves,
+		const Array<int>& first_leaf, NodeArray<DPoint>& F_direct) {
+	const int number_of_chunks = first_leaf.size() - 1;
+	if (number_of_chunks == 1) {
+		calculate_neighbourcell_forces(A, quad_tree_leaves, first_leaf[0], first_leaf[1],
+				F_direct);
+		return;
+	}
+
+	// The forces between neighboured leaves are added to both leaves, so the chunks
+	// cannot share F_direct. The first chunk uses F_direct itself.
+	Array<NodeArray<DPoint>> F_chunk(1, number_of_chunks - 1);
+	run_in_parallel(number_of_chunks, [&](int chunk) {
+		if (chunk == 0) {
+			calculate_neighbourcell_forces(A, quad_tree_leaves, first_leaf[0], first_leaf[1],
+					F_direct);
+		} else {
+			F_chunk[chunk].init(G, DPoint(0, 0));
+			calculate_neighbourcell_forces(A, quad_tree_leaves, first_leaf[chunk],
+					first_leaf[chunk + 1], F_chunk[chunk]);
+		}
+	});
+
+	for (node v : G.nodes) {
+		for (int chunk = 1; chunk < number_of_chunks; chunk++) {
+			F_direct[v] += F_chunk[chunk][v];
+		}
 	}
 }
 
 void NewMultipoleMethod::calculate_neighbourcell_forces(NodeArray<NodeAttributes>& A,
-		List<QuadTreeNodeNM*>& quad_tree_leaves, NodeArray<DPoint>& F_direct) {
+		const ArrayBuffer<QuadTreeNodeNM*>& quad_tree_leaves, int first, int last,
+		NodeArray<DPoint>& F_direct) {
 	List<node> act_contained_nodes, neighbour_contained_nodes, non_neighbour_contained_nodes;
 	List<QuadTreeNodeNM*> neighboured_leaves;
 	List<QuadTreeNodeNM*> non_neighboured_leaves;
 	double act_leaf_boxlength, neighbour_leaf_boxlength;
 	DPoint act_leaf_dlc, neighbour_leaf_dlc;
 
-	for (QuadTreeNodeNM* act_leaf : quad_tree_leaves) {
+	for (int i = first; i < last; i++) {
+		QuadTreeNodeNM* act_leaf = quad_tree_leaves[i];
 		act_leaf->get_contained_nodes(act_contained_nodes);
 
 		if (act_contained_nodes.size() <= particles_in_leaves()) { // usual case
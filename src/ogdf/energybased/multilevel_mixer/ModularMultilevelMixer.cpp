@@ -31,8 +31,10 @@
 
 
 #include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/LayoutModule.h>
+#include <ogdf/basic/List.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/exceptions.h>
 #include <ogdf/energybased/SpringEmbedderGridVariant.h>
@@ -44,8 +46,11 @@
 #include <ogdf/energybased/multilevel_mixer/SolarMerger.h>
 
 #include <cmath>
+#include <cstddef>
+#include <initializer_list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #ifdef OGDF_MMM_LEVEL_OUTPUTS
 #	include <sstream>
@@ -53,7 +58,6 @@
 
 
 namespace ogdf {
-class GraphAttributes;
 
 ModularMultilevelMixer::ModularMultilevelMixer() {
 	// options
@@ -63,6 +67,7 @@ ModularMultilevelMixer::ModularMultilevelMixer() {
 	m_coarseningRatio = 1.0;
 	m_levelBound = false;
 	m_randomize = false;
+	m_incrementalRadius = 2;
 
 	// module options
 	setMultilevelBuilder(new SolarMerger);
@@ -161,4 +166,208 @@ void ModularMultilevelMixer::call(MultilevelGraph& MLG) {
 	}
 }
 
+namespace {
+
+// Moves the nodes in part to their positions in subGA, transformed such that the unchanged
+// nodes of part and anchors fit their positions in GA best in the least squares sense.
+void fitLayout(GraphAttributes& GA, const GraphAttributes& subGA, const NodeArray<node>& toSub,
+		const NodeArray<bool>& changed, const std::vector<node>& part,
+		const std::vector<node>& anchors) {
+	std::vector<node> refs;
+	for (const std::vector<node>* nodes : {&part, &anchors}) {
+		for (node v : *nodes) {
+			if (!changed[v]) {
+				refs.push_back(v);
+			}
+		}
+	}
+	// a new component is only translated to where its nodes have been placed
+	bool translateOnly = refs.size() < 2;
+	if (refs.empty()) {
+		refs = part;
+	}
+
+	double px = 0.0, py = 0.0, qx = 0.0, qy = 0.0;
+	for (node v : refs) {
+		px += subGA.x(toSub[v]);
+		py += subGA.y(toSub[v]);
+		qx += GA.x(v);
+		qy += GA.y(v);
+	}
+	px /= refs.size();
+	py /= refs.size();
+	qx /= refs.size();
+	qy /= refs.size();
+
+	// the best similarity maps p to a * p with the complex number a = sum(conj(p) q) / sum(|p|^2)
+	// for the centered points, try both the layout and its mirror image
+	double re[2] = {0.0, 0.0}, im[2] = {0.0, 0.0}, norm = 0.0;
+	for (node v : refs) {
+		double dx = subGA.x(toSub[v]) - px, dy = subGA.y(toSub[v]) - py;
+		double ex = GA.x(v) - qx, ey = GA.y(v) - qy;
+		re[0] += dx * ex + dy * ey;
+		im[0] += dx * ey - dy * ex;
+		re[1] += dx * ex - dy * ey;
+		im[1] += dx * ey + dy * ex;
+		norm += dx * dx + dy * dy;
+	}
+	bool mirror = re[1] * re[1] + im[1] * im[1] > re[0] * re[0] + im[0] * im[0];
+	double ar = 1.0, ai = 0.0;
+	if (!translateOnly && norm > 0.0) {
+		ar = re[mirror] / norm;
+		ai = im[mirror] / norm;
+	} else {
+		mirror = false;
+	}
+
+	for (node v : part) {
+		double dx = subGA.x(toSub[v]) - px, dy = subGA.y(toSub[v]) - py;
+		if (mirror) {
+			dy = -dy;
+		}
+		GA.x(v) = ar * dx - ai * dy + qx;
+		GA.y(v) = ar * dy + ai * dx + qy;
+	}
+}
+
+}
+
+void ModularMultilevelMixer::callIncremental(GraphAttributes& GA, const List<node>& changedNodes) {
+	const Graph& G = GA.constGraph();
+	m_errorCode = erc::None;
+
+	// hop distances from the changed nodes, the nodes at distance m_incrementalRadius + 1 are
+	// the unchanged neighbours of the region that take part in its layout as anchors
+	NodeArray<int> dist(G, -1);
+	std::vector<node> region;
+	for (node v : changedNodes) {
+		if (dist[v] < 0) {
+			dist[v] = 0;
+			region.push_back(v);
+		}
+	}
+	for (size_t i = 0; i < region.size(); ++i) {
+		node v = region[i];
+		if (dist[v] > m_incrementalRadius) {
+			continue;
+		}
+		for (adjEntry adj : v->adjEntries) {
+			node w = adj->twinNode();
+			if (dist[w] < 0) {
+				dist[w] = dist[v] + 1;
+				region.push_back(w);
+			}
+		}
+	}
+
+	// place the changed nodes at the barycenter of their placed neighbours, growing from the
+	// unchanged part of the graph; nodes without any placed neighbour keep their position
+	NodeArray<bool> changed(G, false);
+	NodeArray<bool> placed(G, true);
+	for (node v : changedNodes) {
+		changed[v] = true;
+		placed[v] = false;
+	}
+	std::vector<node> toPlace;
+	NodeArray<bool> queued(G, false);
+	for (node v : changedNodes) {
+		for (adjEntry adj : v->adjEntries) {
+			if (placed[adj->twinNode()] && !queued[v]) {
+				queued[v] = true;
+				toPlace.push_back(v);
+			}
+		}
+	}
+	for (size_t i = 0; i < toPlace.size(); ++i) {
+		node v = toPlace[i];
+		double x = 0.0, y = 0.0;
+		int n = 0;
+		for (adjEntry adj : v->adjEntries) {
+			node w = adj->twinNode();
+			if (placed[w]) {
+				x += GA.x(w);
+				y += GA.y(w);
+				++n;
+			} else if (!queued[w]) {
+				queued[w] = true;
+				toPlace.push_back(w);
+			}
+		}
+		// avoid placing nodes with the same neighbours at the same position
+		double jitter = GA.has(GraphAttributes::nodeGraphics)
+				? 0.5 * max(GA.width(v), GA.height(v))
+				: 1.0;
+		GA.x(v) = x / n + randomDouble(-jitter, jitter);
+		GA.y(v) = y / n + randomDouble(-jitter, jitter);
+		placed[v] = true;
+	}
+
+	// lay out each connected part of the region on its own
+	NodeArray<node> toSub(G, nullptr);
+	std::vector<node> part, anchors;
+	for (node root : region) {
+		if (dist[root] > m_incrementalRadius || toSub[root] != nullptr) {
+			continue;
+		}
+
+		Graph sub;
+		GraphAttributes subGA(sub, GA.attributes());
+		auto copyNode = [&](node v) {
+			node s = sub.newNode();
+			toSub[v] = s;
+			subGA.x(s) = GA.x(v);
+			subGA.y(s) = GA.y(v);
+			if (GA.has(GraphAttributes::nodeGraphics)) {
+				subGA.width(s) = GA.width(v);
+				subGA.height(s) = GA.height(v);
+			}
+		};
+
+		part.clear();
+		anchors.clear();
+		part.push_back(root);
+		copyNode(root);
+		for (size_t i = 0; i < part.size(); ++i) {
+			for (adjEntry adj : part[i]->adjEntries) {
+				node w = adj->twinNode();
+				if (dist[w] < 0 || toSub[w] != nullptr) {
+					continue;
+				}
+				copyNode(w);
+				// anchors do not connect further nodes to the part
+				if (dist[w] <= m_incrementalRadius) {
+					part.push_back(w);
+				} else {
+					anchors.push_back(w);
+				}
+			}
+		}
+
+		for (node v : part) {
+			for (adjEntry adj : v->adjEntries) {
+				node w = adj->twinNode();
+				if (toSub[w] != nullptr && (adj->isSource() || dist[w] > m_incrementalRadius)) {
+					edge e = sub.newEdge(toSub[v], toSub[w]);
+					if (GA.has(GraphAttributes::edgeDoubleWeight)) {
+						subGA.doubleWeight(e) = GA.doubleWeight(adj->theEdge());
+					}
+				}
+			}
+		}
+
+		if (sub.numberOfNodes() > 1) {
+			call(subGA);
+			if (m_errorCode != erc::None) {
+				return;
+			}
+			fitLayout(GA, subGA, toSub, changed, part, anchors);
+		}
+
+		// anchors may be shared with other parts
+		for (node w : anchors) {
+			toSub[w] = nullptr;
+		}
+	}
+}
+
 }
@@ -0,0 +1,310 @@
+/** \file
+ * \brief Implementation of ogdf::spring_embedder::BarnesHutTree.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/geometry.h>
+#include <ogdf/basic/internal/intrinsics.h>
+#include <ogdf/energybased/spring_embedder/BarnesHutTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace ogdf {
+namespace spring_embedder {
+
+namespace {
+
+//! Spreads the lower 16 bits of \p x to the even bits of the result.
+uint32_t spreadBits(uint32_t x) {
+	x = (x | (x << 8)) & 0x00FF00FF;
+	x = (x | (x << 4)) & 0x0F0F0F0F;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+	return x;
+}
+
+double power(double d2, int normExponent) {
+	switch (normExponent) {
+	case 1:
+		return d2;
+	case 2:
+		return d2 * std::sqrt(d2);
+	default:
+		return std::pow(d2, 0.5 * (normExponent + 1));
+	}
+}
+
+// The kernels add the forces of the weights w[i] at (x[i], y[i]) for i in [begin, end) on the
+// point (px, py) to (fx, fy). Weights at the position of the point contribute nothing.
+
+void addForces(double px, double py, const double* x, const double* y, const double* w,
+		int begin, int end, int normExponent, double eps, double& fx, double& fy) {
+	for (int i = begin; i < end; ++i) {
+		double dx = px - x[i];
+		double dy = py - y[i];
+		double f = w[i] / (power(dx * dx + dy * dy, normExponent) + eps);
+		fx += f * dx;
+		fy += f * dy;
+	}
+}
+
+#ifdef OGDF_AVX2_EXTENSIONS
+// returns the sum of the four lanes of a
+inline double horizontalSum(__m256d a) {
+	__m128d sum = _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+	return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+}
+
+void addForces_avx2(double px, double py, const double* x, const double* y, const double* w,
+		int n, int normExponent, double eps, double& fx, double& fy) {
+	const int vecEnd = n - n % 4;
+	const __m256d mm_px = _mm256_set1_pd(px);
+	const __m256d mm_py = _mm256_set1_pd(py);
+	const __m256d mm_eps = _mm256_set1_pd(eps);
+	__m256d mm_fx = _mm256_setzero_pd(), mm_fy = _mm256_setzero_pd();
+
+	for (int i = 0; i < vecEnd; i += 4) {
+		__m256d mm_dx = _mm256_sub_pd(mm_px, _mm256_loadu_pd(x + i));
+		__m256d mm_dy = _mm256_sub_pd(mm_py, _mm256_loadu_pd(y + i));
+		__m256d mm_d = _mm256_add_pd(_mm256_mul_pd(mm_dx, mm_dx), _mm256_mul_pd(mm_dy, mm_dy));
+		if (normExponent == 2) {
+			mm_d = _mm256_mul_pd(mm_d, _mm256_sqrt_pd(mm_d));
+		}
+		__m256d mm_f = _mm256_div_pd(_mm256_loadu_pd(w + i), _mm256_add_pd(mm_d, mm_eps));
+		mm_fx = _mm256_add_pd(mm_fx, _mm256_mul_pd(mm_f, mm_dx));
+		mm_fy = _mm256_add_pd(mm_fy, _mm256_mul_pd(mm_f, mm_dy));
+	}
+
+	fx += horizontalSum(mm_fx);
+	fy += horizontalSum(mm_fy);
+	addForces(px, py, x, y, w, vecEnd, n, normExponent, eps, fx, fy);
+}
+#endif
+
+}
+
+BarnesHutTree::BarnesHutTree(double theta) : m_theta(theta) {
+#ifdef OGDF_AVX2_EXTENSIONS
+	m_useAVX2 = System::cpuSupports(CPUFeature::AVX2);
+#else
+	m_useAVX2 = false;
+#endif
+}
+
+void BarnesHutTree::build() {
+	const int n = static_cast<int>(m_inputX.size());
+
+	m_cellX.clear();
+	m_cellY.clear();
+	m_cellMass.clear();
+	m_cellSize.clear();
+	m_firstChild.clear();
+	m_numChildren.clear();
+	m_begin.clear();
+	m_end.clear();
+	if (n == 0) {
+		return;
+	}
+
+	double xmin = *std::min_element(m_inputX.begin(), m_inputX.end());
+	double xmax = *std::max_element(m_inputX.begin(), m_inputX.end());
+	double ymin = *std::min_element(m_inputY.begin(), m_inputY.end());
+	double ymax = *std::max_element(m_inputY.begin(), m_inputY.end());
+	double size = max(xmax - xmin, ymax - ymin);
+	if (size <= 0) {
+		size = 1;
+	}
+
+	// Morton codes of the points quantized to a grid of 2^16 x 2^16 cells
+	const double quantization = ((1 << s_maxDepth) - 1) / size;
+	std::vector<uint32_t> code(n);
+	for (int i = 0; i < n; ++i) {
+		uint32_t qx = static_cast<uint32_t>((m_inputX[i] - xmin) * quantization);
+		uint32_t qy = static_cast<uint32_t>((m_inputY[i] - ymin) * quantization);
+		code[i] = spreadBits(qx) | (spreadBits(qy) << 1);
+	}
+
+	m_order.resize(n);
+	for (int i = 0; i < n; ++i) {
+		m_order[i] = i;
+	}
+	std::sort(m_order.begin(), m_order.end(), [&](int i, int j) {
+		return code[i] < code[j] || (code[i] == code[j] && i < j);
+	});
+
+	m_code.resize(n);
+	m_rank.resize(n);
+	m_x.resize(n);
+	m_y.resize(n);
+	for (int k = 0; k < n; ++k) {
+		int i = m_order[k];
+		m_code[k] = code[i];
+		m_rank[i] = k;
+		m_x[k] = m_inputX[i];
+		m_y[k] = m_inputY[i];
+	}
+
+	buildCell(newCell(0, n, size), 0, size);
+}
+
+int BarnesHutTree::newCell(int begin, int end, double size) {
+	m_cellX.push_back(0.0);
+	m_cellY.push_back(0.0);
+	m_cellMass.push_back(end - begin);
+	m_cellSize.push_back(size);
+	m_firstChild.push_back(-1);
+	m_numChildren.push_back(0);
+	m_begin.push_back(begin);
+	m_end.push_back(end);
+	return static_cast<int>(m_cellX.size()) - 1;
+}
+
+void BarnesHutTree::buildCell(int cell, int depth, double size) {
+	const int begin = m_begin[cell];
+	const int end = m_end[cell];
+
+	if (end - begin <= s_leafSize || depth == s_maxDepth) {
+		double x = 0.0, y = 0.0;
+		for (int k = begin; k < end; ++k) {
+			x += m_x[k];
+			y += m_y[k];
+		}
+		m_cellX[cell] = x / (end - begin);
+		m_cellY[cell] = y / (end - begin);
+		return;
+	}
+
+	// the points of a quadrant share the next two bits of their codes
+	const int shift = 2 * (s_maxDepth - 1 - depth);
+	const int firstChild = static_cast<int>(m_cellX.size());
+	int childBegin = begin;
+	for (uint32_t quadrant = 0; quadrant < 4 && childBegin < end; ++quadrant) {
+		int childEnd = static_cast<int>(
+				std::partition_point(m_code.begin() + childBegin, m_code.begin() + end,
+						[&](uint32_t c) { return ((c >> shift) & 3) <= quadrant; })
+				- m_code.begin());
+		if (childEnd > childBegin) {
+			newCell(childBegin, childEnd, 0.5 * size);
+			childBegin = childEnd;
+		}
+	}
+	m_firstChild[cell] = firstChild;
+	m_numChildren[cell] = static_cast<int>(m_cellX.size()) - firstChild;
+
+	double x = 0.0, y = 0.0;
+	for (int child = firstChild; child < firstChild + m_numChildren[cell]; ++child) {
+		buildCell(child, depth + 1, 0.5 * size);
+		x += m_cellMass[child] * m_cellX[child];
+		y += m_cellMass[child] * m_cellY[child];
+	}
+	m_cellX[cell] = x / m_cellMass[cell];
+	m_cellY[cell] = y / m_cellMass[cell];
+}
+
+void BarnesHutTree::scale(double s) {
+	for (std::vector<double>* coords : {&m_inputX, &m_inputY, &m_x, &m_y, &m_cellX, &m_cellY}) {
+		for (double& c : *coords) {
+			c *= s;
+		}
+	}
+	for (double& size : m_cellSize) {
+		size *= std::abs(s);
+	}
+}
+
+DPoint BarnesHutTree::repulsion(int i, int normExponent, double eps) const {
+	const int k = m_rank[i];
+	const double px = m_x[k], py = m_y[k];
+	const double theta2 = m_theta * m_theta;
+
+	// the far cells and near points are collected in a buffer and summed up in blocks
+	constexpr int bufferSize = 64;
+	double bx[bufferSize], by[bufferSize], bw[bufferSize];
+	int buffered = 0;
+	double fx = 0.0, fy = 0.0;
+	auto flush = [&] {
+#ifdef OGDF_AVX2_EXTENSIONS
+		if (m_useAVX2 && normExponent <= 2) {
+			addForces_avx2(px, py, bx, by, bw, buffered, normExponent, eps, fx, fy);
+			buffered = 0;
+			return;
+		}
+#endif
+		addForces(px, py, bx, by, bw, 0, buffered, normExponent, eps, fx, fy);
+		buffered = 0;
+	};
+	auto add = [&](double x, double y, double w) {
+		if (buffered == bufferSize) {
+			flush();
+		}
+		bx[buffered] = x;
+		by[buffered] = y;
+		bw[buffered] = w;
+		++buffered;
+	};
+
+	// each cell on the path to the deepest open cell leaves at most three siblings
+	int stack[3 * s_maxDepth + 4];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const int cell = stack[--top];
+		if (k < m_begin[cell] || k >= m_end[cell]) {
+			double dx = px - m_cellX[cell];
+			double dy = py - m_cellY[cell];
+			if (m_cellSize[cell] * m_cellSize[cell] <= theta2 * (dx * dx + dy * dy)) {
+				add(m_cellX[cell], m_cellY[cell], m_cellMass[cell]);
+				continue;
+			}
+		}
+
+		if (m_firstChild[cell] < 0) {
+			for (int j = m_begin[cell]; j < m_end[cell]; ++j) {
+				if (j != k) {
+					add(m_x[j], m_y[j], 1.0);
+				}
+			}
+		} else {
+			for (int child = m_firstChild[cell] + m_numChildren[cell] - 1;
+					child >= m_firstChild[cell]; --child) {
+				stack[top++] = child;
+			}
+		}
+	}
+	flush();
+
+	return DPoint(fx, fy);
+}
+
+}
+}
@@ -34,6 +34,7 @@
 #include <ogdf/basic/List.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/energybased/SpringEmbedderGridVariant.h>
+#include <ogdf/energybased/spring_embedder/BarnesHutTree.h>
 #include <ogdf/energybased/spring_embedder/SEGV_ForceModel.h>
 
 #include <cmath>
@@ -43,6 +44,11 @@ namespace ogdf {
 
 DPoint SpringEmbedderGridVariant::ForceModelBase::computeRepulsiveForce(int j, double boxLength,
 		int idealExponent, int normExponent) const {
+	if (m_barnesHutTree) {
+		return m_barnesHutTree->repulsion(j, normExponent, eps())
+				* std::pow(m_idealEdgeLength, idealExponent);
+	}
+
 	const NodeInfo& vj = m_vInfo[j];
 	int grid_x = vj.m_gridX;
 	int grid_y = vj.m_gridY;
@@ -87,7 +93,8 @@ DPoint SpringEmbedderGridVariant::ForceModelBase::computeMixedForcesDisplacement
 		double d = dist.norm();
 
 		forceAttr -= attractiveChange(d, dist);
-		if (d < boxLength) {
+		// Barnes-Hut does not cut off the repulsive forces
+		if (m_barnesHutTree || d < boxLength) {
 			double f = 1.0 / (d * d + eps());
 			forceRep += f * dist;
 		}
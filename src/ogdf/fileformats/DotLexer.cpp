@@ -34,10 +34,14 @@
 #include <ogdf/fileformats/DotLexer.h>
 #include <ogdf/fileformats/GraphIO.h>
 
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
-#include <sstream>
+#include <cstring>
+#include <iterator>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace ogdf {
@@ -45,7 +49,7 @@ namespace ogdf {
 namespace dot {
 
 
-Token::Token(size_t tokenRow, size_t tokenColumn, std::string* identifierContent)
+Token::Token(size_t tokenRow, size_t tokenColumn, std::string_view identifierContent)
 	: row(tokenRow), column(tokenColumn), value(identifierContent) { }
 
 std::string Token::toString(const Type& type) {
@@ -89,203 +93,229 @@ std::string Token::toString(const Type& type) {
 	return "UNKNOWN";
 }
 
-Lexer::Lexer(std::istream& input) : m_input(input) { }
+Lexer::Lexer(std::istream& input)
+	: m_input(&input), m_begin(nullptr), m_end(nullptr), m_row(0), m_lineStart(nullptr) { }
 
-Lexer::~Lexer() {
-	for (const Token& t : m_tokens) {
-		delete t.value;
-	}
-}
+Lexer::Lexer(const char* begin, const char* end)
+	: m_input(nullptr), m_begin(begin), m_end(end), m_row(0), m_lineStart(nullptr) { }
+
+Lexer::~Lexer() { }
 
 const std::vector<Token>& Lexer::tokens() const { return m_tokens; }
 
-bool Lexer::tokenize() {
-	m_row = 0;
-	while (m_input.good()) {
-		if (!tokenizeLine()) {
-			return false;
+void Lexer::advance(const char*& p, const char* to) {
+	for (;;) {
+		const char* eol = static_cast<const char*>(memchr(p, '\n', to - p));
+		if (eol == nullptr) {
+			break;
 		}
+		p = eol + 1;
+		m_row++;
+		m_lineStart = p;
 	}
-
-	return true;
+	p = to;
 }
 
-bool Lexer::tokenizeLine() {
-	std::getline(m_input, m_buffer);
-	m_row++;
-
-	// Handle line output from a C preprocessor (#blabla).
-	if (m_buffer[0] == '#') {
-		return true;
+bool Lexer::tokenize() {
+	static const std::pair<std::string_view, Token::Type> keywords[] = {
+			{"graph", Token::Type::graph}, {"digraph", Token::Type::digraph},
+			{"subgraph", Token::Type::subgraph}, {"node", Token::Type::node},
+			{"edge", Token::Type::edge}, {"strict", Token::Type::strict}};
+
+	if (m_input != nullptr) {
+		m_buffer.assign(std::istreambuf_iterator<char>(*m_input), std::istreambuf_iterator<char>());
+		m_begin = m_buffer.data();
+		m_end = m_begin + m_buffer.size();
 	}
 
-	for (m_col = 0; m_col < m_buffer.size(); m_col++) {
+	m_tokens.clear();
+	m_joinedStrings.clear();
+	// rough estimate of the number of tokens
+	m_tokens.reserve((m_end - m_begin) / 8);
+
+	m_row = 1;
+	m_lineStart = m_begin;
+
+	const char* p = m_begin;
+	while (p != m_end) {
+		// Handle line output from a C preprocessor (#blabla).
+		if (p == m_lineStart && *p == '#') {
+			const char* eol = static_cast<const char*>(memchr(p, '\n', m_end - p));
+			advance(p, eol == nullptr ? m_end : eol);
+			continue;
+		}
+
+		if (*p == '\n') {
+			advance(p, p + 1);
+			continue;
+		}
+
 		// Ignore whitespaces.
-		if (isspace(m_buffer[m_col])) {
+		if (isspace(static_cast<unsigned char>(*p))) {
+			p++;
 			continue;
 		}
 
+		const size_t rest = m_end - p;
+
 		// Handle single-line comments.
-		if (match("//")) {
-			break;
+		if (rest >= 2 && p[0] == '/' && p[1] == '/') {
+			const char* eol = static_cast<const char*>(memchr(p, '\n', rest));
+			p = eol == nullptr ? m_end : eol;
+			continue;
 		}
 
 		// Handle multi-line comments.
-		if (match("/*")) {
-			const size_t column = m_col;
-			const size_t row = m_row;
-
-			do {
-				m_col++;
-
-				// Get a new line if a current one has ended.
-				if (m_col >= m_buffer.size()) {
-					if (!m_input.good()) {
-						GraphIO::logger.lout()
-								<< "Unclosed comment at" << column << ", " << row << std::endl;
-						return false;
-					}
-					std::getline(m_input, m_buffer);
-					m_row++;
-					m_col = 0;
-				}
-			} while (!(m_buffer[m_col - 1] == '*' && m_buffer[m_col] == '/'));
-
-			m_col += 2;
+		if (rest >= 2 && p[0] == '/' && p[1] == '*') {
+			const char* close = std::search(p + 2, m_end, "*/", "*/" + 2);
+			if (close == m_end) {
+				GraphIO::logger.lout() << "Unclosed comment at " << m_row << ", "
+									   << p - m_lineStart + 1 << std::endl;
+				return false;
+			}
+			advance(p, close + 2);
 			continue;
 		}
 
-		Token token(m_row + 1, m_col + 1);
+		Token token(m_row, p - m_lineStart + 1);
+		const char* next = p + 1;
 
-		if (match(Token::Type::assignment)) {
+		switch (*p) {
+		case '=':
 			token.type = Token::Type::assignment;
-		} else if (match(Token::Type::colon)) {
+			break;
+		case ':':
 			token.type = Token::Type::colon;
-		} else if (match(Token::Type::semicolon)) {
+			break;
+		case ';':
 			token.type = Token::Type::semicolon;
-		} else if (match(Token::Type::comma)) {
+			break;
+		case ',':
 			token.type = Token::Type::comma;
-		} else if (match(Token::Type::edgeOpDirected)) {
-			token.type = Token::Type::edgeOpDirected;
-		} else if (match(Token::Type::edgeOpUndirected)) {
-			token.type = Token::Type::edgeOpUndirected;
-		} else if (match(Token::Type::leftBracket)) {
+			break;
+		case '[':
 			token.type = Token::Type::leftBracket;
-		} else if (match(Token::Type::rightBracket)) {
+			break;
+		case ']':
 			token.type = Token::Type::rightBracket;
-		} else if (match(Token::Type::leftBrace)) {
+			break;
+		case '{':
 			token.type = Token::Type::leftBrace;
-		} else if (match(Token::Type::rightBrace)) {
+			break;
+		case '}':
 			token.type = Token::Type::rightBrace;
-		} else if (match(Token::Type::graph, true)) {
-			token.type = Token::Type::graph;
-		} else if (match(Token::Type::digraph, true)) {
-			token.type = Token::Type::digraph;
-		} else if (match(Token::Type::subgraph, true)) {
-			token.type = Token::Type::subgraph;
-		} else if (match(Token::Type::node, true)) {
-			token.type = Token::Type::node;
-		} else if (match(Token::Type::edge, true)) {
-			token.type = Token::Type::edge;
-		} else if (match(Token::Type::strict, true)) {
-			token.type = Token::Type::strict;
-		} else if (identifier(token)) {
-			token.type = Token::Type::identifier;
-		} else {
-			GraphIO::logger.lout() << "Unknown token at: " << m_row << "; " << m_col << std::endl;
-			return false;
+			break;
+		default:
+			if (rest >= 2 && p[0] == '-' && p[1] == '>') {
+				token.type = Token::Type::edgeOpDirected;
+				next = p + 2;
+			} else if (rest >= 2 && p[0] == '-' && p[1] == '-') {
+				token.type = Token::Type::edgeOpUndirected;
+				next = p + 2;
+			} else if (identifier(next = p, token)) {
+				token.type = Token::Type::identifier;
+
+				// Keywords are unquoted identifiers with a special meaning.
+				if (*p != '"') {
+					for (const auto& keyword : keywords) {
+						if (token.value == keyword.first) {
+							token.type = keyword.second;
+							token.value = std::string_view();
+							break;
+						}
+					}
+				}
+			} else {
+				GraphIO::logger.lout() << "Unknown token at: " << m_row << "; "
+									   << p - m_lineStart + 1 << std::endl;
+				return false;
+			}
 		}
 
 		m_tokens.push_back(token);
+		advance(p, next);
 	}
 
 	return true;
 }
 
-bool Lexer::match(const Token::Type& type, bool word) { return match(Token::toString(type), word); }
-
-bool Lexer::match(const std::string& str, bool word) {
-	// Check whether buffer is too short to match.
-	if (m_buffer.length() < m_col + str.length()) {
-		return false;
-	}
+bool Lexer::identifier(const char*& p, Token& token) {
+	const char* begin = p;
 
-	for (size_t i = 0; i < str.length(); i++) {
-		if (m_buffer[m_col + i] != str[i]) {
+	// Check whether identifier is double-quoted string.
+	if (*begin == '"') {
+		const char* q = begin + 1;
+		while (q != m_end && (*q != '"' || q[-1] == '\\')) {
+			q++;
+		}
+		if (q == m_end) {
+			GraphIO::logger.lout() << "Unclosed string at " << token.row << ", " << token.column
+								   << std::endl;
 			return false;
 		}
-	}
-
-	// we've matched a part of a word instead of a whole word
-	if (word && m_buffer.length() >= m_col + str.length() + 1
-			&& isDotAlnum(m_buffer[m_col + str.length()])) {
-		return false;
-	}
-
-	// After successful match we move the "head".
-	m_col += str.length() - 1;
-
-	return true;
-}
 
-bool Lexer::identifier(Token& token) {
-	// Check whether identifier is double-quoted string.
-	if (m_buffer[m_col] == '"') {
-		m_col++;
-		std::stringstream ss;
-
-		while (m_buffer[m_col] != '"' || m_buffer[m_col - 1] == '\\') {
-			ss << m_buffer[m_col++];
-
-			// Get a new line if a current one has ended.
-			if (m_col >= m_buffer.size()) {
-				if (!m_input.good()) {
-					GraphIO::logger.lout() << "Unclosed string at " << token.row << ", "
-										   << token.column << std::endl;
-					return false;
-				}
-				std::getline(m_input, m_buffer);
-				m_row++;
-				m_col = 0;
-			}
+		token.value = std::string_view(begin + 1, q - begin - 1);
+		if (memchr(begin + 1, '\n', q - begin - 1) != nullptr) {
+			// line breaks are not part of the string
+			std::string joined(token.value);
+			joined.erase(std::remove(joined.begin(), joined.end(), '\n'), joined.end());
+			m_joinedStrings.push_back(std::move(joined));
+			token.value = m_joinedStrings.back();
 		}
-
-		token.value = new std::string(ss.str());
+		p = q + 1;
 		return true;
 	}
 
 	// Check whether identifier is a normal C-like identifier.
 	// according to DOT standard, an ID may not begin with a digit
-	if (isDotAlnum(m_buffer[m_col]) && !isdigit(m_buffer[m_col])) {
-		std::ostringstream ss;
-
-		while (isDotAlnum(m_buffer[m_col])) {
-			ss << m_buffer[m_col++];
+	if (isDotAlnum(*begin) && !isdigit(static_cast<unsigned char>(*begin))) {
+		const char* q = begin;
+		while (q != m_end && isDotAlnum(*q)) {
+			q++;
 		}
-
-		m_col--;
-		token.value = new std::string(ss.str());
+		token.value = std::string_view(begin, q - begin);
+		p = q;
 		return true;
 	}
 
-	// Check whether identifier is a numeric literal. Quite ugly and slow but works.
-	std::istringstream ss(m_buffer.c_str() + m_col);
-	double temp;
-	if (ss >> temp) {
-		std::istringstream::pos_type length = ss.tellg();
-		if (length < 0) { // end of line
-			token.value = new std::string(ss.str());
-			m_col = m_buffer.size();
-		} else {
-			token.value = new std::string(m_buffer.substr(m_col, length));
-			m_col += (static_cast<long>(length) - 1);
+	// Check whether identifier is a numeric literal, i.e., [-+]?(.[0-9]+|[0-9]+(.[0-9]*)?)
+	// with an optional exponent.
+	auto digits = [&](const char* q) {
+		while (q != m_end && isdigit(static_cast<unsigned char>(*q))) {
+			q++;
+		}
+		return q;
+	};
+	const char* q = begin;
+	if (*q == '-' || *q == '+') {
+		q++;
+	}
+	const char* integral = q;
+	q = digits(q);
+	bool hasDigits = q != integral;
+	if (q != m_end && *q == '.') {
+		const char* fractional = q + 1;
+		q = digits(fractional);
+		hasDigits |= q != fractional;
+	}
+	if (!hasDigits) {
+		return false;
+	}
+	if (q != m_end && (*q == 'e' || *q == 'E')) {
+		const char* exponent = q + 1;
+		if (exponent != m_end && (*exponent == '-' || *exponent == '+')) {
+			exponent++;
+		}
+		if (exponent != m_end && isdigit(static_cast<unsigned char>(*exponent))) {
+			q = digits(exponent);
 		}
-		return true;
 	}
 
 	// TODO: HTML string identifiers.
 
-	return false;
+	token.value = std::string_view(begin, q - begin);
+	p = q;
+	return true;
 }
 
 bool Lexer::isDotAlnum(signed char c) { return isalnum(c) || c < 0 || c == '_'; }
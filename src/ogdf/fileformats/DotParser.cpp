@@ -29,11 +29,14 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
+#include <ogdf/basic/Array.h>
 #include <ogdf/basic/ArrayBuffer.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/HashArray.h>
 #include <ogdf/basic/Logger.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/basic/graphics.h>
@@ -45,9 +48,12 @@
 #include <ogdf/fileformats/GraphIO.h>
 #include <ogdf/fileformats/Utils.h>
 
+#include <algorithm>
+#include <functional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -156,12 +162,22 @@ Ast::AList::AList(AsgnStmt* headAsgnStmt, AList* tailAList)
 
 Ast::AList::~AList() { destroyList(this); }
 
-Ast::Ast(const Tokens& tokens) : m_tokens(tokens), m_tend(m_tokens.end()), m_graph(nullptr) { }
+Ast::Ast(const Tokens& tokens) : Ast(tokens.begin(), tokens.end()) { }
+
+Ast::Ast(Iterator begin, Iterator end)
+	: m_tbegin(begin), m_tend(end), m_numThreads(1), m_graph(nullptr) { }
 
 Ast::~Ast() { delete m_graph; }
 
-bool Ast::build() {
-	Iterator it = m_tokens.begin();
+bool Ast::build(unsigned int numThreads) {
+	if (numThreads == 0) {
+		// parts of less than some ten thousand tokens are not worth an extra thread
+		numThreads = static_cast<unsigned int>(std::min<size_t>(System::numberOfProcessors(),
+				std::max<size_t>(1, (m_tend - m_tbegin) >> 16)));
+	}
+	m_numThreads = numThreads;
+
+	Iterator it = m_tbegin;
 	delete m_graph;
 	m_graph = parseGraph(it, it);
 	return m_graph != nullptr;
@@ -222,7 +238,7 @@ Ast::NodeId* Ast::parseNodeId(Iterator curr, Iterator& rest) {
 	if (curr == m_tend || curr->type != Token::Type::identifier) {
 		return nullptr;
 	}
-	std::string id = *(curr->value);
+	std::string id(curr->value);
 	curr++;
 
 	Port* port = parsePort(curr, curr);
@@ -235,7 +251,7 @@ Ast::CompassPt* Ast::parseCompassPt(Iterator curr, Iterator& rest) {
 	if (curr == m_tend || curr->type != Token::Type::identifier) {
 		return nullptr;
 	}
-	const std::string& str = *(curr->value);
+	const std::string_view str = curr->value;
 	curr++;
 	if (str == "n") {
 		rest = curr;
@@ -292,7 +308,10 @@ Ast::Port* Ast::parsePort(Iterator curr, Iterator& rest) {
 		return new Port(nullptr, compass);
 	}
 
-	std::string* id = curr->value;
+	if (curr == m_tend || curr->type != Token::Type::identifier) {
+		return nullptr;
+	}
+	std::string* id = new std::string(curr->value);
 	curr++;
 
 	if (curr != m_tend && curr->type == Token::Type::colon) {
@@ -346,7 +365,7 @@ Ast::AsgnStmt* Ast::parseAsgnStmt(Iterator curr, Iterator& rest) {
 	if (curr == m_tend || curr->type != Token::Type::identifier) {
 		return nullptr;
 	}
-	std::string lhs = *(curr->value);
+	std::string lhs(curr->value);
 	curr++;
 
 	if (curr == m_tend || curr->type != Token::Type::assignment) {
@@ -357,7 +376,7 @@ Ast::AsgnStmt* Ast::parseAsgnStmt(Iterator curr, Iterator& rest) {
 	if (curr == m_tend || curr->type != Token::Type::identifier) {
 		return nullptr;
 	}
-	std::string rhs = *(curr->value);
+	std::string rhs(curr->value);
 	curr++;
 
 	rest = curr;
@@ -377,7 +396,7 @@ Ast::Subgraph* Ast::parseSubgraph(Iterator curr, Iterator& rest) {
 			return nullptr;
 		}
 		if (curr->type == Token::Type::identifier) {
-			id = new std::string(*(curr->value));
+			id = new std::string(curr->value);
 			curr++;
 		}
 	}
@@ -446,6 +465,129 @@ Ast::StmtList* Ast::parseStmtList(Iterator curr, Iterator& rest) {
 	return stmtList;
 }
 
+Ast::StmtList* Ast::parseStmtListParallel(Iterator curr, Iterator& rest) {
+	// Find the brace closing the graph and the semicolons separating its top-level statements.
+	// Within these parts, the parser never looks beyond a semicolon, so they can be parsed
+	// independently of each other.
+	std::vector<Iterator> separators;
+	Iterator close = m_tend;
+	int depth = 0;
+	for (Iterator it = curr; it != m_tend && close == m_tend; ++it) {
+		switch (it->type) {
+		case Token::Type::leftBrace:
+		case Token::Type::leftBracket:
+			depth++;
+			break;
+		case Token::Type::rightBrace:
+			if (depth == 0) {
+				close = it;
+			} else {
+				depth--;
+			}
+			break;
+		case Token::Type::rightBracket:
+			depth--;
+			break;
+		case Token::Type::semicolon:
+			if (depth == 0) {
+				separators.push_back(it);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	if (close == m_tend || depth != 0) {
+		return parseStmtList(curr, rest);
+	}
+
+	// part i consists of the tokens between separator i-1 and separator i
+	const size_t numParts = separators.size() + 1;
+	auto partBegin = [&](size_t i) { return i == 0 ? curr : separators[i - 1] + 1; };
+	auto partEnd = [&](size_t i) { return i + 1 == numParts ? close : separators[i]; };
+
+	const unsigned int numThreads =
+			static_cast<unsigned int>(std::min<size_t>(m_numThreads, numParts));
+	std::vector<size_t> firstPart(numThreads + 1, numParts);
+	firstPart[0] = 0;
+	for (unsigned int t = 1, i = 0; t < numThreads; ++t) {
+		// balance the number of tokens
+		const Iterator target = curr + (close - curr) / numThreads * t;
+		while (i < numParts && partEnd(i) < target) {
+			++i;
+		}
+		firstPart[t] = i;
+	}
+
+	std::vector<StmtList*> heads(numThreads, nullptr);
+	std::vector<StmtList*> tails(numThreads, nullptr);
+	std::vector<char> ok(numThreads, true);
+	std::vector<std::function<void()>> workers;
+	workers.reserve(numThreads);
+	for (unsigned int t = 0; t < numThreads; ++t) {
+		workers.emplace_back([&, t] {
+			for (size_t i = firstPart[t]; i < firstPart[t + 1] && ok[t]; ++i) {
+				Iterator begin = partBegin(i), end = partEnd(i), it = begin;
+				if (begin == end) {
+					// only the part after the last semicolon may be empty
+					ok[t] = i + 1 == numParts;
+					continue;
+				}
+
+				Ast part(begin, end);
+				StmtList* stmts = part.parseStmtList(it, it);
+				if (stmts == nullptr || it != end) {
+					delete stmts;
+					ok[t] = false;
+					continue;
+				}
+
+				if (tails[t] == nullptr) {
+					heads[t] = stmts;
+				} else {
+					tails[t]->tail = stmts;
+				}
+				for (tails[t] = stmts; tails[t]->tail != nullptr; tails[t] = tails[t]->tail) {
+					;
+				}
+			}
+		});
+	}
+
+	Array<Thread> threads(numThreads - 1);
+	for (unsigned int t = 1; t < numThreads; ++t) {
+		threads[t - 1] = Thread(workers[t]);
+	}
+	workers[0]();
+	for (Thread& thread : threads) {
+		thread.join();
+	}
+
+	// concatenate the lists of all threads
+	StmtList* result = nullptr;
+	StmtList* last = nullptr;
+	for (unsigned int t = 0; t < numThreads; ++t) {
+		if (heads[t] == nullptr) {
+			continue;
+		}
+		if (last == nullptr) {
+			result = heads[t];
+		} else {
+			last->tail = heads[t];
+		}
+		last = tails[t];
+	}
+
+	if (std::find(ok.begin(), ok.end(), false) != ok.end()) {
+		// let the sequential parser determine where exactly parsing stops
+		delete result;
+		return parseStmtList(curr, rest);
+	}
+
+	rest = close;
+	return result;
+}
+
 Ast::Graph* Ast::parseGraph(Iterator curr, Iterator& rest) {
 	if (curr == m_tend) {
 		return nullptr;
@@ -483,7 +625,7 @@ Ast::Graph* Ast::parseGraph(Iterator curr, Iterator& rest) {
 	}
 
 	if (curr->type == Token::Type::identifier) {
-		id = new std::string(*(curr->value));
+		id = new std::string(curr->value);
 		curr++;
 	}
 
@@ -500,7 +642,8 @@ Ast::Graph* Ast::parseGraph(Iterator curr, Iterator& rest) {
 	}
 	curr++;
 
-	StmtList* statements = parseStmtList(curr, curr);
+	StmtList* statements =
+			m_numThreads > 1 ? parseStmtListParallel(curr, curr) : parseStmtList(curr, curr);
 
 	if (curr == m_tend || curr->type != Token::Type::rightBrace) {
 		GraphIO::logger.lout() << "Expected \"" << Token::toString(Token::Type::rightBrace)
@@ -1000,7 +1143,8 @@ bool Ast::NodeId::read(Parser& P, ogdf::Graph& G, GraphAttributes* GA, ClusterGr
 	return true;
 }
 
-Parser::Parser(std::istream& in) : m_in(in), m_nodeId(nullptr) { }
+Parser::Parser(std::istream& in, unsigned int numThreads)
+	: m_in(in), m_numThreads(numThreads), m_nodeId(nullptr) { }
 
 node Parser::requestNode(Graph& G, GraphAttributes* GA, ClusterGraph* C, const SubgraphData& data,
 		const std::string& id) {
@@ -1052,7 +1196,7 @@ bool Parser::readGraph(Graph& G, GraphAttributes* GA, ClusterGraph* C, ClusterGr
 	}
 
 	Ast ast(lexer.tokens());
-	return ast.build() && ast.root()->read(*this, G, GA, C, CA);
+	return ast.build(m_numThreads) && ast.root()->read(*this, G, GA, C, CA);
 }
 
 bool Parser::read(Graph& G) { return readGraph(G, nullptr, nullptr, nullptr); }
@@ -43,6 +43,7 @@
 #include <ogdf/fileformats/GexfParser.h>
 #include <ogdf/fileformats/GraphIO.h>
 #include <ogdf/fileformats/GraphML.h>
+#include <ogdf/fileformats/XmlStreamReader.h>
 
 #include <ogdf/lib/pugixml/pugixml.h>
 
@@ -59,7 +60,7 @@ namespace ogdf {
 namespace gexf {
 
 
-Parser::Parser(std::istream& is) : m_is(is) { }
+Parser::Parser(std::istream& is, bool streaming) : m_is(is), m_streaming(streaming) { }
 
 static inline bool readAttrDefs(std::unordered_map<std::string, std::string>& attrMap,
 		const pugi::xml_node attrsTag) {
@@ -269,11 +270,12 @@ bool Parser::readEdges(Graph& G, ClusterGraph* C, GraphAttributes* GA) {
 	return true;
 }
 
-static inline bool readColor(Color& color, const pugi::xml_node tag) {
-	pugi::xml_attribute redAttr = tag.attribute("red");
-	pugi::xml_attribute greenAttr = tag.attribute("green");
-	pugi::xml_attribute blueAttr = tag.attribute("blue");
-	pugi::xml_attribute alphaAttr = tag.attribute("alpha");
+template<typename Tag>
+static inline bool readColor(Color& color, const Tag& tag) {
+	auto redAttr = tag.attribute("red");
+	auto greenAttr = tag.attribute("green");
+	auto blueAttr = tag.attribute("blue");
+	auto alphaAttr = tag.attribute("alpha");
 
 	if (!redAttr || !greenAttr || !blueAttr) {
 		GraphIO::logger.lout() << "Missing compound attribute on color tag." << std::endl;
@@ -289,14 +291,15 @@ static inline bool readColor(Color& color, const pugi::xml_node tag) {
 	return success;
 }
 
-static inline bool readVizAttribute(GraphAttributes& GA, node v, const pugi::xml_node tag) {
+template<typename Tag>
+static inline bool readVizAttribute(GraphAttributes& GA, node v, const Tag& tag) {
 	const long attrs = GA.attributes();
 
 	if (string(tag.name()) == "viz:position") {
 		if (attrs & GraphAttributes::nodeGraphics) {
-			pugi::xml_attribute xAttr = tag.attribute("x");
-			pugi::xml_attribute yAttr = tag.attribute("y");
-			pugi::xml_attribute zAttr = tag.attribute("z");
+			auto xAttr = tag.attribute("x");
+			auto yAttr = tag.attribute("y");
+			auto zAttr = tag.attribute("z");
 
 			if (!xAttr || !yAttr) {
 				GraphIO::logger.lout() << "Missing \"x\" or \"y\" in position tag." << std::endl;
@@ -313,7 +316,7 @@ static inline bool readVizAttribute(GraphAttributes& GA, node v, const pugi::xml
 		}
 	} else if (string(tag.name()) == "viz:size") {
 		if (attrs & GraphAttributes::nodeGraphics) {
-			pugi::xml_attribute valueAttr = tag.attribute("value");
+			auto valueAttr = tag.attribute("value");
 			if (!valueAttr) {
 				GraphIO::logger.lout() << "\"size\" attribute is missing a value." << std::endl;
 				return false;
@@ -325,7 +328,7 @@ static inline bool readVizAttribute(GraphAttributes& GA, node v, const pugi::xml
 		}
 	} else if (string(tag.name()) == "viz:shape") {
 		if (attrs & GraphAttributes::nodeGraphics) {
-			pugi::xml_attribute valueAttr = tag.attribute("value");
+			auto valueAttr = tag.attribute("value");
 			if (!valueAttr) {
 				GraphIO::logger.lout() << "\"shape\" attribute is missing a value." << std::endl;
 				return false;
@@ -345,7 +348,8 @@ static inline bool readVizAttribute(GraphAttributes& GA, node v, const pugi::xml
 	return true;
 }
 
-static inline bool readVizAttribute(GraphAttributes& GA, edge e, const pugi::xml_node tag) {
+template<typename Tag>
+static inline bool readVizAttribute(GraphAttributes& GA, edge e, const Tag& tag) {
 	const long attrs = GA.attributes();
 
 	if (string(tag.name()) == "viz:color") {
@@ -364,7 +368,7 @@ static inline bool readVizAttribute(GraphAttributes& GA, edge e, const pugi::xml
 		// GEXF supports solid, dotted, dashed, double.
 		// We don't support double, but dashdot and dashdotdot instead.
 		if (attrs & GraphAttributes::edgeStyle) {
-			pugi::xml_attribute valueAttr = tag.attribute("value");
+			auto valueAttr = tag.attribute("value");
 			if (!valueAttr) {
 				GraphIO::logger.lout() << "Missing \"value\" on shape tag." << std::endl;
 				return false;
@@ -567,7 +571,233 @@ bool Parser::readAttributes(GraphAttributes& GA, edge e, const pugi::xml_node ed
 	return true;
 }
 
+// Reads the attvalue children of the current attvalues tag; \p valid is cleared on errors.
+template<typename T>
+static inline bool readAttValues(XmlStreamReader& xml, GraphAttributes& GA, T element,
+		std::unordered_map<std::string, std::string>& attrMap, bool& valid) {
+	return xml.forEachChild([&] {
+		if (valid && string(xml.name()) == "attvalue") {
+			auto forAttr = xml.attribute("for");
+			auto valueAttr = xml.attribute("value");
+
+			if (!forAttr || !valueAttr) {
+				GraphIO::logger.lout()
+						<< "\"for\" or \"value\" not found for attvalue tag." << std::endl;
+				valid = false;
+			} else {
+				readAttValue(GA, element, attrMap[forAttr.value()], valueAttr.value());
+			}
+		}
+		return xml.skipElement();
+	});
+}
+
+bool Parser::readStreamedNode(XmlStreamReader& xml, Graph& G, GraphAttributes* GA) {
+	auto idAttr = xml.attribute("id");
+	if (!idAttr) {
+		GraphIO::logger.lout() << "node is missing an id attribute." << std::endl;
+		return false;
+	}
+
+	const node v = G.newNode();
+	m_nodeId[idAttr.value()] = v;
+
+	if (!GA) {
+		return xml.skipElement();
+	}
+
+	if (GA->has(GraphAttributes::nodeLabel)) {
+		auto labelAttr = xml.attribute("label");
+		if (labelAttr) {
+			GA->label(v) = labelAttr.as_string();
+		}
+	}
+
+	// Like in the document based reader, an invalid attribute only ends reading attributes.
+	bool valid = true;
+	return xml.forEachChild([&] {
+		const string name = xml.name();
+		if (name == "attvalues") {
+			return readAttValues(xml, *GA, v, m_nodeAttr, valid);
+		}
+		if (valid && name != "nodes") {
+			valid = readVizAttribute(*GA, v, xml);
+		}
+		return xml.skipElement();
+	});
+}
+
+bool Parser::readStreamedEdge(XmlStreamReader& xml, Graph& G, GraphAttributes* GA) {
+	auto sourceAttr = xml.attribute("source");
+	if (!sourceAttr) {
+		GraphIO::logger.lout() << "edge is missing a source attribute." << std::endl;
+		return false;
+	}
+
+	auto targetAttr = xml.attribute("target");
+	if (!targetAttr) {
+		GraphIO::logger.lout() << "edge is missing a target attribute." << std::endl;
+		return false;
+	}
+
+	auto sourceIt = m_nodeId.find(sourceAttr.value());
+	auto targetIt = m_nodeId.find(targetAttr.value());
+	if (sourceIt == std::end(m_nodeId) || targetIt == std::end(m_nodeId)) {
+		GraphIO::logger.lout() << "source or target node doesn't exist." << std::endl;
+		return false;
+	}
+
+	const edge e = G.newEdge(sourceIt->second, targetIt->second);
+
+	if (!GA) {
+		return xml.skipElement();
+	}
+
+	if (GA->has(GraphAttributes::edgeLabel)) {
+		auto labelAttr = xml.attribute("label");
+		if (labelAttr) {
+			GA->label(e) = labelAttr.as_string();
+		}
+	}
+	if (GA->has(GraphAttributes::edgeDoubleWeight)) {
+		GA->doubleWeight(e) = xml.attribute("weight").as_double();
+	} else if (GA->has(GraphAttributes::edgeIntWeight)) {
+		GA->intWeight(e) = xml.attribute("weight").as_int();
+	}
+
+	bool valid = true;
+	return xml.forEachChild([&] {
+		if (string(xml.name()) == "attvalues") {
+			return readAttValues(xml, *GA, e, m_edgeAttr, valid);
+		}
+		if (valid) {
+			valid = readVizAttribute(*GA, e, xml);
+		}
+		return xml.skipElement();
+	});
+}
+
+bool Parser::readStreamedGraph(XmlStreamReader& xml, Graph& G, GraphAttributes* GA) {
+	bool nodesFound = false, edgesFound = false;
+
+	bool result = xml.forEachChild([&] {
+		const string name = xml.name();
+		if (name == "attributes") {
+			auto classAttr = xml.attribute("class");
+			if (!classAttr) {
+				GraphIO::logger.lout() << "attributes tag is missing a class." << std::endl;
+				return false;
+			}
+
+			std::unordered_map<std::string, std::string>* attrMap;
+			if (string(classAttr.value()) == "node") {
+				attrMap = &m_nodeAttr;
+			} else if (string(classAttr.value()) == "edge") {
+				attrMap = &m_edgeAttr;
+			} else {
+				GraphIO::logger.lout() << "unknown attributes tag class ('" << classAttr.value()
+									   << "')." << std::endl;
+				return false;
+			}
+
+			return xml.forEachChild([&] {
+				if (string(xml.name()) == "attribute") {
+					auto idAttr = xml.attribute("id");
+					auto idTitle = xml.attribute("title");
+
+					if (!idAttr || !idTitle) {
+						GraphIO::logger.lout()
+								<< "\"id\" or \"title\" attribute missing." << std::endl;
+						return false;
+					}
+
+					(*attrMap)[idAttr.value()] = idTitle.value();
+				}
+				return xml.skipElement();
+			});
+		} else if (name == "nodes" && !nodesFound) {
+			nodesFound = true;
+			return xml.forEachChild([&] {
+				return string(xml.name()) == "node" ? readStreamedNode(xml, G, GA)
+													: xml.skipElement();
+			});
+		} else if (name == "edges" && !edgesFound) {
+			edgesFound = true;
+			return xml.forEachChild([&] {
+				return string(xml.name()) == "edge" ? readStreamedEdge(xml, G, GA)
+													: xml.skipElement();
+			});
+		}
+		return xml.skipElement();
+	});
+
+	if (!result) {
+		return false;
+	}
+
+	if (!nodesFound) {
+		GraphIO::logger.lout() << "No \"nodes\" tag found in graph." << std::endl;
+		return false;
+	}
+
+	if (!edgesFound) {
+		GraphIO::logger.lout() << "No \"edges\" tag found in graph." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+bool Parser::readStreaming(Graph& G, GraphAttributes* GA) {
+	XmlStreamReader xml(m_is);
+
+	G.clear();
+	m_nodeId.clear();
+	m_nodeAttr.clear();
+	m_edgeAttr.clear();
+
+	XmlStreamReader::Token token = xml.next();
+	bool result = token == XmlStreamReader::Token::StartElement && string(xml.name()) == "gexf";
+	if (!result && token != XmlStreamReader::Token::Error) {
+		GraphIO::logger.lout() << "Root tag must be \"gexf\"." << std::endl;
+		return false;
+	}
+
+	// Only the first graph is read, like in the document based reader.
+	bool graphFound = false;
+	result = result && xml.forEachChild([&] {
+		if (string(xml.name()) != "graph" || graphFound) {
+			return xml.skipElement();
+		}
+		graphFound = true;
+
+		if (GA) {
+			// Check whether graph is directed or not (undirected by default).
+			auto edgeDirAttr = xml.attribute("defaultedgetype");
+			GA->directed() = !(edgeDirAttr && string(edgeDirAttr.value()) == "undirected");
+		}
+
+		return readStreamedGraph(xml, G, GA);
+	});
+
+	if (!xml.error().empty()) {
+		GraphIO::logger.lout() << "XML parser error: " << xml.error() << std::endl;
+		return false;
+	}
+
+	if (result && !graphFound) {
+		GraphIO::logger.lout() << "Expected \"graph\" tag." << std::endl;
+		return false;
+	}
+
+	return result;
+}
+
 bool Parser::read(Graph& G) {
+	if (m_streaming) {
+		return readStreaming(G, nullptr);
+	}
+
 	if (!init()) {
 		return false;
 	}
@@ -579,6 +809,10 @@ bool Parser::read(Graph& G) {
 }
 
 bool Parser::read(Graph& G, GraphAttributes& GA) {
+	if (m_streaming) {
+		return readStreaming(G, &GA);
+	}
+
 	if (!init()) {
 		return false;
 	}
@@ -54,14 +54,18 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace ogdf {
 
 namespace gml {
 
 
-Parser::Parser(std::istream& is, bool doCheck) {
+Parser::Parser(std::istream& is, bool doCheck, bool streaming) {
 	m_objectTree = nullptr;
+	m_graphObject = nullptr;
+	m_rLineBuffer = nullptr;
+	m_streaming = streaming;
 
 	if (!is) {
 		setError("Cannot open file.");
@@ -70,6 +74,14 @@ Parser::Parser(std::istream& is, bool doCheck) {
 
 	createObjectTree(is, doCheck);
 
+	if (m_streaming) {
+		// parsing stopped right after the opening bracket of the graph list
+		if (!m_graphObject) {
+			setError("Cannot find graph.");
+		}
+		return;
+	}
+
 	int minId, maxId;
 	m_graphObject = getNodeIdRange(minId, maxId);
 	if (!m_graphObject) {
@@ -101,85 +113,103 @@ void Parser::createObjectTree(std::istream& is, bool doCheck) {
 	// create object tree
 	m_objectTree = parseList(ObjectType::Eof);
 
-	delete[] m_rLineBuffer;
+	// the line buffer is still needed for streaming the graph list
+	if (!m_streaming) {
+		delete[] m_rLineBuffer;
+		m_rLineBuffer = nullptr;
+	}
 }
 
 Object* Parser::parseList(ObjectType closingKey) {
 	Object* firstSon = nullptr;
 	Object** pPrev = &firstSon;
 
-	for (;;) {
-		ObjectType symbol = getNextSymbol();
+	while (Object* object = parseObject(closingKey)) {
+		*pPrev = object;
+		pPrev = &object->pBrother;
 
-		if (symbol == closingKey || symbol == ObjectType::Error) {
-			return firstSon;
+		if (object == m_graphObject) {
+			// the sons of the graph list are streamed by read()
+			break;
 		}
+	}
 
-		if (symbol != ObjectType::Key) {
-			setError("key expected");
-			return firstSon;
-		}
+	return firstSon;
+}
 
-		Key key = m_keySymbol;
+Object* Parser::parseObject(ObjectType closingKey) {
+	ObjectType symbol = getNextSymbol();
 
-		symbol = getNextSymbol();
-		Object* object = nullptr;
+	if (symbol == closingKey || symbol == ObjectType::Error) {
+		return nullptr;
+	}
 
-		switch (symbol) {
-		case ObjectType::IntValue:
-			object = new Object(key, m_intSymbol);
-			break;
+	if (symbol != ObjectType::Key) {
+		setError("key expected");
+		return nullptr;
+	}
 
-		case ObjectType::DoubleValue:
-			object = new Object(key, m_doubleSymbol);
-			break;
+	Key key = m_keySymbol;
 
-		case ObjectType::StringValue: {
-			size_t len = strlen(m_stringSymbol) + 1;
-			char* pChar = new char[len];
-			if (pChar == nullptr) {
-				OGDF_THROW(InsufficientMemoryException);
-			}
+	symbol = getNextSymbol();
+	Object* object = nullptr;
+
+	switch (symbol) {
+	case ObjectType::IntValue:
+		object = new Object(key, m_intSymbol);
+		break;
+
+	case ObjectType::DoubleValue:
+		object = new Object(key, m_doubleSymbol);
+		break;
+
+	case ObjectType::StringValue: {
+		size_t len = strlen(m_stringSymbol) + 1;
+		char* pChar = new char[len];
+		if (pChar == nullptr) {
+			OGDF_THROW(InsufficientMemoryException);
+		}
 
 #ifdef _MSC_VER
-			strcpy_s(pChar, len, m_stringSymbol);
+		strcpy_s(pChar, len, m_stringSymbol);
 #else
-			strcpy(pChar,
-					m_stringSymbol); // NOLINT: strcpy is fine here as we allocated pChar exactly big enough
+		strcpy(pChar,
+				m_stringSymbol); // NOLINT: strcpy is fine here as we allocated pChar exactly big enough
 #endif
-			object = new Object(key, pChar);
-		} break;
+		object = new Object(key, pChar);
+	} break;
 
-		case ObjectType::ListBegin:
-			object = new Object(key);
+	case ObjectType::ListBegin:
+		object = new Object(key);
+		if (m_streaming && closingKey == ObjectType::Eof && key == Key::Graph
+				&& m_graphObject == nullptr) {
+			m_graphObject = object;
+		} else {
 			object->pFirstSon = parseList(ObjectType::ListEnd);
-			break;
-
-		case ObjectType::ListEnd:
-			setError("unexpected end of list");
-			return firstSon;
+		}
+		break;
 
-		case ObjectType::Key:
-			setError("unexpected key");
-			return firstSon;
+	case ObjectType::ListEnd:
+		setError("unexpected end of list");
+		return nullptr;
 
-		case ObjectType::Eof:
-			setError("missing value");
-			return firstSon;
+	case ObjectType::Key:
+		setError("unexpected key");
+		return nullptr;
 
-		case ObjectType::Error:
-			return firstSon;
+	case ObjectType::Eof:
+		setError("missing value");
+		return nullptr;
 
-		// one of the cases above has to occur
-		default:
-			OGDF_ASSERT(false);
-		}
+	case ObjectType::Error:
+		return nullptr;
 
-		*pPrev = object;
-		pPrev = &object->pBrother;
+	// one of the cases above has to occur
+	default:
+		OGDF_ASSERT(false);
 	}
 
-	return firstSon;
+	return object;
 }
 
 void Parser::destroyObjectList(Object* object) {
@@ -202,6 +232,7 @@ void Parser::destroyObjectList(Object* object) {
 Parser::~Parser() {
 	// we have to delete all objects and allocated char arrays in string values
 	destroyObjectList(m_objectTree);
+	delete[] m_rLineBuffer;
 }
 
 bool Parser::getLine() {
@@ -654,12 +685,7 @@ public:
 		if (obj->valueType == ObjectType::ListBegin) {
 			Object* son = obj->pFirstSon;
 			for (; son; son = son->pBrother) {
-				if (m_handlers.find(son->key) != m_handlers.end()) {
-					m_handlers[son->key]->handle(son);
-				} else {
-					Logger::slout(Logger::Level::Minor)
-							<< "Ignoring unused attribute " << toString(son->key) << "!\n";
-				}
+				handleSon(son);
 			}
 
 		} else {
@@ -674,6 +700,16 @@ public:
 		}
 	}
 
+	// Handle a single element of the list.
+	void handleSon(Object* son) {
+		if (m_handlers.find(son->key) != m_handlers.end()) {
+			m_handlers[son->key]->handle(son);
+		} else {
+			Logger::slout(Logger::Level::Minor)
+					<< "Ignoring unused attribute " << toString(son->key) << "!\n";
+		}
+	}
+
 private:
 	GraphAttributes* m_GA;
 	std::unordered_map<Key, IHandler*> m_handlers;
@@ -738,7 +774,7 @@ bool Parser::read(Graph& G, GraphAttributes& GA) {
 
 	nh.attribute(Key::Id)
 			.eachInt([&](const int& i) {
-				m_mapToNode[i] = v;
+				setNodeForId(i, v);
 				nodeIdDef = true;
 				return true;
 			})
@@ -796,11 +832,22 @@ bool Parser::read(Graph& G, GraphAttributes& GA) {
 			[&](const double& d) { GA.zLabel(v) = d; });
 
 
+	// Streaming does not know the range of node ids in advance.
+	const bool streaming = m_streaming;
+	m_streaming = false;
+
 	edge e {nullptr};
 	bool sourceIdDef {false}, targetIdDef {false};
+	// Endpoints referring to nodes that are defined after the edge, and a node to attach such
+	// edges to if no node has been defined so far.
+	std::vector<std::pair<edge, int>> pendingSources, pendingTargets;
+	node placeholder {nullptr};
 	ListHandler& eh =
 			lh.listAttribute(Key::Edge)
 					.beforeEach([&] {
+						if (G.empty()) {
+							placeholder = G.newNode();
+						}
 						// Start off by making our edge a selfloop on the first node.
 						// During reading, we update its source and target to what the file defines.
 						e = G.newEdge(G.firstNode(), G.firstNode());
@@ -824,12 +871,15 @@ bool Parser::read(Graph& G, GraphAttributes& GA) {
 			setError("two sources for one edge");
 			return false;
 		}
-		if (i < minId || maxId < i) {
+		if (!streaming && (i < minId || maxId < i)) {
 			setError("source id out of range");
 			return false;
 		}
-		OGDF_ASSERT(m_mapToNode[i] != nullptr);
-		G.moveSource(e, m_mapToNode[i]);
+		if (node w = nodeForId(i)) {
+			G.moveSource(e, w);
+		} else {
+			pendingSources.emplace_back(e, i);
+		}
 		sourceIdDef = true;
 		return true;
 	});
@@ -838,12 +888,15 @@ bool Parser::read(Graph& G, GraphAttributes& GA) {
 			setError("two targets for one edge");
 			return false;
 		}
-		if (i < minId || maxId < i) {
+		if (!streaming && (i < minId || maxId < i)) {
 			setError("target id out of range");
 			return false;
 		}
-		OGDF_ASSERT(m_mapToNode[i] != nullptr);
-		G.moveTarget(e, m_mapToNode[i]);
+		if (node w = nodeForId(i)) {
+			G.moveTarget(e, w);
+		} else {
+			pendingTargets.emplace_back(e, i);
+		}
 		targetIdDef = true;
 		return true;
 	});
@@ -890,12 +943,69 @@ bool Parser::read(Graph& G, GraphAttributes& GA) {
 		GA.type(e) = Graph::EdgeType(i);
 	});
 
-	// Run the handler on the `graph` key.
-	lh.handle(m_graphObject);
+	if (streaming) {
+		// Parse the sons of the `graph` key one by one and discard each right after handling it.
+		while (Object* son = parseObject(ObjectType::ListEnd)) {
+			lh.handleSon(son);
+			destroyObjectList(son);
+		}
+		// Keep the remaining top-level objects (e.g. clusters) for readCluster().
+		if (!m_error) {
+			m_graphObject->pBrother = parseList(ObjectType::Eof);
+		}
+		delete[] m_rLineBuffer;
+		m_rLineBuffer = nullptr;
+	} else {
+		// Run the handler on the `graph` key.
+		lh.handle(m_graphObject);
+	}
+
+	for (const auto& p : pendingSources) {
+		if (node w = nodeForId(p.second)) {
+			G.moveSource(p.first, w);
+		} else {
+			setError("source id not defined");
+		}
+	}
+	for (const auto& p : pendingTargets) {
+		if (node w = nodeForId(p.second)) {
+			G.moveTarget(p.first, w);
+		} else {
+			setError("target id not defined");
+		}
+	}
+	if (placeholder != nullptr) {
+		G.delNode(placeholder);
+	}
 
 	return !m_error;
 }
 
+void Parser::setNodeForId(int id, node v) {
+	if (id < m_mapToNode.low() || m_mapToNode.high() < id) {
+		// grow geometrically so that streaming takes amortized constant time per node
+		int low = id, high = id;
+		if (!m_mapToNode.empty()) {
+			const long long n = m_mapToNode.size();
+			if (id < m_mapToNode.low()) {
+				low = int(std::max<long long>(std::numeric_limits<int>::min(),
+						std::min<long long>(id, m_mapToNode.low() - n)));
+				high = m_mapToNode.high();
+			} else {
+				low = m_mapToNode.low();
+				high = int(std::min<long long>(std::numeric_limits<int>::max(),
+						std::max<long long>(id, m_mapToNode.high() + n)));
+			}
+		}
+		Array<node> map(low, high, nullptr);
+		for (int i = m_mapToNode.low(); i <= m_mapToNode.high(); ++i) {
+			map[i] = m_mapToNode[i];
+		}
+		m_mapToNode = std::move(map);
+	}
+	m_mapToNode[id] = v;
+}
+
 //the clustergraph has to be initialized on G!!,
 //no clusters other then root cluster may exist, which holds all nodes
 bool Parser::readCluster(Graph& G, ClusterGraph& CG, ClusterGraphAttributes* ACG) {
@@ -951,7 +1061,7 @@ bool Parser::recursiveClusterRead(Object* clusterObject, ClusterGraph& CG, clust
 		}
 		int vID = std::stoi(vIDString);
 
-		if (vID > m_mapToNode.high() || vID < 0 || m_mapToNode[vID] == nullptr) {
+		if (vID < 0 || nodeForId(vID) == nullptr) {
 			setError("node index \"" + vIDString + "\" malformed");
 			return false;
 		}
@@ -328,7 +328,7 @@ bool GraphIO::readGML(Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	gml::Parser parser(is);
+	gml::Parser parser(is, false, true);
 	return parser.read(G);
 }
 
@@ -753,7 +753,7 @@ bool GraphIO::readGML(ClusterGraph& C, Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	gml::Parser gml(is);
+	gml::Parser gml(is, false, true);
 	return gml.read(G) && gml.readCluster(G, C);
 }
 
@@ -761,7 +761,7 @@ bool GraphIO::readGML(GraphAttributes& A, Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	gml::Parser parser(is);
+	gml::Parser parser(is, false, true);
 	return parser.read(G, A);
 }
 
@@ -843,7 +843,7 @@ bool GraphIO::readGML(ClusterGraphAttributes& A, ClusterGraph& C, Graph& G, std:
 	if (!is.good()) {
 		return false;
 	}
-	gml::Parser gml(is);
+	gml::Parser gml(is, false, true);
 	return gml.read(G, A) && gml.readCluster(G, C, &A);
 }
 
@@ -1738,7 +1738,7 @@ bool GraphIO::readGraphML(Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	GraphMLParser parser(is);
+	GraphMLParser parser(is, true);
 	return parser.read(G);
 }
 
@@ -1754,7 +1754,7 @@ bool GraphIO::readGraphML(GraphAttributes& A, Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	GraphMLParser parser(is);
+	GraphMLParser parser(is, true);
 	return parser.read(G, A);
 }
 
@@ -1799,7 +1799,7 @@ bool GraphIO::readGEXF(Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	gexf::Parser parser(is);
+	gexf::Parser parser(is, true);
 	return parser.read(G);
 }
 
@@ -1815,7 +1815,7 @@ bool GraphIO::readGEXF(GraphAttributes& A, Graph& G, std::istream& is) {
 	if (!is.good()) {
 		return false;
 	}
-	gexf::Parser parser(is);
+	gexf::Parser parser(is, true);
 	return parser.read(G, A);
 }
 
@@ -0,0 +1,841 @@
+/** \file
+ * \brief Implements OGDF's compact binary graph format.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/Array.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/List.h>
+#include <ogdf/basic/Logger.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/geometry.h>
+#include <ogdf/basic/graphics.h>
+#include <ogdf/cluster/ClusterGraph.h>
+#include <ogdf/cluster/ClusterGraphAttributes.h>
+#include <ogdf/fileformats/GraphIO.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ogdf {
+
+namespace {
+
+/*
+ * Layout of a file (all numbers little-endian, every array padded to a multiple of 8 bytes):
+ *
+ *   char[8]      magic "OGDF-BIN"
+ *   uint64[4]    version, sections, n, m
+ *   uint32[m]    source of each edge (index of the node in the node list)
+ *   uint32[m]    target of each edge
+ *   uint64[n+1]  offsets into the adjacency array
+ *   uint32[2m]   adjacency entries, 2*e for the source side of edge e, 2*e+1 for the target side
+ *
+ * If sections contains sectionClusters:
+ *   uint64       c
+ *   int32[c]     parent of each cluster in preorder (-1 for the root)
+ *   int32[n]     cluster of each node
+ *
+ * If sections contains sectionAttributes:
+ *   int64[2]     attribute flags, directed
+ *   one array per element for every attribute flag set, see writeAttributes()
+ */
+constexpr char binaryMagic[8] = {'O', 'G', 'D', 'F', '-', 'B', 'I', 'N'};
+constexpr uint64_t binaryVersion = 1;
+constexpr uint64_t sectionClusters = 1 << 0;
+constexpr uint64_t sectionAttributes = 1 << 1;
+
+//! Arrays read from the stream are grown in chunks of this many elements.
+constexpr size_t binaryChunkSize = 1 << 16;
+
+inline bool hostIsLittleEndian() {
+	const uint16_t one = 1;
+	unsigned char first;
+	memcpy(&first, &one, 1);
+	return first == 1;
+}
+
+template<typename T>
+inline T swapBytes(T value) {
+	unsigned char bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	std::reverse(bytes, bytes + sizeof(T));
+	memcpy(&value, bytes, sizeof(T));
+	return value;
+}
+
+inline uint32_t colorToInt(const Color& c) {
+	return uint32_t(c.red()) | uint32_t(c.green()) << 8 | uint32_t(c.blue()) << 16
+			| uint32_t(c.alpha()) << 24;
+}
+
+inline Color intToColor(uint32_t x) {
+	return Color(uint8_t(x), uint8_t(x >> 8), uint8_t(x >> 16), uint8_t(x >> 24));
+}
+
+//! Writes raw little-endian arrays and keeps track of the alignment.
+class BinaryWriter {
+public:
+	explicit BinaryWriter(std::ostream& os) : m_os(os), m_swap(!hostIsLittleEndian()) { }
+
+	template<typename T>
+	void write(const T* values, size_t count) {
+		if (m_swap) {
+			for (size_t i = 0; i < count; ++i) {
+				T value = swapBytes(values[i]);
+				m_os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+			}
+		} else {
+			m_os.write(reinterpret_cast<const char*>(values), count * sizeof(T));
+		}
+		m_position += count * sizeof(T);
+
+		static const char zeros[8] = {};
+		size_t padding = (8 - m_position % 8) % 8;
+		m_os.write(zeros, padding);
+		m_position += padding;
+	}
+
+	template<typename T>
+	void write(const std::vector<T>& values) {
+		write(values.data(), values.size());
+	}
+
+	template<typename T>
+	void writeValue(T value) {
+		write(&value, 1);
+	}
+
+	//! Writes \p value(x) for all \p elements as one array.
+	template<typename T, typename CONTAINER, typename FUNC>
+	void writeEach(const CONTAINER& elements, FUNC value) {
+		std::vector<T> values;
+		values.reserve(elements.size());
+		for (auto x : elements) {
+			values.push_back(value(x));
+		}
+		write(values);
+	}
+
+	//! Writes the strings \p value(x) for all \p elements as an offset array and a character array.
+	template<typename CONTAINER, typename FUNC>
+	void writeStrings(const CONTAINER& elements, FUNC value) {
+		std::vector<uint64_t> offsets(1, 0);
+		std::vector<char> chars;
+		offsets.reserve(elements.size() + 1);
+		for (auto x : elements) {
+			const string& s = value(x);
+			chars.insert(chars.end(), s.begin(), s.end());
+			offsets.push_back(chars.size());
+		}
+		write(offsets);
+		write(chars);
+	}
+
+private:
+	std::ostream& m_os;
+	bool m_swap;
+	size_t m_position = 0;
+};
+
+//! Reads raw little-endian arrays written by BinaryWriter.
+class BinaryReader {
+public:
+	explicit BinaryReader(std::istream& is) : m_is(is), m_swap(!hostIsLittleEndian()) { }
+
+	//! Reads \p count values into \p values; returns false if the stream ends prematurely.
+	template<typename T>
+	bool read(std::vector<T>& values, size_t count) {
+		// grow step by step so that a corrupt count cannot trigger a huge allocation
+		values.clear();
+		for (size_t done = 0; done < count;) {
+			size_t chunk = std::min(count - done, binaryChunkSize);
+			values.resize(done + chunk);
+			if (!m_is.read(reinterpret_cast<char*>(values.data() + done), chunk * sizeof(T))) {
+				return false;
+			}
+			done += chunk;
+		}
+		if (m_swap) {
+			for (T& value : values) {
+				value = swapBytes(value);
+			}
+		}
+		m_position += count * sizeof(T);
+
+		char padding[8];
+		size_t numPadding = (8 - m_position % 8) % 8;
+		m_position += numPadding;
+		return bool(m_is.read(padding, numPadding));
+	}
+
+	template<typename T>
+	bool readValue(T& value) {
+		std::vector<T> values;
+		if (!read(values, 1)) {
+			return false;
+		}
+		value = values[0];
+		return true;
+	}
+
+	//! Reads \p count strings stored by BinaryWriter::writeStrings.
+	bool readStrings(std::vector<string>& strings, size_t count) {
+		std::vector<uint64_t> offsets;
+		if (!read(offsets, count + 1) || offsets[0] != 0) {
+			return false;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			if (offsets[i + 1] < offsets[i]) {
+				return false;
+			}
+		}
+		std::vector<char> chars;
+		if (!read(chars, offsets[count])) {
+			return false;
+		}
+		strings.resize(count);
+		for (size_t i = 0; i < count; ++i) {
+			strings[i].assign(chars.data() + offsets[i], offsets[i + 1] - offsets[i]);
+		}
+		return true;
+	}
+
+private:
+	std::istream& m_is;
+	bool m_swap;
+	size_t m_position = 0;
+};
+
+//! Collects the clusters of \p CG in preorder.
+void clustersInPreorder(const ClusterGraph& CG, std::vector<cluster>& clusters) {
+	clusters.clear();
+	clusters.reserve(CG.numberOfClusters());
+	std::vector<cluster> stack(1, CG.rootCluster());
+	while (!stack.empty()) {
+		cluster c = stack.back();
+		stack.pop_back();
+		clusters.push_back(c);
+		size_t first = stack.size();
+		for (cluster child : c->children) {
+			stack.push_back(child);
+		}
+		std::reverse(stack.begin() + first, stack.end());
+	}
+}
+
+void writeAttributes(BinaryWriter& writer, const GraphAttributes& GA,
+		const ClusterGraphAttributes* CGA, const std::vector<cluster>& clusters) {
+	const Graph& G = GA.constGraph();
+	const long attr = GA.attributes();
+	writer.writeValue<int64_t>(attr);
+	writer.writeValue<int64_t>(GA.directed());
+
+	const auto& nodes = G.nodes;
+	const auto& edges = G.edges;
+	if (attr & GraphAttributes::nodeGraphics) {
+		writer.writeEach<double>(nodes, [&](node v) { return GA.x(v); });
+		writer.writeEach<double>(nodes, [&](node v) { return GA.y(v); });
+		writer.writeEach<double>(nodes, [&](node v) { return GA.width(v); });
+		writer.writeEach<double>(nodes, [&](node v) { return GA.height(v); });
+		writer.writeEach<int32_t>(nodes, [&](node v) { return static_cast<int32_t>(GA.shape(v)); });
+	}
+	if (attr & GraphAttributes::threeD) {
+		writer.writeEach<double>(nodes, [&](node v) { return GA.z(v); });
+	}
+	if (attr & GraphAttributes::nodeLabelPosition) {
+		writer.writeEach<double>(nodes, [&](node v) { return GA.xLabel(v); });
+		writer.writeEach<double>(nodes, [&](node v) { return GA.yLabel(v); });
+		if (attr & GraphAttributes::threeD) {
+			writer.writeEach<double>(nodes, [&](node v) { return GA.zLabel(v); });
+		}
+	}
+	if (attr & GraphAttributes::nodeStyle) {
+		writer.writeEach<uint32_t>(nodes, [&](node v) { return colorToInt(GA.strokeColor(v)); });
+		writer.writeEach<float>(nodes, [&](node v) { return GA.strokeWidth(v); });
+		writer.writeEach<int32_t>(nodes,
+				[&](node v) { return static_cast<int32_t>(GA.strokeType(v)); });
+		writer.writeEach<int32_t>(nodes,
+				[&](node v) { return static_cast<int32_t>(GA.fillPattern(v)); });
+		writer.writeEach<uint32_t>(nodes, [&](node v) { return colorToInt(GA.fillColor(v)); });
+		writer.writeEach<uint32_t>(nodes, [&](node v) { return colorToInt(GA.fillBgColor(v)); });
+	}
+	if (attr & GraphAttributes::nodeWeight) {
+		writer.writeEach<int32_t>(nodes, [&](node v) { return GA.weight(v); });
+	}
+	if (attr & GraphAttributes::nodeId) {
+		writer.writeEach<int32_t>(nodes, [&](node v) { return GA.idNode(v); });
+	}
+	if (attr & GraphAttributes::nodeType) {
+		writer.writeEach<int32_t>(nodes, [&](node v) { return static_cast<int32_t>(GA.type(v)); });
+	}
+	if (attr & GraphAttributes::nodeLabel) {
+		writer.writeStrings(nodes, [&](node v) -> const string& { return GA.label(v); });
+	}
+	if (attr & GraphAttributes::nodeTemplate) {
+		writer.writeStrings(nodes, [&](node v) -> const string& { return GA.templateNode(v); });
+	}
+
+	if (attr & GraphAttributes::edgeGraphics) {
+		std::vector<uint64_t> offsets(1, 0);
+		std::vector<double> coordinates;
+		for (edge e : edges) {
+			for (const DPoint& p : GA.bends(e)) {
+				coordinates.push_back(p.m_x);
+				coordinates.push_back(p.m_y);
+			}
+			offsets.push_back(coordinates.size() / 2);
+		}
+		writer.write(offsets);
+		writer.write(coordinates);
+	}
+	if (attr & GraphAttributes::edgeIntWeight) {
+		writer.writeEach<int32_t>(edges, [&](edge e) { return GA.intWeight(e); });
+	}
+	if (attr & GraphAttributes::edgeDoubleWeight) {
+		writer.writeEach<double>(edges, [&](edge e) { return GA.doubleWeight(e); });
+	}
+	if (attr & GraphAttributes::edgeLabel) {
+		writer.writeStrings(edges, [&](edge e) -> const string& { return GA.label(e); });
+	}
+	if (attr & GraphAttributes::edgeType) {
+		writer.writeEach<int32_t>(edges, [&](edge e) { return static_cast<int32_t>(GA.type(e)); });
+	}
+	if (attr & GraphAttributes::edgeArrow) {
+		writer.writeEach<int32_t>(edges,
+				[&](edge e) { return static_cast<int32_t>(GA.arrowType(e)); });
+	}
+	if (attr & GraphAttributes::edgeStyle) {
+		writer.writeEach<uint32_t>(edges, [&](edge e) { return colorToInt(GA.strokeColor(e)); });
+		writer.writeEach<float>(edges, [&](edge e) { return GA.strokeWidth(e); });
+		writer.writeEach<int32_t>(edges,
+				[&](edge e) { return static_cast<int32_t>(GA.strokeType(e)); });
+	}
+	if (attr & GraphAttributes::edgeSubGraphs) {
+		writer.writeEach<uint32_t>(edges, [&](edge e) { return GA.subGraphBits(e); });
+	}
+
+	if (CGA == nullptr) {
+		return;
+	}
+	if (attr & ClusterGraphAttributes::clusterGraphics) {
+		writer.writeEach<double>(clusters, [&](cluster c) { return CGA->x(c); });
+		writer.writeEach<double>(clusters, [&](cluster c) { return CGA->y(c); });
+		writer.writeEach<double>(clusters, [&](cluster c) { return CGA->width(c); });
+		writer.writeEach<double>(clusters, [&](cluster c) { return CGA->height(c); });
+	}
+	if (attr & ClusterGraphAttributes::clusterStyle) {
+		writer.writeEach<uint32_t>(clusters,
+				[&](cluster c) { return colorToInt(CGA->strokeColor(c)); });
+		writer.writeEach<float>(clusters, [&](cluster c) { return CGA->strokeWidth(c); });
+		writer.writeEach<int32_t>(clusters,
+				[&](cluster c) { return static_cast<int32_t>(CGA->strokeType(c)); });
+		writer.writeEach<int32_t>(clusters,
+				[&](cluster c) { return static_cast<int32_t>(CGA->fillPattern(c)); });
+		writer.writeEach<uint32_t>(clusters, [&](cluster c) { return colorToInt(CGA->fillColor(c)); });
+		writer.writeEach<uint32_t>(clusters,
+				[&](cluster c) { return colorToInt(CGA->fillBgColor(c)); });
+	}
+	if (attr & ClusterGraphAttributes::clusterLabel) {
+		writer.writeStrings(clusters, [&](cluster c) -> const string& { return CGA->label(c); });
+	}
+	if (attr & ClusterGraphAttributes::clusterTemplate) {
+		writer.writeStrings(clusters,
+				[&](cluster c) -> const string& { return CGA->templateCluster(c); });
+	}
+}
+
+bool writeBinaryGraph(const Graph& G, const ClusterGraph* CG, const GraphAttributes* GA,
+		const ClusterGraphAttributes* CGA, std::ostream& os) {
+	if (!os.good()) {
+		return false;
+	}
+
+	BinaryWriter writer(os);
+	os.write(binaryMagic, sizeof(binaryMagic));
+
+	const uint64_t n = G.numberOfNodes();
+	const uint64_t m = G.numberOfEdges();
+	const uint64_t header[4] = {binaryVersion,
+			(CG != nullptr ? sectionClusters : 0) | (GA != nullptr ? sectionAttributes : 0), n, m};
+	writer.write(header, 4);
+
+	NodeArray<uint32_t> nodeIndex(G);
+	uint32_t i = 0;
+	for (node v : G.nodes) {
+		nodeIndex[v] = i++;
+	}
+	EdgeArray<uint32_t> edgeIndex(G);
+	i = 0;
+	for (edge e : G.edges) {
+		edgeIndex[e] = i++;
+	}
+
+	writer.writeEach<uint32_t>(G.edges, [&](edge e) { return nodeIndex[e->source()]; });
+	writer.writeEach<uint32_t>(G.edges, [&](edge e) { return nodeIndex[e->target()]; });
+
+	std::vector<uint64_t> adjOffsets(1, 0);
+	std::vector<uint32_t> adjEntries;
+	adjOffsets.reserve(n + 1);
+	adjEntries.reserve(2 * m);
+	for (node v : G.nodes) {
+		for (adjEntry adj : v->adjEntries) {
+			adjEntries.push_back(2 * edgeIndex[adj->theEdge()] + (adj->isSource() ? 0 : 1));
+		}
+		adjOffsets.push_back(adjEntries.size());
+	}
+	writer.write(adjOffsets);
+	writer.write(adjEntries);
+
+	std::vector<cluster> clusters;
+	if (CG != nullptr) {
+		clustersInPreorder(*CG, clusters);
+		ClusterArray<int32_t> clusterIndex(*CG);
+		std::vector<int32_t> parents;
+		parents.reserve(clusters.size());
+		for (cluster c : clusters) {
+			clusterIndex[c] = static_cast<int32_t>(parents.size());
+			parents.push_back(c->parent() == nullptr ? -1 : clusterIndex[c->parent()]);
+		}
+		writer.writeValue<uint64_t>(clusters.size());
+		writer.write(parents);
+		writer.writeEach<int32_t>(G.nodes, [&](node v) { return clusterIndex[CG->clusterOf(v)]; });
+	}
+
+	if (GA != nullptr) {
+		writeAttributes(writer, *GA, CGA, clusters);
+	}
+
+	return os.good();
+}
+
+//! Reads the attribute section; \p nodes, \p edges and \p clusters are listed in file order.
+bool readAttributes(BinaryReader& reader, GraphAttributes* GA, ClusterGraphAttributes* CGA,
+		const Array<node>& nodes, const Array<edge>& edges, const std::vector<cluster>& clusters,
+		bool hasClusters) {
+	int64_t fileAttr, directed;
+	if (!reader.readValue(fileAttr) || !reader.readValue(directed)) {
+		return false;
+	}
+	const long clusterFlags = ClusterGraphAttributes::clusterGraphics
+			| ClusterGraphAttributes::clusterStyle | ClusterGraphAttributes::clusterLabel
+			| ClusterGraphAttributes::clusterTemplate;
+	if ((fileAttr & clusterFlags) && !hasClusters) {
+		Logger::slout() << "GraphIO::readBinary: Cluster attributes without clusters.\n";
+		return false;
+	}
+	if (GA != nullptr) {
+		GA->directed() = directed != 0;
+	}
+
+	const size_t n = nodes.size();
+	const size_t m = edges.size();
+	const size_t c = clusters.size();
+	auto has = [&](long flag) {
+		if (flag & clusterFlags) {
+			return CGA != nullptr && CGA->has(flag);
+		}
+		return GA != nullptr && GA->has(flag);
+	};
+
+	// reads one array of count values and assigns it if the attribute is enabled
+	auto readArray = [&](auto tag, long flag, size_t count, auto assign) {
+		std::vector<decltype(tag)> values;
+		if (!reader.read(values, count)) {
+			return false;
+		}
+		if (has(flag)) {
+			for (size_t i = 0; i < count; ++i) {
+				assign(i, values[i]);
+			}
+		}
+		return true;
+	};
+	auto readStrings = [&](long flag, size_t count, auto assign) {
+		std::vector<string> values;
+		if (!reader.readStrings(values, count)) {
+			return false;
+		}
+		if (has(flag)) {
+			for (size_t i = 0; i < count; ++i) {
+				assign(i, std::move(values[i]));
+			}
+		}
+		return true;
+	};
+
+	bool ok = true;
+	if (fileAttr & GraphAttributes::nodeGraphics) {
+		const long flag = GraphAttributes::nodeGraphics;
+		ok = ok && readArray(double(), flag, n, [&](size_t i, double x) { GA->x(nodes[i]) = x; });
+		ok = ok && readArray(double(), flag, n, [&](size_t i, double x) { GA->y(nodes[i]) = x; });
+		ok = ok && readArray(double(), flag, n, [&](size_t i, double x) { GA->width(nodes[i]) = x; });
+		ok = ok && readArray(double(), flag, n, [&](size_t i, double x) { GA->height(nodes[i]) = x; });
+		ok = ok && readArray(int32_t(), flag, n, [&](size_t i, int32_t x) {
+			GA->shape(nodes[i]) = static_cast<Shape>(x);
+		});
+	}
+	if (ok && (fileAttr & GraphAttributes::threeD)) {
+		ok = readArray(double(), GraphAttributes::threeD, n,
+				[&](size_t i, double x) { GA->z(nodes[i]) = x; });
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeLabelPosition)) {
+		const long flag = GraphAttributes::nodeLabelPosition;
+		ok = readArray(double(), flag, n, [&](size_t i, double x) { GA->xLabel(nodes[i]) = x; });
+		ok = ok && readArray(double(), flag, n, [&](size_t i, double x) { GA->yLabel(nodes[i]) = x; });
+		if (fileAttr & GraphAttributes::threeD) {
+			ok = ok
+					&& readArray(double(), flag | GraphAttributes::threeD, n,
+							[&](size_t i, double x) { GA->zLabel(nodes[i]) = x; });
+		}
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeStyle)) {
+		const long flag = GraphAttributes::nodeStyle;
+		ok = readArray(uint32_t(), flag, n,
+				[&](size_t i, uint32_t x) { GA->strokeColor(nodes[i]) = intToColor(x); });
+		ok = ok
+				&& readArray(float(), flag, n,
+						[&](size_t i, float x) { GA->strokeWidth(nodes[i]) = x; });
+		ok = ok && readArray(int32_t(), flag, n, [&](size_t i, int32_t x) {
+			GA->strokeType(nodes[i]) = static_cast<StrokeType>(x);
+		});
+		ok = ok && readArray(int32_t(), flag, n, [&](size_t i, int32_t x) {
+			GA->fillPattern(nodes[i]) = static_cast<FillPattern>(x);
+		});
+		ok = ok && readArray(uint32_t(), flag, n, [&](size_t i, uint32_t x) {
+			GA->fillColor(nodes[i]) = intToColor(x);
+		});
+		ok = ok && readArray(uint32_t(), flag, n, [&](size_t i, uint32_t x) {
+			GA->fillBgColor(nodes[i]) = intToColor(x);
+		});
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeWeight)) {
+		ok = readArray(int32_t(), GraphAttributes::nodeWeight, n,
+				[&](size_t i, int32_t x) { GA->weight(nodes[i]) = x; });
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeId)) {
+		ok = readArray(int32_t(), GraphAttributes::nodeId, n,
+				[&](size_t i, int32_t x) { GA->idNode(nodes[i]) = x; });
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeType)) {
+		ok = readArray(int32_t(), GraphAttributes::nodeType, n, [&](size_t i, int32_t x) {
+			GA->type(nodes[i]) = static_cast<Graph::NodeType>(x);
+		});
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeLabel)) {
+		ok = readStrings(GraphAttributes::nodeLabel, n,
+				[&](size_t i, string&& s) { GA->label(nodes[i]) = std::move(s); });
+	}
+	if (ok && (fileAttr & GraphAttributes::nodeTemplate)) {
+		ok = readStrings(GraphAttributes::nodeTemplate, n,
+				[&](size_t i, string&& s) { GA->templateNode(nodes[i]) = std::move(s); });
+	}
+
+	if (ok && (fileAttr & GraphAttributes::edgeGraphics)) {
+		std::vector<uint64_t> offsets;
+		std::vector<double> coordinates;
+		ok = reader.read(offsets, m + 1) && offsets[0] == 0;
+		for (size_t i = 0; ok && i < m; ++i) {
+			ok = offsets[i] <= offsets[i + 1];
+		}
+		ok = ok && offsets[m] <= std::numeric_limits<uint64_t>::max() / 2
+				&& reader.read(coordinates, 2 * offsets[m]);
+		if (ok && has(GraphAttributes::edgeGraphics)) {
+			for (size_t i = 0; i < m; ++i) {
+				DPolyline& bends = GA->bends(edges[i]);
+				bends.clear();
+				for (uint64_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+					bends.emplaceBack(coordinates[2 * j], coordinates[2 * j + 1]);
+				}
+			}
+		}
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeIntWeight)) {
+		ok = readArray(int32_t(), GraphAttributes::edgeIntWeight, m,
+				[&](size_t i, int32_t x) { GA->intWeight(edges[i]) = x; });
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeDoubleWeight)) {
+		ok = readArray(double(), GraphAttributes::edgeDoubleWeight, m,
+				[&](size_t i, double x) { GA->doubleWeight(edges[i]) = x; });
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeLabel)) {
+		ok = readStrings(GraphAttributes::edgeLabel, m,
+				[&](size_t i, string&& s) { GA->label(edges[i]) = std::move(s); });
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeType)) {
+		ok = readArray(int32_t(), GraphAttributes::edgeType, m, [&](size_t i, int32_t x) {
+			GA->type(edges[i]) = static_cast<Graph::EdgeType>(x);
+		});
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeArrow)) {
+		ok = readArray(int32_t(), GraphAttributes::edgeArrow, m, [&](size_t i, int32_t x) {
+			GA->arrowType(edges[i]) = static_cast<EdgeArrow>(x);
+		});
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeStyle)) {
+		const long flag = GraphAttributes::edgeStyle;
+		ok = readArray(uint32_t(), flag, m,
+				[&](size_t i, uint32_t x) { GA->strokeColor(edges[i]) = intToColor(x); });
+		ok = ok
+				&& readArray(float(), flag, m,
+						[&](size_t i, float x) { GA->strokeWidth(edges[i]) = x; });
+		ok = ok && readArray(int32_t(), flag, m, [&](size_t i, int32_t x) {
+			GA->strokeType(edges[i]) = static_cast<StrokeType>(x);
+		});
+	}
+	if (ok && (fileAttr & GraphAttributes::edgeSubGraphs)) {
+		ok = readArray(uint32_t(), GraphAttributes::edgeSubGraphs, m,
+				[&](size_t i, uint32_t x) { GA->subGraphBits(edges[i]) = x; });
+	}
+
+	if (ok && (fileAttr & ClusterGraphAttributes::clusterGraphics)) {
+		const long flag = ClusterGraphAttributes::clusterGraphics;
+		ok = readArray(double(), flag, c, [&](size_t i, double x) { CGA->x(clusters[i]) = x; });
+		ok = ok && readArray(double(), flag, c, [&](size_t i, double x) { CGA->y(clusters[i]) = x; });
+		ok = ok
+				&& readArray(double(), flag, c,
+						[&](size_t i, double x) { CGA->width(clusters[i]) = x; });
+		ok = ok
+				&& readArray(double(), flag, c,
+						[&](size_t i, double x) { CGA->height(clusters[i]) = x; });
+	}
+	if (ok && (fileAttr & ClusterGraphAttributes::clusterStyle)) {
+		const long flag = ClusterGraphAttributes::clusterStyle;
+		ok = readArray(uint32_t(), flag, c,
+				[&](size_t i, uint32_t x) { CGA->strokeColor(clusters[i]) = intToColor(x); });
+		ok = ok
+				&& readArray(float(), flag, c,
+						[&](size_t i, float x) { CGA->strokeWidth(clusters[i]) = x; });
+		ok = ok && readArray(int32_t(), flag, c, [&](size_t i, int32_t x) {
+			CGA->strokeType(clusters[i]) = static_cast<StrokeType>(x);
+		});
+		ok = ok && readArray(int32_t(), flag, c, [&](size_t i, int32_t x) {
+			CGA->fillPattern(clusters[i]) = static_cast<FillPattern>(x);
+		});
+		ok = ok && readArray(uint32_t(), flag, c, [&](size_t i, uint32_t x) {
+			CGA->fillColor(clusters[i]) = intToColor(x);
+		});
+		ok = ok && readArray(uint32_t(), flag, c, [&](size_t i, uint32_t x) {
+			CGA->fillBgColor(clusters[i]) = intToColor(x);
+		});
+	}
+	if (ok && (fileAttr & ClusterGraphAttributes::clusterLabel)) {
+		ok = readStrings(ClusterGraphAttributes::clusterLabel, c,
+				[&](size_t i, string&& s) { CGA->label(clusters[i]) = std::move(s); });
+	}
+	if (ok && (fileAttr & ClusterGraphAttributes::clusterTemplate)) {
+		ok = readStrings(ClusterGraphAttributes::clusterTemplate, c,
+				[&](size_t i, string&& s) { CGA->templateCluster(clusters[i]) = std::move(s); });
+	}
+
+	return ok;
+}
+
+bool readBinaryGraph(Graph& G, ClusterGraph* CG, GraphAttributes* GA, ClusterGraphAttributes* CGA,
+		std::istream& is) {
+	if (!is.good()) {
+		return false;
+	}
+
+	BinaryReader reader(is);
+	char magic[sizeof(binaryMagic)];
+	std::vector<uint64_t> header;
+	if (!is.read(magic, sizeof(magic)) || memcmp(magic, binaryMagic, sizeof(magic)) != 0
+			|| !reader.read(header, 4)) {
+		Logger::slout() << "GraphIO::readBinary: Not an OGDF binary graph file.\n";
+		return false;
+	}
+	if (header[0] != binaryVersion) {
+		Logger::slout() << "GraphIO::readBinary: Unsupported version " << header[0] << ".\n";
+		return false;
+	}
+	const uint64_t sections = header[1];
+	const uint64_t n = header[2];
+	const uint64_t m = header[3];
+	if (n > uint64_t(std::numeric_limits<int>::max()) || m > uint64_t(std::numeric_limits<int>::max())) {
+		Logger::slout() << "GraphIO::readBinary: Graph too large.\n";
+		return false;
+	}
+
+	auto malformed = [](const char* what) {
+		Logger::slout() << "GraphIO::readBinary: Malformed " << what << ".\n";
+		return false;
+	};
+
+	std::vector<uint32_t> sources, targets;
+	if (!reader.read(sources, m) || !reader.read(targets, m)) {
+		return malformed("edge arrays");
+	}
+	for (uint64_t i = 0; i < m; ++i) {
+		if (sources[i] >= n || targets[i] >= n) {
+			return malformed("edge arrays");
+		}
+	}
+
+	G.clear();
+
+	Array<node> nodes;
+	G.newNodes(static_cast<int>(n), nodes);
+	{
+		std::vector<std::pair<node, node>> endpoints;
+		endpoints.reserve(m);
+		for (uint64_t i = 0; i < m; ++i) {
+			endpoints.emplace_back(nodes[sources[i]], nodes[targets[i]]);
+		}
+		G.newEdges(endpoints.begin(), endpoints.end());
+	}
+	Array<edge> edges(static_cast<int>(m));
+	int i = 0;
+	for (edge e : G.edges) {
+		edges[i++] = e;
+	}
+
+	// restore the order of the adjacency lists
+	std::vector<uint64_t> adjOffsets;
+	std::vector<uint32_t> adjEntries;
+	if (!reader.read(adjOffsets, n + 1) || !reader.read(adjEntries, 2 * m) || adjOffsets[0] != 0
+			|| adjOffsets[n] != 2 * m) {
+		return malformed("adjacency arrays");
+	}
+	std::vector<bool> seen(2 * m, false);
+	std::vector<adjEntry> order;
+	for (uint64_t k = 0; k < n; ++k) {
+		node v = nodes[static_cast<int>(k)];
+		if (adjOffsets[k + 1] < adjOffsets[k]
+				|| adjOffsets[k + 1] - adjOffsets[k] != uint64_t(v->degree())) {
+			return malformed("adjacency arrays");
+		}
+		order.clear();
+		for (uint64_t j = adjOffsets[k]; j < adjOffsets[k + 1]; ++j) {
+			uint32_t entry = adjEntries[j];
+			if (entry >= 2 * m || seen[entry]) {
+				return malformed("adjacency arrays");
+			}
+			seen[entry] = true;
+			edge e = edges[static_cast<int>(entry / 2)];
+			adjEntry adj = entry % 2 == 0 ? e->adjSource() : e->adjTarget();
+			if (adj->theNode() != v) {
+				return malformed("adjacency arrays");
+			}
+			order.push_back(adj);
+		}
+		G.sort(v, order.begin(), order.end());
+	}
+
+	// clusters are listed in preorder, i.e., parents precede their children
+	std::vector<cluster> clusters;
+	const bool hasClusters = sections & sectionClusters;
+	if (hasClusters) {
+		uint64_t c;
+		std::vector<int32_t> parents, clusterOfNode;
+		if (!reader.readValue(c) || c == 0 || c > uint64_t(std::numeric_limits<int>::max())
+				|| !reader.read(parents, c) || !reader.read(clusterOfNode, n) || parents[0] != -1) {
+			return malformed("cluster section");
+		}
+		for (uint64_t k = 1; k < c; ++k) {
+			if (parents[k] < 0 || uint64_t(parents[k]) >= k) {
+				return malformed("cluster section");
+			}
+		}
+		for (int32_t x : clusterOfNode) {
+			if (x < 0 || uint64_t(x) >= c) {
+				return malformed("cluster section");
+			}
+		}
+
+		if (CG != nullptr) {
+			clusters.reserve(c);
+			clusters.push_back(CG->rootCluster());
+			for (uint64_t k = 1; k < c; ++k) {
+				clusters.push_back(CG->newCluster(clusters[parents[k]]));
+			}
+			for (uint64_t k = 0; k < n; ++k) {
+				CG->reassignNode(nodes[static_cast<int>(k)], clusters[clusterOfNode[k]]);
+			}
+		} else {
+			// the cluster attributes need the right number of entries to be skipped
+			clusters.assign(c, nullptr);
+		}
+	}
+
+	if (sections & sectionAttributes) {
+		if (!readAttributes(reader, GA, CGA, nodes, edges, clusters,
+					hasClusters)) {
+			return malformed("attribute section");
+		}
+	}
+
+	return true;
+}
+
+}
+
+bool GraphIO::readBinary(Graph& G, std::istream& is) {
+	return readBinaryGraph(G, nullptr, nullptr, nullptr, is);
+}
+
+bool GraphIO::writeBinary(const Graph& G, std::ostream& os) {
+	return writeBinaryGraph(G, nullptr, nullptr, nullptr, os);
+}
+
+bool GraphIO::readBinary(ClusterGraph& C, Graph& G, std::istream& is) {
+	OGDF_ASSERT(&C.constGraph() == &G);
+	return readBinaryGraph(G, &C, nullptr, nullptr, is);
+}
+
+bool GraphIO::writeBinary(const ClusterGraph& C, std::ostream& os) {
+	return writeBinaryGraph(C.constGraph(), &C, nullptr, nullptr, os);
+}
+
+bool GraphIO::readBinary(ClusterGraphAttributes& A, ClusterGraph& C, Graph& G, std::istream& is) {
+	OGDF_ASSERT(&A.constClusterGraph() == &C);
+	OGDF_ASSERT(&C.constGraph() == &G);
+	return readBinaryGraph(G, &C, &A, &A, is);
+}
+
+bool GraphIO::writeBinary(const ClusterGraphAttributes& A, std::ostream& os) {
+	return writeBinaryGraph(A.constGraph(), &A.constClusterGraph(), &A, &A, os);
+}
+
+bool GraphIO::readBinary(GraphAttributes& A, Graph& G, std::istream& is) {
+	OGDF_ASSERT(&A.constGraph() == &G);
+	return readBinaryGraph(G, nullptr, &A, nullptr, is);
+}
+
+bool GraphIO::writeBinary(const GraphAttributes& A, std::ostream& os) {
+	return writeBinaryGraph(A.constGraph(), nullptr, &A, nullptr, os);
+}
+
+}
@@ -0,0 +1,340 @@
+/** \file
+ * \brief Implements memory-mapped, parallel readers for edge lists
+ *        and the Matrix Market exchange format.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/Array.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/Logger.h>
+#include <ogdf/basic/Math.h>
+#include <ogdf/basic/System.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/fileformats/GraphIO.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef OGDF_SYSTEM_WINDOWS
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace ogdf {
+
+namespace {
+
+//! Read-only view of a whole file that is memory-mapped if possible.
+class MappedFile {
+public:
+	explicit MappedFile(const string& filename) {
+#ifdef OGDF_SYSTEM_WINDOWS
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+				OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file != INVALID_HANDLE_VALUE) {
+			LARGE_INTEGER size;
+			if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+				HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				if (mapping != nullptr) {
+					m_map = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+					CloseHandle(mapping);
+				}
+				if (m_map != nullptr) {
+					m_data = static_cast<const char*>(m_map);
+					m_size = static_cast<size_t>(size.QuadPart);
+				}
+			}
+			CloseHandle(file);
+		}
+#else
+		int fd = open(filename.c_str(), O_RDONLY);
+		if (fd >= 0) {
+			struct stat st;
+			if (fstat(fd, &st) == 0 && st.st_size > 0) {
+				void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (map != MAP_FAILED) {
+					madvise(map, st.st_size, MADV_SEQUENTIAL);
+					m_map = map;
+					m_data = static_cast<const char*>(map);
+					m_size = st.st_size;
+				}
+			}
+			close(fd);
+		}
+#endif
+		if (m_map == nullptr) {
+			// empty file or mapping not supported, read it the conventional way
+			std::ifstream is(filename, std::ios::binary);
+			m_good = is.good();
+			m_buffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+			m_data = m_buffer.data();
+			m_size = m_buffer.size();
+		}
+	}
+
+	~MappedFile() {
+		if (m_map != nullptr) {
+#ifdef OGDF_SYSTEM_WINDOWS
+			UnmapViewOfFile(m_map);
+#else
+			munmap(m_map, m_size);
+#endif
+		}
+	}
+
+	OGDF_NO_COPY(MappedFile)
+	OGDF_NO_MOVE(MappedFile)
+
+	bool good() const { return m_good; }
+
+	const char* begin() const { return m_data; }
+
+	const char* end() const { return m_data + m_size; }
+
+private:
+	void* m_map = nullptr;
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+	bool m_good = true;
+	string m_buffer;
+};
+
+inline const char* skipBlanks(const char* p, const char* end) {
+	while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+		++p;
+	}
+	return p;
+}
+
+inline const char* skipLine(const char* p, const char* end) {
+	const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+	return eol == nullptr ? end : eol + 1;
+}
+
+inline bool isComment(char c) { return c == '%' || c == '#'; }
+
+//! Parses a decimal integer at \p p; returns nullptr if there is none.
+inline const char* parseInt(const char* p, const char* end, int& value) {
+	bool negative = p != end && *p == '-';
+	if (negative) {
+		++p;
+	}
+	if (p == end || *p < '0' || '9' < *p) {
+		return nullptr;
+	}
+	int64_t x = 0;
+	do {
+		x = 10 * x + (*p++ - '0');
+		if (x > std::numeric_limits<int>::max()) {
+			return nullptr;
+		}
+	} while (p != end && '0' <= *p && *p <= '9');
+	value = static_cast<int>(negative ? -x : x);
+	return p;
+}
+
+//! Parses all lines in [\p p, \p end) into pairs of ids; returns false on malformed lines.
+bool parseEdgeLines(const char* p, const char* end, std::vector<std::pair<int, int>>& entries) {
+	while (p != end) {
+		p = skipBlanks(p, end);
+		if (p == end) {
+			break;
+		}
+		if (*p == '\n' || isComment(*p)) {
+			p = skipLine(p, end);
+			continue;
+		}
+
+		int u, v;
+		const char* q = parseInt(p, end, u);
+		if (q == nullptr || q == end || (*q != ' ' && *q != '\t')) {
+			return false;
+		}
+		q = parseInt(skipBlanks(q, end), end, v);
+		if (q == nullptr || (q != end && *q != ' ' && *q != '\t' && *q != '\r' && *q != '\n')) {
+			return false;
+		}
+		entries.emplace_back(u, v);
+
+		// ignore weights and other entries
+		p = skipLine(q, end);
+	}
+	return true;
+}
+
+//! Parses the lines in [\p begin, \p end) in parallel and creates the corresponding graph.
+bool readEdgeLines(Graph& G, const char* begin, const char* end, unsigned int numThreads,
+		const char* context) {
+	const size_t size = end - begin;
+	if (numThreads == 0) {
+		// chunks of less than a few MBytes are not worth an extra thread
+		numThreads = static_cast<unsigned int>(std::min<size_t>(System::numberOfProcessors(),
+				std::max<size_t>(1, size >> 22)));
+	}
+	numThreads = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(numThreads, size)));
+
+	// chunks always end after a line break
+	std::vector<const char*> bounds(numThreads + 1, end);
+	bounds[0] = begin;
+	for (unsigned int i = 1; i < numThreads; ++i) {
+		const char* p = std::max(bounds[i - 1], begin + size / numThreads * i);
+		bounds[i] = p == begin ? p : skipLine(p - 1, end);
+	}
+
+	std::vector<std::vector<std::pair<int, int>>> entries(numThreads);
+	std::vector<char> ok(numThreads, false);
+	std::vector<std::function<void()>> workers;
+	workers.reserve(numThreads);
+	for (unsigned int i = 0; i < numThreads; ++i) {
+		workers.emplace_back([&, i] {
+			// rough estimate of the number of lines
+			entries[i].reserve((bounds[i + 1] - bounds[i]) / 8);
+			ok[i] = parseEdgeLines(bounds[i], bounds[i + 1], entries[i]);
+		});
+	}
+
+	Array<Thread> threads(numThreads - 1);
+	for (unsigned int i = 1; i < numThreads; ++i) {
+		threads[i - 1] = Thread(workers[i]);
+	}
+	workers[0]();
+	for (Thread& t : threads) {
+		t.join();
+	}
+
+	if (std::find(ok.begin(), ok.end(), false) != ok.end()) {
+		Logger::slout() << context << ": Malformed line, expected two integer ids.\n";
+		return false;
+	}
+
+	// number the ids in the order of their first occurrence
+	size_t numEntries = 0;
+	int minId = std::numeric_limits<int>::max();
+	int maxId = std::numeric_limits<int>::min();
+	for (const auto& chunk : entries) {
+		numEntries += chunk.size();
+		for (const auto& entry : chunk) {
+			Math::updateMin(minId, std::min(entry.first, entry.second));
+			Math::updateMax(maxId, std::max(entry.first, entry.second));
+		}
+	}
+
+	int n = 0;
+	std::vector<int> denseIndex;
+	std::unordered_map<int, int> sparseIndex;
+	const bool dense = numEntries > 0 && int64_t(maxId) - minId < 2 * int64_t(numEntries) + 1024;
+	if (dense) {
+		denseIndex.assign(int64_t(maxId) - minId + 1, -1);
+	}
+	auto index = [&](int id) -> int {
+		int& i = dense ? denseIndex[int64_t(id) - minId] : sparseIndex.emplace(id, -1).first->second;
+		if (i < 0) {
+			i = n++;
+		}
+		return i;
+	};
+	for (auto& chunk : entries) {
+		for (auto& entry : chunk) {
+			entry.first = index(entry.first);
+			entry.second = index(entry.second);
+		}
+	}
+
+	Array<node> nodes;
+	G.newNodes(n, nodes);
+
+	std::vector<std::pair<node, node>> edges;
+	for (auto& chunk : entries) {
+		edges.reserve(chunk.size());
+		for (const auto& entry : chunk) {
+			edges.emplace_back(nodes[entry.first], nodes[entry.second]);
+		}
+		chunk.clear();
+		chunk.shrink_to_fit();
+		G.newEdges(edges.begin(), edges.end());
+		edges.clear();
+	}
+
+	return true;
+}
+
+}
+
+bool GraphIO::readMatrixMarketMapped(Graph& G, const string& filename, unsigned int numThreads) {
+	MappedFile file(filename);
+	if (!file.good()) {
+		return false;
+	}
+
+	G.clear();
+
+	// skip comments and the line containing the number of rows, columns and non zero entries
+	const char* p = file.begin();
+	while (p != file.end()) {
+		const char* q = skipBlanks(p, file.end());
+		bool sizeLine = q != file.end() && *q != '\n' && !isComment(*q);
+		p = skipLine(q, file.end());
+		if (sizeLine) {
+			break;
+		}
+	}
+
+	if (!readEdgeLines(G, p, file.end(), numThreads, "GraphIO::readMatrixMarketMapped")) {
+		return false;
+	}
+
+	makeParallelFree(G);
+	return true;
+}
+
+bool GraphIO::readEdgeListMapped(Graph& G, const string& filename, unsigned int numThreads) {
+	MappedFile file(filename);
+	if (!file.good()) {
+		return false;
+	}
+
+	G.clear();
+
+	return readEdgeLines(G, file.begin(), file.end(), numThreads, "GraphIO::readEdgeListMapped");
+}
+
+}
@@ -40,6 +40,7 @@
 #include <ogdf/fileformats/GraphIO.h>
 #include <ogdf/fileformats/GraphML.h>
 #include <ogdf/fileformats/GraphMLParser.h>
+#include <ogdf/fileformats/XmlStreamReader.h>
 
 #include <ogdf/lib/pugixml/pugixml.h>
 
@@ -50,11 +51,47 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace ogdf {
 
 
-GraphMLParser::GraphMLParser(std::istream& in) : m_error(false) {
+// Maps the id of the key defined by \p keyTag to its attribute name.
+template<typename Tag>
+static bool readKey(std::unordered_map<string, string>& attrName, const Tag& keyTag) {
+	auto idAttr = keyTag.attribute("id");
+	auto nameAttr = keyTag.attribute("attr.name");
+	auto yfilesAttr = keyTag.attribute("yfiles.type");
+
+	if (!idAttr) {
+		GraphIO::logger.lout() << "Key does not have an id attribute." << std::endl;
+		return false;
+	}
+	// Some tags in GraphML files produced by yFiles yEd have no attr.name,
+	// only a yfiles.type.
+	if (!nameAttr && !yfilesAttr) {
+		GraphIO::logger.lout() << "Key does not have an attr.name attribute." << std::endl;
+		return false;
+	}
+
+	attrName[idAttr.value()] = nameAttr ? nameAttr.value() : yfilesAttr.value();
+	return true;
+}
+
+static bool xmlError(const XmlStreamReader& xml) {
+	GraphIO::logger.lout() << "XML parser error: " << xml.error() << std::endl;
+	return false;
+}
+
+GraphMLParser::GraphMLParser(std::istream& in, bool streaming) : m_in(nullptr), m_error(false) {
+	if (streaming) {
+		m_in = &in;
+	} else {
+		loadDocument(in);
+	}
+}
+
+void GraphMLParser::loadDocument(std::istream& in) {
 	pugi::xml_parse_result result = m_xml.load(in);
 
 	if (!result) {
@@ -80,32 +117,17 @@ GraphMLParser::GraphMLParser(std::istream& in) : m_error(false) {
 	}
 
 	for (const pugi::xml_node& keyTag : root.children("key")) {
-		pugi::xml_attribute idAttr = keyTag.attribute("id");
-		pugi::xml_attribute nameAttr = keyTag.attribute("attr.name");
-		pugi::xml_attribute yfilesAttr = keyTag.attribute("yfiles.type");
-
-		if (!idAttr) {
-			GraphIO::logger.lout() << "Key does not have an id attribute." << std::endl;
+		if (!readKey(m_attrName, keyTag)) {
 			m_error = true;
 			return;
 		}
-		// Some tags in GraphML files produced by yFiles yEd have no attr.name,
-		// only a yfiles.type.
-		if (!nameAttr && !yfilesAttr) {
-			GraphIO::logger.lout() << "Key does not have an attr.name attribute." << std::endl;
-			m_error = true;
-			return;
-		}
-
-		m_attrName[idAttr.value()] = nameAttr ? nameAttr.value() : yfilesAttr.value();
 	}
 }
 
 GraphMLParser::~GraphMLParser() { }
 
-bool GraphMLParser::readData(GraphAttributes& GA, const node& v, const pugi::xml_node nodeData) {
-	pugi::xml_attribute keyId = nodeData.attribute("key");
-
+bool GraphMLParser::readData(GraphAttributes& GA, const node& v, const char* keyId,
+		const char* text) {
 	if (!keyId) {
 		GraphIO::logger.lout() << "Node data does not have a key." << std::endl;
 		return false;
@@ -113,43 +135,41 @@ bool GraphMLParser::readData(GraphAttributes& GA, const node& v, const pugi::xml
 
 	const long attrs = GA.attributes();
 
-	pugi::xml_text text = nodeData.text();
-
-	switch (graphml::toAttribute(m_attrName[keyId.value()])) {
+	switch (graphml::toAttribute(m_attrName[keyId])) {
 	case graphml::Attribute::NodeId:
 		if (attrs & GraphAttributes::nodeId) {
-			GA.idNode(v) = text.as_int();
+			GA.idNode(v) = XmlStreamReader::toInt(text);
 		}
 		break;
 	case graphml::Attribute::NodeLabel:
 		if (attrs & GraphAttributes::nodeLabel) {
-			GA.label(v) = text.get();
+			GA.label(v) = text;
 		}
 		break;
 	case graphml::Attribute::X:
 		if (attrs & GraphAttributes::nodeGraphics) {
-			GA.x(v) = text.as_double();
+			GA.x(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::Y:
 		if (attrs & GraphAttributes::nodeGraphics) {
-			GA.y(v) = text.as_double();
+			GA.y(v) = XmlStreamReader::toDouble(text);
 			;
 		}
 		break;
 	case graphml::Attribute::Width:
 		if (attrs & GraphAttributes::nodeGraphics) {
-			GA.width(v) = text.as_double();
+			GA.width(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::Height:
 		if (attrs & GraphAttributes::nodeGraphics) {
-			GA.height(v) = text.as_double();
+			GA.height(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::Size:
 		if (attrs & GraphAttributes::nodeGraphics) {
-			double size = text.as_double();
+			double size = XmlStreamReader::toDouble(text);
 
 			// We want to set a new size only if width and height was not set.
 			if (GA.height(v) == GA.width(v)) {
@@ -159,149 +179,148 @@ bool GraphMLParser::readData(GraphAttributes& GA, const node& v, const pugi::xml
 		break;
 	case graphml::Attribute::Shape:
 		if (attrs & GraphAttributes::nodeGraphics) {
-			GA.shape(v) = graphml::toShape(text.get());
+			GA.shape(v) = graphml::toShape(text);
 		}
 		break;
 	case graphml::Attribute::Z:
 		if (attrs & GraphAttributes::threeD) {
-			GA.z(v) = text.as_double();
+			GA.z(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::NodeLabelX:
 		if (attrs & GraphAttributes::nodeLabelPosition) {
-			GA.xLabel(v) = text.as_double();
+			GA.xLabel(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::NodeLabelY:
 		if (attrs & GraphAttributes::nodeLabelPosition) {
-			GA.yLabel(v) = text.as_double();
+			GA.yLabel(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::NodeLabelZ:
 		if (attrs & GraphAttributes::nodeLabelPosition && attrs & GraphAttributes::threeD) {
-			GA.zLabel(v) = text.as_double();
+			GA.zLabel(v) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case graphml::Attribute::R:
 		if (attrs & GraphAttributes::nodeStyle
-				&& !GraphIO::setColorValue(text.as_int(),
+				&& !GraphIO::setColorValue(XmlStreamReader::toInt(text),
 						[&](uint8_t val) { GA.fillColor(v).red(val); })) {
 			return false;
 		}
 		break;
 	case graphml::Attribute::G:
 		if (attrs & GraphAttributes::nodeStyle
-				&& !GraphIO::setColorValue(text.as_int(),
+				&& !GraphIO::setColorValue(XmlStreamReader::toInt(text),
 						[&](uint8_t val) { GA.fillColor(v).green(val); })) {
 			return false;
 		}
 		break;
 	case graphml::Attribute::B:
 		if (attrs & GraphAttributes::nodeStyle
-				&& !GraphIO::setColorValue(text.as_int(),
+				&& !GraphIO::setColorValue(XmlStreamReader::toInt(text),
 						[&](uint8_t val) { GA.fillColor(v).blue(val); })) {
 			return false;
 		}
 		break;
 	case graphml::Attribute::NodeFillPattern:
 		if (attrs & GraphAttributes::nodeStyle) {
-			GA.fillPattern(v) = FillPattern(text.as_int());
+			GA.fillPattern(v) = FillPattern(XmlStreamReader::toInt(text));
 		}
 		break;
 	case graphml::Attribute::NodeFillBackground:
 		if (attrs & GraphAttributes::nodeStyle) {
-			GA.fillBgColor(v) = text.get();
+			GA.fillBgColor(v) = text;
 		}
 		break;
 	case graphml::Attribute::NodeStrokeColor:
 		if (attrs & GraphAttributes::nodeStyle) {
-			GA.strokeColor(v) = text.get();
+			GA.strokeColor(v) = text;
 		}
 		break;
 	case graphml::Attribute::NodeStrokeType:
 		if (attrs & GraphAttributes::nodeStyle) {
-			GA.strokeType(v) = StrokeType(text.as_int());
+			GA.strokeType(v) = StrokeType(XmlStreamReader::toInt(text));
 		}
 		break;
 	case graphml::Attribute::NodeStrokeWidth:
 		if (attrs & GraphAttributes::nodeStyle) {
-			GA.strokeWidth(v) = text.as_float();
+			GA.strokeWidth(v) = static_cast<float>(XmlStreamReader::toDouble(text));
 		}
 		break;
 	case graphml::Attribute::NodeType:
 		if (attrs & GraphAttributes::nodeType) {
-			GA.type(v) = Graph::NodeType(text.as_int());
+			GA.type(v) = Graph::NodeType(XmlStreamReader::toInt(text));
 		}
 		break;
 	case graphml::Attribute::Template:
 		if (attrs & GraphAttributes::nodeTemplate) {
-			GA.templateNode(v) = text.get();
+			GA.templateNode(v) = text;
 		}
 		break;
 	case graphml::Attribute::NodeWeight:
 		if (attrs & GraphAttributes::nodeWeight) {
-			GA.weight(v) = text.as_int();
+			GA.weight(v) = XmlStreamReader::toInt(text);
 		}
 		break;
 	default:
 		GraphIO::logger.lout(Logger::Level::Minor)
-				<< "Unknown node attribute: \"" << keyId.value() << "\"." << std::endl;
+				<< "Unknown node attribute: \"" << keyId << "\"." << std::endl;
 	}
 
 	return true;
 }
 
-bool GraphMLParser::readData(GraphAttributes& GA, const edge& e, const pugi::xml_node edgeData) {
-	pugi::xml_attribute keyId = edgeData.attribute("key");
+bool GraphMLParser::readData(GraphAttributes& GA, const edge& e, const char* keyId,
+		const char* text) {
 	if (!keyId) {
 		GraphIO::logger.lout() << "Edge data does not have a key." << std::endl;
 		return false;
 	}
 
 	const long attrs = GA.attributes();
-	pugi::xml_text text = edgeData.text();
 
-	switch (graphml::toAttribute(m_attrName[keyId.value()])) {
+	switch (graphml::toAttribute(m_attrName[keyId])) {
 	case graphml::Attribute::EdgeLabel:
 		if (attrs & GraphAttributes::edgeLabel) {
-			GA.label(e) = text.get();
+			GA.label(e) = text;
 		}
 		break;
 	case graphml::Attribute::EdgeWeight:
 		if (attrs & GraphAttributes::edgeDoubleWeight) {
-			GA.doubleWeight(e) = text.as_double();
+			GA.doubleWeight(e) = XmlStreamReader::toDouble(text);
 		} else if (attrs & GraphAttributes::edgeIntWeight) {
-			GA.intWeight(e) = text.as_int();
+			GA.intWeight(e) = XmlStreamReader::toInt(text);
 		}
 		break;
 	case graphml::Attribute::EdgeType:
 		if (attrs & GraphAttributes::edgeType) {
-			GA.type(e) = graphml::toEdgeType(text.get());
+			GA.type(e) = graphml::toEdgeType(text);
 		}
 		break;
 	case graphml::Attribute::EdgeArrow:
 		if (attrs & GraphAttributes::edgeArrow) {
-			GA.arrowType(e) = graphml::toArrow(text.get());
+			GA.arrowType(e) = graphml::toArrow(text);
 		}
 		break;
 	case graphml::Attribute::EdgeStrokeColor:
 		if (attrs & GraphAttributes::edgeStyle) {
-			GA.strokeColor(e) = text.get();
+			GA.strokeColor(e) = text;
 		}
 		break;
 	case graphml::Attribute::EdgeStrokeType:
 		if (attrs & GraphAttributes::edgeStyle) {
-			GA.strokeType(e) = StrokeType(text.as_int());
+			GA.strokeType(e) = StrokeType(XmlStreamReader::toInt(text));
 		}
 		break;
 	case graphml::Attribute::EdgeStrokeWidth:
 		if (attrs & GraphAttributes::edgeStyle) {
-			GA.strokeWidth(e) = text.as_float();
+			GA.strokeWidth(e) = static_cast<float>(XmlStreamReader::toDouble(text));
 		}
 		break;
 	case graphml::Attribute::EdgeBends:
 		if (attrs & GraphAttributes::edgeGraphics) {
-			std::stringstream is(text.get());
+			std::stringstream is(text);
 			double x, y;
 			DPolyline& polyline = GA.bends(e);
 			polyline.clear();
@@ -312,7 +331,7 @@ bool GraphMLParser::readData(GraphAttributes& GA, const edge& e, const pugi::xml
 		break;
 	case graphml::Attribute::EdgeSubGraph:
 		if (attrs & GraphAttributes::edgeSubGraphs) {
-			std::stringstream sstream(text.get());
+			std::stringstream sstream(text);
 			int sg;
 			while (sstream >> sg) {
 				GA.addSubGraph(e, sg);
@@ -321,67 +340,67 @@ bool GraphMLParser::readData(GraphAttributes& GA, const edge& e, const pugi::xml
 		break;
 	default:
 		GraphIO::logger.lout(Logger::Level::Minor)
-				<< "Unknown edge attribute with \"" << keyId.value() << "\"." << std::endl;
+				<< "Unknown edge attribute with \"" << keyId << "\"." << std::endl;
 	}
 
 	return true;
 }
 
-bool GraphMLParser::readData(ClusterGraphAttributes& CA, const cluster& c,
-		const pugi::xml_node clusterData) {
-	auto keyId = clusterData.attribute("key");
+bool GraphMLParser::readData(ClusterGraphAttributes& CA, const cluster& c, const char* keyId,
+		const char* text) {
 	if (!keyId) {
 		GraphIO::logger.lout() << "Cluster data does not have a key." << std::endl;
 		return false;
 	}
 
-	pugi::xml_text text = clusterData.text();
-
 	using namespace graphml;
-	switch (toAttribute(m_attrName[keyId.value()])) {
+	switch (toAttribute(m_attrName[keyId])) {
 	case Attribute::NodeLabel:
-		CA.label(c) = text.get();
+		CA.label(c) = text;
 		break;
 	case Attribute::X:
-		CA.x(c) = text.as_double();
+		CA.x(c) = XmlStreamReader::toDouble(text);
 		break;
 	case Attribute::Y:
-		CA.y(c) = text.as_double();
+		CA.y(c) = XmlStreamReader::toDouble(text);
 		break;
 	case Attribute::Width:
-		CA.width(c) = text.as_double();
+		CA.width(c) = XmlStreamReader::toDouble(text);
 		break;
 	case Attribute::Height:
-		CA.height(c) = text.as_double();
+		CA.height(c) = XmlStreamReader::toDouble(text);
 		break;
 	case Attribute::Size:
 		// We want to set a new size only if width and height was not set.
 		if (CA.width(c) == CA.height(c)) {
-			CA.width(c) = CA.height(c) = text.as_double();
+			CA.width(c) = CA.height(c) = XmlStreamReader::toDouble(text);
 		}
 		break;
 	case Attribute::R:
-		if (!GraphIO::setColorValue(text.as_int(), [&](uint8_t val) { CA.fillColor(c).red(val); })) {
+		if (!GraphIO::setColorValue(XmlStreamReader::toInt(text),
+				[&](uint8_t val) { CA.fillColor(c).red(val); })) {
 			return false;
 		}
 		break;
 	case Attribute::G:
-		if (!GraphIO::setColorValue(text.as_int(), [&](uint8_t val) { CA.fillColor(c).green(val); })) {
+		if (!GraphIO::setColorValue(XmlStreamReader::toInt(text),
+				[&](uint8_t val) { CA.fillColor(c).green(val); })) {
 			return false;
 		}
 		break;
 	case Attribute::B:
-		if (!GraphIO::setColorValue(text.as_int(), [&](uint8_t val) { CA.fillColor(c).blue(val); })) {
+		if (!GraphIO::setColorValue(XmlStreamReader::toInt(text),
+				[&](uint8_t val) { CA.fillColor(c).blue(val); })) {
 			return false;
 		}
 		break;
 	case Attribute::ClusterStroke:
-		CA.strokeColor(c) = text.get();
+		CA.strokeColor(c) = text;
 		break;
 	default:
 		GraphIO::logger.lout(Logger::Level::Minor)
-				<< "Unknown cluster attribute with \"" << keyId.value()
-				<< "--enum: " << m_attrName[keyId.value()] << "--"
+				<< "Unknown cluster attribute with \"" << keyId
+				<< "--enum: " << m_attrName[keyId] << "--"
 				<< "\"." << std::endl;
 	}
 
@@ -494,7 +513,226 @@ bool GraphMLParser::readClusters(Graph& G, ClusterGraph& C, ClusterGraphAttribut
 	return readEdges(G, CA, rootTag);
 }
 
+bool GraphMLParser::readStreaming(Graph& G, GraphAttributes* GA) {
+	OGDF_ASSERT(m_in);
+	XmlStreamReader xml(*m_in);
+	m_in = nullptr;
+
+	G.clear();
+	m_nodeId.clear();
+	m_attrName.clear();
+	m_pendingEdges.clear();
+
+	XmlStreamReader::Token token = xml.next();
+	if (token == XmlStreamReader::Token::Error) {
+		return xmlError(xml);
+	}
+	if (token != XmlStreamReader::Token::StartElement || string(xml.name()) != "graphml") {
+		GraphIO::logger.lout() << "File root tag is not a <graphml>." << std::endl;
+		return false;
+	}
+
+	// Only the first graph is read, like in the document based reader.
+	bool graphFound = false;
+	while ((token = xml.next()) != XmlStreamReader::Token::EndElement) {
+		if (token == XmlStreamReader::Token::Error) {
+			return xmlError(xml);
+		}
+		if (token != XmlStreamReader::Token::StartElement) {
+			continue;
+		}
+
+		const string name = xml.name();
+		if (name == "key") {
+			if (!readKey(m_attrName, xml)) {
+				return false;
+			}
+			if (!xml.skipElement()) {
+				return xmlError(xml);
+			}
+		} else if (name == "graph" && !graphFound) {
+			graphFound = true;
+			if (GA) {
+				// Check whether graph is directed or not (directed by default).
+				auto edgeDefaultAttr = xml.attribute("edgedefault");
+				GA->directed() =
+						(!edgeDefaultAttr || string(edgeDefaultAttr.value()) == "directed");
+			}
+			if (!readGraph(xml, G, GA)) {
+				return false;
+			}
+		} else if (!xml.skipElement()) {
+			return xmlError(xml);
+		}
+	}
+
+	if (!graphFound) {
+		GraphIO::logger.lout() << "<graph> tag not found." << std::endl;
+		return false;
+	}
+
+	return readPendingEdges(G, GA);
+}
+
+bool GraphMLParser::readGraph(XmlStreamReader& xml, Graph& G, GraphAttributes* GA) {
+	for (;;) {
+		switch (xml.next()) {
+		case XmlStreamReader::Token::StartElement:
+			if (string(xml.name()) == "node") {
+				if (!readNode(xml, G, GA)) {
+					return false;
+				}
+			} else if (string(xml.name()) == "edge") {
+				if (!readEdge(xml, G, GA)) {
+					return false;
+				}
+			} else if (!xml.skipElement()) {
+				return xmlError(xml);
+			}
+			break;
+		case XmlStreamReader::Token::EndElement:
+			return true;
+		case XmlStreamReader::Token::Text:
+			break;
+		default:
+			return xmlError(xml);
+		}
+	}
+}
+
+bool GraphMLParser::readNode(XmlStreamReader& xml, Graph& G, GraphAttributes* GA) {
+	auto idAttr = xml.attribute("id");
+	if (!idAttr) {
+		GraphIO::logger.lout() << "Node is missing id attribute." << std::endl;
+		return false;
+	}
+
+	const node v = G.newNode();
+	m_nodeId[idAttr.value()] = v;
+
+	string key, text;
+	for (;;) {
+		switch (xml.next()) {
+		case XmlStreamReader::Token::StartElement:
+			if (GA && string(xml.name()) == "data") {
+				auto keyAttr = xml.attribute("key");
+				key = keyAttr.value();
+				if (!xml.readText(text)) {
+					return xmlError(xml);
+				}
+				if (!readData(*GA, v, keyAttr ? key.c_str() : nullptr, text.c_str())) {
+					return false;
+				}
+			} else if (string(xml.name()) == "graph") {
+				GraphIO::logger.lout(Logger::Level::Minor)
+						<< "Nested graphs are not fully supported." << std::endl;
+				if (!readGraph(xml, G, GA)) {
+					return false;
+				}
+			} else if (!xml.skipElement()) {
+				return xmlError(xml);
+			}
+			break;
+		case XmlStreamReader::Token::EndElement:
+			return true;
+		case XmlStreamReader::Token::Text:
+			break;
+		default:
+			return xmlError(xml);
+		}
+	}
+}
+
+bool GraphMLParser::readEdge(XmlStreamReader& xml, Graph& G, GraphAttributes* GA) {
+	auto sourceId = xml.attribute("source");
+	auto targetId = xml.attribute("target");
+
+	if (!sourceId) {
+		GraphIO::logger.lout() << "Edge is missing source node." << std::endl;
+		return false;
+	}
+	if (!targetId) {
+		GraphIO::logger.lout() << "Edge is missing target node." << std::endl;
+		return false;
+	}
+
+	PendingEdge pending {sourceId.value(), targetId.value(), {}};
+
+	// The data is collected first since the endpoints might not exist yet.
+	string text;
+	for (;;) {
+		XmlStreamReader::Token token = xml.next();
+		if (token == XmlStreamReader::Token::EndElement) {
+			break;
+		} else if (token == XmlStreamReader::Token::StartElement) {
+			if (GA && string(xml.name()) == "data") {
+				auto keyAttr = xml.attribute("key");
+				if (!keyAttr) {
+					GraphIO::logger.lout() << "Edge data does not have a key." << std::endl;
+					return false;
+				}
+				string key = keyAttr.value();
+				if (!xml.readText(text)) {
+					return xmlError(xml);
+				}
+				pending.data.emplace_back(std::move(key), text);
+			} else if (!xml.skipElement()) {
+				return xmlError(xml);
+			}
+		} else if (token != XmlStreamReader::Token::Text) {
+			return xmlError(xml);
+		}
+	}
+
+	auto sourceIt = m_nodeId.find(pending.source);
+	auto targetIt = m_nodeId.find(pending.target);
+	if (sourceIt == m_nodeId.end() || targetIt == m_nodeId.end()) {
+		m_pendingEdges.push_back(std::move(pending));
+		return true;
+	}
+
+	const edge e = G.newEdge(sourceIt->second, targetIt->second);
+	for (const auto& data : pending.data) {
+		if (!readData(*GA, e, data.first.c_str(), data.second.c_str())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool GraphMLParser::readPendingEdges(Graph& G, GraphAttributes* GA) {
+	for (const PendingEdge& pending : m_pendingEdges) {
+		auto sourceIt = m_nodeId.find(pending.source);
+		if (sourceIt == std::end(m_nodeId)) {
+			GraphIO::logger.lout()
+					<< "Edge source node \"" << pending.source << "\" is incorrect.\n" << std::endl;
+			return false;
+		}
+
+		auto targetIt = m_nodeId.find(pending.target);
+		if (targetIt == std::end(m_nodeId)) {
+			GraphIO::logger.lout()
+					<< "Edge target node \"" << pending.target << "\" is incorrect.\n" << std::endl;
+			return false;
+		}
+
+		const edge e = G.newEdge(sourceIt->second, targetIt->second);
+		for (const auto& data : pending.data) {
+			if (!readData(*GA, e, data.first.c_str(), data.second.c_str())) {
+				return false;
+			}
+		}
+	}
+	m_pendingEdges.clear();
+
+	return true;
+}
+
 bool GraphMLParser::read(Graph& G) {
+	if (m_in) {
+		return readStreaming(G, nullptr);
+	}
 	if (m_error) {
 		return false;
 	}
@@ -506,6 +744,10 @@ bool GraphMLParser::read(Graph& G) {
 }
 
 bool GraphMLParser::read(Graph& G, GraphAttributes& GA) {
+	if (m_in) {
+		return readStreaming(G, &GA);
+	}
+
 	// Check whether graph is directed or not (directed by default).
 	pugi::xml_attribute edgeDefaultAttr = m_graphTag.attribute("edgedefault");
 	GA.directed() = (!edgeDefaultAttr || string(edgeDefaultAttr.value()) == "directed");
@@ -521,6 +763,10 @@ bool GraphMLParser::read(Graph& G, GraphAttributes& GA) {
 }
 
 bool GraphMLParser::read(Graph& G, ClusterGraph& C) {
+	if (m_in) {
+		loadDocument(*m_in);
+		m_in = nullptr;
+	}
 	if (m_error) {
 		return false;
 	}
@@ -532,6 +778,10 @@ bool GraphMLParser::read(Graph& G, ClusterGraph& C) {
 }
 
 bool GraphMLParser::read(Graph& G, ClusterGraph& C, ClusterGraphAttributes& CA) {
+	if (m_in) {
+		loadDocument(*m_in);
+		m_in = nullptr;
+	}
 	if (m_error) {
 		return false;
 	}
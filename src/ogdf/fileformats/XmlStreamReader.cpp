@@ -0,0 +1,480 @@
+/** \file
+ * \brief Implementation of an incremental pull parser for XML documents.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/basic.h>
+#include <ogdf/fileformats/XmlStreamReader.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace ogdf {
+
+namespace {
+
+inline bool isWhitespace(int c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+inline bool isNameEnd(int c) {
+	return c < 0 || isWhitespace(c) || c == '/' || c == '>' || c == '=' || c == '?';
+}
+
+inline bool isWhitespaceOnly(const string& s) {
+	return std::all_of(s.begin(), s.end(), [](char c) { return isWhitespace(c); });
+}
+
+//! Appends the UTF-8 encoding of \p code to \p out.
+void appendUtf8(string& out, uint32_t code) {
+	if (code < 0x80) {
+		out += static_cast<char>(code);
+	} else if (code < 0x800) {
+		out += static_cast<char>(0xC0 | (code >> 6));
+		out += static_cast<char>(0x80 | (code & 0x3F));
+	} else if (code < 0x10000) {
+		out += static_cast<char>(0xE0 | (code >> 12));
+		out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (code & 0x3F));
+	} else {
+		out += static_cast<char>(0xF0 | (code >> 18));
+		out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+		out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+		out += static_cast<char>(0x80 | (code & 0x3F));
+	}
+}
+
+}
+
+XmlStreamReader::XmlStreamReader(std::istream& is, size_t chunkSize)
+	: m_is(is), m_chunkSize(std::max<size_t>(chunkSize, 16)) { }
+
+int XmlStreamReader::toInt(const char* s) {
+	while (isWhitespace(*s)) {
+		++s;
+	}
+	bool negative = *s == '-';
+	const char* digits = negative || *s == '+' ? s + 1 : s;
+	int base = 10;
+	if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')) {
+		digits += 2;
+		base = 16;
+	}
+	unsigned long long value = std::strtoull(digits, nullptr, base);
+	if (negative) {
+		return value > static_cast<unsigned long long>(INT_MAX) + 1
+				? INT_MIN
+				: static_cast<int>(-static_cast<long long>(value));
+	}
+	return value > static_cast<unsigned long long>(INT_MAX) ? INT_MAX : static_cast<int>(value);
+}
+
+double XmlStreamReader::toDouble(const char* s) { return std::strtod(s, nullptr); }
+
+XmlStreamReader::Attribute XmlStreamReader::attribute(const char* attrName) const {
+	for (size_t i = 0; i < m_numAttributes; ++i) {
+		if (m_attributes[i].first == attrName) {
+			return Attribute(&m_attributes[i].second);
+		}
+	}
+	return Attribute();
+}
+
+bool XmlStreamReader::fill(size_t n) {
+	while (m_buffer.size() - m_pos < n && !m_eof) {
+		// drop the consumed part so that the buffer stays small
+		m_buffer.erase(0, m_pos);
+		m_pos = 0;
+
+		size_t size = m_buffer.size();
+		m_buffer.resize(size + m_chunkSize);
+		m_is.read(&m_buffer[size], m_chunkSize);
+		size_t count = static_cast<size_t>(m_is.gcount());
+		m_buffer.resize(size + count);
+		m_eof = count < m_chunkSize;
+	}
+	return m_buffer.size() - m_pos >= n;
+}
+
+bool XmlStreamReader::startsWith(const char* prefix, size_t length) {
+	return fill(length) && m_buffer.compare(m_pos, length, prefix) == 0;
+}
+
+void XmlStreamReader::skipWhitespace() {
+	for (int c = peek(); isWhitespace(c); c = peek()) {
+		if (c == '\n') {
+			++m_line;
+		}
+		++m_pos;
+	}
+}
+
+void XmlStreamReader::readName(string& name) {
+	name.clear();
+	for (int c = peek(); !isNameEnd(c); c = peek()) {
+		name += static_cast<char>(c);
+		++m_pos;
+	}
+}
+
+void XmlStreamReader::readReference(string& out) {
+	OGDF_ASSERT(m_buffer[m_pos] == '&');
+
+	// the longest reference we decode is "&#x10FFFF;"
+	fill(12);
+	const char* semicolon = static_cast<const char*>(
+			memchr(m_buffer.data() + m_pos, ';', std::min<size_t>(12, m_buffer.size() - m_pos)));
+	size_t length = semicolon == nullptr ? 0 : semicolon - (m_buffer.data() + m_pos) + 1;
+	if (length < 3) {
+		out += '&';
+		++m_pos;
+		return;
+	}
+
+	const char* ref = m_buffer.data() + m_pos + 1;
+	size_t refLength = length - 2;
+	auto is = [&](const char* entity) {
+		return refLength == strlen(entity) && strncmp(ref, entity, refLength) == 0;
+	};
+
+	if (is("lt")) {
+		out += '<';
+	} else if (is("gt")) {
+		out += '>';
+	} else if (is("amp")) {
+		out += '&';
+	} else if (is("quot")) {
+		out += '"';
+	} else if (is("apos")) {
+		out += '\'';
+	} else if (ref[0] == '#') {
+		bool hex = ref[1] == 'x';
+		const char* digits = ref + (hex ? 2 : 1);
+		char* end;
+		unsigned long code = std::strtoul(digits, &end, hex ? 16 : 10);
+		if (end != ref + refLength || end == digits || code > 0x10FFFF) {
+			out += '&';
+			++m_pos;
+			return;
+		}
+		appendUtf8(out, static_cast<uint32_t>(code));
+	} else {
+		// unknown entities are kept as they are
+		out += '&';
+		++m_pos;
+		return;
+	}
+	m_pos += length;
+}
+
+bool XmlStreamReader::readCharData(string& out, char quote) {
+	const char stop = quote ? quote : '<';
+	for (;;) {
+		if (m_pos == m_buffer.size() && !fill(1)) {
+			return quote == 0;
+		}
+
+		const char* begin = m_buffer.data() + m_pos;
+		const char* end = m_buffer.data() + m_buffer.size();
+		const char* p = begin;
+		while (p != end && *p != stop && *p != '&' && *p != '\r') {
+			++p;
+		}
+
+		size_t start = out.size();
+		out.append(begin, p);
+		for (size_t i = start; i < out.size(); ++i) {
+			if (out[i] == '\n') {
+				++m_line;
+				if (quote) {
+					out[i] = ' ';
+				}
+			} else if (quote && out[i] == '\t') {
+				out[i] = ' ';
+			}
+		}
+		m_pos += p - begin;
+
+		if (p == end) {
+			continue;
+		}
+		if (*p == stop) {
+			if (quote) {
+				++m_pos;
+			}
+			return true;
+		}
+		if (*p == '\r') {
+			// "\r\n" and a single '\r' both become a line break
+			++m_pos;
+			if (peek() == '\n') {
+				++m_pos;
+			}
+			++m_line;
+			out += quote ? ' ' : '\n';
+		} else {
+			readReference(out);
+		}
+	}
+}
+
+bool XmlStreamReader::skipPast(const char* delim, string* out) {
+	const size_t length = strlen(delim);
+	for (;;) {
+		size_t found = m_buffer.find(delim, m_pos);
+		size_t upto = found != string::npos ? found : m_buffer.size();
+		if (found == string::npos) {
+			// keep a possible prefix of the delimiter for the next round
+			upto -= std::min(length - 1, upto - m_pos);
+		}
+
+		m_line += static_cast<int>(
+				std::count(m_buffer.begin() + m_pos, m_buffer.begin() + upto, '\n'));
+		if (out) {
+			out->append(m_buffer, m_pos, upto - m_pos);
+		}
+		m_pos = upto;
+
+		if (found != string::npos) {
+			m_pos += length;
+			return true;
+		}
+		if (!fill(m_buffer.size() - m_pos + 1)) {
+			return false;
+		}
+	}
+}
+
+bool XmlStreamReader::skipDoctype() {
+	// skips "<!DOCTYPE ...>" including an internal subset in brackets
+	int brackets = 0;
+	for (int c = peek(); c >= 0; c = peek()) {
+		++m_pos;
+		if (c == '\n') {
+			++m_line;
+		} else if (c == '[') {
+			++brackets;
+		} else if (c == ']') {
+			--brackets;
+		} else if (c == '>' && brackets <= 0) {
+			return true;
+		} else if (c == '"' || c == '\'') {
+			const char quote[2] = {static_cast<char>(c), '\0'};
+			if (!skipPast(quote)) {
+				return false;
+			}
+		}
+	}
+	return false;
+}
+
+XmlStreamReader::Token XmlStreamReader::fail(const string& msg) {
+	m_error = msg + " (line " + std::to_string(m_line) + ")";
+	m_done = true;
+	return Token::Error;
+}
+
+XmlStreamReader::Token XmlStreamReader::readStartTag() {
+	++m_pos; // '<'
+	readName(m_name);
+	if (m_name.empty()) {
+		return fail("Invalid start tag");
+	}
+
+	m_numAttributes = 0;
+	for (;;) {
+		skipWhitespace();
+		int c = peek();
+		if (c == '>') {
+			++m_pos;
+			break;
+		}
+		if (c == '/') {
+			++m_pos;
+			if (peek() != '>') {
+				return fail("Expected '>' after '/' in <" + m_name + ">");
+			}
+			++m_pos;
+			m_closeEmptyElement = true;
+			break;
+		}
+		if (c < 0) {
+			return fail("Unexpected end of document in <" + m_name + ">");
+		}
+
+		if (m_numAttributes == m_attributes.size()) {
+			m_attributes.emplace_back();
+		}
+		auto& attr = m_attributes[m_numAttributes++];
+		readName(attr.first);
+		skipWhitespace();
+		if (attr.first.empty() || peek() != '=') {
+			return fail("Invalid attribute in <" + m_name + ">");
+		}
+		++m_pos;
+		skipWhitespace();
+		c = peek();
+		if (c != '"' && c != '\'') {
+			return fail("Expected quoted value of attribute \"" + attr.first + "\"");
+		}
+		++m_pos;
+		attr.second.clear();
+		if (!readCharData(attr.second, static_cast<char>(c))) {
+			return fail("Unterminated value of attribute \"" + attr.first + "\"");
+		}
+	}
+
+	m_openElements.push_back(m_name);
+	m_seenDocumentElement = true;
+	return Token::StartElement;
+}
+
+XmlStreamReader::Token XmlStreamReader::readEndTag() {
+	m_pos += 2; // "</"
+	readName(m_name);
+	skipWhitespace();
+	if (peek() != '>') {
+		return fail("Expected '>' in end tag </" + m_name + ">");
+	}
+	++m_pos;
+
+	if (m_openElements.empty() || m_openElements.back() != m_name) {
+		return fail("End tag </" + m_name + "> does not match start tag"
+				+ (m_openElements.empty() ? string() : " <" + m_openElements.back() + ">"));
+	}
+	m_openElements.pop_back();
+	return Token::EndElement;
+}
+
+XmlStreamReader::Token XmlStreamReader::next() {
+	if (m_done) {
+		return m_error.empty() ? Token::EndOfDocument : Token::Error;
+	}
+	if (m_closeEmptyElement) {
+		m_closeEmptyElement = false;
+		m_name = m_openElements.back();
+		m_openElements.pop_back();
+		return Token::EndElement;
+	}
+
+	for (;;) {
+		int c = peek();
+		if (c < 0) {
+			if (!m_openElements.empty()) {
+				return fail("Unexpected end of document in <" + m_openElements.back() + ">");
+			}
+			if (!m_seenDocumentElement) {
+				return fail("No document element");
+			}
+			m_done = true;
+			return Token::EndOfDocument;
+		}
+
+		if (c != '<') {
+			m_text.clear();
+			m_cdata = false;
+			readCharData(m_text, 0);
+			if (!m_openElements.empty()) {
+				return Token::Text;
+			}
+			if (!isWhitespaceOnly(m_text)) {
+				return fail("Text outside of the document element");
+			}
+			continue;
+		}
+
+		if (startsWith("<?", 2)) {
+			if (!skipPast("?>")) {
+				return fail("Unterminated processing instruction");
+			}
+		} else if (startsWith("<!--", 4)) {
+			if (!skipPast("-->")) {
+				return fail("Unterminated comment");
+			}
+		} else if (startsWith("<![CDATA[", 9)) {
+			m_pos += 9;
+			m_text.clear();
+			m_cdata = true;
+			if (!skipPast("]]>", &m_text)) {
+				return fail("Unterminated CDATA section");
+			}
+			if (m_openElements.empty()) {
+				return fail("CDATA section outside of the document element");
+			}
+			return Token::Text;
+		} else if (startsWith("<!", 2)) {
+			if (!skipDoctype()) {
+				return fail("Unterminated document type declaration");
+			}
+		} else if (startsWith("</", 2)) {
+			return readEndTag();
+		} else {
+			return readStartTag();
+		}
+	}
+}
+
+bool XmlStreamReader::skipElement() {
+	const int d = depth();
+	while (depth() >= d) {
+		Token token = next();
+		if (token == Token::Error || token == Token::EndOfDocument) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool XmlStreamReader::readText(string& text) {
+	text.clear();
+	bool found = false;
+	const int d = depth();
+	while (depth() >= d) {
+		switch (next()) {
+		case Token::Text:
+			if (!found && depth() == d && (m_cdata || !isWhitespaceOnly(m_text))) {
+				text = m_text;
+				found = true;
+			}
+			break;
+		case Token::StartElement:
+			if (!skipElement()) {
+				return false;
+			}
+			break;
+		case Token::EndElement:
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+}
@@ -30,12 +30,14 @@
  */
 
 
+#include <ogdf/basic/CompactGraph.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/graphalg/PageRank.h>
 
 #include <algorithm>
 #include <cmath>
 #include <utility>
+#include <vector>
 
 namespace ogdf {
 
@@ -116,4 +118,67 @@ void BasicPageRank::call(const Graph& graph, const EdgeArray<double>& edgeWeight
 	// result is now between 0 and 1
 }
 
+void BasicPageRank::call(const CompactGraph& graph, const EdgeArray<double>& edgeWeight,
+		NodeArray<double>& pageRankResult) {
+	const int n = graph.numberOfNodes();
+	const double initialPageRank = 1.0 / (double)n;
+	const double maxPageRankDeltaBound = initialPageRank * m_threshold;
+	const std::vector<int>& nodes = graph.nodes();
+
+	// the two ping pong buffers, indexed by node index
+	std::vector<double> currPageRank(graph.maxNodeIndex() + 1, initialPageRank);
+	std::vector<double> nextPageRank(graph.maxNodeIndex() + 1, 0.0);
+
+	std::vector<double> nodeNorm(graph.maxNodeIndex() + 1, 0.0);
+	for (int v : nodes) {
+		double sum = 0.0;
+		for (int i = graph.firstAdj(v); i < graph.stopAdj(v); ++i) {
+			sum += edgeWeight[graph.edgeIndex(i)];
+		}
+		nodeNorm[v] = 1.0 / sum;
+	}
+
+	// main iteration loop
+	int numIterations = 0;
+	bool converged = false;
+	while (!converged && (numIterations < m_maxNumIterations)) {
+		for (int v : nodes) {
+			nextPageRank[v] = (1.0 - m_dampingFactor) / (double)n;
+		}
+		// every edge appears once in the adjacency slots of each of its end points,
+		// hence pushing along all slots equals the transfer in both directions
+		for (int v : nodes) {
+			const double out = nodeNorm[v] * currPageRank[v];
+			for (int i = graph.firstAdj(v); i < graph.stopAdj(v); ++i) {
+				nextPageRank[graph.twinNode(i)] += edgeWeight[graph.edgeIndex(i)] * out;
+			}
+		}
+
+		// damping and calculating change
+		double maxPageRankDelta = 0.0;
+		for (int v : nodes) {
+			nextPageRank[v] *= m_dampingFactor;
+			maxPageRankDelta = std::max(maxPageRankDelta, fabs(nextPageRank[v] - currPageRank[v]));
+		}
+
+		std::swap(nextPageRank, currPageRank);
+		numIterations++;
+
+		converged = (maxPageRankDelta < maxPageRankDeltaBound);
+	}
+
+	// normalization
+	double maxPageRank = currPageRank[nodes.front()];
+	double minPageRank = currPageRank[nodes.front()];
+	for (int v : nodes) {
+		maxPageRank = std::max(maxPageRank, currPageRank[v]);
+		minPageRank = std::min(minPageRank, currPageRank[v]);
+	}
+
+	pageRankResult.init(graph.constGraph());
+	for (int v : nodes) {
+		pageRankResult[v] = (currPageRank[v] - minPageRank) / (maxPageRank - minPageRank);
+	}
+}
+
 }
@@ -29,7 +29,6 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
-#include <ogdf/basic/Array.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/layered/BarycenterHeuristic.h>
 #include <ogdf/layered/HierarchyLevels.h>
@@ -38,18 +37,16 @@
 namespace ogdf {
 
 void BarycenterHeuristic::call(Level& L) {
-	const HierarchyLevels& levels = L.levels();
+	const LevelAdjacency& adj = L.adjPositions();
 
 	for (int i = 0; i <= L.high(); ++i) {
-		node v = L[i];
 		long sumpos = 0L;
-
-		const Array<node>& adjNodes = L.adjNodes(v);
-		for (int j = 0; j <= adjNodes.high(); ++j) {
-			sumpos += levels.pos(adjNodes[j]);
+		for (const int* p = adj.begin(i); p != adj.end(i); ++p) {
+			sumpos += *p;
 		}
 
-		m_weight[v] = (adjNodes.high() < 0) ? 0.0 : double(sumpos) / double(adjNodes.size());
+		const int deg = adj.degree(i);
+		m_weight[L[i]] = (deg == 0) ? 0.0 : double(sumpos) / double(deg);
 	}
 
 	L.sort(m_weight);
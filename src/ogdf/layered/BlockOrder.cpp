@@ -758,6 +758,8 @@ void BlockOrder::buildAdjNodes() {
 			}
 		}
 	}
+
+	invalidateCrossings();
 }
 
 int BlockOrder::localCountCrossings(const Array<int>& levels) {
@@ -856,6 +858,7 @@ int BlockOrder::localCountCrossings(const Array<int>& levels) {
 			}
 		}
 	}
+	invalidateCrossings();
 	return calculateCrossings();
 }
 
@@ -31,8 +31,13 @@
 
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/Graph.h>
+#include <ogdf/basic/Thread.h>
+#include <ogdf/basic/basic.h>
 #include <ogdf/layered/CrossingMinInterfaces.h>
 
+#include <atomic>
+#include <cstdint>
+
 namespace ogdf {
 
 // calculation of edge crossings between level i and i+1
@@ -88,13 +93,79 @@ int HierarchyLevelsBase::calculateCrossings(int i) const {
 }
 
 int HierarchyLevelsBase::calculateCrossings() const {
+	Array<int> pairs(max(0, this->high()));
+	for (int i = 0; i < pairs.size(); ++i) {
+		pairs[i] = i;
+	}
+
+	Array<int> crossings(pairs.size());
+	calculateCrossings(pairs, crossings);
+
 	int nCrossings = 0;
+	for (int nc : crossings) {
+		nCrossings += nc;
+	}
 
-	for (int i = 0; i < this->high(); ++i) {
-		nCrossings += calculateCrossings(i);
+	return nCrossings;
+}
+
+int HierarchyLevelsBase::updateCrossings() {
+	const int nPairs = max(0, this->high());
+
+	if (m_pairChanged.size() != nPairs) {
+		m_pairCrossings.init(nPairs);
+		m_pairChanged.init(0, nPairs - 1, true);
+	}
+
+	int nChanged = 0;
+	for (bool changed : m_pairChanged) {
+		nChanged += changed;
+	}
+
+	Array<int> pairs(nChanged);
+	for (int i = 0, k = 0; i < nPairs; ++i) {
+		if (m_pairChanged[i]) {
+			pairs[k++] = i;
+			m_pairChanged[i] = false;
+		}
+	}
+	calculateCrossings(pairs, m_pairCrossings);
+
+	int nCrossings = 0;
+	for (int nc : m_pairCrossings) {
+		nCrossings += nc;
 	}
 
 	return nCrossings;
 }
 
+void HierarchyLevelsBase::calculateCrossings(const Array<int>& pairs, Array<int>& crossings) const {
+	// only start another thread for every few thousand nodes
+	const int64_t minNodesPerThread = 4096;
+
+	int64_t nNodes = 0;
+	for (int i : pairs) {
+		nNodes += (*this)[i].size() + (*this)[i + 1].size();
+	}
+	const unsigned int nThreads = static_cast<unsigned int>(
+			min<int64_t>(m_maxThreads, max<int64_t>(1, nNodes / minNodesPerThread)));
+
+	// the pairs are handed out one by one since their sizes may differ a lot
+	std::atomic<int> next(0);
+	auto countPairs = [&] {
+		for (int k = next++; k < pairs.size(); k = next++) {
+			crossings[pairs[k]] = calculateCrossings(pairs[k]);
+		}
+	};
+
+	Array<Thread> threads(nThreads - 1);
+	for (Thread& thread : threads) {
+		thread = Thread(countPairs);
+	}
+	countPairs();
+	for (Thread& thread : threads) {
+		thread.join();
+	}
+}
+
 }
@@ -43,6 +43,7 @@
 #include <ogdf/layered/Level.h>
 
 #include <cstdint>
+#include <vector>
 
 namespace ogdf {
 
@@ -61,27 +62,57 @@ CrossingsMatrix::CrossingsMatrix(const HierarchyLevels& levels) {
 }
 
 void CrossingsMatrix::init(Level& L) {
-	for (int i = 0; i < L.size(); i++) {
+	const LevelAdjacency& adj = L.adjPositions();
+	const int n = L.size();
+
+	// the nodes adjacent to each position on the adjacent level
+	int nPositions = 0;
+	for (int i = 0; i < n; i++) {
+		if (adj.degree(i) > 0) {
+			nPositions = max(nPositions, adj.end(i)[-1] + 1);
+		}
+	}
+	std::vector<int> start(nPositions + 1, 0);
+	for (int i = 0; i < n; i++) {
+		for (const int* p = adj.begin(i); p != adj.end(i); ++p) {
+			++start[*p + 1];
+		}
+	}
+	for (int p = 0; p < nPositions; p++) {
+		start[p + 1] += start[p];
+	}
+	std::vector<int> adjNodes(start[nPositions]);
+	std::vector<int> next(start.begin(), start.end() - 1);
+	for (int i = 0; i < n; i++) {
+		for (const int* p = adj.begin(i); p != adj.end(i); ++p) {
+			adjNodes[next[*p]++] = i;
+		}
+	}
+
+	for (int i = 0; i < n; i++) {
 		map[i] = i;
-		for (int j = 0; j < L.size(); j++) {
+		for (int j = 0; j < n; j++) {
 			matrix(i, j) = 0;
 		}
 	}
 
-	for (int i = 0; i < L.size(); i++) {
-		node v = L[i];
-		const Array<node>& L_adj_i = L.adjNodes(v);
-
-		for (auto pos_adj_k : L_adj_i) {
-			for (int j = i + 1; j < L.size(); j++) {
-				const Array<node>& L_adj_j = L.adjNodes(L[j]);
-
-				for (auto pos_adj_l : L_adj_j) {
-					matrix(i, j) += (pos_adj_k > pos_adj_l);
-					matrix(j, i) += (pos_adj_l > pos_adj_k);
-				}
+	// traverse the adjacent positions from left to right; an edge from i to position p
+	// crosses all edges from j to the positions left of p if i is placed left of j
+	std::vector<int> nLeft(n, 0);
+	for (int p = 0; p < nPositions; p++) {
+		for (int k = start[p]; k < start[p + 1]; k++) {
+			int* row = &matrix(adjNodes[k], 0);
+			for (int j = 0; j < n; j++) {
+				row[j] += nLeft[j];
 			}
 		}
+		for (int k = start[p]; k < start[p + 1]; k++) {
+			++nLeft[adjNodes[k]];
+		}
+	}
+
+	for (int i = 0; i < n; i++) {
+		matrix(i, i) = 0;
 	}
 }
 
@@ -35,9 +35,9 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/GraphCopy.h>
-#include <ogdf/basic/GraphList.h>
 #include <ogdf/basic/LayoutStandards.h>
 #include <ogdf/basic/Math.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/exceptions.h>
 #include <ogdf/layered/CrossingMinInterfaces.h>
@@ -45,12 +45,409 @@
 #include <ogdf/layered/Hierarchy.h>
 
 #include <algorithm>
-#include <cmath>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 namespace ogdf {
 
+namespace {
+
+//! Minimal number of nodes for computing the four layouts of the balanced mode in parallel.
+constexpr int MIN_NODES_FOR_THREADS = 2000;
+
+//! The levels of a hierarchy as contiguous arrays.
+/**
+ * The nodes are numbered level by level and from left to right on each level, so the
+ * position of a node on its level is its index minus the index of the first node on the
+ * level. The neighbours on the lower and upper level are stored as sorted index ranges.
+ */
+struct FlatLevels {
+	std::vector<node> nodes; //!< The node for each index.
+	std::vector<int> level; //!< The level of each node.
+	std::vector<int> levelBegin; //!< The first index on each level, followed by the number of nodes.
+	std::vector<int> lowerBegin; //!< The first entry in #lower for each node.
+	std::vector<int> lower; //!< The neighbours on the lower level (according to adjNodes()).
+	std::vector<int> upperBegin; //!< The first entry in #upper for each node.
+	std::vector<int> upper; //!< The neighbours on the upper level (according to adjNodes()).
+	std::vector<bool> longEdgeDummy; //!< Whether a node is a long edge dummy.
+	std::vector<double> width; //!< The width of a node, 0 for dummies.
+
+	FlatLevels(const HierarchyLevelsBase& levels, const GraphAttributes& AGC) {
+		const Hierarchy& H = levels.hierarchy();
+		const GraphCopy& GC = H;
+		const int n = GC.numberOfNodes();
+
+		nodes.reserve(n);
+		level.reserve(n);
+		levelBegin.reserve(levels.size() + 1);
+		NodeArray<int> index(GC);
+		for (int i = 0; i < levels.size(); ++i) {
+			const LevelBase& L = levels[i];
+			levelBegin.push_back(static_cast<int>(nodes.size()));
+			for (int j = 0; j < L.size(); ++j) {
+				index[L[j]] = static_cast<int>(nodes.size());
+				nodes.push_back(L[j]);
+				level.push_back(i);
+			}
+		}
+		levelBegin.push_back(static_cast<int>(nodes.size()));
+
+		lowerBegin.reserve(n + 1);
+		upperBegin.reserve(n + 1);
+		longEdgeDummy.reserve(n);
+		width.reserve(n);
+		for (node v : nodes) {
+			lowerBegin.push_back(static_cast<int>(lower.size()));
+			for (node u : levels.adjNodes(v, HierarchyLevelsBase::TraversingDir::downward)) {
+				lower.push_back(index[u]);
+			}
+			upperBegin.push_back(static_cast<int>(upper.size()));
+			for (node u : levels.adjNodes(v, HierarchyLevelsBase::TraversingDir::upward)) {
+				upper.push_back(index[u]);
+			}
+			longEdgeDummy.push_back(H.isLongEdgeDummy(v));
+			width.push_back(GC.isDummy(v) ? 0.0 : AGC.width(v));
+		}
+		lowerBegin.push_back(static_cast<int>(lower.size()));
+		upperBegin.push_back(static_cast<int>(upper.size()));
+	}
+
+	int numberOfNodes() const { return static_cast<int>(nodes.size()); }
+
+	int numberOfLevels() const { return static_cast<int>(levelBegin.size()) - 1; }
+
+	//! Returns the position of \p v on its level.
+	int pos(int v) const { return v - levelBegin[level[v]]; }
+
+	//! Returns the neighbours on the previous level of a \p downward or upward traversal.
+	const std::vector<int>& adj(bool downward) const { return downward ? lower : upper; }
+
+	//! Returns the index of the first neighbour of \p v in adj(\p downward).
+	int adjBegin(int v, bool downward) const {
+		return downward ? lowerBegin[v] : upperBegin[v];
+	}
+
+	//! Returns the index after the last neighbour of \p v in adj(\p downward).
+	int adjEnd(int v, bool downward) const {
+		return downward ? lowerBegin[v + 1] : upperBegin[v + 1];
+	}
+};
+
+/**
+ * Preprocessing step to find all type1 conflicts.
+ * A type1 conflict is a crossing of a inner segment with a non-inner segment.
+ *
+ * This is for preferring straight inner segments.
+ *
+ * @param levels The Hierarchy
+ * @param downward The level direction
+ * @param type1Conflicts is assigned the conflicts, type1Conflicts[e]=true means that the segment
+ * to the neighbour at index e of levels.adj(downward) is marked
+ */
+void markType1Conflicts(const FlatLevels& levels, const bool downward,
+		std::vector<bool>& type1Conflicts) {
+	const std::vector<int>& adj = levels.adj(downward);
+	type1Conflicts.assign(adj.size(), false);
+
+	// The twin of an inner segment, i.e., the neighbour of a long edge dummy, or -1.
+	auto virtualTwinNode = [&](int v) {
+		const int begin = levels.adjBegin(v, downward);
+		const int end = levels.adjEnd(v, downward);
+		if (!levels.longEdgeDummy[v] || begin == end) {
+			return -1;
+		}
+		if (end - begin > 1) {
+			// since v is a dummy there sould be only one upper neighbour
+			throw AlgorithmFailureException("FastSimpleHierarchyLayout.cpp");
+		}
+		return adj[begin];
+	};
+
+	const int high = levels.numberOfLevels() - 1;
+	if (high < 3) {
+		return;
+	}
+
+	// iterate level[2..h-2] in the given direction
+	const int lower = downward ? 1 : high - 1;
+	const int upper = downward ? high - 2 : 2;
+	for (int i = lower; downward ? i <= upper : i >= upper; i += downward ? 1 : -1) {
+		const int next = downward ? i + 1 : i - 1;
+		const int currentHigh = levels.levelBegin[i + 1] - levels.levelBegin[i] - 1;
+		const int nextBegin = levels.levelBegin[next];
+		const int nextEnd = levels.levelBegin[next + 1];
+
+		int k0 = 0;
+		for (int v = nextBegin; v < nextEnd; ++v) {
+			const int virtualTwin = virtualTwinNode(v);
+
+			if (v == nextEnd - 1 || virtualTwin >= 0) {
+				// node position boundaries of closest inner segments
+				const int k1 = virtualTwin >= 0 ? levels.pos(virtualTwin) : currentHigh;
+
+				for (int e = levels.adjBegin(v, downward); e < levels.adjEnd(v, downward); ++e) {
+					const int p = levels.pos(adj[e]);
+					if (p < k0 || p > k1) {
+						type1Conflicts[e] = true;
+					}
+				}
+				k0 = k1;
+			}
+		}
+	}
+}
+
+//! One of the four alignments and compactions with its scratch arrays.
+class Alignment {
+	const FlatLevels& m_levels;
+	const std::vector<bool>& m_type1Conflicts;
+	const bool m_downward;
+	const bool m_leftToRight;
+	const double m_minXSep;
+
+	std::vector<int> m_align; //!< align[v] = u <=> u is aligned to v
+	std::vector<int> m_sink;
+	std::vector<double> m_shift;
+
+public:
+	std::vector<int> root; //!< The root of the block of each node.
+	std::vector<double> blockWidth; //!< The width of each block, stored for its root.
+	std::vector<double> x; //!< The x-coordinate of each node.
+
+	Alignment(const FlatLevels& levels, const std::vector<bool>& type1Conflicts, bool downward,
+			bool leftToRight, double minXSep)
+		: m_levels(levels)
+		, m_type1Conflicts(type1Conflicts)
+		, m_downward(downward)
+		, m_leftToRight(leftToRight)
+		, m_minXSep(minXSep) { }
+
+	void run() {
+		verticalAlignment();
+		computeBlockWidths();
+		horizontalCompactation();
+	}
+
+private:
+	//! Calls \p f for the levels in the level direction.
+	template<typename F>
+	void forLevels(F f) const {
+		const int high = m_levels.numberOfLevels() - 1;
+		for (int i = m_downward ? 0 : high; m_downward ? i <= high : i >= 0;
+				i += m_downward ? 1 : -1) {
+			f(i);
+		}
+	}
+
+	//! Returns the first node on level \p i in the node direction.
+	int first(int i) const {
+		return m_leftToRight ? m_levels.levelBegin[i] : m_levels.levelBegin[i + 1] - 1;
+	}
+
+	//! Returns whether \p v is the first node on its level in the node direction.
+	bool isFirst(int v) const { return v == first(m_levels.level[v]); }
+
+	//! Returns the predecessor of \p v on its level in the node direction.
+	int pred(int v) const { return m_leftToRight ? v - 1 : v + 1; }
+
+	/**
+	 * Align each node to a node on the next higher level. The result is a blockgraph where each
+	 * node is in a block whith a nother node when they have the same root.
+	 */
+	void verticalAlignment() {
+		const int n = m_levels.numberOfNodes();
+		const std::vector<int>& adj = m_levels.adj(m_downward);
+
+		root.resize(n);
+		m_align.resize(n);
+		for (int v = 0; v < n; ++v) {
+			root[v] = v;
+			m_align[v] = v;
+		}
+
+		forLevels([&](int i) {
+			int r = m_leftToRight ? -1 : std::numeric_limits<int>::max();
+			const int last = m_leftToRight ? m_levels.levelBegin[i + 1] : m_levels.levelBegin[i] - 1;
+
+			for (int v = first(i); v != last; v += m_leftToRight ? 1 : -1) {
+				const int begin = m_levels.adjBegin(v, m_downward);
+				const int degree = m_levels.adjEnd(v, m_downward) - begin;
+				// the first median
+				const int median = (degree + 1) / 2;
+				const int medianCount = degree == 0 ? 0 : (degree % 2 == 1 ? 1 : 2);
+
+				// for all median neighbours in direction of H
+				for (int count = 0; count < medianCount; count++) {
+					const int e = begin + median + count - 1;
+					const int u = adj[e];
+					const int posU = m_levels.pos(u);
+
+					if (m_align[v] == v
+							// if segment (u,v) not marked by type1 conflicts AND ...
+							&& !m_type1Conflicts[e]
+							&& (m_leftToRight ? r < posU : r > posU)) {
+						m_align[u] = v;
+						root[v] = root[u];
+						m_align[v] = root[v];
+						r = posU;
+					}
+				}
+			}
+		});
+	}
+
+	/**
+	 * Computes the width of each block, i.e., the maximal width of a node in the block, and
+	 * stores it in blockWidth for the root of the block.
+	 */
+	void computeBlockWidths() {
+		const int n = m_levels.numberOfNodes();
+		blockWidth.assign(n, 0.0);
+		for (int v = 0; v < n; ++v) {
+			Math::updateMax(blockWidth[root[v]], m_levels.width[v]);
+		}
+	}
+
+	//! Calculate the coordinates for each node
+	void horizontalCompactation() {
+		const int n = m_levels.numberOfNodes();
+
+		m_sink.resize(n);
+		for (int v = 0; v < n; ++v) {
+			m_sink[v] = v;
+		}
+		x.assign(n, std::numeric_limits<double>::lowest());
+
+		// calculate class relative coordinates for all roots
+		forLevels([&](int i) {
+			const int last = m_leftToRight ? m_levels.levelBegin[i + 1] : m_levels.levelBegin[i] - 1;
+			for (int v = first(i); v != last; v += m_leftToRight ? 1 : -1) {
+				if (root[v] == v) {
+					placeBlock(v);
+				}
+			}
+		});
+
+		computeClassShifts();
+
+		// apply root coordinates for all aligned nodes
+		// (place block did this only for the roots)
+		for (int v = 0; v < n; ++v) {
+			x[v] = x[root[v]];
+		}
+
+		// apply shift for each class
+		for (int v = 0; v < n; ++v) {
+			x[v] += m_shift[m_sink[root[v]]];
+		}
+	}
+
+	//! Calculate the coordinate for the root node \p v (placing)
+	void placeBlock(int v) {
+		if (x[v] != std::numeric_limits<double>::lowest()) {
+			return;
+		}
+
+		x[v] = 0;
+		int w = v;
+		do {
+			// if not first node on layer
+			if (!isFirst(w)) {
+				const int u = root[pred(w)];
+				placeBlock(u);
+				if (m_sink[v] == v) {
+					m_sink[v] = m_sink[u];
+				}
+				if (m_sink[v] == m_sink[u]) {
+					if (m_leftToRight) {
+						x[v] = max<double>(x[v],
+								x[u] + m_minXSep + 0.5 * (blockWidth[u] + blockWidth[v]));
+					} else {
+						x[v] = min<double>(x[v],
+								x[u] - m_minXSep - 0.5 * (blockWidth[u] + blockWidth[v]));
+					}
+				}
+			}
+			w = m_align[w];
+		} while (w != v);
+	}
+
+	/**
+	 * Computes the shift of each class such that adjacent nodes of different classes are
+	 * separated.
+	 *
+	 * Unlike in the original algorithm, the shifts are only derived once the class relative
+	 * coordinates are final, and the shift of a class follows from all classes next to it in
+	 * the node direction, as described in the erratum by Brandes, Walter and Zink (2020).
+	 */
+	void computeClassShifts() {
+		const int n = m_levels.numberOfNodes();
+		const double unset = m_leftToRight ? std::numeric_limits<double>::max()
+										   : std::numeric_limits<double>::lowest();
+
+		// for each pair of adjacent nodes in different classes, the class of the predecessor
+		// is shifted relative to the class of the successor
+		struct Constraint {
+			int pred; //!< The class of the predecessor.
+			double offset; //!< The maximal (or minimal) difference of the shifts.
+		};
+		std::vector<int> constraintBegin(n + 1, 0);
+		std::vector<int> nSuccessors(n, 0);
+		auto forPairs = [&](auto f) {
+			for (int v = 0; v < n; ++v) {
+				if (!isFirst(v)) {
+					const int ru = root[pred(v)];
+					const int rv = root[v];
+					if (m_sink[ru] != m_sink[rv]) {
+						f(ru, rv);
+					}
+				}
+			}
+		};
+		forPairs([&](int, int rv) { ++constraintBegin[m_sink[rv] + 1]; });
+		for (int c = 0; c < n; ++c) {
+			constraintBegin[c + 1] += constraintBegin[c];
+		}
+		std::vector<Constraint> constraints(constraintBegin[n]);
+		std::vector<int> next(constraintBegin.begin(), constraintBegin.end() - 1);
+		forPairs([&](int ru, int rv) {
+			const double sep = m_minXSep + 0.5 * (blockWidth[ru] + blockWidth[rv]);
+			constraints[next[m_sink[rv]]++] = {m_sink[ru],
+					m_leftToRight ? x[rv] - x[ru] - sep : x[rv] - x[ru] + sep};
+			++nSuccessors[m_sink[ru]];
+		});
+
+		// classes without successors stay in place, the others follow in topological order
+		m_shift.assign(n, unset);
+		std::vector<int> queue;
+		for (int c = 0; c < n; ++c) {
+			if (m_sink[c] == c && nSuccessors[c] == 0) {
+				queue.push_back(c);
+			}
+		}
+		for (size_t k = 0; k < queue.size(); ++k) {
+			const int c = queue[k];
+			if (m_shift[c] == unset) {
+				m_shift[c] = 0;
+			}
+			for (int i = constraintBegin[c]; i < constraintBegin[c + 1]; ++i) {
+				const Constraint& con = constraints[i];
+				const double shift = m_shift[c] + con.offset;
+				if (m_leftToRight ? shift < m_shift[con.pred] : shift > m_shift[con.pred]) {
+					m_shift[con.pred] = shift;
+				}
+				if (--nSuccessors[con.pred] == 0) {
+					queue.push_back(con.pred);
+				}
+			}
+		}
+	}
+};
+
+}
+
 FastSimpleHierarchyLayout::FastSimpleHierarchyLayout() {
 	m_minXSep = LayoutStandards::defaultNodeSeparation();
 	m_ySep = 1.5 * LayoutStandards::defaultNodeSeparation();
@@ -87,8 +484,6 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevelsBase& levels, GraphA
 		return;
 	}
 
-	NodeArray<node> align(GC);
-
 #ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
 	for (int i = 0; i <= levels.high(); ++i) {
 		std::cout << "level " << i << ": ";
@@ -100,50 +495,67 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevelsBase& levels, GraphA
 	}
 #endif
 
-	if (m_balanced) {
-		// the x positions; x = -infinity <=> x is undefined
-		NodeArray<double> x[4];
-		NodeArray<double> blockWidth[4];
-		NodeArray<node> root[4];
-		double width[4];
-		double min[4];
-		double max[4];
-		int minWidthLayout = 0;
+	const FlatLevels flatLevels(levels, AGC);
+	const int n = flatLevels.numberOfNodes();
 
-		// initializing
-		for (int i = 0; i < 4; i++) {
-			min[i] = std::numeric_limits<double>::max();
-			max[i] = std::numeric_limits<double>::lowest();
-		}
+	if (m_balanced) {
+		// type1Conflicts[0] for the downward, type1Conflicts[1] for the upward alignments
+		std::vector<bool> type1Conflicts[2];
+		markType1Conflicts(flatLevels, true, type1Conflicts[0]);
+		markType1Conflicts(flatLevels, false, type1Conflicts[1]);
 
 		// calc the layout for down/up and leftToRight/rightToLeft
+		std::vector<Alignment> alignment;
+		alignment.reserve(4);
 		for (int downward = 0; downward <= 1; downward++) {
-			NodeArray<NodeArray<bool>> type1Conflicts(GC);
-			markType1Conflicts(levels, downward == 0, type1Conflicts);
 			for (int leftToRight = 0; leftToRight <= 1; leftToRight++) {
-				int k = 2 * downward + leftToRight;
-				root[k].init(GC);
-				verticalAlignment(levels, root[k], align, type1Conflicts, downward == 0,
-						leftToRight == 0);
-				computeBlockWidths(GC, AGC, root[k], blockWidth[k]);
-				horizontalCompactation(align, levels, root[k], blockWidth[k], x[k],
-						leftToRight == 0, downward == 0);
+				alignment.emplace_back(flatLevels, type1Conflicts[downward], downward == 0,
+						leftToRight == 0, m_minXSep);
 			}
 		}
 
+		// the alignments only share read-only data
+		if (n >= MIN_NODES_FOR_THREADS && Thread::hardware_concurrency() > 1) {
+			// Thread keeps a reference to its function, so the functions must outlive the threads
+			std::vector<std::function<void()>> workers;
+			for (int k = 1; k < 4; ++k) {
+				workers.emplace_back([&alignment, k] { alignment[k].run(); });
+			}
+			Array<Thread> threads(3);
+			for (int k = 0; k < 3; ++k) {
+				threads[k] = Thread(workers[k]);
+			}
+			alignment[0].run();
+			for (Thread& thread : threads) {
+				thread.join();
+			}
+		} else {
+			for (Alignment& a : alignment) {
+				a.run();
+			}
+		}
+
+		double width[4];
+		double min[4];
+		double max[4];
+		int minWidthLayout = 0;
+
 		/*
 		* - calc min/max x coordinate for each layout
 		* - calc x-width for each layout
 		* - find the layout with the minimal width
 		*/
 		for (int i = 0; i < 4; i++) {
-			for (node v : GC.nodes) {
-				double bw = 0.5 * blockWidth[i][root[i][v]];
-				double xp = x[i][v] - bw;
+			const Alignment& a = alignment[i];
+			min[i] = std::numeric_limits<double>::max();
+			max[i] = std::numeric_limits<double>::lowest();
+			for (int v = 0; v < n; ++v) {
+				double bw = 0.5 * a.blockWidth[a.root[v]];
+				double xp = a.x[v] - bw;
 				if (min[i] > xp) {
 					min[i] = xp;
 				}
-				xp = x[i][v] + bw;
+				xp = a.x[v] + bw;
 				if (max[i] < xp) {
 					max[i] = xp;
 				}
@@ -174,27 +586,23 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevelsBase& levels, GraphA
 		* shift the layouts and use the
 		* median average coordinate for each node
 		*/
-		Array<double> sorting(4);
-		for (node v : GC.nodes) {
+		double sorting[4];
+		for (int v = 0; v < n; ++v) {
 			for (int i = 0; i < 4; i++) {
-				sorting[i] = x[i][v] + shift[i];
+				sorting[i] = alignment[i].x[v] + shift[i];
 			}
-			sorting.quicksort();
-			AGC.x(v) = 0.5 * (sorting[1] + sorting[2]);
+			std::sort(sorting, sorting + 4);
+			AGC.x(flatLevels.nodes[v]) = 0.5 * (sorting[1] + sorting[2]);
 		}
 
 	} else {
-		NodeArray<double> x;
-		NodeArray<NodeArray<bool>> type1Conflicts(GC);
-		markType1Conflicts(levels, m_downward, type1Conflicts);
-		NodeArray<double> blockWidth; // the width of each block (max width of node in block)
-
-		NodeArray<node> root(GC);
-		verticalAlignment(levels, root, align, type1Conflicts, m_downward, m_leftToRight);
-		computeBlockWidths(GC, AGC, root, blockWidth);
-		horizontalCompactation(align, levels, root, blockWidth, x, m_leftToRight, m_downward);
-		for (node v : GC.nodes) {
-			AGC.x(v) = x[v];
+		std::vector<bool> type1Conflicts;
+		markType1Conflicts(flatLevels, m_downward, type1Conflicts);
+
+		Alignment alignment(flatLevels, type1Conflicts, m_downward, m_leftToRight, m_minXSep);
+		alignment.run();
+		for (int v = 0; v < n; ++v) {
+			AGC.x(flatLevels.nodes[v]) = alignment.x[v];
 		}
 	}
 
@@ -231,318 +639,4 @@ void FastSimpleHierarchyLayout::doCall(const HierarchyLevelsBase& levels, GraphA
 	}
 }
 
-void FastSimpleHierarchyLayout::markType1Conflicts(const HierarchyLevelsBase& levels,
-		const bool downward, NodeArray<NodeArray<bool>>& type1Conflicts) {
-	const GraphCopy& GC = levels.hierarchy();
-
-	for (node v : GC.nodes) {
-		type1Conflicts[v].init(GC, false);
-	}
-
-	if (levels.size() >= 4) {
-		int upper, lower; // iteration bounds
-		int k1; // node position boundaries of closest inner segments
-		HierarchyLevelsBase::TraversingDir relupward; // upward relativ to the direction from downward
-
-		if (downward) {
-			lower = 1;
-			upper = levels.high() - 2;
-
-			relupward = HierarchyLevelsBase::TraversingDir::downward;
-		} else {
-			lower = levels.high() - 1;
-			upper = 2;
-
-			relupward = HierarchyLevelsBase::TraversingDir::upward;
-		}
-
-		/*
-		 * iterate level[2..h-2] in the given direction
-		 *
-		 * availible levels: 1 to h
-		 */
-		for (int i = lower; (downward && i <= upper) || (!downward && i >= upper);
-				i = downward ? i + 1 : i - 1) {
-			int k0 = 0;
-			int firstIndex = 0; // index of first node on layer
-			const LevelBase& currentLevel = levels[i];
-			const LevelBase& nextLevel = downward ? levels[i + 1] : levels[i - 1];
-
-			// for all nodes on next level
-			for (int l1 = 0; l1 <= nextLevel.high(); l1++) {
-				const node virtualTwin = virtualTwinNode(levels, nextLevel[l1], relupward);
-
-				if (l1 == nextLevel.high() || virtualTwin != nullptr) {
-					k1 = currentLevel.high();
-
-					if (virtualTwin != nullptr) {
-						k1 = levels.pos(virtualTwin);
-					}
-
-					for (; firstIndex <= l1; firstIndex++) {
-						const Array<node>& upperNeighbours =
-								levels.adjNodes(nextLevel[l1], relupward);
-
-						for (auto currentNeighbour : upperNeighbours) {
-							/*
-							 * XXX: < 0 in first iteration is still ok for indizes starting
-							 * with 0 because no index can be smaller than 0
-							 */
-							if (levels.pos(currentNeighbour) < k0
-									|| levels.pos(currentNeighbour) > k1) {
-								type1Conflicts[nextLevel[l1]][currentNeighbour] = true;
-							}
-						}
-					}
-					k0 = k1;
-				}
-			}
-		}
-	}
-}
-
-void FastSimpleHierarchyLayout::verticalAlignment(const HierarchyLevelsBase& levels,
-		NodeArray<node>& root, NodeArray<node>& align,
-		const NodeArray<NodeArray<bool>>& type1Conflicts, bool downward, const bool leftToRight) {
-	const GraphCopy& GC = levels.hierarchy();
-	HierarchyLevelsBase::TraversingDir relupward; // upward relativ to the direction from downward
-
-	relupward = downward ? HierarchyLevelsBase::TraversingDir::downward
-						 : HierarchyLevelsBase::TraversingDir::upward;
-
-	// initialize root and align
-	for (node v : GC.nodes) {
-		root[v] = v;
-		align[v] = v;
-	}
-
-	// for all Level
-	for (int i = downward ? 0 : levels.high();
-			(downward && i <= levels.high()) || (!downward && i >= 0); i = downward ? i + 1 : i - 1) {
-		const LevelBase& currentLevel = levels[i];
-		int r = leftToRight ? -1 : std::numeric_limits<int>::max();
-
-		// for all nodes on Level i (with direction leftToRight)
-		for (int j = leftToRight ? 0 : currentLevel.high();
-				(leftToRight && j <= currentLevel.high()) || (!leftToRight && j >= 0);
-				leftToRight ? j++ : j--) {
-			node v = currentLevel[j];
-			// the first median
-			int median = (int)floor((levels.adjNodes(v, relupward).size() + 1) / 2.0);
-
-			int medianCount = (levels.adjNodes(v, relupward).size() % 2 == 1) ? 1 : 2;
-			if (levels.adjNodes(v, relupward).size() == 0) {
-				medianCount = 0;
-			}
-
-			// for all median neighbours in direction of H
-			for (int count = 0; count < medianCount; count++) {
-				node u = levels.adjNodes(v, relupward)[median + count - 1];
-
-				if (align[v] == v
-						// if segment (u,v) not marked by type1 conflicts AND ...
-						&& !type1Conflicts[v][u]
-						&& ((leftToRight && r < levels.pos(u))
-								|| (!leftToRight && r > levels.pos(u)))) {
-					align[u] = v;
-					root[v] = root[u];
-					align[v] = root[v];
-					r = levels.pos(u);
-				}
-			}
-		}
-	}
-
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-	for (node v : GC.nodes) {
-		std::cout << "node: " << GC.original(v) << "/" << v << ", root: " << GC.original(root[v])
-				  << "/" << root[v] << ", alignment: " << GC.original(align[v]) << "/" << align[v]
-				  << std::endl;
-	}
-#endif
-}
-
-void FastSimpleHierarchyLayout::computeBlockWidths(const GraphCopy& GC, const GraphAttributes& GCA,
-		NodeArray<node>& root, NodeArray<double>& blockWidth) {
-	blockWidth.init(GC, 0.0);
-	for (node v : GC.nodes) {
-		if (!GC.isDummy(v)) {
-			Math::updateMax(blockWidth[root[v]], GCA.width(v));
-		}
-	}
-}
-
-void FastSimpleHierarchyLayout::horizontalCompactation(const NodeArray<node>& align,
-		const HierarchyLevelsBase& levels, const NodeArray<node>& root,
-		const NodeArray<double>& blockWidth, NodeArray<double>& x, const bool leftToRight,
-		bool downward) {
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-	std::cout << "-------- Horizontal Compactation --------" << std::endl;
-#endif
-
-	const GraphCopy& GC = levels.hierarchy();
-
-	NodeArray<node> sink(GC);
-	NodeArray<double> shift(GC, std::numeric_limits<double>::max());
-
-	x.init(GC, std::numeric_limits<double>::lowest());
-
-	for (node v : GC.nodes) {
-		sink[v] = v;
-	}
-
-	// calculate class relative coordinates for all roots
-	for (int i = downward ? 0 : levels.high();
-			(downward && i <= levels.high()) || (!downward && i >= 0); i = downward ? i + 1 : i - 1) {
-		const LevelBase& currentLevel = levels[i];
-
-		for (int j = leftToRight ? 0 : currentLevel.high();
-				(leftToRight && j <= currentLevel.high()) || (!leftToRight && j >= 0);
-				leftToRight ? j++ : j--) {
-			node v = currentLevel[j];
-			if (root[v] == v) {
-				placeBlock(v, sink, shift, x, align, levels, blockWidth, root, leftToRight);
-			}
-		}
-	}
-
-	double d = 0;
-	for (int i = downward ? 0 : levels.high();
-			(downward && i <= levels.high()) || (!downward && i >= 0); i = downward ? i + 1 : i - 1) {
-		const LevelBase& currentLevel = levels[i];
-
-		node v = currentLevel[leftToRight ? 0 : currentLevel.high()];
-
-		if (v == sink[root[v]]) {
-			double oldShift = shift[v];
-			if (oldShift < std::numeric_limits<double>::max()) {
-				shift[v] += d;
-				d += oldShift;
-			} else {
-				shift[v] = 0;
-			}
-		}
-	}
-
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-	std::cout << "------- Sinks ----------" << std::endl;
-#endif
-	// apply root coordinates for all aligned nodes
-	// (place block did this only for the roots)
-	for (node v : GC.nodes) {
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-		if (sink[root[v]] == v) {
-			std::cout << "Topmost Root von Senke!: " << GC.original(v) << std::endl;
-			std::cout << "-> Shift: " << shift[v] << std::endl;
-			std::cout << "-> x: " << x[v] << std::endl;
-		}
-#endif
-		x[v] = x[root[v]];
-	}
-
-	// apply shift for each class
-	for (node v : GC.nodes) {
-		x[v] += shift[sink[root[v]]];
-	}
-}
-
-void FastSimpleHierarchyLayout::placeBlock(node v, NodeArray<node>& sink, NodeArray<double>& shift,
-		NodeArray<double>& x, const NodeArray<node>& align, const HierarchyLevelsBase& levels,
-		const NodeArray<double>& blockWidth, const NodeArray<node>& root, const bool leftToRight) {
-	const Hierarchy& H = levels.hierarchy();
-
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-	const GraphCopy& GC = H;
-#endif
-
-	if (x[v] == std::numeric_limits<double>::lowest()) {
-		x[v] = 0;
-		node w = v;
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-		std::cout << "---placeblock: " << GC.original(v) << " ---" << std::endl;
-#endif
-		do {
-			// if not first node on layer
-			if ((leftToRight && levels.pos(w) > 0)
-					|| (!leftToRight && levels.pos(w) < levels[H.rank(w)].high())) {
-				node u = root[pred(w, levels, leftToRight)];
-				placeBlock(u, sink, shift, x, align, levels, blockWidth, root, leftToRight);
-				if (sink[v] == v) {
-					sink[v] = sink[u];
-				}
-				if (sink[v] != sink[u]) {
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-					std::cout << "old shift " << GC.original(sink[u]) << ": " << shift[sink[u]]
-							  << "<>" << x[v] - x[u] - m_minXSep << std::endl;
-#endif
-					if (leftToRight) {
-						shift[sink[u]] = min<double>(shift[sink[u]],
-								x[v] - x[u] - m_minXSep - 0.5 * (blockWidth[u] + blockWidth[v]));
-					} else {
-						shift[sink[u]] = max<double>(shift[sink[u]],
-								x[v] - x[u] + m_minXSep + 0.5 * (blockWidth[u] + blockWidth[v]));
-					}
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-					std::cout << "-> new shift: " << shift[sink[u]] << std::endl;
-#endif
-				} else {
-					if (leftToRight) {
-						x[v] = max<double>(x[v],
-								x[u] + m_minXSep + 0.5 * (blockWidth[u] + blockWidth[v]));
-					} else {
-						x[v] = min<double>(x[v],
-								x[u] - m_minXSep - 0.5 * (blockWidth[u] + blockWidth[v]));
-					}
-				}
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-				std::cout << "placing w: " << GC.original(w)
-						  << "; predecessor: " << GC.original(pred(w, levels, leftToRight))
-						  << "; root(w)=v: " << GC.original(v)
-						  << "; root(pred(u)): " << GC.original(u)
-						  << "; sink(v): " << GC.original(sink[v])
-						  << "; sink(u): " << GC.original(sink[u]) << std::endl;
-				std::cout << "x(v): " << x[v] << std::endl;
-			} else {
-				std::cout << "not placing w: " << GC.original(w) << " because at beginning of layer"
-						  << std::endl;
-#endif
-			}
-			w = align[w];
-		} while (w != v);
-#ifdef OGDF_FAST_SIMPLE_HIERARCHY_LAYOUT_LOGGING
-		std::cout << "---END placeblock: " << GC.original(v) << " ---" << std::endl;
-#endif
-	}
-}
-
-node FastSimpleHierarchyLayout::virtualTwinNode(const HierarchyLevelsBase& levels, const node v,
-		const HierarchyLevelsBase::TraversingDir dir) const {
-	const Hierarchy& H = levels.hierarchy();
-
-	if (!H.isLongEdgeDummy(v) || levels.adjNodes(v, dir).size() == 0) {
-		return nullptr;
-	}
-
-	if (levels.adjNodes(v, dir).size() > 1) {
-		// since v is a dummy there sould be only one upper neighbour
-		throw AlgorithmFailureException("FastSimpleHierarchyLayout.cpp");
-	}
-
-	return *levels.adjNodes(v, dir).begin();
-}
-
-node FastSimpleHierarchyLayout::pred(const node v, const HierarchyLevelsBase& levels,
-		const bool leftToRight) {
-	const Hierarchy& H = levels.hierarchy();
-
-	int pos = levels.pos(v);
-	int rank = H.rank(v);
-
-	const LevelBase& level = levels[rank];
-	if ((leftToRight && pos != 0) || (!leftToRight && pos != level.high())) {
-		return level[leftToRight ? pos - 1 : pos + 1];
-	}
-	return nullptr;
-}
-
 }
@@ -29,7 +29,6 @@
  * http://www.gnu.org/copyleft/gpl.html
  */
 
-#include <ogdf/basic/Array.h>
 #include <ogdf/basic/Graph.h>
 #include <ogdf/layered/HierarchyLevels.h>
 #include <ogdf/layered/Level.h>
@@ -39,19 +38,20 @@ namespace ogdf {
 
 void MedianHeuristic::call(Level& L) {
 	const HierarchyLevels& levels = L.levels();
+	const LevelAdjacency& adj = L.adjPositions();
 
 	for (int i = 0; i <= L.high(); ++i) {
 		node v = L[i];
 
-		const Array<node>& adjNodes = L.adjNodes(v);
-		const int high = adjNodes.high();
+		const int* adjPos = adj.begin(i);
+		const int high = adj.degree(i) - 1;
 
 		if (high < 0) {
 			m_weight[v] = 0;
 		} else if (high & 1) {
-			m_weight[v] = levels.pos(adjNodes[high / 2]) + levels.pos(adjNodes[1 + high / 2]);
+			m_weight[v] = adjPos[high / 2] + adjPos[1 + high / 2];
 		} else {
-			m_weight[v] = 2 * levels.pos(adjNodes[high / 2]);
+			m_weight[v] = 2 * adjPos[high / 2];
 		}
 	}
 
@@ -0,0 +1,526 @@
+/** \file
+ * \brief Implementation of the network simplex ranking algorithm
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/List.h>
+#include <ogdf/basic/Math.h>
+#include <ogdf/basic/SList.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/basic/simple_graph_alg.h>
+#include <ogdf/layered/AcyclicSubgraphModule.h>
+#include <ogdf/layered/DfsAcyclicSubgraph.h>
+#include <ogdf/layered/NetworkSimplexRanking.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ogdf {
+
+namespace {
+
+//! The network simplex algorithm for the ranking problem on a DAG given by arrays.
+/**
+ * Minimizes the sum of weight[e] * (rank[head[e]] - rank[tail[e]]) subject to
+ * rank[head[e]] - rank[tail[e]] >= length[e] for all edges e. Every connected component
+ * gets ranks starting at 0.
+ *
+ * The ranks are given by a spanning tree of tight edges. The tree is rooted at an artificial
+ * node that is connected to every node by an artificial edge. The cut value of a tree edge is
+ * the weight of the edges from the tail to the head component minus the weight in the other
+ * direction, taking the cut values of the other tree edges into account; it is the flow on
+ * this edge in the dual min-cost flow problem. The tree is optimal if all cut values and all
+ * slacks of the non-tree edges are non-negative.
+ *
+ * Initially, all tree edges are artificial; their lengths and cut values are chosen such that
+ * the tree is feasible and artificial edges are never worth keeping. Each pivot lets a
+ * non-tree edge with negative slack enter the tree. It closes a cycle with the tree, and the
+ * cut values along the cycle change until the first one drops to 0; this edge leaves the tree.
+ * Ties are broken as proposed by Cunningham, which keeps the tree strongly feasible and
+ * prevents cycling. The cut values only change on the cycle.
+ *
+ * The nodes are threaded in preorder, so every subtree is a contiguous segment of the thread.
+ * After a pivot, only the thread around the path from the entering to the leaving edge (the
+ * stem) is relinked, and only the ranks in the subtree below the leaving edge (or, if it is
+ * larger, the ranks of all other nodes) are shifted.
+ *
+ * The entering edge is chosen by block search: the edges are scanned cyclically in blocks
+ * of about sqrt(m) edges, and the edge of minimal slack in the first block containing a
+ * negative slack enters the tree.
+ */
+class NetworkSimplex {
+	//! The minimal number of edges in a block of the search for an entering edge.
+	static constexpr int MIN_BLOCK_SIZE = 10;
+
+	const int m_n; //!< The number of nodes; node #m_n is the artificial root.
+	const int m_m; //!< The number of edges; edge #m_m + v is the artificial edge of node v.
+
+	std::vector<int> m_tail;
+	std::vector<int> m_head;
+	std::vector<int64_t> m_length;
+	std::vector<int64_t> m_rank;
+
+	// the spanning tree rooted at the artificial node
+	std::vector<bool> m_inTree;
+	std::vector<int64_t> m_cut; //!< The cut value of each tree edge (0 for other edges).
+	std::vector<int> m_parent; //!< The parent of each node or -1 for the root.
+	std::vector<int> m_parentEdge; //!< The edge to the parent of each node.
+	std::vector<int> m_thread; //!< The successor of each node in preorder (cyclic).
+	std::vector<int> m_revThread; //!< The predecessor of each node in preorder.
+	std::vector<int> m_size; //!< The number of nodes in the subtree of each node.
+	std::vector<int> m_last; //!< The last node of the subtree of each node in preorder.
+	std::vector<int> m_dirtyRevThread; //!< The nodes whose successor changed during a pivot.
+
+	int m_blockSize;
+	int m_nextEdge = 0; //!< The edge where the search for an entering edge continues.
+
+public:
+	NetworkSimplex(int n, const std::vector<int>& tail, const std::vector<int>& head,
+			const std::vector<int>& length, const std::vector<int>& weight)
+		: m_n(n)
+		, m_m(static_cast<int>(tail.size()))
+		, m_tail(tail)
+		, m_head(head)
+		, m_length(length.begin(), length.end())
+		, m_blockSize(max(MIN_BLOCK_SIZE, static_cast<int>(std::sqrt(double(m_m))))) {
+		std::vector<int64_t> supply(m_n, 0);
+		int64_t maxLength = 0;
+		for (int e = 0; e < m_m; ++e) {
+			supply[m_tail[e]] += weight[e];
+			supply[m_head[e]] -= weight[e];
+			Math::updateMax(maxLength, m_length[e] < 0 ? -m_length[e] : m_length[e]);
+		}
+		// longer than any path, so that optimal cut values of artificial edges are 0
+		const int64_t artificialLength = (maxLength + 1) * (m_n + 1);
+
+		m_tail.resize(m_m + m_n);
+		m_head.resize(m_m + m_n);
+		m_length.resize(m_m + m_n);
+		m_rank.assign(m_n + 1, 0);
+		m_inTree.assign(m_m + m_n, false);
+		m_cut.assign(m_m + m_n, 0);
+		m_parent.assign(m_n + 1, m_n);
+		m_parentEdge.resize(m_n + 1);
+		m_thread.resize(m_n + 1);
+		m_revThread.resize(m_n + 1);
+		m_size.assign(m_n + 1, 1);
+		m_last.resize(m_n + 1);
+
+		// the artificial edges point to the root if they have cut value 0 (strong feasibility)
+		for (int v = 0; v < m_n; ++v) {
+			const int e = m_m + v;
+			if (supply[v] >= 0) {
+				m_tail[e] = v;
+				m_head[e] = m_n;
+				m_length[e] = 0;
+				m_cut[e] = supply[v];
+			} else {
+				m_tail[e] = m_n;
+				m_head[e] = v;
+				m_length[e] = -artificialLength;
+				m_rank[v] = -artificialLength;
+				m_cut[e] = -supply[v];
+			}
+			m_inTree[e] = true;
+			m_parentEdge[v] = e;
+			m_thread[v] = v + 1;
+			m_revThread[v + 1] = v;
+			m_last[v] = v;
+		}
+		m_parent[m_n] = -1;
+		m_parentEdge[m_n] = -1;
+		m_thread[m_n] = 0;
+		m_revThread[0] = m_n;
+		m_size[m_n] = m_n + 1;
+		m_last[m_n] = m_n == 0 ? m_n : m_n - 1;
+	}
+
+	//! Computes the optimal ranking.
+	void run() {
+		for (int e = enterEdge(); e >= 0; e = enterEdge()) {
+			pivot(e);
+		}
+		normalize();
+	}
+
+	//! Returns the rank of node \p v.
+	int rank(int v) const { return static_cast<int>(m_rank[v]); }
+
+private:
+	int64_t slack(int e) const { return m_rank[m_head[e]] - m_rank[m_tail[e]] - m_length[e]; }
+
+	//! Returns a non-tree edge with negative slack or -1 if the ranking is optimal.
+	int enterEdge() {
+		int best = -1;
+		int64_t bestSlack = 0;
+		int count = m_blockSize;
+		for (int k = 0; k < m_m; ++k) {
+			const int e = m_nextEdge;
+			if (++m_nextEdge == m_m) {
+				m_nextEdge = 0;
+			}
+			if (!m_inTree[e] && slack(e) < bestSlack) {
+				best = e;
+				bestSlack = slack(e);
+			}
+			if (--count == 0) {
+				if (best >= 0) {
+					break;
+				}
+				count = m_blockSize;
+			}
+		}
+		return best;
+	}
+
+	//! Returns the lowest common ancestor of \p u and \p w.
+	int commonAncestor(int u, int w) const {
+		while (u != w) {
+			// a node with a smaller subtree cannot be an ancestor of the other one
+			if (m_size[u] < m_size[w]) {
+				u = m_parent[u];
+			} else {
+				w = m_parent[w];
+			}
+		}
+		return u;
+	}
+
+	//! Lets \p in enter the tree.
+	void pivot(int in) {
+		// the cycle closed by in runs from its tail up to the join node and down to its head
+		const int first = m_tail[in];
+		const int second = m_head[in];
+		const int join = commonAncestor(first, second);
+
+		// The leaving edge is the last edge on the cycle (starting at the join node) whose cut
+		// value drops to 0 first. The cut values of edges oriented against the cycle decrease.
+		int64_t delta = std::numeric_limits<int64_t>::max();
+		int uOut = -1;
+		bool outOnFirst = false;
+		for (int u = first; u != join; u = m_parent[u]) {
+			const int e = m_parentEdge[u];
+			if (m_tail[e] == u && m_cut[e] < delta) {
+				delta = m_cut[e];
+				uOut = u;
+				outOnFirst = true;
+			}
+		}
+		for (int u = second; u != join; u = m_parent[u]) {
+			const int e = m_parentEdge[u];
+			if (m_head[e] == u && m_cut[e] <= delta) {
+				delta = m_cut[e];
+				uOut = u;
+				outOnFirst = false;
+			}
+		}
+		OGDF_ASSERT(uOut >= 0);
+
+		if (delta > 0) {
+			m_cut[in] += delta;
+			for (int u = first; u != join; u = m_parent[u]) {
+				const int e = m_parentEdge[u];
+				m_cut[e] += m_tail[e] == u ? -delta : delta;
+			}
+			for (int u = second; u != join; u = m_parent[u]) {
+				const int e = m_parentEdge[u];
+				m_cut[e] += m_tail[e] == u ? delta : -delta;
+			}
+		}
+
+		// the subtree of uOut moves below the endpoint vIn of in, uIn becomes its root
+		const int uIn = outOnFirst ? first : second;
+		const int vIn = outOnFirst ? second : first;
+		const int64_t shift = uIn == m_tail[in] ? slack(in) : -slack(in);
+		m_inTree[m_parentEdge[uOut]] = false;
+		m_inTree[in] = true;
+		updateTree(in, uIn, vIn, uOut, join);
+
+		// only rank differences matter, so shift the smaller of the subtree and the rest
+		const int end = m_thread[m_last[uIn]];
+		if (2 * m_size[uIn] <= m_n + 1) {
+			for (int u = uIn; u != end; u = m_thread[u]) {
+				m_rank[u] += shift;
+			}
+		} else {
+			for (int u = end; u != uIn; u = m_thread[u]) {
+				m_rank[u] -= shift;
+			}
+		}
+		OGDF_ASSERT(slack(in) == 0);
+	}
+
+	//! Replaces the edge from \p uOut to its parent by the edge \p in from \p uIn to \p vIn.
+	/**
+	 * The path from \p uIn up to \p uOut (the stem) is reversed. Each stem node is moved in the
+	 * thread together with the part of its subtree that does not contain the next stem node.
+	 */
+	void updateTree(int in, int uIn, int vIn, int uOut, int join) {
+		const int oldRevThread = m_revThread[uOut];
+		const int oldSize = m_size[uOut];
+		const int oldLast = m_last[uOut];
+		const int vOut = m_parent[uOut];
+
+		if (uIn == uOut) {
+			m_parent[uIn] = vIn;
+			m_parentEdge[uIn] = in;
+
+			// move the subtree of uIn behind vIn in the thread
+			if (m_thread[vIn] != uOut) {
+				int after = m_thread[oldLast];
+				m_thread[oldRevThread] = after;
+				m_revThread[after] = oldRevThread;
+				after = m_thread[vIn];
+				m_thread[vIn] = uOut;
+				m_revThread[uOut] = vIn;
+				m_thread[oldLast] = after;
+				m_revThread[after] = oldLast;
+			}
+		} else {
+			// if the thread reaches uOut from vIn, vOut is the join node
+			const int threadContinue = oldRevThread == vIn ? m_thread[oldLast] : m_thread[vIn];
+
+			// relink the thread and the parents along the stem
+			int stem = uIn;
+			int parentStem = vIn;
+			int last = m_last[uIn];
+			int after = m_thread[last];
+			m_thread[vIn] = uIn;
+			m_dirtyRevThread.clear();
+			m_dirtyRevThread.push_back(vIn);
+			while (stem != uOut) {
+				// the next stem node follows the part of the subtree of the current one
+				const int nextStem = m_parent[stem];
+				m_thread[last] = nextStem;
+				m_dirtyRevThread.push_back(last);
+
+				// remove the subtree of the current stem node from the thread
+				const int before = m_revThread[stem];
+				m_thread[before] = after;
+				m_revThread[after] = before;
+
+				m_parent[stem] = parentStem;
+				parentStem = stem;
+				stem = nextStem;
+
+				// the part of the subtree of stem that does not contain parentStem
+				last = m_last[stem] == m_last[parentStem] ? m_revThread[parentStem] : m_last[stem];
+				after = m_thread[last];
+			}
+			m_parent[uOut] = parentStem;
+			m_thread[last] = threadContinue;
+			m_revThread[threadContinue] = last;
+			m_last[uOut] = last;
+
+			// remove the subtree of uOut from the thread unless vIn precedes it
+			if (oldRevThread != vIn) {
+				m_thread[oldRevThread] = after;
+				m_revThread[after] = oldRevThread;
+			}
+
+			for (int u : m_dirtyRevThread) {
+				m_revThread[m_thread[u]] = u;
+			}
+
+			// the parent edges, sizes and last nodes of the stem from uOut down to uIn
+			int stemSize = 0;
+			const int stemLast = m_last[uOut];
+			for (int u = uOut, p = m_parent[u]; u != uIn; u = p, p = m_parent[u]) {
+				m_parentEdge[u] = m_parentEdge[p];
+				stemSize += m_size[u] - m_size[p];
+				m_size[u] = stemSize;
+				m_last[p] = stemLast;
+			}
+			m_parentEdge[uIn] = in;
+			m_size[uIn] = oldSize;
+		}
+
+		// the last nodes from vIn towards the root
+		const int upLimitOut = m_last[join] == vIn ? join : -1;
+		const int lastOut = m_last[uOut];
+		for (int u = vIn; u != -1 && m_last[u] == vIn; u = m_parent[u]) {
+			m_last[u] = lastOut;
+		}
+
+		// the last nodes from vOut towards the root
+		if (join != oldRevThread && vIn != oldRevThread) {
+			for (int u = vOut; u != upLimitOut && m_last[u] == oldLast; u = m_parent[u]) {
+				m_last[u] = oldRevThread;
+			}
+		} else if (lastOut != oldLast) {
+			for (int u = vOut; u != upLimitOut && m_last[u] == oldLast; u = m_parent[u]) {
+				m_last[u] = lastOut;
+			}
+		}
+
+		// the sizes on the paths from vIn and vOut to the join node
+		for (int u = vIn; u != join; u = m_parent[u]) {
+			m_size[u] += oldSize;
+		}
+		for (int u = vOut; u != join; u = m_parent[u]) {
+			m_size[u] -= oldSize;
+		}
+	}
+
+	//! Shifts the ranks of each connected component such that the minimal rank is 0.
+	void normalize() {
+		std::vector<int> set(m_n);
+		for (int v = 0; v < m_n; ++v) {
+			set[v] = v;
+		}
+		auto find = [&](int v) {
+			while (set[v] != v) {
+				v = set[v] = set[set[v]];
+			}
+			return v;
+		};
+		for (int e = 0; e < m_m; ++e) {
+			set[find(m_tail[e])] = find(m_head[e]);
+		}
+
+		std::vector<int64_t> minRank(m_n, std::numeric_limits<int64_t>::max());
+		for (int v = 0; v < m_n; ++v) {
+			Math::updateMin(minRank[find(v)], m_rank[v]);
+		}
+		for (int v = 0; v < m_n; ++v) {
+			m_rank[v] -= minRank[find(v)];
+		}
+	}
+};
+
+}
+
+NetworkSimplexRanking::NetworkSimplexRanking() {
+	m_subgraph.reset(new DfsAcyclicSubgraph);
+	m_separateMultiEdges = true;
+}
+
+void NetworkSimplexRanking::call(const Graph& G, const EdgeArray<int>& length,
+		NodeArray<int>& rank) {
+	EdgeArray<int> cost(G, 1);
+	call(G, length, cost, rank);
+}
+
+void NetworkSimplexRanking::call(const Graph& G, const EdgeArray<int>& length,
+		const EdgeArray<int>& cost, NodeArray<int>& rank) {
+	List<edge> R;
+
+	m_subgraph->call(G, R);
+
+	EdgeArray<bool> reversed(G, false);
+	for (edge e : R) {
+		reversed[e] = true;
+	}
+	R.clear();
+
+	doCall(G, rank, reversed, length, cost);
+}
+
+void NetworkSimplexRanking::call(const Graph& G, NodeArray<int>& rank) {
+	List<edge> R;
+
+	m_subgraph->call(G, R);
+
+	EdgeArray<bool> reversed(G, false);
+	for (edge e : R) {
+		reversed[e] = true;
+	}
+	R.clear();
+
+	EdgeArray<int> length(G, 1);
+
+	if (m_separateMultiEdges) {
+		SListPure<edge> edges;
+		EdgeArray<int> minIndex(G), maxIndex(G);
+		parallelFreeSortUndirected(G, edges, minIndex, maxIndex);
+
+		SListConstIterator<edge> it = edges.begin();
+		if (it.valid()) {
+			int prevSrc = minIndex[*it];
+			int prevTgt = maxIndex[*it];
+
+			for (it = it.succ(); it.valid(); ++it) {
+				edge e = *it;
+				if (minIndex[e] == prevSrc && maxIndex[e] == prevTgt) {
+					length[e] = 2;
+				} else {
+					prevSrc = minIndex[e];
+					prevTgt = maxIndex[e];
+				}
+			}
+		}
+	}
+
+	EdgeArray<int> cost(G, 1);
+	doCall(G, rank, reversed, length, cost);
+}
+
+void NetworkSimplexRanking::doCall(const Graph& G, NodeArray<int>& rank,
+		const EdgeArray<bool>& reversed, const EdgeArray<int>& length, const EdgeArray<int>& cost) {
+	NodeArray<int> index(G);
+	int n = 0;
+	for (node v : G.nodes) {
+		index[v] = n++;
+	}
+
+	// the acyclic graph without self-loops
+	std::vector<int> tail, head, edgeLength, weight;
+	tail.reserve(G.numberOfEdges());
+	head.reserve(G.numberOfEdges());
+	edgeLength.reserve(G.numberOfEdges());
+	weight.reserve(G.numberOfEdges());
+	for (edge e : G.edges) {
+		if (e->isSelfLoop()) {
+			continue;
+		}
+		int src = index[e->source()];
+		int tgt = index[e->target()];
+		if (reversed[e]) {
+			std::swap(src, tgt);
+		}
+		tail.push_back(src);
+		head.push_back(tgt);
+		edgeLength.push_back(length[e]);
+		weight.push_back(cost[e]);
+	}
+
+	NetworkSimplex ns(n, tail, head, edgeLength, weight);
+	ns.run();
+
+	rank.init(G);
+	for (node v : G.nodes) {
+		rank[v] = ns.rank(index[v]);
+	}
+}
+
+}
@@ -33,11 +33,11 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/List.h>
 #include <ogdf/layered/CrossingsMatrix.h>
+#include <ogdf/layered/HierarchyLevels.h>
 #include <ogdf/layered/Level.h>
 #include <ogdf/layered/SiftingHeuristic.h>
 
 namespace ogdf {
-class HierarchyLevels;
 
 SiftingHeuristic::SiftingHeuristic()
 	: m_crossingMatrix(nullptr), m_strategy(Strategy::LeftToRight) { }
@@ -75,10 +75,11 @@ void SiftingHeuristic::call(Level& L) {
 		}
 
 	} else { // m_strategy == Strategy::DescDegree
+		const LevelAdjacency& adj = L.adjPositions();
 		int max_deg = 0;
 
 		for (i = 0; i < n; i++) {
-			int deg = L.adjNodes(L[i]).size();
+			int deg = adj.degree(i);
 			if (deg > max_deg) {
 				max_deg = deg;
 			}
@@ -86,7 +87,7 @@ void SiftingHeuristic::call(Level& L) {
 
 		Array<List<node>, int> bucket(0, max_deg);
 		for (i = 0; i < n; i++) {
-			bucket[L.adjNodes(L[i]).size()].pushBack(L[i]);
+			bucket[adj.degree(i)].pushBack(L[i]);
 		}
 
 		for (i = max_deg; i >= 0; i--) {
@@ -42,6 +42,7 @@
 #include <ogdf/basic/SList.h>
 #include <ogdf/basic/System.h>
 #include <ogdf/basic/Thread.h>
+#include <ogdf/basic/WorkStealingPool.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/geometry.h>
 #include <ogdf/basic/simple_graph_alg.h>
@@ -69,7 +70,6 @@
 #include <ogdf/simultaneous/TwoLayerCrossMinSimDraw.h>
 
 #include <algorithm>
-#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
@@ -78,12 +78,12 @@
 #include <mutex>
 #include <random>
 #include <utility>
+#include <vector>
 
 namespace ogdf {
 class ClusterGraph;
 } // namespace ogdf
 
-using std::atomic;
 using std::lock_guard;
 using std::minstd_rand;
 using std::mutex;
@@ -139,20 +139,37 @@ void ClusterGraphCopyAttributes::transform() {
 
 const Array<node>& Level::adjNodes(node v) const { return m_pLevels->adjNodes(v); }
 
+const LevelAdjacency& Level::adjPositions() const {
+	return m_pLevels->adjPositions(m_index, m_pLevels->direction());
+}
+
 void Level::swap(int i, int j) {
 	m_nodes.swap(i, j);
 	m_pLevels->m_pos[m_nodes[i]] = i;
 	m_pLevels->m_pos[m_nodes[j]] = j;
+	m_pLevels->levelChanged(m_index);
+	m_pLevels->swapAdjPositions(m_index, i, j);
 }
 
 void Level::recalcPos() {
 	NodeArray<int>& pos = m_pLevels->m_pos;
 
+	bool changed = false;
 	for (int i = 0; i <= high(); ++i) {
-		pos[m_nodes[i]] = i;
+		if (pos[m_nodes[i]] != i) {
+			pos[m_nodes[i]] = i;
+			changed = true;
+		}
 	}
 
-	m_pLevels->buildAdjNodes(m_index);
+	if (changed) {
+		m_pLevels->levelChanged(m_index);
+	}
+
+	// the adjacent nodes are still sorted if neither sorting nor swaps moved a node
+	if (changed || m_pLevels->m_swapped[m_index]) {
+		m_pLevels->buildAdjNodes(m_index);
+	}
 }
 
 void Level::getIsolatedNodes(SListPure<Tuple2<node, int>>& isolated) const {
@@ -294,7 +311,16 @@ void Hierarchy::doInit(const NodeArray<int>& rank) {
 }
 
 HierarchyLevels::HierarchyLevels(const Hierarchy& H)
-	: m_H(H), m_pLevel(0, H.maxRank()), m_pos(H), m_lowerAdjNodes(H), m_upperAdjNodes(H), m_nSet(H, 0) {
+	: m_H(H)
+	, m_pLevel(0, H.maxRank())
+	, m_pos(H)
+	, m_lowerAdjNodes(H)
+	, m_upperAdjNodes(H)
+	, m_nSet(H, 0)
+	, m_row(H)
+	, m_lowerAdjPos(0, H.maxRank())
+	, m_upperAdjPos(0, H.maxRank())
+	, m_swapped(0, H.maxRank(), false) {
 	const GraphCopy& GC = m_H;
 	int maxRank = H.maxRank();
 
@@ -322,9 +348,50 @@ HierarchyLevels::~HierarchyLevels() {
 }
 
 void HierarchyLevels::buildAdjNodes() {
+	// the levels may have been rearranged completely, so the row of each node is its position
+	if (m_lowerAdjPos.size() != size()) {
+		m_lowerAdjPos.init(0, high());
+		m_upperAdjPos.init(0, high());
+		m_swapped.init(0, high(), false);
+	}
+	for (int i = 0; i <= high(); ++i) {
+		const Level& level = *m_pLevel[i];
+		LevelAdjacency& lower = m_lowerAdjPos[i];
+		LevelAdjacency& upper = m_upperAdjPos[i];
+
+		// buildAdjNodes(i) only needs the sets of adjacent nodes
+		for (int j = 0; j <= level.high(); ++j) {
+			node v = level[j];
+			int nLower = 0, nUpper = 0;
+			for (adjEntry adj : v->adjEntries) {
+				if (adj->isSource()) {
+					m_upperAdjNodes[v][nUpper++] = adj->twinNode();
+				} else {
+					m_lowerAdjNodes[v][nLower++] = adj->twinNode();
+				}
+			}
+		}
+
+		lower.m_row.resize(level.size());
+		upper.m_row.resize(level.size());
+		lower.m_start.resize(level.size() + 1);
+		upper.m_start.resize(level.size() + 1);
+		lower.m_start[0] = upper.m_start[0] = 0;
+		for (int j = 0; j <= level.high(); ++j) {
+			node v = level[j];
+			m_row[v] = j;
+			lower.m_start[j + 1] = lower.m_start[j] + v->indeg();
+			upper.m_start[j + 1] = upper.m_start[j] + v->outdeg();
+		}
+		lower.m_adjPos.resize(lower.m_start.back());
+		upper.m_adjPos.resize(upper.m_start.back());
+	}
+
 	for (int i = 0; i <= high(); ++i) {
 		buildAdjNodes(i);
 	}
+
+	invalidateCrossings();
 }
 
 void HierarchyLevels::buildAdjNodes(int i) {
@@ -345,18 +412,34 @@ void HierarchyLevels::buildAdjNodes(int i) {
 	}
 
 	const Level& level = *m_pLevel[i];
+	LevelAdjacency& lower = m_lowerAdjPos[i];
+	LevelAdjacency& upper = m_upperAdjPos[i];
 
 	for (int j = 0; j <= level.high(); ++j) {
 		node v = level[j];
-		for (adjEntry adj : v->adjEntries) {
-			edge e = adj->theEdge();
-			if (e->source() == v) {
-				(m_lowerAdjNodes[e->target()])[m_nSet[e->target()]++] = v;
-			} else {
-				(m_upperAdjNodes[e->source()])[m_nSet[e->source()]++] = v;
-			}
+		lower.m_row[j] = upper.m_row[j] = m_row[v];
+
+		for (node w : m_upperAdjNodes[v]) {
+			const int k = m_nSet[w]++;
+			m_lowerAdjNodes[w][k] = v;
+			LevelAdjacency& adjW = m_lowerAdjPos[i + 1];
+			adjW.m_adjPos[adjW.m_start[m_row[w]] + k] = j;
+		}
+		for (node w : m_lowerAdjNodes[v]) {
+			const int k = m_nSet[w]++;
+			m_upperAdjNodes[w][k] = v;
+			LevelAdjacency& adjW = m_upperAdjPos[i - 1];
+			adjW.m_adjPos[adjW.m_start[m_row[w]] + k] = j;
 		}
 	}
+
+	m_swapped[i] = false;
+}
+
+void HierarchyLevels::swapAdjPositions(int k, int i, int j) {
+	std::swap(m_lowerAdjPos[k].m_row[i], m_lowerAdjPos[k].m_row[j]);
+	std::swap(m_upperAdjPos[k].m_row[i], m_upperAdjPos[k].m_row[j]);
+	m_swapped[k] = true;
 }
 
 void HierarchyLevels::storePos(NodeArray<int>& oldPos) const { oldPos = m_pos; }
@@ -552,19 +635,30 @@ class LayerByLayerSweep::CrossMinMaster {
 	const SugiyamaLayout& m_sugi;
 	const Hierarchy& m_H;
 
-	atomic<int> m_runs;
+	WorkStealingPool::StopFlag m_stop;
 	mutex m_mutex;
 
 public:
-	CrossMinMaster(const SugiyamaLayout& sugi, const Hierarchy& H, int runs);
+	CrossMinMaster(const SugiyamaLayout& sugi, const Hierarchy& H);
 
 	const Hierarchy& hierarchy() const { return m_H; }
 
-	void restore(HierarchyLevels& levels, int& cr);
+	//! Performs all runs with \p pCrossMin or \p pCrossMinSimDraw and restores the best result.
+	/**
+	 * The runs are executed by WorkStealingPool::instance(); the calling thread works on
+	 * \p levels with the given module, the other threads on their own levels with clones.
+	 */
+	void doRuns(LayerByLayerSweep* pCrossMin, TwoLayerCrossMinSimDraw* pCrossMinSimDraw,
+			HierarchyLevels& levels, int& nCrossings);
+
+	//! Prepares \p levels and the module of a thread for its runs.
+	void initWorker(LayerByLayerSweep* pCrossMin, TwoLayerCrossMinSimDraw* pCrossMinSimDraw,
+			HierarchyLevels& levels, Array<bool>*& pLevelChanged);
 
-	void doWorkHelper(LayerByLayerSweep* pCrossMin, TwoLayerCrossMinSimDraw* pCrossMinSimDraw,
-			HierarchyLevels& levels, NodeArray<int>& bestPos, bool permuteFirst,
-			std::minstd_rand& rng);
+	//! Performs one run starting with the current order in \p levels, or a random order if \p permute is set.
+	void doRun(LayerByLayerSweep* pCrossMin, TwoLayerCrossMinSimDraw* pCrossMinSimDraw,
+			HierarchyLevels& levels, NodeArray<int>& bestPos, bool permute, std::minstd_rand& rng,
+			Array<bool>* pLevelChanged);
 
 private:
 	const EdgeArray<uint32_t>* subgraphs() const { return m_sugi.subgraphs(); }
@@ -592,16 +686,68 @@ private:
 	int queryBestKnown() const { return m_bestCR; }
 
 	bool postNewResult(int cr, NodeArray<int>* pPos);
-	bool getNextRun();
+
+	void restore(HierarchyLevels& levels, int& cr);
+
+	//! Returns the number of crossings of \p levels.
+	int crossings(HierarchyLevels& levels, LayerByLayerSweep* pCrossMin) const {
+		return (pCrossMin != nullptr) ? levels.updateCrossings()
+									  : levels.calculateCrossingsSimDraw(subgraphs());
+	}
+};
+
+// LayerByLayerSweep::CrossMinWorker
+
+//! The data of a thread performing runs of the crossing minimization.
+class LayerByLayerSweep::CrossMinWorker {
+	LayerByLayerSweep::CrossMinMaster& m_master;
+	LayerByLayerSweep* m_pCrossMin;
+	TwoLayerCrossMinSimDraw* m_pCrossMinSimDraw;
+
+	std::unique_ptr<HierarchyLevels> m_pOwnLevels;
+	HierarchyLevels& m_levels;
+	Array<bool>* m_pLevelChanged;
+
+	NodeArray<int> m_bestPos;
+	minstd_rand m_rng;
+
+public:
+	//! Creates a worker using the given module on \p levels, or on its own levels if \p pLevels is nullptr.
+	CrossMinWorker(LayerByLayerSweep::CrossMinMaster& master, LayerByLayerSweep* pCrossMin,
+			TwoLayerCrossMinSimDraw* pCrossMinSimDraw, HierarchyLevels* pLevels, int seed)
+		: m_master(master)
+		, m_pCrossMin(pCrossMin)
+		, m_pCrossMinSimDraw(pCrossMinSimDraw)
+		, m_pOwnLevels(pLevels == nullptr ? new HierarchyLevels(master.hierarchy()) : nullptr)
+		, m_levels(pLevels == nullptr ? *m_pOwnLevels : *pLevels)
+		, m_pLevelChanged(nullptr)
+		, m_rng(seed) {
+		OGDF_ASSERT((pCrossMin != nullptr && pCrossMinSimDraw == nullptr)
+				|| (pCrossMin == nullptr && pCrossMinSimDraw != nullptr));
+		m_master.initWorker(m_pCrossMin, m_pCrossMinSimDraw, m_levels, m_pLevelChanged);
+	}
+
+	~CrossMinWorker() {
+		delete m_pLevelChanged;
+		if (m_pCrossMin != nullptr) {
+			m_pCrossMin->cleanup();
+		} else {
+			m_pCrossMinSimDraw->cleanup();
+		}
+	}
+
+	void doRun(bool permute) {
+		m_master.doRun(m_pCrossMin, m_pCrossMinSimDraw, m_levels, m_bestPos, permute, m_rng,
+				m_pLevelChanged);
+	}
+
+private:
+	CrossMinWorker(const CrossMinWorker&); // = delete
+	CrossMinWorker& operator=(const CrossMinWorker&); // = delete
 };
 
-LayerByLayerSweep::CrossMinMaster::CrossMinMaster(const SugiyamaLayout& sugi, const Hierarchy& H,
-		int runs)
-	: m_pBestPos(nullptr)
-	, m_bestCR(std::numeric_limits<int>::max())
-	, m_sugi(sugi)
-	, m_H(H)
-	, m_runs(runs) { }
+LayerByLayerSweep::CrossMinMaster::CrossMinMaster(const SugiyamaLayout& sugi, const Hierarchy& H)
+	: m_pBestPos(nullptr), m_bestCR(std::numeric_limits<int>::max()), m_sugi(sugi), m_H(H) { }
 
 bool LayerByLayerSweep::CrossMinMaster::postNewResult(int cr, NodeArray<int>* pPos) {
 	bool storeResult = false;
@@ -613,16 +759,15 @@ bool LayerByLayerSweep::CrossMinMaster::postNewResult(int cr, NodeArray<int>* pP
 		m_pBestPos = pPos;
 		storeResult = true;
 
+		// no run can do better
 		if (cr == 0) {
-			m_runs = 0;
+			m_stop.stop();
 		}
 	}
 
 	return storeResult;
 }
 
-bool LayerByLayerSweep::CrossMinMaster::getNextRun() { return --m_runs >= 0; }
-
 void LayerByLayerSweep::CrossMinMaster::restore(HierarchyLevels& levels, int& cr) {
 	levels.restorePos(*m_pBestPos);
 	cr = m_bestCR;
@@ -696,7 +841,7 @@ int LayerByLayerSweep::CrossMinMaster::traverseTopDown(HierarchyLevels& levels,
 		levels.separateCCs(arrange_numCC(), arrange_compGC());
 	}
 
-	return (pCrossMin != nullptr) ? levels.calculateCrossings()
+	return (pCrossMin != nullptr) ? levels.updateCrossings()
 								  : levels.calculateCrossingsSimDraw(subgraphs());
 }
 
@@ -720,26 +865,50 @@ int LayerByLayerSweep::CrossMinMaster::traverseBottomUp(HierarchyLevels& levels,
 		levels.separateCCs(arrange_numCC(), arrange_compGC());
 	}
 
-	return (pCrossMin != nullptr) ? levels.calculateCrossings()
+	return (pCrossMin != nullptr) ? levels.updateCrossings()
 								  : levels.calculateCrossingsSimDraw(subgraphs());
 }
 
-void LayerByLayerSweep::CrossMinMaster::doWorkHelper(LayerByLayerSweep* pCrossMin,
-		TwoLayerCrossMinSimDraw* pCrossMinSimDraw, HierarchyLevels& levels, NodeArray<int>& bestPos,
-		bool permuteFirst, minstd_rand& rng) {
-	if (permuteFirst) {
-		levels.permute(rng);
-	}
+void LayerByLayerSweep::CrossMinMaster::doRuns(LayerByLayerSweep* pCrossMin,
+		TwoLayerCrossMinSimDraw* pCrossMinSimDraw, HierarchyLevels& levels, int& nCrossings) {
+	const unsigned int nThreads = min(m_sugi.maxThreads(), (unsigned int)m_sugi.runs());
 
-	int nCrossingsOld = (pCrossMin != nullptr) ? levels.calculateCrossings()
-											   : levels.calculateCrossingsSimDraw(subgraphs());
-	if (postNewResult(nCrossingsOld, &bestPos)) {
-		levels.storePos(bestPos);
+	// the modules are cloned before any of them is used, the workers are created by the
+	// threads using them
+	std::vector<std::unique_ptr<LayerByLayerSweep>> crossMinClone(nThreads);
+	std::vector<std::unique_ptr<TwoLayerCrossMinSimDraw>> crossMinSimDrawClone(nThreads);
+	for (unsigned int i = 1; i < nThreads; ++i) {
+		if (pCrossMin != nullptr) {
+			crossMinClone[i].reset(pCrossMin->clone());
+		} else {
+			crossMinSimDrawClone[i].reset(pCrossMinSimDraw->clone());
+		}
 	}
 
-	if (queryBestKnown() == 0) {
-		return;
-	}
+	const int seed = randomSeed();
+	std::vector<std::unique_ptr<CrossMinWorker>> worker(nThreads);
+	WorkStealingPool::instance().run(m_sugi.runs(), nThreads, m_stop,
+			[&](int run, unsigned int slot) {
+				if (!worker[slot]) {
+					worker[slot].reset(slot == 0
+									? new CrossMinWorker(*this, pCrossMin, pCrossMinSimDraw,
+											&levels, seed)
+									: new CrossMinWorker(*this, crossMinClone[slot].get(),
+											crossMinSimDrawClone[slot].get(), nullptr,
+											randomSeed())); // different seeds per worker
+				}
+				worker[slot]->doRun(run > 0 || m_sugi.permuteFirst());
+			});
+
+	restore(levels, nCrossings);
+}
+
+void LayerByLayerSweep::CrossMinMaster::initWorker(LayerByLayerSweep* pCrossMin,
+		TwoLayerCrossMinSimDraw* pCrossMinSimDraw, HierarchyLevels& levels,
+		Array<bool>*& pLevelChanged) {
+	// threads that are not needed for the runs count the crossings of the level pairs
+	const unsigned int nRunThreads = min(m_sugi.maxThreads(), (unsigned int)m_sugi.runs());
+	levels.maxThreads(max(1u, m_sugi.maxThreads() / nRunThreads));
 
 	if (pCrossMin != nullptr) {
 		pCrossMin->init(levels);
@@ -747,97 +916,58 @@ void LayerByLayerSweep::CrossMinMaster::doWorkHelper(LayerByLayerSweep* pCrossMi
 		pCrossMinSimDraw->init(levels);
 	}
 
-	Array<bool>* pLevelChanged = nullptr;
 	if (transpose()) {
 		pLevelChanged = new Array<bool>(-1, levels.size());
 		(*pLevelChanged)[-1] = (*pLevelChanged)[levels.size()] = false;
 	}
+}
 
-	int maxFails = fails();
-	for (;;) {
-		int nFails = maxFails + 1;
-		do {
-			// top-down traversal
-			int nCrossingsNew = traverseTopDown(levels, pCrossMin, pCrossMinSimDraw, pLevelChanged);
-			if (nCrossingsNew < nCrossingsOld) {
-				if (nCrossingsNew < queryBestKnown() && postNewResult(nCrossingsNew, &bestPos)) {
-					levels.storePos(bestPos);
-				}
-
-				nCrossingsOld = nCrossingsNew;
-				nFails = maxFails + 1;
-			} else {
-				--nFails;
-			}
+void LayerByLayerSweep::CrossMinMaster::doRun(LayerByLayerSweep* pCrossMin,
+		TwoLayerCrossMinSimDraw* pCrossMinSimDraw, HierarchyLevels& levels, NodeArray<int>& bestPos,
+		bool permute, minstd_rand& rng, Array<bool>* pLevelChanged) {
+	if (permute) {
+		levels.permute(rng);
+	}
 
-			// bottom-up traversal
-			nCrossingsNew = traverseBottomUp(levels, pCrossMin, pCrossMinSimDraw, pLevelChanged);
-			if (nCrossingsNew < nCrossingsOld) {
-				if (nCrossingsNew < queryBestKnown() && postNewResult(nCrossingsNew, &bestPos)) {
-					levels.storePos(bestPos);
-				}
+	int nCrossingsOld = crossings(levels, pCrossMin);
+	if (nCrossingsOld < queryBestKnown() && postNewResult(nCrossingsOld, &bestPos)) {
+		levels.storePos(bestPos);
+	}
 
-				nCrossingsOld = nCrossingsNew;
-				nFails = maxFails + 1;
-			} else {
-				--nFails;
+	const int maxFails = fails();
+	int nFails = maxFails + 1;
+	// stop as soon as any run reached the lower bound
+	while (nFails > 0 && !m_stop.stopped()) {
+		// top-down traversal
+		int nCrossingsNew = traverseTopDown(levels, pCrossMin, pCrossMinSimDraw, pLevelChanged);
+		if (nCrossingsNew < nCrossingsOld) {
+			if (nCrossingsNew < queryBestKnown() && postNewResult(nCrossingsNew, &bestPos)) {
+				levels.storePos(bestPos);
 			}
 
-		} while (nFails > 0);
+			nCrossingsOld = nCrossingsNew;
+			nFails = maxFails + 1;
+		} else {
+			--nFails;
+		}
 
-		if (!getNextRun()) {
+		if (m_stop.stopped()) {
 			break;
 		}
 
-		levels.permute(rng);
+		// bottom-up traversal
+		nCrossingsNew = traverseBottomUp(levels, pCrossMin, pCrossMinSimDraw, pLevelChanged);
+		if (nCrossingsNew < nCrossingsOld) {
+			if (nCrossingsNew < queryBestKnown() && postNewResult(nCrossingsNew, &bestPos)) {
+				levels.storePos(bestPos);
+			}
 
-		nCrossingsOld = (pCrossMin != nullptr) ? levels.calculateCrossings()
-											   : levels.calculateCrossingsSimDraw(subgraphs());
-		if (nCrossingsOld < queryBestKnown() && postNewResult(nCrossingsOld, &bestPos)) {
-			levels.storePos(bestPos);
+			nCrossingsOld = nCrossingsNew;
+			nFails = maxFails + 1;
+		} else {
+			--nFails;
 		}
 	}
-
-	delete pLevelChanged;
-
-	if (pCrossMin != nullptr) {
-		pCrossMin->cleanup();
-	} else {
-		pCrossMinSimDraw->cleanup();
-	}
-}
-
-// LayerByLayerSweep::CrossMinWorker
-
-class LayerByLayerSweep::CrossMinWorker : public Thread {
-	LayerByLayerSweep::CrossMinMaster& m_master;
-	LayerByLayerSweep* m_pCrossMin;
-	TwoLayerCrossMinSimDraw* m_pCrossMinSimDraw;
-
-	NodeArray<int> m_bestPos;
-
-public:
-	CrossMinWorker(LayerByLayerSweep::CrossMinMaster& master, LayerByLayerSweep* pCrossMin,
-			TwoLayerCrossMinSimDraw* pCrossMinSimDraw)
-		: m_master(master), m_pCrossMin(pCrossMin), m_pCrossMinSimDraw(pCrossMinSimDraw) {
-		OGDF_ASSERT((pCrossMin != nullptr && pCrossMinSimDraw == nullptr)
-				|| (pCrossMin == nullptr && pCrossMinSimDraw != nullptr));
-	}
-
-	~CrossMinWorker() { delete m_pCrossMin; }
-
-	void operator()();
-
-private:
-	CrossMinWorker(const CrossMinWorker&); // = delete
-	CrossMinWorker& operator=(const CrossMinWorker&); // = delete
-};
-
-void LayerByLayerSweep::CrossMinWorker::operator()() {
-	HierarchyLevels levels(m_master.hierarchy());
-
-	minstd_rand rng(randomSeed()); // different seeds per worker
-	m_master.doWorkHelper(m_pCrossMin, m_pCrossMinSimDraw, levels, m_bestPos, true, rng);
 }
 
 SugiyamaLayout::SugiyamaLayout() {
@@ -1252,31 +1382,8 @@ const HierarchyLevels* LayerByLayerSweep::reduceCrossings(const SugiyamaLayout&
 
 	OGDF_ASSERT(sugi.runs() >= 1);
 
-	unsigned int nThreads = min(sugi.maxThreads(), (unsigned int)sugi.runs());
-
-	minstd_rand rng(randomSeed());
-
-	LayerByLayerSweep::CrossMinMaster master(sugi, levels->hierarchy(), sugi.runs() - nThreads);
-
-	Array<LayerByLayerSweep::CrossMinWorker*> worker(nThreads - 1);
-	Array<Thread> thread(nThreads - 1);
-	for (unsigned int i = 0; i < nThreads - 1; ++i) {
-		worker[i] = new LayerByLayerSweep::CrossMinWorker(master, clone(), nullptr);
-		thread[i] = Thread(*worker[i]);
-	}
-
-	NodeArray<int> bestPos;
-	master.doWorkHelper(this, nullptr, *levels, bestPos, sugi.permuteFirst(), rng);
-
-	for (unsigned int i = 0; i < nThreads - 1; ++i) {
-		thread[i].join();
-	}
-
-	master.restore(*levels, nCrossings);
-
-	for (unsigned int i = 0; i < nThreads - 1; ++i) {
-		delete worker[i];
-	}
+	LayerByLayerSweep::CrossMinMaster master(sugi, levels->hierarchy());
+	master.doRuns(this, nullptr, *levels, nCrossings);
 
 	return levels;
 }
@@ -1302,39 +1409,8 @@ const HierarchyLevelsBase* SugiyamaLayout::reduceCrossings(Hierarchy& H) {
 	int64_t t;
 	System::usedRealTime(t);
 
-	LayerByLayerSweep* pCrossMin = nullptr;
-	TwoLayerCrossMinSimDraw* pCrossMinSimDraw = nullptr;
-
-	pCrossMinSimDraw = m_crossMinSimDraw.get();
-
-	unsigned int nThreads = min(m_maxThreads, (unsigned int)m_runs);
-
-	int seed = rand();
-	minstd_rand rng(seed);
-
-	LayerByLayerSweep::CrossMinMaster master(*this, levels.hierarchy(), m_runs - nThreads);
-
-	Array<LayerByLayerSweep::CrossMinWorker*> worker(nThreads - 1);
-	Array<Thread> thread(nThreads - 1);
-	for (unsigned int i = 0; i < nThreads - 1; ++i) {
-		worker[i] = new LayerByLayerSweep::CrossMinWorker(master,
-				(pCrossMin != nullptr) ? pCrossMin->clone() : nullptr,
-				(pCrossMinSimDraw != nullptr) ? pCrossMinSimDraw->clone() : nullptr);
-		thread[i] = Thread(*worker[i]);
-	}
-
-	NodeArray<int> bestPos;
-	master.doWorkHelper(pCrossMin, pCrossMinSimDraw, levels, bestPos, m_permuteFirst, rng);
-
-	for (unsigned int i = 0; i < nThreads - 1; ++i) {
-		thread[i].join();
-	}
-
-	master.restore(levels, m_nCrossings);
-
-	for (unsigned int i = 0; i < nThreads - 1; ++i) {
-		delete worker[i];
-	}
+	LayerByLayerSweep::CrossMinMaster master(*this, levels.hierarchy());
+	master.doRuns(nullptr, m_crossMinSimDraw.get(), levels, m_nCrossings);
 
 	t = System::usedRealTime(t);
 	m_timeReduceCrossings = double(t) / 1000;
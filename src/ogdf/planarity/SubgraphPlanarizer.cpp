@@ -38,6 +38,7 @@
 #include <ogdf/basic/SList.h>
 #include <ogdf/basic/System.h>
 #include <ogdf/basic/Thread.h>
+#include <ogdf/basic/WorkStealingPool.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/extended_graph_alg.h>
 #include <ogdf/planarity/CrossingMinimizationModule.h>
@@ -52,7 +53,6 @@
 #include <ogdf/planarity/embedder/CrossingStructure.h>
 
 #include <algorithm>
-#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -60,8 +60,8 @@
 #include <mutex>
 #include <random>
 #include <utility>
+#include <vector>
 
-using std::atomic;
 using std::lock_guard;
 using std::minstd_rand;
 using std::mutex;
@@ -83,14 +83,14 @@ class SubgraphPlanarizer::ThreadMaster {
 	const List<edge>& m_delEdges;
 
 	int m_seed;
-	atomic<int> m_perms;
 	int64_t m_stopTime;
+	WorkStealingPool::StopFlag m_stop;
 	mutex m_mutex;
 
 public:
 	ThreadMaster(const PlanRep& pr, int cc, const EdgeArray<int>* pCost,
 			const EdgeArray<bool>* pForbid, const EdgeArray<uint32_t>* pEdgeSubGraphs,
-			const List<edge>& delEdges, int seed, int perms, int64_t stopTime);
+			const List<edge>& delEdges, int seed, int64_t stopTime);
 
 	~ThreadMaster() { delete m_pCS; }
 
@@ -110,24 +110,31 @@ public:
 
 	int queryBestKnown() const { return m_bestCR; }
 
+	WorkStealingPool::StopFlag& stopFlag() { return m_stop; }
+
 	CrossingStructure* postNewResult(CrossingStructure* pCS);
-	bool getNextPerm();
+
+	//! Stops the remaining permutations if the time limit is exceeded.
+	void checkTimeout();
 
 	void restore(PlanRep& pr, int& cr);
 };
 
+//! The data of a thread performing permutations.
 class SubgraphPlanarizer::Worker {
-	int m_id;
-	ThreadMaster* m_pMaster;
-	EdgeInsertionModule* m_pInserter;
+	ThreadMaster& m_master;
+	EdgeInsertionModule& m_inserter;
+	minstd_rand m_rng;
 
-public:
-	Worker(int id, ThreadMaster* pMaster, EdgeInsertionModule* pInserter)
-		: m_id(id), m_pMaster(pMaster), m_pInserter(pInserter) { }
+	PlanRepLight m_prl;
+	Array<edge> m_deletedEdges;
 
-	~Worker() { delete m_pInserter; }
+public:
+	//! Creates a worker using \p inserter, which must not be used by any other worker.
+	Worker(ThreadMaster& master, EdgeInsertionModule& inserter, int seed);
 
-	void operator()();
+	//! Performs one permutation and posts its result to the master.
+	void doPermutation();
 
 private:
 	Worker(const Worker& other); // = delete
@@ -136,7 +143,7 @@ private:
 
 SubgraphPlanarizer::ThreadMaster::ThreadMaster(const PlanRep& pr, int cc, const EdgeArray<int>* pCost,
 		const EdgeArray<bool>* pForbid, const EdgeArray<uint32_t>* pEdgeSubGraphs,
-		const List<edge>& delEdges, int seed, int perms, int64_t stopTime)
+		const List<edge>& delEdges, int seed, int64_t stopTime)
 	: m_pCS(nullptr)
 	, m_bestCR(std::numeric_limits<int>::max())
 	, m_pr(pr)
@@ -146,7 +153,6 @@ SubgraphPlanarizer::ThreadMaster::ThreadMaster(const PlanRep& pr, int cc, const
 	, m_pEdgeSubGraph(pEdgeSubGraphs)
 	, m_delEdges(delEdges)
 	, m_seed(seed)
-	, m_perms(perms)
 	, m_stopTime(stopTime) { }
 
 CrossingStructure* SubgraphPlanarizer::ThreadMaster::postNewResult(CrossingStructure* pCS) {
@@ -157,17 +163,20 @@ CrossingStructure* SubgraphPlanarizer::ThreadMaster::postNewResult(CrossingStruc
 	if (newCR < m_bestCR) {
 		std::swap(pCS, m_pCS);
 		m_bestCR = newCR;
+
+		// no permutation can do better
+		if (newCR == 0) {
+			m_stop.stop();
+		}
 	}
 
 	return pCS;
 }
 
-bool SubgraphPlanarizer::ThreadMaster::getNextPerm() {
+void SubgraphPlanarizer::ThreadMaster::checkTimeout() {
 	if (m_stopTime >= 0 && System::realTime() >= m_stopTime) {
-		return false;
+		m_stop.stop();
 	}
-
-	return --m_perms >= 0;
 }
 
 void SubgraphPlanarizer::ThreadMaster::restore(PlanRep& pr, int& cr) {
@@ -205,41 +214,30 @@ bool SubgraphPlanarizer::doSinglePermutation(PlanRepLight& prl, int cc, const Ed
 	return true;
 }
 
-void SubgraphPlanarizer::doWorkHelper(ThreadMaster& master, EdgeInsertionModule& inserter,
-		minstd_rand& rng) {
-	const List<edge>& delEdges = master.delEdges();
-
-	const int m = delEdges.size();
-	Array<edge> deletedEdges(m);
+SubgraphPlanarizer::Worker::Worker(ThreadMaster& master, EdgeInsertionModule& inserter, int seed)
+	: m_master(master)
+	, m_inserter(inserter)
+	, m_rng(seed)
+	, m_prl(master.planRep())
+	, m_deletedEdges(master.delEdges().size()) {
 	int j = 0;
-	for (edge e : delEdges) {
-		deletedEdges[j++] = e;
+	for (edge e : master.delEdges()) {
+		m_deletedEdges[j++] = e;
 	}
-
-	PlanRepLight prl(master.planRep());
-	int cc = master.currentCC();
-
-	const EdgeArray<int>* pCost = master.cost();
-	const EdgeArray<bool>* pForbid = master.forbid();
-	const EdgeArray<uint32_t>* pEdgeSubGraphs = master.edgeSubGraphs();
-
-	do {
-		int crossingNumber;
-		if (doSinglePermutation(prl, cc, pCost, pForbid, pEdgeSubGraphs, deletedEdges, inserter,
-					rng, crossingNumber)
-				&& crossingNumber < master.queryBestKnown()) {
-			CrossingStructure* pCS = new CrossingStructure;
-			pCS->init(prl, crossingNumber);
-			pCS = master.postNewResult(pCS);
-			delete pCS;
-		}
-
-	} while (master.getNextPerm());
 }
 
-void SubgraphPlanarizer::Worker::operator()() {
-	minstd_rand rng(m_pMaster->rseed(11 + 7 * m_id)); // different seeds per thread
-	doWorkHelper(*m_pMaster, *m_pInserter, rng);
+void SubgraphPlanarizer::Worker::doPermutation() {
+	int crossingNumber;
+	if (doSinglePermutation(m_prl, m_master.currentCC(), m_master.cost(), m_master.forbid(),
+				m_master.edgeSubGraphs(), m_deletedEdges, m_inserter, m_rng, crossingNumber)
+			&& crossingNumber < m_master.queryBestKnown()) {
+		CrossingStructure* pCS = new CrossingStructure;
+		pCS->init(m_prl, crossingNumber);
+		pCS = m_master.postNewResult(pCS);
+		delete pCS;
+	}
+
+	m_master.checkTimeout();
 }
 
 // default constructor
@@ -354,21 +352,25 @@ Module::ReturnType SubgraphPlanarizer::doCall(PlanRep& pr, int cc, const EdgeArr
 		// Parallel implementation
 		//
 		ThreadMaster master(pr, cc, pCostOrig, pForbiddenOrig, pEdgeSubGraphs, delEdges, seed,
-				m_permutations - nThreads, stopTime);
-
-		Array<Worker*> worker(nThreads - 1);
-		Array<Thread> thread(nThreads - 1);
-		for (unsigned int i = 0; i < nThreads - 1; ++i) {
-			worker[i] = new Worker(i, &master, inserter.clone());
-			thread[i] = Thread(*worker[i]);
-		}
-
-		doWorkHelper(master, inserter, rng);
+				stopTime);
 
-		for (unsigned int i = 0; i < nThreads - 1; ++i) {
-			thread[i].join();
-			delete worker[i];
+		// the inserters are cloned before any of them is used, the workers are created by
+		// the threads using them
+		std::vector<std::unique_ptr<EdgeInsertionModule>> inserterClone(nThreads);
+		for (unsigned int i = 1; i < nThreads; ++i) {
+			inserterClone[i].reset(inserter.clone());
 		}
+		std::vector<std::unique_ptr<Worker>> worker(nThreads);
+		WorkStealingPool::instance().run(m_permutations, nThreads, master.stopFlag(),
+				[&](int, unsigned int slot) {
+					if (!worker[slot]) {
+						worker[slot].reset(slot == 0
+										? new Worker(master, inserter, seed)
+										: new Worker(master, *inserterClone[slot],
+												master.rseed(11 + 7 * (slot - 1))));
+					}
+					worker[slot]->doPermutation();
+				});
 
 		master.restore(pr, crossingNumber);
 
@@ -396,6 +398,11 @@ Module::ReturnType SubgraphPlanarizer::doCall(PlanRep& pr, int cc, const EdgeArr
 				cs.init(prl, cr);
 			}
 
+			// no permutation can do better
+			if (foundSolution && cs.weightedCrossingNumber() == 0) {
+				break;
+			}
+
 			if (stopTime >= 0 && System::realTime() >= stopTime) {
 				if (!foundSolution) {
 					return ReturnType::TimeoutInfeasible; // not able to find a solution...
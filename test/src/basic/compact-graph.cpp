@@ -0,0 +1,181 @@
+/** \file
+ * \brief Tests for ogdf::CompactGraph and the algorithms running on it
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/CompactGraph.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphList.h>
+#include <ogdf/basic/basic.h>
+#include <ogdf/graphalg/DistanceMatrix.h>
+#include <ogdf/graphalg/PageRank.h>
+#include <ogdf/graphalg/ShortestPathAlgorithms.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <graphs.h>
+
+#include <testing.h>
+
+go_bandit([] {
+	describe("CompactGraph", [] {
+		forEachGraphItWorks({}, [](const Graph& G) {
+			CompactGraph CG(G);
+
+			AssertThat(CG.numberOfNodes(), Equals(G.numberOfNodes()));
+			AssertThat(CG.numberOfEdges(), Equals(G.numberOfEdges()));
+			AssertThat(CG.maxNodeIndex(), Equals(G.maxNodeIndex()));
+			AssertThat(CG.maxEdgeIndex(), Equals(G.maxEdgeIndex()));
+
+			int k = 0;
+			for (node v : G.nodes) {
+				AssertThat(CG.nodes()[k++], Equals(v->index()));
+				AssertThat(CG.original(v->index()), Equals(v));
+				AssertThat(CG.degree(v->index()), Equals(v->degree()));
+
+				int i = CG.firstAdj(v->index());
+				for (adjEntry adj : v->adjEntries) {
+					AssertThat(CG.twinNode(i), Equals(adj->twinNode()->index()));
+					AssertThat(CG.originalEdge(CG.edgeIndex(i)), Equals(adj->theEdge()));
+					AssertThat(CG.isOutgoing(i), Equals(adj->isSource()));
+					++i;
+				}
+				AssertThat(i, Equals(CG.stopAdj(v->index())));
+			}
+		});
+
+		forEachGraphItWorks({}, [](const Graph& G) {
+			CompactGraph CG(G);
+			for (node s : G.nodes) {
+				NodeArray<int> expected(G, -1);
+				NodeArray<int> actual(G, -1);
+				bfs_SPSS(s, G, expected, 1);
+				bfs_SPSS(s, CG, actual, 1);
+				for (node v : G.nodes) {
+					AssertThat(actual[v], Equals(expected[v]));
+				}
+			}
+		});
+
+		forEachGraphItWorks({}, [](const Graph& G) {
+			CompactGraph CG(G);
+			EdgeArray<double> cost(G);
+			for (edge e : G.edges) {
+				cost[e] = 1 + e->index() % 7;
+			}
+			for (node s : G.nodes) {
+				NodeArray<double> expected;
+				NodeArray<double> actual;
+				dijkstra_SPSS(s, G, expected, cost);
+				dijkstra_SPSS(s, CG, actual, cost);
+				for (node v : G.nodes) {
+					AssertThat(actual[v], Equals(expected[v]));
+				}
+			}
+		});
+
+		forEachGraphItWorks({GraphProperty::connected}, [](const Graph& G) {
+			if (G.numberOfEdges() == 0) {
+				return;
+			}
+			CompactGraph CG(G);
+			EdgeArray<double> weight(G, 1.0);
+			BasicPageRank pageRank;
+			NodeArray<double> expected;
+			NodeArray<double> actual;
+			pageRank.call(G, weight, expected);
+			pageRank.call(CG, weight, actual);
+			for (node v : G.nodes) {
+				if (std::isnan(expected[v])) {
+					AssertThat(std::isnan(actual[v]), IsTrue());
+				} else {
+					AssertThat(actual[v], EqualsWithDelta(expected[v], 1e-9));
+				}
+			}
+		});
+	});
+
+	describe("DistanceMatrix", [] {
+		for (unsigned int threads : {1, 3}) {
+			describe("computed with " + std::to_string(threads) + " threads", [threads] {
+				forEachGraphItWorks({}, [threads](const Graph& G) {
+					CompactGraph CG(G);
+					DistanceMatrix<int> hops;
+					DistanceMatrix<uint16_t> compressedHops;
+					bfs_SPAP(CG, hops, 2, threads);
+					bfs_SPAP(CG, compressedHops, uint16_t(2), threads);
+					AssertThat(hops.dimension(), Equals(G.maxNodeIndex() + 1));
+					for (node s : G.nodes) {
+						NodeArray<int> expected(G, -1);
+						bfs_SPSS(s, CG, expected, 2);
+						for (node v : G.nodes) {
+							if (expected[v] < 0) {
+								AssertThat(hops(s, v), Equals(DistanceMatrix<int>::unreachable()));
+								AssertThat(compressedHops(s, v),
+										Equals(DistanceMatrix<uint16_t>::unreachable()));
+							} else {
+								AssertThat(hops(s, v), Equals(expected[v]));
+								AssertThat(compressedHops(s, v), Equals(expected[v]));
+							}
+						}
+					}
+				});
+
+				forEachGraphItWorks({}, [threads](const Graph& G) {
+					CompactGraph CG(G);
+					EdgeArray<double> cost(G);
+					EdgeArray<float> compressedCost(G);
+					for (edge e : G.edges) {
+						cost[e] = compressedCost[e] = 1 + e->index() % 7;
+					}
+					DistanceMatrix<double> distance;
+					DistanceMatrix<float> compressedDistance;
+					dijkstra_SPAP(CG, distance, cost, threads);
+					dijkstra_SPAP(CG, compressedDistance, compressedCost, threads);
+					for (node s : G.nodes) {
+						NodeArray<double> expected;
+						dijkstra_SPSS(s, CG, expected, cost);
+						for (node v : G.nodes) {
+							if (expected[v] == std::numeric_limits<double>::max()) {
+								AssertThat(distance(s, v),
+										Equals(DistanceMatrix<double>::unreachable()));
+								AssertThat(compressedDistance(s, v),
+										Equals(DistanceMatrix<float>::unreachable()));
+							} else {
+								AssertThat(distance(s, v), Equals(expected[v]));
+								AssertThat(compressedDistance(s, v), Equals(float(expected[v])));
+							}
+						}
+					}
+				});
+			});
+		}
+	});
+});
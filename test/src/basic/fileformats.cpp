@@ -43,6 +43,8 @@
 #include <ogdf/basic/simple_graph_alg.h>
 #include <ogdf/cluster/ClusterGraph.h>
 #include <ogdf/cluster/ClusterGraphAttributes.h>
+#include <ogdf/fileformats/DotParser.h>
+#include <ogdf/fileformats/GexfParser.h>
 #include <ogdf/fileformats/GraphIO.h>
 #include <ogdf/graphalg/steiner_tree/EdgeWeightedGraph.h>
 
@@ -852,6 +854,16 @@ void describeGML() {
 		describeGAFormat("GML", GraphIO::readGML, GraphIO::writeGML, false, GraphAttributes::all);
 		describeClusterGAFormat(GraphIO::readGML, GraphIO::writeGML, ClusterGraphAttributes::all);
 
+		it("reads edges that precede their nodes", [] {
+			stringstream read {"graph [ edge [ source 7 target 3 ] node [ id 3 ] node [ id 7 ] ]"};
+			Graph G;
+			AssertThat(GraphIO::readGML(G, read), IsTrue());
+			AssertThat(G.numberOfNodes(), Equals(2));
+			AssertThat(G.numberOfEdges(), Equals(1));
+			AssertThat(G.firstEdge()->source(), Equals(G.lastNode()));
+			AssertThat(G.firstEdge()->target(), Equals(G.firstNode()));
+		});
+
 		describe("cluster specific issue handling", [&] {
 			for_each_file("fileformats/gml/cluster", [&](const ResourceFile* file) {
 				it("detects errors in " + file->fullPath(), [&]() {
@@ -910,8 +922,137 @@ void describeGraph6() {
 }
 
 void describeMatrixMarket() {
-	describe("MatrixMarket",
-			[] { describeFormat("MatrixMarket", GraphIO::readMatrixMarket, nullptr, false); });
+	describe("MatrixMarket", [] {
+		describeFormat("MatrixMarket", GraphIO::readMatrixMarket, nullptr, false);
+
+		for (unsigned int numThreads : {1, 3, 16}) {
+			it("reads memory-mapped files using " + to_string(numThreads) + " threads", [numThreads] {
+				const string filename = "mapped-graph.mtx";
+				std::ostringstream content;
+				content << "%%MatrixMarket matrix coordinate real general\n% comment\n\n30 30 60\n";
+				for (int i = 0; i < 60; ++i) {
+					content << (7 * i) % 30 + 1 << " " << (11 * i + 3) % 30 + 1 << " 0.5\n";
+				}
+				content << "4 4 1.0"; // no final line break
+				{
+					std::ofstream os(filename);
+					os << content.str();
+				}
+
+				Graph expected;
+				std::istringstream is(content.str());
+				AssertThat(GraphIO::readMatrixMarket(expected, is), IsTrue());
+
+				Graph G;
+				AssertThat(GraphIO::readMatrixMarketMapped(G, filename, numThreads), IsTrue());
+				std::remove(filename.c_str());
+
+				AssertThat(G.numberOfNodes(), Equals(expected.numberOfNodes()));
+				AssertThat(G.numberOfEdges(), Equals(expected.numberOfEdges()));
+				for (edge e = G.firstEdge(), f = expected.firstEdge(); e != nullptr;
+						e = e->succ(), f = f->succ()) {
+					AssertThat(e->source()->index(), Equals(f->source()->index()));
+					AssertThat(e->target()->index(), Equals(f->target()->index()));
+				}
+			});
+		}
+
+		it("rejects malformed memory-mapped files", [] {
+			const string filename = "mapped-graph.mtx";
+			{
+				std::ofstream os(filename);
+				os << "3 3 2\n1 2\n2 x\n";
+			}
+			Graph G;
+			AssertThat(GraphIO::readMatrixMarketMapped(G, filename), IsFalse());
+			std::remove(filename.c_str());
+			AssertThat(GraphIO::readMatrixMarketMapped(G, filename), IsFalse());
+		});
+	});
+
+	describe("Edge list", [] {
+		it("reads memory-mapped files in parallel", [] {
+			const string filename = "mapped-graph.txt";
+			{
+				std::ofstream os(filename);
+				os << "# SNAP style comment\n";
+				for (int i = 0; i < 100; ++i) {
+					os << 1000 * ((5 * i) % 40) << "\t" << 1000 * ((3 * i + 1) % 40) << "\n";
+				}
+			}
+			Graph G;
+			AssertThat(GraphIO::readEdgeListMapped(G, filename, 4), IsTrue());
+			std::remove(filename.c_str());
+
+			AssertThat(G.numberOfNodes(), Equals(40));
+			AssertThat(G.numberOfEdges(), Equals(100));
+			// nodes are created in the order of their first occurrence
+			AssertThat(G.firstEdge()->source(), Equals(G.firstNode()));
+			AssertThat(G.firstEdge()->target(), Equals(G.firstNode()->succ()));
+		});
+	});
+}
+
+void describeBinary() {
+	describe("Binary", [] {
+		describeFormat("Binary", GraphIO::readBinary, GraphIO::writeBinary, false);
+		describeGAFormat("Binary", GraphIO::readBinary, GraphIO::writeBinary, false,
+				GraphAttributes::all);
+		describeClusterGAFormat(GraphIO::readBinary, GraphIO::writeBinary,
+				ClusterGraphAttributes::all);
+
+		it("preserves the order of the adjacency lists", [] {
+			Graph G;
+			randomGraph(G, 30, 90);
+			for (node v : G.nodes) {
+				List<adjEntry> order;
+				v->allAdjEntries(order);
+				order.permute();
+				G.sort(v, order);
+			}
+
+			std::ostringstream write;
+			AssertThat(GraphIO::writeBinary(G, write), IsTrue());
+			Graph G2;
+			std::istringstream read(write.str());
+			AssertThat(GraphIO::readBinary(G2, read), IsTrue());
+
+			EdgeArray<int> position(G);
+			int i = 0;
+			for (edge e : G.edges) {
+				position[e] = i++;
+			}
+			EdgeArray<int> position2(G2);
+			i = 0;
+			for (edge e : G2.edges) {
+				position2[e] = i++;
+			}
+
+			AssertThat(G2.numberOfNodes(), Equals(G.numberOfNodes()));
+			AssertThat(G2.numberOfEdges(), Equals(G.numberOfEdges()));
+			for (node v = G.firstNode(), v2 = G2.firstNode(); v != nullptr;
+					v = v->succ(), v2 = v2->succ()) {
+				AssertThat(v2->degree(), Equals(v->degree()));
+				for (adjEntry adj = v->firstAdj(), adj2 = v2->firstAdj(); adj != nullptr;
+						adj = adj->succ(), adj2 = adj2->succ()) {
+					AssertThat(position2[adj2->theEdge()], Equals(position[adj->theEdge()]));
+					AssertThat(adj2->isSource(), Equals(adj->isSource()));
+				}
+			}
+		});
+
+		it("rejects truncated input", [] {
+			Graph G;
+			randomGraph(G, 20, 40);
+			std::ostringstream write;
+			AssertThat(GraphIO::writeBinary(G, write), IsTrue());
+			string data = write.str();
+
+			Graph G2;
+			std::istringstream read(data.substr(0, data.size() - 8));
+			AssertThat(GraphIO::readBinary(G2, read), IsFalse());
+		});
+	});
 }
 
 void describeRudy() {
@@ -925,6 +1066,51 @@ void describeGraphML() {
 		describeFormat("GraphML", GraphIO::readGraphML, GraphIO::writeGraphML, true);
 		describeGAFormatPerEdgeWeightType("GraphML", GraphIO::readGraphML, GraphIO::writeGraphML,
 				true, GraphAttributes::all);
+
+		describe("streaming", [] {
+			it("reads edges that precede their nodes", [] {
+				stringstream read {R"(<?xml version="1.0"?>
+<!-- edges first -->
+<graphml>
+	<key id="l" for="edge" attr.name="label"/>
+	<graph edgedefault="undirected">
+		<edge source="b" target="a"><data key="l">x &amp; &#x79;</data></edge>
+		<node id="a"/>
+		<node id="b"/>
+	</graph>
+</graphml>)"};
+				Graph G;
+				GraphAttributes GA(G, GraphAttributes::edgeLabel);
+				AssertThat(GraphIO::readGraphML(GA, G, read), IsTrue());
+				AssertThat(G.numberOfNodes(), Equals(2));
+				AssertThat(G.numberOfEdges(), Equals(1));
+				AssertThat(G.firstEdge()->source(), Equals(G.lastNode()));
+				AssertThat(GA.label(G.firstEdge()), Equals("x & y"));
+				AssertThat(GA.directed(), IsFalse());
+			});
+
+			it("flattens nested graphs", [] {
+				stringstream read {R"(<graphml><graph>
+	<node id="a"><graph><node id="b"/><node id="c"/><edge source="b" target="c"/></graph></node>
+	<node id="d"><data key="unknown"><![CDATA[ <text> ]]></data></node>
+	<edge source="a" target="d"/>
+</graph></graphml>)"};
+				Graph G;
+				AssertThat(GraphIO::readGraphML(G, read), IsTrue());
+				AssertThat(G.numberOfNodes(), Equals(4));
+				AssertThat(G.numberOfEdges(), Equals(2));
+			});
+
+			it("detects malformed XML", [] {
+				for (string input : {"<graphml><graph><node id=\"a\"></graph></graphml>",
+							 "<graphml><graph><node id=\"a\"/>", "<graphml><graph><node id=a/>",
+							 "<graphml><graph><edge source=\"a\" target=\"b\"/></graph></graphml>"}) {
+					stringstream read {input};
+					Graph G;
+					AssertThat(GraphIO::readGraphML(G, read), IsFalse());
+				}
+			});
+		});
 	});
 }
 
@@ -961,6 +1147,65 @@ void describeDOTSpecialCases() {
 		AssertThat(CGA.label(CG.rootCluster()), Equals("wat"));
 	});
 
+	describe("parallel parsing", [] {
+		std::ostringstream dot;
+		dot << "digraph G {\n";
+		for (int i = 0; i < 200; ++i) {
+			dot << "  n" << i << " [label=\"node " << i << "\"];\n";
+			dot << "  node [shape=box]\n";
+			dot << "  n" << i << " -> n" << (7 * i) % 200 << " [label=e" << i << "];\n";
+			if (i % 20 == 0) {
+				dot << "  subgraph cluster" << i << " { label=c" << i << "; n" << i + 1 << "; n"
+					<< i + 2 << " }\n";
+			}
+		}
+		dot << "}\n";
+		const string text = dot.str();
+
+		auto read = [&](const string& input, unsigned int numThreads, ClusterGraphAttributes& CGA,
+							ClusterGraph& CG, Graph& G) {
+			std::istringstream is(input);
+			dot::Parser parser(is, numThreads);
+			return parser.read(G, CG, CGA);
+		};
+
+		for (unsigned int numThreads : {2, 3, 16}) {
+			it("builds the same graph with " + to_string(numThreads) + " threads", [&, numThreads] {
+				Graph G1, G2;
+				ClusterGraph CG1(G1), CG2(G2);
+				ClusterGraphAttributes CGA1(CG1, ClusterGraphAttributes::all);
+				ClusterGraphAttributes CGA2(CG2, ClusterGraphAttributes::all);
+				AssertThat(read(text, 1, CGA1, CG1, G1), IsTrue());
+				AssertThat(read(text, numThreads, CGA2, CG2, G2), IsTrue());
+
+				AssertThat(G2.numberOfNodes(), Equals(G1.numberOfNodes()));
+				AssertThat(G2.numberOfEdges(), Equals(G1.numberOfEdges()));
+				AssertThat(CG2.numberOfClusters(), Equals(CG1.numberOfClusters()));
+				for (node v1 = G1.firstNode(), v2 = G2.firstNode(); v1 != nullptr;
+						v1 = v1->succ(), v2 = v2->succ()) {
+					AssertThat(CGA2.label(v2), Equals(CGA1.label(v1)));
+					AssertThat(CGA2.shape(v2), Equals(CGA1.shape(v1)));
+					AssertThat(CG2.clusterOf(v2)->depth(), Equals(CG1.clusterOf(v1)->depth()));
+				}
+				for (edge e1 = G1.firstEdge(), e2 = G2.firstEdge(); e1 != nullptr;
+						e1 = e1->succ(), e2 = e2->succ()) {
+					AssertThat(CGA2.label(e2), Equals(CGA1.label(e1)));
+					AssertThat(CGA2.label(e2->source()), Equals(CGA1.label(e1->source())));
+					AssertThat(CGA2.label(e2->target()), Equals(CGA1.label(e1->target())));
+				}
+			});
+
+			it("detects errors with " + to_string(numThreads) + " threads", [&, numThreads] {
+				string broken = text;
+				broken.insert(broken.find('\n', broken.size() / 2) + 1, " -> ;\n");
+				Graph G;
+				ClusterGraph CG(G);
+				ClusterGraphAttributes CGA(CG, ClusterGraphAttributes::all);
+				AssertThat(read(broken, numThreads, CGA, CG, G), IsFalse());
+			});
+		}
+	});
+
 	{ // a scope for the variables to deal with arrow types
 		std::stringstream is {ResourceFile::get("fileformats/dot/valid/arrowtypes.dot")->data()};
 		Graph G;
@@ -1001,6 +1246,27 @@ void describeGEXF() {
 		describeFormat("GEXF", GraphIO::readGEXF, GraphIO::writeGEXF, true);
 		describeGAFormatPerEdgeWeightType("GEXF", GraphIO::readGEXF, GraphIO::writeGEXF, true,
 				GraphAttributes::all);
+
+		for_each_file("fileformats/gexf/valid", [](const ResourceFile* file) {
+			it("reads " + file->fullPath() + " like the document based parser", [file] {
+				Graph G[2];
+				GraphAttributes GA[2];
+				for (int i : {0, 1}) {
+					GA[i].init(G[i], GraphAttributes::all);
+					stringstream read {file->data()};
+					gexf::Parser parser(read, i == 1);
+					AssertThat(parser.read(G[i], GA[i]), IsTrue());
+				}
+
+				AssertThat(G[1].numberOfNodes(), Equals(G[0].numberOfNodes()));
+				AssertThat(G[1].numberOfEdges(), Equals(G[0].numberOfEdges()));
+				for (node v = G[0].firstNode(), w = G[1].firstNode(); v; v = v->succ(), w = w->succ()) {
+					AssertThat(GA[1].label(w), Equals(GA[0].label(v)));
+					AssertThat(GA[1].x(w), Equals(GA[0].x(v)));
+					AssertThat(GA[1].fillColor(w), Equals(GA[0].fillColor(v)));
+				}
+			});
+		});
 	});
 }
 
@@ -1438,6 +1704,7 @@ void describeSpecificFormats() {
 	describeYGraph();
 	describeGraph6();
 	describeMatrixMarket();
+	describeBinary();
 	describeRudy();
 	// TODO: BENCH (only very restrictive reader; point-based expansion of a hypergraph)
 	// TODO: PLA (only very restrictive reader; point-based expansion of a hypergraph)
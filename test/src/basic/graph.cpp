@@ -42,6 +42,7 @@
 #include <initializer_list>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <resources.h>
@@ -279,6 +280,77 @@ go_bandit([]() {
 			delete[] visited;
 		});
 
+		it("adds nodes and edges in bulk", []() {
+			Graph graph;
+			NodeArray<int> nodeLabel(graph, -1);
+			EdgeArray<int> edgeLabel(graph, -1);
+			AdjEntryArray<int> adjLabel(graph, -1);
+
+			struct BatchObserver : public GraphObserver {
+				int nodeBatches = 0, edgeBatches = 0, nodes = 0, edges = 0;
+
+				void nodeDeleted(node) override { }
+
+				void nodeAdded(node) override { ++nodes; }
+
+				void edgeDeleted(edge) override { }
+
+				void edgeAdded(edge) override { ++edges; }
+
+				void cleared() override { }
+
+				void nodesAdded(node first, node last) override {
+					++nodeBatches;
+					GraphObserver::nodesAdded(first, last);
+				}
+
+				void edgesAdded(edge first, edge last) override {
+					++edgeBatches;
+					GraphObserver::edgesAdded(first, last);
+				}
+			} observer;
+			observer.reregister(&graph);
+
+			Array<node> created;
+			graph.newNodes(100, created);
+			AssertThat(created.size(), Equals(100));
+			AssertThat(graph.numberOfNodes(), Equals(100));
+			AssertThat(graph.firstNode(), Equals(created[0]));
+			AssertThat(graph.lastNode(), Equals(created[99]));
+
+			std::vector<std::pair<node, node>> endPoints;
+			for (int i = 0; i < 100; i++) {
+				for (int j = i; j < 100; j += 7) {
+					endPoints.emplace_back(created[i], created[j]);
+				}
+			}
+			graph.newEdge(created[0], created[1]);
+			int count = graph.newEdges(endPoints.begin(), endPoints.end());
+			AssertThat(count, Equals(static_cast<int>(endPoints.size())));
+			AssertThat(graph.numberOfEdges(), Equals(count + 1));
+#ifdef OGDF_DEBUG
+			graph.consistencyCheck();
+#endif
+
+			edge e = graph.firstEdge()->succ();
+			for (const auto& p : endPoints) {
+				AssertThat(e->source(), Equals(p.first));
+				AssertThat(e->target(), Equals(p.second));
+				AssertThat(edgeLabel[e], Equals(-1));
+				AssertThat(adjLabel[e->adjSource()], Equals(-1));
+				AssertThat(adjLabel[e->adjTarget()], Equals(-1));
+				e = e->succ();
+			}
+			for (node v : graph.nodes) {
+				AssertThat(nodeLabel[v], Equals(-1));
+			}
+
+			AssertThat(observer.nodeBatches, Equals(1));
+			AssertThat(observer.nodes, Equals(100));
+			AssertThat(observer.edgeBatches, Equals(1));
+			AssertThat(observer.edges, Equals(count + 1));
+		});
+
 		it("doesn't duplicate self-loops", []() {
 			Graph graph;
 
@@ -33,6 +33,7 @@
 #include <ogdf/basic/Thread.h>
 #include <ogdf/basic/basic.h>
 #include <ogdf/basic/memory.h>
+#include <ogdf/basic/memory/ArenaMemoryAllocator.h>
 #include <ogdf/basic/memory/PoolMemoryAllocator.h>
 
 #include <algorithm>
@@ -234,10 +235,135 @@ go_bandit([] {
 #endif
 				);
 			},
-#ifdef OGDF_MEMORY_MALLOC_TS
+#if defined(OGDF_MEMORY_MALLOC_TS) || defined(OGDF_MEMORY_ARENA_TS)
 			true
 #else
 			false
 #endif
 	);
+
+	describe(
+			"PoolMemoryManager trimming",
+			[] {
+				using Object = OGDFObject<248>;
+
+				auto allocateAndDelete = [] {
+					std::vector<Object*> objects;
+					for (int i = 0; i < 1000; ++i) {
+						objects.push_back(new Object());
+					}
+					for (auto object : objects) {
+						delete object;
+					}
+				};
+
+				it("reports counters per size", [&] {
+					std::vector<PoolSizeClassStatistics> before;
+					PoolMemoryAllocator::getSizeClassStatistics(before);
+					allocateAndDelete();
+					std::vector<PoolSizeClassStatistics> after;
+					PoolMemoryAllocator::getSizeClassStatistics(after);
+
+					AssertThat(after.size(), Equals(before.size()));
+					AssertThat(after[248].allocations - before[248].allocations, Equals(1000u));
+					AssertThat(after[248].live, Equals(before[248].live));
+					AssertThat(after[248].blocks, IsGreaterThan(0u));
+				});
+
+				it("returns free blocks to the system", [&] {
+					allocateAndDelete();
+					std::vector<PoolSizeClassStatistics> before;
+					PoolMemoryAllocator::getSizeClassStatistics(before);
+					size_t allocatedBefore = PoolMemoryAllocator::memoryAllocatedInBlocks();
+
+					size_t released = PoolMemoryAllocator::trim();
+
+					std::vector<PoolSizeClassStatistics> after;
+					PoolMemoryAllocator::getSizeClassStatistics(after);
+					AssertThat(after[248].blocks, Equals(0u));
+					AssertThat(after[248].inThreadFreeList, Equals(0u));
+					AssertThat(released, IsGreaterThanOrEqualTo(before[248].blocks * 8192));
+					AssertThat(PoolMemoryAllocator::memoryAllocatedInBlocks(),
+							Equals(allocatedBefore - released));
+					AssertThat(PoolMemoryAllocator::trim(), Equals(0u));
+				});
+
+				it(
+						"trims when a thread hands over its memory",
+						[&] {
+							PoolMemoryAllocator::setTrimThreshold(1);
+							ogdf::Thread(allocateAndDelete).join();
+							PoolMemoryAllocator::setTrimThreshold(0);
+
+							std::vector<PoolSizeClassStatistics> stats;
+							PoolMemoryAllocator::getSizeClassStatistics(stats);
+							AssertThat(stats[248].blocks, Equals(0u));
+							AssertThat(stats[248].inGlobalFreeList, Equals(0u));
+						},
+#ifdef OGDF_MEMORY_POOL_NTS
+						true
+#else
+						false
+#endif
+				);
+			},
+#if defined(OGDF_MEMORY_MALLOC_TS) || defined(OGDF_MEMORY_ARENA_TS)
+			true
+#else
+			false
+#endif
+	);
+
+	describe("ArenaMemoryAllocator", [] {
+		it("frees all memory of a scope on its destruction", [] {
+			ArenaStatistics before = System::arenaStatisticsOfMemoryManager();
+			{
+				ArenaScope scope;
+				AssertThat(scope.memoryAllocatedInBlocks(), Equals(0u));
+				std::vector<void*> pieces;
+				for (int i = 0; i < 1024; ++i) {
+					pieces.push_back(ArenaMemoryAllocator::allocate(OBJ_SIZE));
+				}
+				AssertThat(scope.memoryAllocatedInBlocks(),
+						IsGreaterThanOrEqualTo(1024u * OBJ_SIZE));
+
+				// half of the pieces is abandoned and released with the scope
+				for (int i = 0; i < 512; ++i) {
+					ArenaMemoryAllocator::deallocate(OBJ_SIZE, pieces[i]);
+				}
+				AssertThat(ArenaMemoryAllocator::memoryInThreadFreeList(),
+						IsGreaterThanOrEqualTo(512u * OBJ_SIZE));
+			}
+			ArenaStatistics after = System::arenaStatisticsOfMemoryManager();
+			AssertThat(after.scopesOpened - before.scopesOpened, Equals(1u));
+			AssertThat(after.scopesClosed - before.scopesClosed, Equals(1u));
+			AssertThat(after.blocksReleased - before.blocksReleased,
+					Equals(after.blocksAllocated - before.blocksAllocated));
+		});
+
+		it("reuses memory freed in nested scopes only within them", [] {
+			ArenaScope outer;
+			void* p = ArenaMemoryAllocator::allocate(OBJ_SIZE);
+			{
+				ArenaScope inner;
+				void* q = ArenaMemoryAllocator::allocate(OBJ_SIZE);
+				AssertThat(q, !Equals(p));
+				ArenaMemoryAllocator::deallocate(OBJ_SIZE, p);
+				AssertThat(ArenaMemoryAllocator::allocate(OBJ_SIZE), !Equals(p));
+			}
+			AssertThat(ArenaMemoryAllocator::allocate(OBJ_SIZE), Equals(p));
+		});
+
+		it("hands thread memory over on thread termination", [] {
+			size_t globalBefore = ArenaMemoryAllocator::memoryInGlobalFreeList();
+			ogdf::Thread([] {
+				void* p = ArenaMemoryAllocator::allocate(OBJ_SIZE);
+				ArenaMemoryAllocator::deallocate(OBJ_SIZE, p);
+				// ogdf::Thread only flushes the configured memory manager
+				ArenaMemoryAllocator::flushPool();
+			}).join();
+			AssertThat(ArenaMemoryAllocator::memoryInGlobalFreeList(),
+					IsGreaterThanOrEqualTo(globalBefore + OBJ_SIZE));
+		});
+	});
 });
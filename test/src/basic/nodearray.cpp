@@ -31,8 +31,12 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphSets.h>
 #include <ogdf/basic/RegisteredSet.h>
+#include <ogdf/basic/Thread.h>
 #include <ogdf/basic/graph_generators.h>
 
+#include <functional>
+#include <vector>
+
 #include "array_helper.h" // IWYU pragma: associated
 #include <testing.h>
 
@@ -69,6 +73,47 @@ go_bandit([]() {
 		});
 	});
 
+	describe("NodeArray registration from multiple threads", [&]() {
+		it("registers and unregisters arrays concurrently", [&]() {
+			Graph G;
+			init(G);
+			const int numThreads = 8;
+			const size_t before = G.nodeRegistry().numberOfRegisteredArrays();
+
+			std::vector<NodeArray<int>> kept(numThreads);
+			std::vector<std::function<void()>> workers;
+			for (int t = 0; t < numThreads; ++t) {
+				workers.emplace_back([&, t] {
+					for (int i = 0; i < 1000; ++i) {
+						NodeArray<int> temp(G, i);
+						NodeArray<int> moved(std::move(temp));
+					}
+					kept[t].init(G, t);
+				});
+			}
+			Array<Thread> threads(numThreads);
+			for (int t = 0; t < numThreads; ++t) {
+				threads[t] = Thread(workers[t]);
+			}
+			for (Thread& thread : threads) {
+				thread.join();
+			}
+
+			AssertThat(G.nodeRegistry().numberOfRegisteredArrays(), Equals(before + numThreads));
+
+			// arrays registered by other threads still follow the graph
+			for (int i = 0; i < 100; ++i) {
+				G.newNode();
+			}
+			for (int t = 0; t < numThreads; ++t) {
+				AssertThat(kept[t][G.lastNode()], Equals(t));
+			}
+
+			kept.clear();
+			AssertThat(G.nodeRegistry().numberOfRegisteredArrays(), Equals(before));
+		});
+	});
+
 	runBasicSetTests<Graph, NodeSet, node>("NodeSet", init, chooseNode, allNodes, createNode,
 			deleteNode, clearNodes);
 });
@@ -0,0 +1,94 @@
+/** \file
+ * \brief Tests for ogdf::WorkStealingPool.
+ *
+ * \par License:
+ * This file is part of the Open Graph Drawing Framework (OGDF).
+ *
+ * \par
+ * Copyright (C)<br>
+ * See README.md in the OGDF root directory for details.
+ *
+ * \par
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * Version 2 or 3 as published by the Free Software Foundation;
+ * see the file LICENSE.txt included in the packaging of this file
+ * for details.
+ *
+ * \par
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * \par
+ * You should have received a copy of the GNU General Public
+ * License along with this program; if not, see
+ * http://www.gnu.org/copyleft/gpl.html
+ */
+
+#include <ogdf/basic/WorkStealingPool.h>
+
+#include <atomic>
+#include <vector>
+
+#include <testing.h>
+
+go_bandit([] {
+	describe("WorkStealingPool", [] {
+		it("executes every run exactly once", [] {
+			WorkStealingPool pool(3);
+			for (int nRuns : {0, 1, 4, 100}) {
+				std::vector<std::atomic<int>> calls(nRuns);
+				std::atomic<unsigned int> maxSlot {0};
+				WorkStealingPool::StopFlag stop;
+				pool.run(nRuns, 4, stop, [&](int run, unsigned int slot) {
+					++calls[run];
+					unsigned int seen = maxSlot;
+					while (slot > seen && !maxSlot.compare_exchange_weak(seen, slot)) { }
+				});
+				for (const std::atomic<int>& c : calls) {
+					AssertThat(c.load(), Equals(1));
+				}
+				AssertThat(maxSlot.load(), IsLessThan(4u));
+			}
+		});
+
+		it("starts no further runs after stop", [] {
+			WorkStealingPool pool(3);
+			std::atomic<int> calls {0};
+			WorkStealingPool::StopFlag stop;
+			pool.run(1000, 4, stop, [&](int, unsigned int) {
+				if (++calls == 10) {
+					stop.stop();
+				}
+			});
+			AssertThat(stop.stopped(), IsTrue());
+			// each of the at most four threads may have started one run concurrently
+			AssertThat(calls.load(), IsLessThan(14));
+		});
+
+		it("completes nested calls", [] {
+			WorkStealingPool pool(3);
+			std::atomic<int> calls {0};
+			WorkStealingPool::StopFlag stop;
+			pool.run(8, 4, stop, [&](int, unsigned int) {
+				WorkStealingPool::StopFlag innerStop;
+				pool.run(8, 4, innerStop, [&](int, unsigned int) { ++calls; });
+			});
+			AssertThat(calls.load(), Equals(64));
+		});
+
+		it("executes everything in the calling thread without pool threads", [] {
+			WorkStealingPool pool(0);
+			int calls = 0;
+			WorkStealingPool::StopFlag stop;
+			pool.run(10, 4, stop, [&](int run, unsigned int slot) {
+				AssertThat(run, Equals(calls));
+				AssertThat(slot, Equals(0u));
+				++calls;
+			});
+			AssertThat(calls, Equals(10));
+		});
+	});
+});
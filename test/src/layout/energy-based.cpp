@@ -48,10 +48,13 @@
 #include <ogdf/energybased/StressMinimization.h>
 #include <ogdf/energybased/TutteLayout.h>
 #include <ogdf/energybased/fmmm/FMMMOptions.h>
+#include <ogdf/energybased/multilevel_mixer/ModularMultilevelMixer.h>
 
+#include <cmath>
 #include <functional>
 #include <initializer_list>
 #include <string>
+#include <vector>
 
 #include "layout_helpers.h"
 #include <graphs.h>
@@ -121,6 +124,64 @@ void describeEnergyBasedLayout(const string& name, int extraAttr,
 	describeLayout(name, layout, extraAttr, requirements);
 }
 
+template<class T>
+void describeProgress(const string& name) {
+	describe(name + " reporting its progress", [] {
+		Graph G;
+		randomSimpleConnectedGraph(G, 200, 400);
+
+		auto assertCompleteLayout = [&](const GraphAttributes& GA) {
+			for (node v : G.nodes) {
+				AssertThat(std::isfinite(GA.x(v)), IsTrue());
+				AssertThat(std::isfinite(GA.y(v)), IsTrue());
+			}
+		};
+
+		it("exports intermediate layouts", [&] {
+			T layout;
+			init(layout);
+			GraphAttributes GA(G), snapshot(G);
+			int reports = 0;
+			layout.setProgressCallback([&](const ForceLayoutModule::Progress& progress) {
+				AssertThat(progress.level(), IsGreaterThanOrEqualTo(0));
+				AssertThat(progress.elapsedSeconds(), IsGreaterThanOrEqualTo(0.0));
+				progress.exportLayout(snapshot);
+				++reports;
+				return true;
+			});
+			layout.call(GA);
+			AssertThat(reports, IsGreaterThan(1));
+			AssertThat(layout.stoppedEarly(), IsFalse());
+			assertCompleteLayout(snapshot);
+		});
+
+		it("stops when the callback returns false", [&] {
+			T layout;
+			init(layout);
+			GraphAttributes GA(G);
+			int reports = 0;
+			layout.setProgressCallback([&](const ForceLayoutModule::Progress&) {
+				++reports;
+				return false;
+			});
+			layout.call(GA);
+			AssertThat(reports, Equals(1));
+			AssertThat(layout.stoppedEarly(), IsTrue());
+			assertCompleteLayout(GA);
+		});
+
+		it("stops when the time limit is exceeded", [&] {
+			T layout;
+			init(layout);
+			layout.timeLimit(0.0);
+			GraphAttributes GA(G);
+			layout.call(GA);
+			AssertThat(layout.stoppedEarly(), IsTrue());
+			assertCompleteLayout(GA);
+		});
+	});
+}
+
 void describeFMMM() {
 	TEST_ENERGY_BASED_LAYOUT(FMMMLayout, 0);
 
@@ -151,6 +212,13 @@ void describeFMMM() {
 	fmmm.useHighLevelOptions(false);
 	describeLayout("FMMMLayout with very specific configuration (using NewMultipoleMethod))", fmmm);
 
+	fmmm.nmThreads(4);
+	describeLayout("FMMMLayout using NewMultipoleMethod with 4 threads", fmmm);
+	fmmm.nmThreads(1);
+
+	fmmm.nmTreeConstruction(FMMMOptions::ReducedTreeConstruction::MortonOrder);
+	describeLayout("FMMMLayout using NewMultipoleMethod with a Morton-ordered quadtree", fmmm);
+
 	fmmm.allowedPositions(FMMMOptions::AllowedPositions::All);
 	fmmm.forceModel(FMMMOptions::ForceModel::FruchtermanReingold);
 	fmmm.galaxyChoice(FMMMOptions::GalaxyChoice::NonUniformProbHigherMass);
@@ -174,6 +242,82 @@ void describeFMMM() {
 		fmmm.call(GA);
 		AssertThat(fmmm.allowedPositions(), Equals(FMMMOptions::AllowedPositions::All));
 	});
+
+	it("computes the same layout in each run for a fixed number of threads", [] {
+		Graph G;
+		randomSimpleGraph(G, 1000, 2000);
+		GraphAttributes GA1(G), GA2(G);
+
+		FMMMLayout layout;
+		layout.useHighLevelOptions(false);
+		layout.repulsiveForcesCalculation(FMMMOptions::RepulsiveForcesMethod::NMM);
+		layout.nmThreads(3);
+		layout.call(GA1);
+		layout.call(GA2);
+
+		for (node v : G.nodes) {
+			AssertThat(GA1.x(v), Equals(GA2.x(v)));
+			AssertThat(GA1.y(v), Equals(GA2.y(v)));
+		}
+	});
+}
+
+void describeIncrementalMixer() {
+	describe("ModularMultilevelMixer with incremental updates", [] {
+		Graph G;
+		randomSimpleConnectedGraph(G, 300, 600);
+		GraphAttributes GA(G);
+		ModularMultilevelMixer mixer;
+		mixer.call(GA);
+
+		GraphAttributes before(GA);
+		List<node> changed;
+		std::vector<node> oldNodes(G.nodes.begin(), G.nodes.end());
+		for (int i = 0; i < 3; ++i) {
+			node v = G.newNode();
+			changed.pushBack(v);
+			for (int j = 0; j < 2; ++j) {
+				node w = oldNodes[randomNumber(0, 299)];
+				if (G.searchEdge(v, w) == nullptr) {
+					G.newEdge(v, w);
+					changed.pushBack(w);
+				}
+			}
+		}
+		mixer.callIncremental(GA, changed);
+
+		it("places the new nodes", [&] {
+			for (node v : changed) {
+				AssertThat(std::isfinite(GA.x(v)), IsTrue());
+				AssertThat(std::isfinite(GA.y(v)), IsTrue());
+			}
+		});
+
+		it("only moves nodes close to the change", [&] {
+			NodeArray<int> dist(G, -1);
+			std::vector<node> queue;
+			for (node v : changed) {
+				dist[v] = 0;
+				queue.push_back(v);
+			}
+			for (size_t i = 0; i < queue.size(); ++i) {
+				for (adjEntry adj : queue[i]->adjEntries) {
+					if (dist[adj->twinNode()] < 0) {
+						dist[adj->twinNode()] = dist[queue[i]] + 1;
+						queue.push_back(adj->twinNode());
+					}
+				}
+			}
+			int moved = 0;
+			for (node v : oldNodes) {
+				if (GA.x(v) != before.x(v) || GA.y(v) != before.y(v)) {
+					AssertThat(dist[v], IsLessThanOrEqualTo(mixer.incrementalRadius()));
+					++moved;
+				}
+			}
+			AssertThat(moved, IsGreaterThan(0));
+		});
+	});
 }
 
 go_bandit([] {
@@ -185,26 +329,59 @@ go_bandit([] {
 				GraphProperty::connected);
 
 		TEST_ENERGY_BASED_LAYOUT(FastMultipoleEmbedder, 0, GraphProperty::connected);
+
+		FastMultipoleEmbedder fme3D;
+		init(fme3D);
+		fme3D.setNumberOfThreads(2);
+		describeLayout("FastMultipoleEmbedder in 3D with 2 threads", fme3D, GraphAttributes::threeD,
+				{GraphProperty::connected});
 		TEST_ENERGY_BASED_LAYOUT(FastMultipoleMultilevelEmbedder, 0, GraphProperty::connected);
 
 		describeFMMM();
 
+		describeProgress<FMMMLayout>("FMMMLayout");
+		describeProgress<FastMultipoleMultilevelEmbedder>("FastMultipoleMultilevelEmbedder");
+		describeProgress<SpringEmbedderGridVariant>("SpringEmbedderGridVariant");
+
 		TEST_ENERGY_BASED_LAYOUT(GEMLayout, 0);
 
 		TEST_ENERGY_BASED_LAYOUT(MultilevelLayout, 0);
 
+		describeIncrementalMixer();
+
 		TEST_ENERGY_BASED_LAYOUT(NodeRespecterLayout, 0);
 
 		TEST_ENERGY_BASED_LAYOUT(PivotMDS, 0, GraphProperty::connected);
 
+		PivotMDS randomPivotMDS;
+		randomPivotMDS.setPivotSelection(PivotMDS::PivotSelection::Random);
+		randomPivotMDS.maxThreads(3);
+		describeLayout("PivotMDS with random pivots and 3 threads", randomPivotMDS, 0,
+				{GraphProperty::connected});
+
 		TEST_ENERGY_BASED_LAYOUT(SpringEmbedderFRExact, 0);
 
 		TEST_ENERGY_BASED_LAYOUT(SpringEmbedderGridVariant, 0);
 
+		SpringEmbedderGridVariant barnesHutGV;
+		barnesHutGV.repulsion(SpringEmbedderGridVariant::Repulsion::barnesHut);
+		describeLayout("SpringEmbedderGridVariant with Barnes-Hut repulsion", barnesHutGV);
+
 		TEST_ENERGY_BASED_LAYOUT(SpringEmbedderKK, 0, GraphProperty::connected);
 
+		SpringEmbedderKK scalarKK;
+		scalarKK.setUseVectorization(false);
+		describeLayout("SpringEmbedderKK without vectorization", scalarKK, 0,
+				{GraphProperty::connected});
+
 		TEST_ENERGY_BASED_LAYOUT(StressMinimization, 0);
 
+		StressMinimization sparseStress;
+		sparseStress.setIterations(50);
+		sparseStress.useSparseStress(true);
+		sparseStress.setNumberOfPivots(10);
+		describeLayout("StressMinimization with sparse stress", sparseStress);
+
 		TEST_ENERGY_BASED_LAYOUT(TutteLayout, 0, GraphProperty::triconnected, GraphProperty::planar,
 				GraphProperty::simple);
 	});
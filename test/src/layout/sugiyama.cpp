@@ -30,8 +30,10 @@
  */
 
 #include <ogdf/basic/Thread.h>
+#include <ogdf/basic/graph_generators/randomized.h>
 #include <ogdf/layered/BarycenterHeuristic.h>
 #include <ogdf/layered/CoffmanGrahamRanking.h>
+#include <ogdf/layered/CrossingsMatrix.h>
 #include <ogdf/layered/DfsAcyclicSubgraph.h>
 #include <ogdf/layered/FastHierarchyLayout.h>
 #include <ogdf/layered/FastSimpleHierarchyLayout.h>
@@ -39,8 +41,12 @@
 #include <ogdf/layered/GreedyInsertHeuristic.h>
 #include <ogdf/layered/GreedySwitchHeuristic.h>
 #include <ogdf/layered/GridSifting.h>
+#include <ogdf/layered/Hierarchy.h>
+#include <ogdf/layered/HierarchyLevels.h>
+#include <ogdf/layered/Level.h>
 #include <ogdf/layered/LongestPathRanking.h>
 #include <ogdf/layered/MedianHeuristic.h>
+#include <ogdf/layered/NetworkSimplexRanking.h>
 #include <ogdf/layered/OptimalHierarchyLayout.h>
 #include <ogdf/layered/OptimalRanking.h>
 #include <ogdf/layered/SiftingHeuristic.h>
@@ -48,9 +54,11 @@
 #include <ogdf/layered/SugiyamaLayout.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "layout_helpers.h"
 #include <graphs.h>
@@ -110,6 +118,188 @@ void describeSugi(const std::string& name, const std::set<GraphProperty>& reqs)
 }
 
 go_bandit([] {
+	describe("HierarchyLevels", [] {
+		it("counts crossings in parallel and incrementally", [] {
+			Graph G;
+			randomHierarchy(G, 10000, 20000, false, false, true);
+			NodeArray<int> rank(G);
+			LongestPathRanking().call(G, rank);
+			Hierarchy H(G, rank);
+			HierarchyLevels levels(H);
+			levels.permute();
+
+			int expected = 0;
+			for (int i = 0; i < levels.high(); ++i) {
+				expected += levels.calculateCrossings(i);
+			}
+			AssertThat(levels.calculateCrossings(), Equals(expected));
+			levels.maxThreads(4);
+			AssertThat(levels.calculateCrossings(), Equals(expected));
+			AssertThat(levels.updateCrossings(), Equals(expected));
+
+			NodeArray<double> weight(H);
+			for (int k = 0; k < 10; ++k) {
+				Level& level = levels[randomNumber(0, levels.high())];
+				for (int j = 0; j <= level.high(); ++j) {
+					weight[level[j]] = randomDouble(0, 1);
+				}
+				level.sort(weight);
+				if (level.size() > 1) {
+					levels.transpose(levels[randomNumber(0, levels.high())][0]);
+				}
+				AssertThat(levels.updateCrossings(), Equals(levels.calculateCrossings()));
+			}
+		});
+
+		it("keeps the positions of adjacent nodes up to date", [] {
+			Graph G;
+			randomHierarchy(G, 500, 1000, false, false, true);
+			NodeArray<int> rank(G);
+			LongestPathRanking().call(G, rank);
+			Hierarchy H(G, rank);
+			HierarchyLevels levels(H);
+
+			auto check = [&levels] {
+				for (auto dir : {HierarchyLevels::TraversingDir::downward,
+							 HierarchyLevels::TraversingDir::upward}) {
+					for (int i = 0; i <= levels.high(); ++i) {
+						const Level& level = levels[i];
+						const LevelAdjacency& adj = levels.adjPositions(i, dir);
+						for (int j = 0; j <= level.high(); ++j) {
+							std::vector<int> expected;
+							for (node w : levels.adjNodes(level[j], dir)) {
+								expected.push_back(levels.pos(w));
+							}
+							std::sort(expected.begin(), expected.end());
+							AssertThat(std::vector<int>(adj.begin(j), adj.end(j)),
+									Equals(expected));
+						}
+					}
+				}
+			};
+
+			check();
+			levels.permute();
+			check();
+
+			NodeArray<double> weight(H);
+			for (int k = 0; k < 10; ++k) {
+				Level& level = levels[randomNumber(0, levels.high())];
+				if (level.size() > 1) {
+					level.swap(0, level.high());
+				}
+				check();
+				for (int j = 0; j <= level.high(); ++j) {
+					weight[level[j]] = randomDouble(0, 1);
+				}
+				level.sort(weight);
+				check();
+			}
+		});
+
+		it("computes the crossings matrix", [] {
+			Graph G;
+			randomHierarchy(G, 200, 500, false, false, true);
+			NodeArray<int> rank(G);
+			LongestPathRanking().call(G, rank);
+			Hierarchy H(G, rank);
+			HierarchyLevels levels(H);
+			levels.permute();
+			levels.direction(HierarchyLevels::TraversingDir::upward);
+
+			CrossingsMatrix matrix(levels);
+			for (int i = 0; i < levels.high(); ++i) {
+				Level& level = levels[i];
+				matrix.init(level);
+				for (int j = 0; j <= level.high(); ++j) {
+					for (int k = 0; k <= level.high(); ++k) {
+						int crossings = 0;
+						if (j != k) {
+							for (node u : level.adjNodes(level[j])) {
+								for (node w : level.adjNodes(level[k])) {
+									crossings += levels.pos(u) > levels.pos(w);
+								}
+							}
+						}
+						AssertThat(matrix(j, k), Equals(crossings));
+					}
+				}
+			}
+		});
+	});
+
+	describe("NetworkSimplexRanking", [] {
+		auto totalLength = [](const Graph& G, const NodeArray<int>& rank) {
+			int length = 0;
+			for (edge e : G.edges) {
+				length += std::abs(rank[e->target()] - rank[e->source()]);
+			}
+			return length;
+		};
+
+		for (int n : {1, 10, 50, 200}) {
+			it("computes optimal rankings of random graphs with " + std::to_string(n) + " nodes",
+					[&, n] {
+						for (int k = 0; k < 5; ++k) {
+							Graph G;
+							randomGraph(G, n, 2 * n);
+
+							// both modules must use the same acyclic subgraph
+							NetworkSimplexRanking ns;
+							ns.setSubgraph(new GreedyCycleRemoval);
+							NodeArray<int> rank;
+							ns.call(G, rank);
+
+							OptimalRanking opt;
+							opt.setSubgraph(new GreedyCycleRemoval);
+							NodeArray<int> optRank;
+							opt.call(G, optRank);
+
+							for (edge e : G.edges) {
+								if (!e->isSelfLoop()) {
+									AssertThat(rank[e->source()], !Equals(rank[e->target()]));
+								}
+							}
+							AssertThat(totalLength(G, rank), Equals(totalLength(G, optRank)));
+						}
+					});
+		}
+	});
+
+	describe("FastSimpleHierarchyLayout", [] {
+		it("separates the nodes on each level of a large hierarchy", [] {
+			Graph G;
+			randomHierarchy(G, 5000, 10000, false, false, true);
+			NodeArray<int> rank(G);
+			LongestPathRanking().call(G, rank);
+			Hierarchy H(G, rank);
+			HierarchyLevels levels(H);
+			levels.permute();
+
+			GraphAttributes GA(G);
+			FastSimpleHierarchyLayout fshl;
+			fshl.call(levels, GA);
+
+			const GraphCopy& GC = H;
+			for (int i = 0; i <= levels.high(); ++i) {
+				node u = nullptr;
+				for (int j = 0; j <= levels[i].high(); ++j) {
+					node v = levels[i][j];
+					if (GC.isDummy(v)) {
+						continue;
+					}
+					node w = GC.original(v);
+					if (u != nullptr) {
+						AssertThat(GA.x(w) - GA.x(u),
+								!IsLessThan(0.5 * (GA.width(u) + GA.width(w)) + fshl.nodeDistance()
+										- 1e-6));
+					}
+					u = w;
+				}
+			}
+		});
+	});
+
 	describe("SugiyamaLayout", [] {
 		DESCRIBE_SUGI_LAYOUT(FastHierarchyLayout, {GraphProperty::sparse});
 		DESCRIBE_SUGI_LAYOUT(FastSimpleHierarchyLayout, {GraphProperty::sparse});